@@ -27,71 +27,134 @@
 
 #include "ggqr.h"
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <utility>
 
 #include "ggqr_lagrange.h"
 #include "ggqr_lu.h"
+#include "../utils/mpfr_context.h"
+#include "../utils/mpfr_expression.h"
 #include "../utils/mpfr_polynomial.h"
 
-ggqr::ggqr() {
-    mpfr_class::set_default_prec(512);
+template <class T>
+ggqr_basic<T>::ggqr_basic() {
+    this->m_precision = mpfr_scalar_traits<T>::is_fixed_prec ? mpfr_scalar_traits<T>::fixed_prec : 512;
+    this->m_rnd = MPFR_RNDN;
+    mpfr_context context(this->m_precision, this->m_rnd);
     this->m_singularity = ggqr_logarithm;
     this->m_exponent = 0;
-    this->m_error_tolerance = "1e-20";
+    this->m_error_tolerance = T(mpfr_class::literal("1e-20"));
     this->m_max_damping = 5;
     this->m_n_nodes = 10;
     this->m_eval_func = NULL;
     this->m_left_limit = 0;
     this->m_right_limit = 1;
+    this->m_use_precision_ladder = false;
+    this->m_ladder_start_precision = 64;
+    this->m_use_certification = false;
 }
 
-ggqr::~ggqr() {
+template <class T>
+ggqr_basic<T>::~ggqr_basic() {
 }
 
-void ggqr::set_precision(const mpfr_prec_t precision) {
-    mpfr_class::set_default_prec(precision);
+template <class T>
+void ggqr_basic<T>::set_precision(const mpfr_prec_t precision) {
+    if (mpfr_scalar_traits<T>::is_fixed_prec && precision != mpfr_scalar_traits<T>::fixed_prec) {
+        printf("ggqr[%s:%d]: The precision of a fixed-precision scalar type cannot be changed.\n", __FILE__, __LINE__);
+        abort();
+    }
+    this->m_precision = precision;
+    this->round_to_precision(this->m_exponent);
+    this->round_to_precision(this->m_error_tolerance);
+    this->round_to_precision(this->m_left_limit);
+    this->round_to_precision(this->m_right_limit);
+}
+
+template <class T>
+void ggqr_basic<T>::set_rounding_mode(const mpfr_rnd_t rnd) {
+    this->m_rnd = rnd;
 }
 
-void ggqr::set_singularity(const singularity_type singularity) {
+template <class T>
+void ggqr_basic<T>::set_singularity(const singularity_type singularity) {
     this->m_singularity = singularity;
 }
 
-void ggqr::set_singularity_exponent(const mpfr_class& exponent) {
+template <class T>
+void ggqr_basic<T>::set_singularity_exponent(const T& exponent) {
     this->m_exponent = exponent;
+    this->round_to_precision(this->m_exponent);
 }
 
-void ggqr::set_error_tolerance(const mpfr_class& error_tolerance) {
+template <class T>
+void ggqr_basic<T>::set_error_tolerance(const T& error_tolerance) {
     this->m_error_tolerance = error_tolerance;
+    this->round_to_precision(this->m_error_tolerance);
 }
 
-void ggqr::set_max_damping(const size_t max_damping) {
+template <class T>
+void ggqr_basic<T>::set_max_damping(const size_t max_damping) {
     this->m_max_damping = max_damping;
 }
 
-void ggqr::set_n_nodes(const size_t n_nodes) {
+template <class T>
+void ggqr_basic<T>::set_n_nodes(const size_t n_nodes) {
     this->m_n_nodes = n_nodes;
 }
 
-void ggqr::set_evaluation_function(mpfr_class (*eval_func)(const mpfr_class&)) {
+template <class T>
+void ggqr_basic<T>::set_evaluation_function(T (*eval_func)(const T&)) {
     this->m_eval_func = eval_func;
 }
 
-void ggqr::set_left_limit(const mpfr_class& left_limit) {
+template <class T>
+void ggqr_basic<T>::set_left_limit(const T& left_limit) {
     this->m_left_limit = left_limit;
+    this->round_to_precision(this->m_left_limit);
 }
 
-void ggqr::set_right_limit(const mpfr_class& right_limit) {
+template <class T>
+void ggqr_basic<T>::set_right_limit(const T& right_limit) {
     this->m_right_limit = right_limit;
+    this->round_to_precision(this->m_right_limit);
+}
+
+template <class T>
+void ggqr_basic<T>::set_precision_ladder(const bool use_ladder, const mpfr_prec_t start_precision) {
+    if (mpfr_scalar_traits<T>::is_fixed_prec && use_ladder) {
+        printf("ggqr[%s:%d]: The precision ladder requires a variable-precision scalar type.\n", __FILE__, __LINE__);
+        abort();
+    }
+    this->m_use_precision_ladder = use_ladder;
+    this->m_ladder_start_precision = start_precision;
+}
+
+// With certification the iteration only stops once the Krawczyk test proves a
+// zero within the error tolerance, so the tolerance has to be attainable at the
+// working precision.
+template <class T>
+void ggqr_basic<T>::set_certification(const bool use_certification) {
+    this->m_use_certification = use_certification;
+}
+
+template <class T>
+T ggqr_basic<T>::singularity_value(const T& value) {
+    T result;
+    this->singularity_value_into(result, value);
+    return result;
 }
 
-mpfr_class ggqr::singularity_value(const mpfr_class& value) {
+template <class T>
+void ggqr_basic<T>::singularity_value_into(T& result, const T& value) {
     switch (this->m_singularity) {
         case ggqr_exponentiation: { // => x^e
-            return (value ^ this->m_exponent);
+            T::pow(result, value, this->m_exponent);
         } break;
         case ggqr_logarithm: { // => log(x)
-            return value.log_value();
+            T::log_into(result, value);
         } break;
         default: {
             printf("ggqr[%s:%d]: Undefined singularity function.\n", __FILE__, __LINE__);
@@ -100,10 +163,11 @@ mpfr_class ggqr::singularity_value(const mpfr_class& value) {
     }
 }
 
-mpfr_class ggqr::singularity_value_inverse(const mpfr_class& value) {
+template <class T>
+T ggqr_basic<T>::singularity_value_inverse(const T& value) {
     switch (this->m_singularity) {
         case ggqr_exponentiation: { // => x^(1/e)
-            mpfr_class exponent = 1 / this->m_exponent;
+            T exponent = 1 / this->m_exponent;
             return (value ^ exponent);
         } break;
         case ggqr_logarithm: { // => exp(x)
@@ -116,13 +180,23 @@ mpfr_class ggqr::singularity_value_inverse(const mpfr_class& value) {
     }
 }
 
-mpfr_class ggqr::singularity_value_derivation(const mpfr_class& value) {
+template <class T>
+T ggqr_basic<T>::singularity_value_derivation(const T& value) {
+    T result;
+    this->singularity_value_derivation_into(result, value);
+    return result;
+}
+
+template <class T>
+void ggqr_basic<T>::singularity_value_derivation_into(T& result, const T& value) {
     switch (this->m_singularity) {
         case ggqr_exponentiation: { // => e * x^(e-1)
-            return (this->m_exponent * (value ^ (this->m_exponent - 1)));
+            T::sub(result, this->m_exponent, 1);
+            T::pow(result, value, result);
+            T::mul(result, result, this->m_exponent);
         } break;
         case ggqr_logarithm: { // => 1/x
-            return (1 / value);
+            T::div(result, 1, value);
         } break;
         default: {
             printf("ggqr[%s:%d]: Undefined singularity function.\n", __FILE__, __LINE__);
@@ -131,33 +205,99 @@ mpfr_class ggqr::singularity_value_derivation(const mpfr_class& value) {
     }
 }
 
-mpfr_class ggqr::basis_value(const mpfr_class& value, const size_t k) {
+// psi at all values at once, in the precision of the entries of result.
+template <class T>
+void ggqr_basic<T>::singularity_values_into(mpfr_basic_vector<T>& result, const mpfr_basic_vector_const_view<T>& values) {
+    if (result.size() != values.size()) {
+        result = mpfr_basic_vector<T>(values.size());
+    }
+    switch (this->m_singularity) {
+        case ggqr_exponentiation: { // => x^e
+            values.pow_all(this->m_exponent, result);
+        } break;
+        case ggqr_logarithm: { // => log(x)
+            values.log_all(result);
+        } break;
+        default: {
+            printf("ggqr[%s:%d]: Undefined singularity function.\n", __FILE__, __LINE__);
+            abort();
+        }
+    }
+}
+
+template <class T>
+T ggqr_basic<T>::basis_value(const T& value, const size_t k) {
+    T result, tmp;
+    this->basis_value_into(result, value, k, tmp);
+    return result;
+}
+
+template <class T>
+void ggqr_basic<T>::basis_value_into(T& result, const T& value, const size_t k, T& tmp) {
     if (k % 2 == 0) { // => x^(k/2)
-        return (value ^ (k / 2));
+        T::pow_ui(result, value, k / 2);
+        return;
+    }
+    this->singularity_value_into(tmp, value);
+    this->basis_value_from_singularity_into(result, value, tmp, k);
+}
+
+// Same as basis_value_into with psi(value) given.
+template <class T>
+void ggqr_basic<T>::basis_value_from_singularity_into(T& result, const T& value, const T& singularity, const size_t k) {
+    if (k % 2 == 0) { // => x^(k/2)
+        T::pow_ui(result, value, k / 2);
+        return;
     }
     // => x^((k-1)/2) * psi(x)
-    return ((value ^ ((k - 1) / 2)) * this->singularity_value(value));
+    T::pow_ui(result, value, (k - 1) / 2);
+    T::mul(result, result, singularity);
+}
+
+template <class T>
+T ggqr_basic<T>::basis_value_derivation(const T& value, const size_t k) {
+    T result, tmp;
+    this->basis_value_derivation_into(result, value, k, tmp);
+    return result;
+}
+
+template <class T>
+void ggqr_basic<T>::basis_value_derivation_into(T& result, const T& value, const size_t k, T& tmp) {
+    if (k % 2 == 1 && k > 1 && this->m_singularity == ggqr_logarithm) {
+        this->singularity_value_into(tmp, value);
+    }
+    this->basis_value_derivation_from_singularity_into(result, value, tmp, k, tmp);
 }
 
-mpfr_class ggqr::basis_value_derivation(const mpfr_class& value, const size_t k) {
+// Same as basis_value_derivation_into with psi(value) given. Only the
+// logarithmic case reads the singularity, which may alias tmp.
+template <class T>
+void ggqr_basic<T>::basis_value_derivation_from_singularity_into(T& result, const T& value, const T& singularity, const size_t k, T& tmp) {
     if (k % 2 == 0) {
         if (k == 0) {
-            return 0;
+            result.set_zero(1);
         } else { // => (k/2) * x^(k/2-1)
-            return ((k / 2) * (value ^ ((k / 2) - 1)));
+            T::pow_ui(result, value, (k / 2) - 1);
+            T::mul(result, result, k / 2);
         }
+        return;
     }
     if (k == 1) { // => psi'(x)
-        return this->singularity_value_derivation(value);
+        this->singularity_value_derivation_into(result, value);
+        return;
     }
     switch (this->m_singularity) {
         case ggqr_exponentiation: { // => (e + (k-1)/2) * x^(e + (k-3)/2)
-            mpfr_class tmp = this->m_exponent + ((k - 3) / 2);
-            return ((this->m_exponent + ((k - 1) / 2)) * (value ^ tmp));
+            T::add(tmp, this->m_exponent, (k - 3) / 2);
+            T::pow(result, value, tmp);
+            T::add(tmp, this->m_exponent, (k - 1) / 2);
+            T::mul(result, result, tmp);
         } break;
         case ggqr_logarithm: { // => x^((k-3)/2) * ((k-1)/2 * log(x) + 1)
-            mpfr_class tmp = ((k - 1) / 2) * value.log_value() + 1;
-            return (tmp * (value ^ ((k - 3) / 2)));
+            T::mul(tmp, singularity, (k - 1) / 2);
+            T::add(tmp, tmp, 1);
+            T::pow_ui(result, value, (k - 3) / 2);
+            T::mul(result, result, tmp);
         } break;
         default: {
             printf("ggqr[%s:%d]: Undefined singularity function.\n", __FILE__, __LINE__);
@@ -166,19 +306,20 @@ mpfr_class ggqr::basis_value_derivation(const mpfr_class& value, const size_t k)
     }
 }
 
-mpfr_class ggqr::basis_value_antiderivation(const mpfr_class& value, const size_t k) {
+template <class T>
+T ggqr_basic<T>::basis_value_antiderivation(const T& value, const size_t k) {
     if (k % 2 == 0) { // => 1/((k+2)/2) * x^((k+2)/2)
         size_t tmp = (k + 2) / 2;
         return ((value ^ tmp) / tmp);
     }
     switch (this->m_singularity) {
         case ggqr_exponentiation: { // => (2/(2*e+k+1)) * x^((2*e+k+1)/2)
-            mpfr_class tmp = (2 * this->m_exponent + k + 1) / 2;
+            T tmp = (2 * this->m_exponent + k + 1) / 2;
             return ((value ^ tmp) / tmp);
         } break;
         case ggqr_logarithm: { // => (2*x^((k+1)/2) * ((k+1)*log(x)-2)) / ((k+1)*(k+1))
-            mpfr_class tmp = (k + 1) * (k + 1);
-            return ((2 * (value ^ ((k + 1) / 2)) * (((k + 1) * value.log_value()) - 2)) / tmp);
+            T tmp = (k + 1) * (k + 1);
+            return T((2 * (mpfr_expr(value) ^ ((k + 1) / 2)) * (((k + 1) * mpfr_expr(value.log_value())) - 2)) / mpfr_expr(tmp));
         } break;
         default: {
             printf("ggqr[%s:%d]: Undefined singularity function.\n", __FILE__, __LINE__);
@@ -187,169 +328,499 @@ mpfr_class ggqr::basis_value_antiderivation(const mpfr_class& value, const size_
     }
 }
 
-mpfr_class ggqr::basis_value_integration(const size_t k) {
+template <class T>
+T ggqr_basic<T>::basis_value_integration(const size_t k) {
     return (this->basis_value_antiderivation(this->m_right_limit, k) -
             this->basis_value_antiderivation(this->m_left_limit + this->m_delta, k));
 }
 
-mpfr_vector ggqr::function_f_value(const mpfr_vector& nodes_weights) {
+template <class T>
+mpfr_basic_vector<T> ggqr_basic<T>::function_f_value(const mpfr_basic_vector_const_view<T>& nodes_weights) {
     if (nodes_weights.size() % 2 == 1) {
         printf("ggqr[%s:%d]: The size of the vector must be even.\n", __FILE__, __LINE__);
         abort();
     }
-    mpfr_vector::size_t n = nodes_weights.size() / 2;
-    mpfr_vector result(nodes_weights.size(), 0);
-    for (mpfr_vector::size_t i = 0; i < nodes_weights.size(); ++i) {
-        for (mpfr_vector::size_t j = 0; j < n; ++j) {
-            result[i] += nodes_weights[n + j] * this->basis_value(nodes_weights[j], i);
+    size_t n = nodes_weights.size() / 2;
+    mpfr_basic_vector<T> result(nodes_weights.size(), 0);
+    mpfr_basic_vector_const_view<T> nodes = nodes_weights.slice(0, n);
+    mpfr_basic_vector_const_view<T> weights = nodes_weights.slice(n, n);
+    mpfr_basic_vector<T> singularity_values(n);
+    this->singularity_values_into(singularity_values, nodes);
+    mpfr_basic_accumulator<T> sum;
+    T basis;
+    for (size_t i = 0; i < nodes_weights.size(); ++i) {
+        sum.reset();
+        for (size_t j = 0; j < n; ++j) {
+            this->basis_value_from_singularity_into(basis, nodes[j], singularity_values[j], i);
+            sum.addmul(weights[j], basis);
         }
-        result[i] -= this->basis_value_integration(i);
+        sum.sub(this->basis_value_integration(i));
+        sum.get(result[i]);
     }
     return result;
 }
 
-mpfr_matrix ggqr::function_f_value_derivation(const mpfr_vector& nodes_weights) {
+template <class T>
+mpfr_basic_matrix<T> ggqr_basic<T>::function_f_value_derivation(const mpfr_basic_vector_const_view<T>& nodes_weights) {
+    mpfr_basic_matrix<T> result(nodes_weights.size(), nodes_weights.size());
+    this->function_f_value_derivation(nodes_weights, result);
+    return result;
+}
+
+// The entries are computed in their own precision and the matrix is only
+// reallocated if its size does not match, so a reused matrix costs no
+// allocations. psi is evaluated once for all nodes.
+template <class T>
+void ggqr_basic<T>::function_f_value_derivation(const mpfr_basic_vector_const_view<T>& nodes_weights, mpfr_basic_matrix<T>& result) {
+    if (nodes_weights.size() % 2 == 1) {
+        printf("ggqr[%s:%d]: The size of the vector must be even.\n", __FILE__, __LINE__);
+        abort();
+    }
+    size_t n = nodes_weights.size() / 2;
+    if (result.n_rows() != nodes_weights.size() || result.n_cols() != nodes_weights.size()) {
+        result = mpfr_basic_matrix<T>(nodes_weights.size(), nodes_weights.size());
+    }
+    T& tmp = this->m_scratch;
+    mpfr_basic_vector<T>& singularity_values = this->m_scratch_singularity_values;
+    if (n > 0 && tmp.get_prec() != result(0, 0).get_prec()) {
+        tmp.set_prec(result(0, 0).get_prec());
+    }
+    if (singularity_values.size() != n) {
+        singularity_values = mpfr_basic_vector<T>(n);
+    }
+    if (n > 0 && singularity_values[0].get_prec() != tmp.get_prec()) {
+        singularity_values.set_prec(tmp.get_prec());
+    }
+    mpfr_basic_vector_const_view<T> nodes = nodes_weights.slice(0, n);
+    mpfr_basic_vector_const_view<T> weights = nodes_weights.slice(n, n);
+    this->singularity_values_into(singularity_values, nodes);
+    for (size_t i = 0; i < nodes_weights.size(); ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            this->basis_value_derivation_from_singularity_into(result(i, j), nodes[j], singularity_values[j], i, tmp);
+            T::mul(result(i, j), weights[j], result(i, j));
+        }
+        for (size_t j = n; j < nodes_weights.size(); ++j) {
+            this->basis_value_from_singularity_into(result(i, j), nodes[j - n], singularity_values[j - n], i);
+        }
+    }
+}
+
+template <class T>
+mpfr_ball ggqr_basic<T>::singularity_value_ball(const mpfr_ball& value) {
+    switch (this->m_singularity) {
+        case ggqr_exponentiation: { // => x^e
+            return (value ^ mpfr_ball(this->m_exponent.class_value()));
+        } break;
+        case ggqr_logarithm: { // => log(x)
+            return value.log_value();
+        } break;
+        default: {
+            printf("ggqr[%s:%d]: Undefined singularity function.\n", __FILE__, __LINE__);
+            abort();
+        }
+    }
+}
+
+template <class T>
+mpfr_ball ggqr_basic<T>::singularity_value_derivation_ball(const mpfr_ball& value) {
+    switch (this->m_singularity) {
+        case ggqr_exponentiation: { // => e * x^(e-1)
+            mpfr_ball exponent(this->m_exponent.class_value());
+            return (exponent * (value ^ (exponent - 1)));
+        } break;
+        case ggqr_logarithm: { // => 1/x
+            return (1 / value);
+        } break;
+        default: {
+            printf("ggqr[%s:%d]: Undefined singularity function.\n", __FILE__, __LINE__);
+            abort();
+        }
+    }
+}
+
+template <class T>
+mpfr_ball ggqr_basic<T>::basis_value_ball(const mpfr_ball& value, const size_t k) {
+    if (k % 2 == 0) { // => x^(k/2)
+        return (value ^ (k / 2));
+    }
+    // => x^((k-1)/2) * psi(x)
+    return ((value ^ ((k - 1) / 2)) * this->singularity_value_ball(value));
+}
+
+template <class T>
+mpfr_ball ggqr_basic<T>::basis_value_derivation_ball(const mpfr_ball& value, const size_t k) {
+    if (k % 2 == 0) {
+        if (k == 0) {
+            return mpfr_ball(0);
+        }
+        // => (k/2) * x^(k/2-1)
+        return ((k / 2) * (value ^ ((k / 2) - 1)));
+    }
+    if (k == 1) { // => psi'(x)
+        return this->singularity_value_derivation_ball(value);
+    }
+    switch (this->m_singularity) {
+        case ggqr_exponentiation: { // => (e + (k-1)/2) * x^(e + (k-3)/2)
+            mpfr_ball exponent(this->m_exponent.class_value());
+            return ((exponent + (k - 1) / 2) * (value ^ (exponent + (k - 3) / 2)));
+        } break;
+        case ggqr_logarithm: { // => x^((k-3)/2) * ((k-1)/2 * log(x) + 1)
+            return ((value ^ ((k - 3) / 2)) * ((k - 1) / 2 * value.log_value() + 1));
+        } break;
+        default: {
+            printf("ggqr[%s:%d]: Undefined singularity function.\n", __FILE__, __LINE__);
+            abort();
+        }
+    }
+}
+
+template <class T>
+mpfr_ball ggqr_basic<T>::basis_value_antiderivation_ball(const mpfr_ball& value, const size_t k) {
+    if (k % 2 == 0) { // => 1/((k+2)/2) * x^((k+2)/2)
+        size_t tmp = (k + 2) / 2;
+        return ((value ^ tmp) / tmp);
+    }
+    switch (this->m_singularity) {
+        case ggqr_exponentiation: { // => (2/(2*e+k+1)) * x^((2*e+k+1)/2)
+            mpfr_ball tmp = (2 * mpfr_ball(this->m_exponent.class_value()) + (k + 1)) / 2;
+            return ((value ^ tmp) / tmp);
+        } break;
+        case ggqr_logarithm: { // => (2*x^((k+1)/2) * ((k+1)*log(x)-2)) / ((k+1)*(k+1))
+            size_t tmp = (k + 1) * (k + 1);
+            return ((2 * (value ^ ((k + 1) / 2)) * ((k + 1) * value.log_value() - 2)) / tmp);
+        } break;
+        default: {
+            printf("ggqr[%s:%d]: Undefined singularity function.\n", __FILE__, __LINE__);
+            abort();
+        }
+    }
+}
+
+// The antiderivatives vanish at a left limit of zero, where they can only be
+// evaluated as a limit.
+template <class T>
+mpfr_ball ggqr_basic<T>::basis_value_integration_ball(const mpfr_ball& left_limit, const size_t k) {
+    mpfr_ball right = this->basis_value_antiderivation_ball(mpfr_ball(this->m_right_limit.class_value()), k);
+    if (left_limit.is_zero()) {
+        return right;
+    }
+    return (right - this->basis_value_antiderivation_ball(left_limit, k));
+}
+
+// Enclosure of the residual for the moments over [left_limit, b].
+template <class T>
+mpfr_basic_vector<mpfr_ball> ggqr_basic<T>::function_f_value_ball(const mpfr_basic_vector_const_view<T>& nodes_weights, const mpfr_ball& left_limit) {
     if (nodes_weights.size() % 2 == 1) {
         printf("ggqr[%s:%d]: The size of the vector must be even.\n", __FILE__, __LINE__);
         abort();
     }
-    mpfr_vector::size_t n = nodes_weights.size() / 2;
-    mpfr_matrix result(nodes_weights.size(), nodes_weights.size(), 0);
-    for (mpfr_vector::size_t i = 0; i < nodes_weights.size(); ++i) {
-        for (mpfr_vector::size_t j = 0; j < n; ++j) {
-            result[i][j] = nodes_weights[n + j] * this->basis_value_derivation(nodes_weights[j], i);
+    size_t n = nodes_weights.size() / 2;
+    mpfr_basic_vector<mpfr_ball> nodes(n);
+    mpfr_basic_vector<mpfr_ball> weights(n);
+    for (size_t j = 0; j < n; ++j) {
+        nodes[j] = mpfr_ball(nodes_weights[j].class_value());
+        weights[j] = mpfr_ball(nodes_weights[n + j].class_value());
+    }
+    mpfr_basic_vector<mpfr_ball> result(nodes_weights.size(), 0);
+    for (size_t i = 0; i < nodes_weights.size(); ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            result[i].addmul(weights[j], this->basis_value_ball(nodes[j], i));
         }
-        for (mpfr_vector::size_t j = n; j < nodes_weights.size(); ++j) {
-            result[i][j] = this->basis_value(nodes_weights[j - n], i);
+        result[i] -= this->basis_value_integration_ball(left_limit, i);
+    }
+    return result;
+}
+
+// Column of the Jacobian enclosed over the balls of nodes and weights.
+template <class T>
+mpfr_basic_vector<mpfr_ball> ggqr_basic<T>::function_f_value_derivation_ball(const mpfr_basic_vector<mpfr_ball>& nodes_weights, const size_t column) {
+    if (nodes_weights.size() % 2 == 1) {
+        printf("ggqr[%s:%d]: The size of the vector must be even.\n", __FILE__, __LINE__);
+        abort();
+    }
+    size_t n = nodes_weights.size() / 2;
+    mpfr_basic_vector<mpfr_ball> result(nodes_weights.size());
+    for (size_t i = 0; i < nodes_weights.size(); ++i) {
+        if (column < n) {
+            result[i] = nodes_weights[n + column] * this->basis_value_derivation_ball(nodes_weights[column], i);
+        } else {
+            result[i] = this->basis_value_ball(nodes_weights[column - n], i);
         }
     }
     return result;
 }
 
-mpfr_class ggqr::starting_point() { // psi^-1( (Psi(b)-Psi(a+d)) / (b-(a+d)) )
-    mpfr_class limit_delta = this->m_right_limit - (this->m_left_limit + this->m_delta);
-    mpfr_class value = this->basis_value_integration(1) / limit_delta;
+template <class T>
+T ggqr_basic<T>::starting_point() { // psi^-1( (Psi(b)-Psi(a+d)) / (b-(a+d)) )
+    T limit_delta = this->m_right_limit - (this->m_left_limit + this->m_delta);
+    T value = this->basis_value_integration(1) / limit_delta;
     return this->singularity_value_inverse(value);
 }
 
-mpfr_vector ggqr::starting_points(const mpfr_vector& previous_nodes) {
-    mpfr_vector::size_t size = previous_nodes.size();
-    mpfr_vector nodes(size + 1);
+template <class T>
+mpfr_basic_vector<T> ggqr_basic<T>::starting_points(const mpfr_basic_vector_const_view<T>& previous_nodes) {
+    size_t size = previous_nodes.size();
+    mpfr_basic_vector<T> nodes(size + 1);
     nodes[0] = (this->m_left_limit + this->m_delta + previous_nodes[0]) / 2;
-    for (mpfr_vector::size_t i = 1; i < size; ++i) {
+    for (size_t i = 1; i < size; ++i) {
         nodes[i] = (previous_nodes[i - 1] + previous_nodes[i]) / 2;
     }
     nodes[size] = (previous_nodes[size - 1] + this->m_right_limit) / 2;
     return nodes;
 }
 
-mpfr_vector ggqr::starting_weights(const mpfr_vector& nodes) {
-    mpfr_vector::size_t size = nodes.size();
-    mpfr_class left_limit = this->m_left_limit + this->m_delta;
+template <class T>
+mpfr_basic_vector<T> ggqr_basic<T>::starting_weights(const mpfr_basic_vector<T>& nodes) {
+    size_t size = nodes.size();
+    T left_limit = this->m_left_limit + this->m_delta;
     if (size == 1) {
-        mpfr_vector weight(1);
+        mpfr_basic_vector<T> weight(1);
         weight[0] = this->m_right_limit - left_limit;
         return weight;
     }
-    ggqr_lagrange lagrange(nodes);
+    ggqr_basic_lagrange<T> lagrange(nodes);
     lagrange.calculate();
-    mpfr_vector weights(size);
-    for (mpfr_vector::size_t i = 0; i < size; ++i) {
-        mpfr_polynomial basis_polynomial = lagrange.get_basis_polynomial(i);
+    mpfr_basic_vector<T> weights(size);
+    for (size_t i = 0; i < size; ++i) {
+        mpfr_basic_polynomial<T> basis_polynomial = lagrange.get_basis_polynomial(i);
         weights[i] = basis_polynomial.integral(left_limit, this->m_right_limit);
     }
     return weights;
 }
 
-mpfr_vector ggqr::starting_values(const size_t n_nodes) {
-    mpfr_vector nodes(1, this->starting_point());
-    for (mpfr_vector::size_t i = 1; i < n_nodes; ++i) {
+template <class T>
+mpfr_basic_vector<T> ggqr_basic<T>::starting_values(const size_t n_nodes) {
+    mpfr_basic_vector<T> nodes(1, this->starting_point());
+    for (size_t i = 1; i < n_nodes; ++i) {
         nodes = this->starting_points(nodes);
     }
-    mpfr_vector weights = this->starting_weights(nodes);
-    mpfr_vector nodes_weights(2 * n_nodes);
-    for (mpfr_vector::size_t i = 0; i < n_nodes; ++i) {
-        nodes_weights[i] = nodes[i];
-        nodes_weights[n_nodes + i] = weights[i];
-    }
-    return nodes_weights;
+    mpfr_basic_vector<T> weights = this->starting_weights(nodes);
+    nodes.append(std::move(weights));
+    return nodes;
 }
 
-void ggqr::execute() {
+template <class T>
+void ggqr_basic<T>::execute() {
+    mpfr_context context(this->m_precision, this->m_rnd);
     this->do_calculation_level_delta();
     this->output_nodes_weights();
     this->output_evaluation();
 }
 
-void ggqr::do_calculation_level_delta() {
+template <class T>
+void ggqr_basic<T>::round_to_precision(T& value) const {
+    mpfr_context context(this->m_precision, this->m_rnd);
+    value.round_prec(this->m_precision);
+}
+
+// Upper bound of the euclidean norm over all vectors in the balls.
+template <class T>
+T ggqr_basic<T>::certified_norm(const mpfr_basic_vector<mpfr_ball>& values) const {
+    mpfr_class result = mpfr_ball::zero_radius();
+    for (size_t i = 0; i < values.size(); ++i) {
+        mpfr_class magnitude = values[i].get_magnitude();
+        mpfr_sqr(magnitude.get_raw(), magnitude.get_raw(), MPFR_RNDU);
+        mpfr_add(result.get_raw(), result.get_raw(), magnitude.get_raw(), MPFR_RNDU);
+    }
+    mpfr_sqrt(result.get_raw(), result.get_raw(), MPFR_RNDU);
+    return T(result);
+}
+
+// Error bound of x for the moments over [a+delta, b] or [a, b] by the
+// Krawczyk test. With C the inverse of the factors of J(x), y the enclosure of
+// C F(x) and X the balls around x with radii r, the image
+// x - y + (I - C J(X)) (X - x) lying inside X proves that F has a unique zero
+// in X. The radii are inflated from |y|, and NaN is returned if the test
+// fails. The balls and the factors carry guard bits, so that the test also
+// holds for Jacobians too ill-conditioned for the working precision.
+template <class T>
+T ggqr_basic<T>::certified_error(const mpfr_basic_vector<T>& x, const bool with_delta) {
+    mpfr_context context(this->m_precision + mpfr_ball::radius_precision, this->m_rnd);
+    mpfr_ball left_limit(this->m_left_limit.class_value());
+    if (with_delta) {
+        left_limit += mpfr_ball(this->m_delta.class_value());
+    }
+    size_t size = x.size();
+    mpfr_basic_vector<mpfr_ball> points(size);
+    for (size_t i = 0; i < size; ++i) {
+        points[i] = mpfr_ball(x[i].class_value());
+    }
+    mpfr_basic_matrix<mpfr_class> jac_f(size, size);
+    for (size_t j = 0; j < size; ++j) {
+        mpfr_basic_vector<mpfr_ball> column = this->function_f_value_derivation_ball(points, j);
+        for (size_t i = 0; i < size; ++i) {
+            jac_f(i, j) = column[i].get_mid();
+        }
+    }
+    ggqr_basic_lu<mpfr_class> lu(std::move(jac_f));
+    lu.decompose();
+    mpfr_basic_vector<mpfr_ball> correction = lu.solve_ball(this->function_f_value_ball(x, left_limit));
+    mpfr_class floor = mpfr_ball::zero_radius();
+    for (size_t i = 0; i < size; ++i) {
+        mpfr_max(floor.get_raw(), floor.get_raw(), correction[i].get_magnitude().get_raw(), MPFR_RNDU);
+    }
+    mpfr_div_2si(floor.get_raw(), floor.get_raw(), krawczyk_floor_bits, MPFR_RNDU);
+    mpfr_basic_vector<mpfr_ball> domain(size);
+    mpfr_basic_vector<mpfr_ball> offsets(size);
+    mpfr_basic_vector<mpfr_ball> image(size);
+    for (size_t i = 0; i < size; ++i) { // => r = 2 |y| + max |y| / 2^floor_bits
+        mpfr_class radius = correction[i].get_magnitude();
+        mpfr_mul_2ui(radius.get_raw(), radius.get_raw(), 1, MPFR_RNDU);
+        mpfr_add(radius.get_raw(), radius.get_raw(), floor.get_raw(), MPFR_RNDU);
+        domain[i] = mpfr_ball(x[i].class_value(), radius);
+        offsets[i] = mpfr_ball(mpfr_class(0), radius);
+        image[i] = -correction[i];
+    }
+    // C J(X) lies in C mid(J(X)) + |C| rad(J(X)), which avoids the blowup of
+    // solving with wide right-hand sides.
+    mpfr_basic_vector<mpfr_ball> spread(size, 0);
+    for (size_t j = 0; j < size; ++j) {
+        mpfr_basic_vector<mpfr_ball> column = this->function_f_value_derivation_ball(domain, j);
+        for (size_t i = 0; i < size; ++i) {
+            spread[i].addmul(mpfr_ball(mpfr_class(0), column[i].get_rad()), offsets[j]);
+            column[i] = mpfr_ball(column[i].get_mid());
+        }
+        column = lu.solve_ball(column);
+        for (size_t i = 0; i < size; ++i) {
+            mpfr_ball entry = -column[i];
+            if (i == j) {
+                entry += 1;
+            }
+            image[i].addmul(entry, offsets[j]);
+        }
+    }
+    for (size_t j = 0; j < size; ++j) {
+        mpfr_basic_vector<mpfr_ball> unit(size, 0);
+        unit[j] = 1;
+        unit = lu.solve_ball(unit);
+        for (size_t i = 0; i < size; ++i) {
+            image[i].addmul(mpfr_ball(mpfr_class(0), unit[i].get_magnitude()), spread[j]);
+        }
+    }
+    for (size_t i = 0; i < size; ++i) {
+        if (!(image[i].get_magnitude() < domain[i].get_rad())) {
+            T result;
+            result.set_nan();
+            return result;
+        }
+    }
+    return this->certified_norm(offsets);
+}
+
+template <class T>
+void ggqr_basic<T>::do_calculation_level_delta() {
     size_t n_steps;
     size_t n_dampings;
-    mpfr_vector previous_x, x;
+    mpfr_prec_t min_precision;
+    T error;
+    mpfr_basic_vector<T> previous_x, x;
     this->m_delta = (this->m_right_limit - this->m_left_limit) / 1000;
     this->output_head();
     for (size_t i = 0;; ++i) {
-        x = this->do_calculation_level_main(n_steps, n_dampings);
-        if (i > 0) {
-            mpfr_vector dx = x - previous_x;
-            mpfr_class error = dx.euclidean_norm();
-            this->output_step(i + 1, this->m_delta, error, n_steps, n_dampings);
+        x = this->do_calculation_level_main(n_steps, n_dampings, min_precision, error);
+        if (this->m_use_certification) {
+            this->output_step(i + 1, this->m_delta, error, n_steps, n_dampings, min_precision);
+            if (error < this->m_error_tolerance) {
+                this->m_out_error = error;
+                break;
+            }
+        } else if (i > 0) {
+            mpfr_basic_vector<T> dx = x - previous_x;
+            T error = dx.euclidean_norm();
+            this->output_step(i + 1, this->m_delta, error, n_steps, n_dampings, min_precision);
             if (error < this->m_error_tolerance) {
                 break;
             }
         } else {
-            this->output_step(i + 1, this->m_delta, mpfr_class(), n_steps, n_dampings);
+            this->output_step(i + 1, this->m_delta, T(), n_steps, n_dampings, min_precision);
         }
-        previous_x = x;
-        this->m_delta /= 1e+6;
-    }
-    this->m_out_nodes = mpfr_vector(this->m_n_nodes);
-    this->m_out_weights = mpfr_vector(this->m_n_nodes);
-    for (mpfr_vector::size_t i = 0; i < this->m_n_nodes; ++i) {
-        this->m_out_nodes[i] = x[i];
-        this->m_out_weights[i] = x[this->m_n_nodes + i];
+        previous_x = std::move(x);
+        this->m_delta /= 1000000;
     }
+    this->m_out_nodes_weights = std::move(x);
 }
 
-mpfr_vector ggqr::do_calculation_level_main(size_t& out_n_steps, size_t& out_n_dampings) {
-    mpfr_vector start_x = this->starting_values(1);
-    mpfr_vector x;
+template <class T>
+mpfr_basic_vector<T> ggqr_basic<T>::do_calculation_level_main(size_t& out_n_steps, size_t& out_n_dampings, mpfr_prec_t& out_min_precision, T& out_error) {
+    mpfr_basic_vector<T> start_x = this->starting_values(1);
+    mpfr_basic_vector<T> x;
     size_t n_newton_steps = 0;
     size_t n_newton_dampings = 0;
+    mpfr_prec_t newton_min_precision = this->m_precision;
     out_n_steps = 0;
     out_n_dampings = 0;
+    out_min_precision = this->m_precision;
     for (size_t i = 0; i < this->m_n_nodes; ++i) {
-        x = this->do_calculation_level_newton(start_x, n_newton_steps, n_newton_dampings);
+        x = this->do_calculation_level_newton(start_x, n_newton_steps, n_newton_dampings, newton_min_precision, i == this->m_n_nodes - 1, out_error);
         out_n_steps += n_newton_steps;
         out_n_dampings += n_newton_dampings;
+        if (newton_min_precision < out_min_precision) {
+            out_min_precision = newton_min_precision;
+        }
         if (i == this->m_n_nodes - 1) {
             break;
         }
-        mpfr_vector nodes(i + 1);
-        for (mpfr_vector::size_t i = 0; i < nodes.size(); ++i) {
-            nodes[i] = x[i];
-        }
-        start_x = this->starting_points(nodes);
-        mpfr_vector weights = this->starting_weights(start_x);
-        start_x.append(weights);
+        start_x = this->starting_points(x.slice(0, i + 1));
+        mpfr_basic_vector<T> weights = this->starting_weights(start_x);
+        start_x.append(std::move(weights));
     }
     return x;
 }
 
-mpfr_vector ggqr::do_calculation_level_newton(const mpfr_vector& start_x, size_t& out_n_steps, size_t& out_n_dampings) {
-    mpfr_vector x = start_x;
-    mpfr_class damping = 1;
+// With the precision ladder enabled the iteration starts at a low working
+// precision, which is raised as soon as the next quadratically convergent step
+// could not be resolved any more. The next rung at least doubles the precision
+// and resolves the step after it with ladder_guard_bits to spare, so every rung
+// serves about one step. The step expected to reach the error tolerance, or
+// one after the correction stopped shrinking, jumps to the full precision, and
+// convergence is only accepted on a step at the full precision.
+//
+// With certification the residual is first solved with the factors of the
+// previous step before a new Jacobian is set up. The iteration ends once that
+// correction is below the tolerance, and if requested, once the Krawczyk test
+// proves a zero within the tolerance as well. The requested bound of the final iterate is taken
+// against the moments over the whole interval [a, b], which also accounts for
+// the cut-off delta.
+template <class T>
+mpfr_basic_vector<T> ggqr_basic<T>::do_calculation_level_newton(const mpfr_basic_vector<T>& start_x, size_t& out_n_steps, size_t& out_n_dampings, mpfr_prec_t& out_min_precision, const bool certify, T& out_error) {
+    mpfr_prec_t start_precision = this->m_precision;
+    if (this->m_use_precision_ladder && this->m_ladder_start_precision < this->m_precision) {
+        start_precision = this->m_ladder_start_precision;
+    }
+    mpfr_prec_t precision = start_precision;
+    mpfr_basic_vector<T> x = start_x;
+    x.round_prec(precision);
+    T damping = 1;
+    T previous_error;
     bool use_damping = false;
+    ggqr_basic_lu<T> previous_lu((mpfr_basic_matrix<T>()));
+    bool has_previous_lu = false;
     out_n_steps = 0;
     out_n_dampings = 0;
+    out_min_precision = precision;
     for (size_t i = 0, j = 1;; ++i, ++j) {
-        mpfr_vector func_f = this->function_f_value(x);
-        mpfr_matrix jac_f = this->function_f_value_derivation(x);
-        ggqr_lu lu_decomposition(jac_f);
+        mpfr_context context(precision, this->m_rnd);
+        mpfr_basic_vector<T> func_f = this->function_f_value(x);
+        if (has_previous_lu) {
+            mpfr_basic_vector<T> simplified_dx = previous_lu.solve(func_f);
+            if (simplified_dx.euclidean_norm() < this->m_error_tolerance &&
+                (!certify || this->certified_error(x, true) < this->m_error_tolerance)) {
+                x -= simplified_dx;
+                out_n_steps = j - 1;
+                break;
+            }
+        }
+        mpfr_basic_matrix<T> jac_f = this->function_f_value_derivation(x);
+        ggqr_basic_lu<T> lu_decomposition(std::move(jac_f));
         lu_decomposition.decompose();
-        mpfr_vector dx = lu_decomposition.solve(func_f);
+        mpfr_basic_vector<T> dx = lu_decomposition.solve(func_f);
         if (dx.contains_nan()) {
             damping *= 2;
             x = start_x;
+            precision = start_precision;
+            x.round_prec(precision);
+            previous_error.set_nan();
+            has_previous_lu = false;
             ++i, j = 0;
             if (!use_damping) {
                 use_damping = true;
@@ -361,18 +832,48 @@ mpfr_vector ggqr::do_calculation_level_newton(const mpfr_vector& start_x, size_t
             dx /= damping;
         }
         x -= dx;
+        if (precision < this->m_precision) {
+            T error = dx.euclidean_norm();
+            mpfr_prec_t next_precision = precision;
+            if (error.is_zero() || (!previous_error.is_nan() && !(error < previous_error)) ||
+                2 * error.get_exp() <= this->m_error_tolerance.get_exp()) {
+                next_precision = this->m_precision;
+            } else if (-2 * error.get_exp() >= precision - ladder_guard_bits) {
+                next_precision = std::max(2 * precision, (mpfr_prec_t)(ladder_guard_bits - 4 * error.get_exp()));
+                next_precision = std::min(next_precision, this->m_precision);
+            }
+            if (next_precision != precision) {
+                precision = next_precision;
+                x.round_prec(precision);
+            }
+            if (precision == this->m_precision) {
+                previous_error.set_nan();
+            } else {
+                T::set(previous_error, error);
+            }
+            continue;
+        }
+        if (this->m_use_certification) {
+            previous_lu = std::move(lu_decomposition);
+            has_previous_lu = true;
+            continue;
+        }
         if (j > 1) {
-            mpfr_class error = dx.euclidean_norm();
+            T error = dx.euclidean_norm();
             if (error < this->m_error_tolerance) {
                 out_n_steps = j - 1;
                 break;
             }
         }
     }
+    if (this->m_use_certification && certify) {
+        out_error = this->certified_error(x, false);
+    }
     return x;
 }
 
-void ggqr::output_head() const {
+template <class T>
+void ggqr_basic<T>::output_head() const {
     std::cout << "Calculate a quadrature rule with "
               << this->m_n_nodes
               << " points in ["
@@ -381,13 +882,21 @@ void ggqr::output_head() const {
               << this->m_right_limit.get_str_with_format("%.2Rf")
               << "]:"
               << std::endl;
-    std::cout << "                   Delta             Error    No.Steps    No.Dampings"
-              << std::endl;
-    std::cout << "    -----------------------------------------------------------------"
-              << std::endl;
+    if (this->m_use_precision_ladder) {
+        std::cout << "                   Delta             Error    No.Steps    No.Dampings      Precision"
+                  << std::endl;
+        std::cout << "    ---------------------------------------------------------------------------------"
+                  << std::endl;
+    } else {
+        std::cout << "                   Delta             Error    No.Steps    No.Dampings"
+                  << std::endl;
+        std::cout << "    -----------------------------------------------------------------"
+                  << std::endl;
+    }
 }
 
-void ggqr::output_step(const size_t step, const mpfr_class& delta, const mpfr_class& error, const size_t n_steps, const size_t n_dampings) const {
+template <class T>
+void ggqr_basic<T>::output_step(const size_t step, const T& delta, const T& error, const size_t n_steps, const size_t n_dampings, const mpfr_prec_t min_precision) const {
     if (error.is_nan()) {
         std::cout << "    "
                   << std::setw(4) << step
@@ -396,8 +905,7 @@ void ggqr::output_step(const size_t step, const mpfr_class& delta, const mpfr_cl
                   << "                --       "
                   << std::setw(5) << n_steps
                   << "          "
-                  << std::setw(5) << n_dampings
-                  << std::endl;
+                  << std::setw(5) << n_dampings;
     } else {
         std::cout << "    "
                   << std::setw(4) << step
@@ -408,33 +916,50 @@ void ggqr::output_step(const size_t step, const mpfr_class& delta, const mpfr_cl
                   << "       "
                   << std::setw(5) << n_steps
                   << "          "
-                  << std::setw(5) << n_dampings
-                  << std::endl;
+                  << std::setw(5) << n_dampings;
     }
+    if (this->m_use_precision_ladder) {
+        std::cout << "     "
+                  << std::setw(5) << min_precision
+                  << " .. "
+                  << std::setw(5) << this->m_precision;
+    }
+    std::cout << std::endl;
 }
 
-void ggqr::output_nodes_weights() const {
+template <class T>
+void ggqr_basic<T>::output_nodes_weights() const {
+    mpfr_basic_vector_const_view<T> nodes = this->m_out_nodes_weights.slice(0, this->m_n_nodes);
+    mpfr_basic_vector_const_view<T> weights = this->m_out_nodes_weights.slice(this->m_n_nodes, this->m_n_nodes);
     std::cout << "Nodes and weights:" << std::endl;
-    for (mpfr_vector::size_t i = 0; i < this->m_n_nodes; ++i) {
+    for (size_t i = 0; i < this->m_n_nodes; ++i) {
         std::cout << "    x["
                   << std::setw(2) << i + 1
                   << "] = "
-                  << this->m_out_nodes[i].get_str_with_format("%+.20Rf")
+                  << nodes[i].get_str_with_format("%+.20Rf")
                   << "    w["
                   << std::setw(2) << i + 1
                   << "] = "
-                  << this->m_out_weights[i].get_str_with_format("%+.20Rf")
+                  << weights[i].get_str_with_format("%+.20Rf")
+                  << std::endl;
+    }
+    if (this->m_use_certification) {
+        std::cout << "    Certified error: "
+                  << this->m_out_error.get_str_with_format("%.6RE")
                   << std::endl;
     }
 }
 
-void ggqr::output_evaluation() const {
+template <class T>
+void ggqr_basic<T>::output_evaluation() const {
     if (this->m_eval_func == NULL) {
         return;
     }
-    mpfr_class eval = 0;
-    for (mpfr_vector::size_t i = 0; i < this->m_n_nodes; ++i) {
-        eval += this->m_out_weights[i] * (*this->m_eval_func)(this->m_out_nodes[i]);
+    mpfr_basic_vector_const_view<T> nodes = this->m_out_nodes_weights.slice(0, this->m_n_nodes);
+    mpfr_basic_vector_const_view<T> weights = this->m_out_nodes_weights.slice(this->m_n_nodes, this->m_n_nodes);
+    T eval = 0;
+    for (size_t i = 0; i < this->m_n_nodes; ++i) {
+        eval += weights[i] * (*this->m_eval_func)(nodes[i]);
     }
     std::cout << "Evaluation of the integrand:"
               << std::endl
@@ -442,3 +967,16 @@ void ggqr::output_evaluation() const {
               << eval.get_str_with_format("%+.20Rf")
               << std::endl;
 }
+
+template class ggqr_basic<mpfr_class>;
+template class ggqr_basic<mpfr_fixed128>;
+template class ggqr_basic<mpfr_fixed256>;
+template class ggqr_basic<mpfr_fixed512>;
+template class ggqr_basic<mpfr_fixed1024>;
+template class ggqr_basic<dd_class>;
+template class ggqr_basic<qd_class>;
+template class ggqr_basic<double_class>;
+template class ggqr_basic<ldouble_class>;
+#ifdef HAVE_FLOAT128
+template class ggqr_basic<float128_class>;
+#endif
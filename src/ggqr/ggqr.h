@@ -28,11 +28,23 @@
 #ifndef __GGQR_H__
 #define __GGQR_H__
 
+#include "../utils/dd_class.h"
+#include "../utils/mpfr_accumulator.h"
+#include "../utils/mpfr_ball.h"
 #include "../utils/mpfr_class.h"
+#include "../utils/mpfr_fixed.h"
+#include "../utils/qd_class.h"
+#include "../utils/native_class.h"
+#include "../utils/mpfr_scalar_traits.h"
 #include "../utils/mpfr_vector.h"
+#include "../utils/mpfr_vector_view.h"
 #include "../utils/mpfr_matrix.h"
 
-class ggqr {
+template <class T>
+class ggqr_basic_lu;
+
+template <class T>
+class ggqr_basic {
 
 public:
 
@@ -46,67 +58,108 @@ public:
 
 private:
 
+    mpfr_prec_t m_precision;
+    mpfr_rnd_t m_rnd;
+
     singularity_type m_singularity;
-    mpfr_class m_exponent;
+    T m_exponent;
 
-    mpfr_class m_error_tolerance;
+    T m_error_tolerance;
     size_t m_max_damping;
 
     size_t m_n_nodes;
-    mpfr_class (*m_eval_func)(const mpfr_class&);
+    T (*m_eval_func)(const T&);
+
+    T m_left_limit;
+    T m_right_limit;
+
+    mpfr_basic_vector<T> m_out_nodes_weights;
+    T m_out_error;
+    T m_delta;
+
+    static const mpfr_prec_t ladder_guard_bits = 32;
+    static const long int krawczyk_floor_bits = 16;
+
+    bool m_use_precision_ladder;
+    mpfr_prec_t m_ladder_start_precision;
 
-    mpfr_class m_left_limit;
-    mpfr_class m_right_limit;
+    bool m_use_certification;
 
-    mpfr_vector m_out_nodes;
-    mpfr_vector m_out_weights;
-    mpfr_class m_delta;
+    T m_scratch;
+    mpfr_basic_vector<T> m_scratch_singularity_values;
 
 public:
 
-    ggqr();
-    ~ggqr();
+    ggqr_basic();
+    ~ggqr_basic();
 
     void set_precision(const mpfr_prec_t precision);
+    void set_rounding_mode(const mpfr_rnd_t rnd);
     void set_singularity(const singularity_type singularity);
-    void set_singularity_exponent(const mpfr_class& exponent);
-    void set_error_tolerance(const mpfr_class& error_tolerance);
+    void set_singularity_exponent(const T& exponent);
+    void set_error_tolerance(const T& error_tolerance);
     void set_max_damping(const size_t max_damping);
     void set_n_nodes(const size_t n_nodes);
-    void set_evaluation_function(mpfr_class (*eval_func)(const mpfr_class&));
-    void set_left_limit(const mpfr_class& left_limit);
-    void set_right_limit(const mpfr_class& right_limit);
-
-    mpfr_class singularity_value(const mpfr_class& value);
-    mpfr_class singularity_value_inverse(const mpfr_class& value);
-    mpfr_class singularity_value_derivation(const mpfr_class& value);
-
-    mpfr_class basis_value(const mpfr_class& value, const size_t k);
-    mpfr_class basis_value_derivation(const mpfr_class& value, const size_t k);
-    mpfr_class basis_value_antiderivation(const mpfr_class& value, const size_t k);
-    mpfr_class basis_value_integration(const size_t k);
-
-    mpfr_vector function_f_value(const mpfr_vector& nodes_weights);
-    mpfr_matrix function_f_value_derivation(const mpfr_vector& nodes_weights);
-
-    mpfr_class starting_point();
-    mpfr_vector starting_points(const mpfr_vector& previous_nodes);
-    mpfr_vector starting_weights(const mpfr_vector& nodes);
-    mpfr_vector starting_values(const size_t n_nodes);
+    void set_evaluation_function(T (*eval_func)(const T&));
+    void set_left_limit(const T& left_limit);
+    void set_right_limit(const T& right_limit);
+    void set_precision_ladder(const bool use_ladder, const mpfr_prec_t start_precision = 64);
+    void set_certification(const bool use_certification);
+
+    T singularity_value(const T& value);
+    T singularity_value_inverse(const T& value);
+    T singularity_value_derivation(const T& value);
+    void singularity_value_into(T& result, const T& value);
+    void singularity_value_derivation_into(T& result, const T& value);
+    void singularity_values_into(mpfr_basic_vector<T>& result, const mpfr_basic_vector_const_view<T>& values);
+
+    T basis_value(const T& value, const size_t k);
+    T basis_value_derivation(const T& value, const size_t k);
+    void basis_value_into(T& result, const T& value, const size_t k, T& tmp);
+    void basis_value_derivation_into(T& result, const T& value, const size_t k, T& tmp);
+    void basis_value_from_singularity_into(T& result, const T& value, const T& singularity, const size_t k);
+    void basis_value_derivation_from_singularity_into(T& result, const T& value, const T& singularity, const size_t k, T& tmp);
+    T basis_value_antiderivation(const T& value, const size_t k);
+    T basis_value_integration(const size_t k);
+
+    mpfr_basic_vector<T> function_f_value(const mpfr_basic_vector_const_view<T>& nodes_weights);
+    mpfr_basic_matrix<T> function_f_value_derivation(const mpfr_basic_vector_const_view<T>& nodes_weights);
+    void function_f_value_derivation(const mpfr_basic_vector_const_view<T>& nodes_weights, mpfr_basic_matrix<T>& result);
+
+    mpfr_ball singularity_value_ball(const mpfr_ball& value);
+    mpfr_ball singularity_value_derivation_ball(const mpfr_ball& value);
+    mpfr_ball basis_value_ball(const mpfr_ball& value, const size_t k);
+    mpfr_ball basis_value_derivation_ball(const mpfr_ball& value, const size_t k);
+    mpfr_ball basis_value_antiderivation_ball(const mpfr_ball& value, const size_t k);
+    mpfr_ball basis_value_integration_ball(const mpfr_ball& left_limit, const size_t k);
+
+    mpfr_basic_vector<mpfr_ball> function_f_value_ball(const mpfr_basic_vector_const_view<T>& nodes_weights, const mpfr_ball& left_limit);
+    mpfr_basic_vector<mpfr_ball> function_f_value_derivation_ball(const mpfr_basic_vector<mpfr_ball>& nodes_weights, const size_t column);
+
+    T starting_point();
+    mpfr_basic_vector<T> starting_points(const mpfr_basic_vector_const_view<T>& previous_nodes);
+    mpfr_basic_vector<T> starting_weights(const mpfr_basic_vector<T>& nodes);
+    mpfr_basic_vector<T> starting_values(const size_t n_nodes);
 
     void execute();
 
 private:
 
+    void round_to_precision(T& value) const;
+    T certified_norm(const mpfr_basic_vector<mpfr_ball>& values) const;
+    T certified_error(const mpfr_basic_vector<T>& x, const bool with_delta);
+
     void do_calculation_level_delta();
-    mpfr_vector do_calculation_level_main(size_t& out_n_steps, size_t& out_n_dampings);
-    mpfr_vector do_calculation_level_newton(const mpfr_vector& start_x, size_t& out_n_steps, size_t& out_n_dampings);
+    mpfr_basic_vector<T> do_calculation_level_main(size_t& out_n_steps, size_t& out_n_dampings, mpfr_prec_t& out_min_precision, T& out_error);
+    mpfr_basic_vector<T> do_calculation_level_newton(const mpfr_basic_vector<T>& start_x, size_t& out_n_steps, size_t& out_n_dampings, mpfr_prec_t& out_min_precision, const bool certify, T& out_error);
 
     void output_head() const;
-    void output_step(const size_t step, const mpfr_class& delta, const mpfr_class& error, const size_t n_steps, const size_t n_dampings) const;
+    void output_step(const size_t step, const T& delta, const T& error, const size_t n_steps, const size_t n_dampings, const mpfr_prec_t min_precision) const;
     void output_nodes_weights() const;
     void output_evaluation() const;
 
-}; // class ggqr
+}; // class ggqr_basic
+
+typedef ggqr_basic<mpfr_class> ggqr;
 
 #endif // __GGQR_H__
@@ -29,7 +29,8 @@
 
 #include <iostream>
 
-ggqr_lagrange::ggqr_lagrange(const mpfr_vector& points) {
+template <class T>
+ggqr_basic_lagrange<T>::ggqr_basic_lagrange(const mpfr_basic_vector<T>& points) {
     if (points.size() < 2) {
         printf("ggqr_lagrange[%s:%d]: The set must contain at least two points.\n", __FILE__, __LINE__);
         abort();
@@ -37,19 +38,21 @@ ggqr_lagrange::ggqr_lagrange(const mpfr_vector& points) {
     this->m_calculated = false;
     this->m_points = points;
     this->m_size = this->m_points.size();
-    this->m_general_polynomial = mpfr_polynomial();
-    this->m_denominators = mpfr_vector(this->m_size, 1);
+    this->m_general_polynomial = mpfr_basic_polynomial<T>();
+    this->m_denominators = mpfr_basic_vector<T>(this->m_size, 1);
 }
 
-ggqr_lagrange::~ggqr_lagrange() {
+template <class T>
+ggqr_basic_lagrange<T>::~ggqr_basic_lagrange() {
 }
 
-void ggqr_lagrange::calculate() {
+template <class T>
+void ggqr_basic_lagrange<T>::calculate() {
     if (this->m_calculated) {
         return;
     }
-    for (mpfr_vector::size_t i = 0; i < this->m_size; ++i) {
-        mpfr_polynomial linear_polynomial = mpfr_polynomial(1, 1);
+    for (size_t i = 0; i < this->m_size; ++i) {
+        mpfr_basic_polynomial<T> linear_polynomial = mpfr_basic_polynomial<T>(1, 1);
         linear_polynomial[0] = -this->m_points[i];
         if (i == 0) {
             this->m_general_polynomial = linear_polynomial;
@@ -57,8 +60,8 @@ void ggqr_lagrange::calculate() {
             this->m_general_polynomial *= linear_polynomial;
         }
     }
-    for (mpfr_vector::size_t i = 0; i < this->m_size; ++i) {
-        for (mpfr_vector::size_t j = 0; j < this->m_size; ++j) {
+    for (size_t i = 0; i < this->m_size; ++i) {
+        for (size_t j = 0; j < this->m_size; ++j) {
             if (i != j) {
                 this->m_denominators[i] *= this->m_points[i] - this->m_points[j];
             }
@@ -67,13 +70,14 @@ void ggqr_lagrange::calculate() {
     this->m_calculated = true;
 }
 
-mpfr_polynomial ggqr_lagrange::get_basis_polynomial(mpfr_vector::size_t index) const {
+template <class T>
+mpfr_basic_polynomial<T> ggqr_basic_lagrange<T>::get_basis_polynomial(size_t index) const {
     if (!this->m_calculated) {
         printf("ggqr_lagrange[%s:%d]: Polynomials were not calculated.\n", __FILE__, __LINE__);
         abort();
     }
-    mpfr_class point = this->m_points[index];
-    mpfr_polynomial basis = this->m_general_polynomial.synthetic_division_without_remainder(point, false);
+    T point = this->m_points[index];
+    mpfr_basic_polynomial<T> basis = this->m_general_polynomial.synthetic_division_without_remainder(point, false);
     if (basis.get_degree() + 1 != this->m_size) {
         printf("ggqr_lagrange[%s:%d]: Basis polynomial calculation went wrong.\n", __FILE__, __LINE__);
         abort();
@@ -81,3 +85,16 @@ mpfr_polynomial ggqr_lagrange::get_basis_polynomial(mpfr_vector::size_t index) c
     basis /= this->m_denominators[index];
     return basis;
 }
+
+template class ggqr_basic_lagrange<mpfr_class>;
+template class ggqr_basic_lagrange<mpfr_fixed128>;
+template class ggqr_basic_lagrange<mpfr_fixed256>;
+template class ggqr_basic_lagrange<mpfr_fixed512>;
+template class ggqr_basic_lagrange<mpfr_fixed1024>;
+template class ggqr_basic_lagrange<dd_class>;
+template class ggqr_basic_lagrange<qd_class>;
+template class ggqr_basic_lagrange<double_class>;
+template class ggqr_basic_lagrange<ldouble_class>;
+#ifdef HAVE_FLOAT128
+template class ggqr_basic_lagrange<float128_class>;
+#endif
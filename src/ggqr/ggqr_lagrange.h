@@ -32,27 +32,30 @@
 #include "../utils/mpfr_vector.h"
 #include "../utils/mpfr_polynomial.h"
 
-class ggqr_lagrange {
+template <class T>
+class ggqr_basic_lagrange {
 
 private:
 
     bool m_calculated;
 
-    mpfr_vector m_points;
-    mpfr_vector::size_t m_size;
+    mpfr_basic_vector<T> m_points;
+    size_t m_size;
 
-    mpfr_polynomial m_general_polynomial;
-    mpfr_vector m_denominators;
+    mpfr_basic_polynomial<T> m_general_polynomial;
+    mpfr_basic_vector<T> m_denominators;
 
 public:
 
-    ggqr_lagrange(const mpfr_vector& points);
-    ~ggqr_lagrange();
+    ggqr_basic_lagrange(const mpfr_basic_vector<T>& points);
+    ~ggqr_basic_lagrange();
 
     void calculate();
 
-    mpfr_polynomial get_basis_polynomial(mpfr_vector::size_t index) const;
+    mpfr_basic_polynomial<T> get_basis_polynomial(size_t index) const;
 
-}; // class ggqr_lagrange
+}; // class ggqr_basic_lagrange
+
+typedef ggqr_basic_lagrange<mpfr_class> ggqr_lagrange;
 
 #endif // __GGQR_LAGRANGE_H__
@@ -28,70 +28,82 @@
 #include "ggqr_lu.h"
 
 #include <iostream>
+#include <utility>
 
-ggqr_lu::ggqr_lu(const mpfr_matrix& original_matrix) {
-    if (original_matrix.n_rows() != original_matrix.n_cols()) {
-        printf("ggqr_lu[%s:%d]: Matrix has to be a square matrix.\n", __FILE__, __LINE__);
-        abort();
-    }
-    this->m_decomposed = false;
-    this->m_original = original_matrix;
-    this->m_size = this->m_original.n_rows();
-    this->m_lower = mpfr_matrix(this->m_size, this->m_size);
-    this->m_upper = mpfr_matrix(this->m_size, this->m_size);
-    this->m_pivot = mpfr_matrix(this->m_size, this->m_size);
+template <class T>
+ggqr_basic_lu<T>::ggqr_basic_lu(const mpfr_basic_matrix<T>& original_matrix) :
+    m_original(original_matrix) {
+    this->initialize();
 }
 
-ggqr_lu::~ggqr_lu() {
+template <class T>
+ggqr_basic_lu<T>::ggqr_basic_lu(mpfr_basic_matrix<T>&& original_matrix) :
+    m_original(std::move(original_matrix)) {
+    this->initialize();
 }
 
-void ggqr_lu::decompose() {
+template <class T>
+ggqr_basic_lu<T>::~ggqr_basic_lu() {
+}
+
+template <class T>
+void ggqr_basic_lu<T>::decompose() {
     if (this->m_decomposed) {
         return;
     }
     this->pivot();
-    this->m_lower = mpfr_matrix::eye_matrix(this->m_size);
-    this->m_upper = mpfr_matrix::zero_matrix(this->m_size, this->m_size);
-    mpfr_matrix pivot_original = this->m_pivot * this->m_original;
-    mpfr_class tmp_sum;
-    for (mpfr_matrix::size_t i = 0; i < this->m_size; ++i) {
-        for (mpfr_matrix::size_t j = 0; j < this->m_size; ++j) {
+    this->m_lower = mpfr_basic_matrix<T>::eye_matrix(this->m_size);
+    // The inner products run down the columns of the upper factor.
+    this->m_upper = mpfr_basic_matrix<T>(this->m_size, this->m_size, 0, mpfr_matrix_column_major);
+    mpfr_basic_matrix<T> pivot_original = this->m_pivot * this->m_original;
+    T tmp_sum;
+    for (size_t i = 0; i < this->m_size; ++i) {
+        for (size_t j = 0; j < this->m_size; ++j) {
             if (j <= i) {
-                tmp_sum = 0;
-                for (mpfr_matrix::size_t k = 0; k < j; ++k) {
-                    tmp_sum += this->m_lower[j][k] * this->m_upper[k][i];
-                }
-                this->m_upper[j][i] = pivot_original[j][i] - tmp_sum;
+                this->m_sum.set(pivot_original(j, i));
+                this->m_sum.submul_n(this->m_lower.row(j).slice(0, j), this->m_upper.col(i).slice(0, j));
+                this->m_sum.get(this->m_upper(j, i));
             }
             if (j >= i) {
-                tmp_sum = 0;
-                for (mpfr_matrix::size_t k = 0; k < i; ++k) {
-                    tmp_sum += this->m_lower[j][k] * this->m_upper[k][i];
-                }
-                this->m_lower[j][i] = (pivot_original[j][i] - tmp_sum) / this->m_upper[i][i];
+                this->m_sum.set(pivot_original(j, i));
+                this->m_sum.submul_n(this->m_lower.row(j).slice(0, i), this->m_upper.col(i).slice(0, i));
+                this->m_sum.get(tmp_sum);
+                this->m_lower(j, i) = tmp_sum / this->m_upper(i, i);
             }
         }
     }
     this->m_decomposed = true;
 }
 
-mpfr_matrix ggqr_lu::inverse() const {
+template <class T>
+mpfr_basic_matrix<T> ggqr_basic_lu<T>::inverse() const {
     if (!this->m_decomposed) {
         printf("ggqr_lu[%s:%d]: Original matrix was not decomposed.\n", __FILE__, __LINE__);
         abort();
     }
-    mpfr_matrix inverse(this->m_size, this->m_size);
-    for (mpfr_matrix::size_t i = 0; i < this->m_size; ++i) {
-        mpfr_vector right = mpfr_vector::eye_vector(this->m_size, i);
-        mpfr_vector solution = this->solve(right);
-        for (mpfr_vector::size_t j = 0; j < this->m_size; ++j) {
-            inverse[j][i] = solution[j];
+    mpfr_basic_matrix<T> inverse(this->m_size, this->m_size);
+    for (size_t i = 0; i < this->m_size; ++i) {
+        mpfr_basic_vector<T> right = mpfr_basic_vector<T>::eye_vector(this->m_size, i);
+        mpfr_basic_vector<T> solution = this->solve(right);
+        for (size_t j = 0; j < this->m_size; ++j) {
+            inverse(j, i) = solution[j];
         }
     }
     return inverse;
 }
 
-mpfr_vector ggqr_lu::solve(const mpfr_vector& right) const {
+template <class T>
+mpfr_basic_vector<T> ggqr_basic_lu<T>::solve(const mpfr_basic_vector<T>& right) const {
+    mpfr_basic_vector<T> solution(this->m_size);
+    this->solve(right, solution);
+    return solution;
+}
+
+// Forward and back substitution in place, in the precision of the entries of
+// the solution, which is only reallocated if its size does not match. Every
+// inner product is accumulated exactly and rounded once.
+template <class T>
+void ggqr_basic_lu<T>::solve(const mpfr_basic_vector<T>& right, mpfr_basic_vector<T>& solution) const {
     if (!this->m_decomposed) {
         printf("ggqr_lu[%s:%d]: Original matrix was not decomposed.\n", __FILE__, __LINE__);
         abort();
@@ -100,45 +112,113 @@ mpfr_vector ggqr_lu::solve(const mpfr_vector& right) const {
         printf("ggqr_lu[%s:%d]: Cannot operate on objects of different sizes.\n", __FILE__, __LINE__);
         abort();
     }
-    mpfr_vector tmp_right = this->m_pivot * right;
-    mpfr_vector buffer(this->m_size);
-    mpfr_vector solution(this->m_size);
-    for (mpfr_vector::size_t i = 0; i < this->m_size; ++i) {
-        mpfr_class sum = 0;
-        for (mpfr_vector::size_t j = 0; j < i; ++j) {
-            sum += this->m_lower[i][j] * buffer[j];
+    if (&right == &solution) {
+        printf("ggqr_lu[%s:%d]: The solution must not alias the right-hand side.\n", __FILE__, __LINE__);
+        abort();
+    }
+    if (solution.size() != this->m_size) {
+        solution = mpfr_basic_vector<T>(this->m_size);
+    }
+    for (size_t i = 0; i < this->m_size; ++i) {
+        this->m_sum.set(right[this->m_permutation[i]]);
+        this->m_sum.submul_n(this->m_lower.row(i).slice(0, i), solution.slice(0, i));
+        this->m_sum.get(solution[i]);
+        T::div(solution[i], solution[i], this->m_lower(i, i));
+    }
+    for (size_t i = this->m_size; i > 0; --i) {
+        this->m_sum.set(solution[i - 1]);
+        this->m_sum.submul_n(this->m_upper.row(i - 1).slice(i, this->m_size - i), solution.slice(i, this->m_size - i));
+        this->m_sum.get(solution[i - 1]);
+        T::div(solution[i - 1], solution[i - 1], this->m_upper(i - 1, i - 1));
+    }
+}
+
+// Forward and back substitution in ball arithmetic. The result encloses the
+// exact solution of the system given by the computed factors.
+template <class T>
+mpfr_basic_vector<mpfr_ball> ggqr_basic_lu<T>::solve_ball(const mpfr_basic_vector<mpfr_ball>& right) const {
+    if (!this->m_decomposed) {
+        printf("ggqr_lu[%s:%d]: Original matrix was not decomposed.\n", __FILE__, __LINE__);
+        abort();
+    }
+    if (right.size() != this->m_size) {
+        printf("ggqr_lu[%s:%d]: Cannot operate on objects of different sizes.\n", __FILE__, __LINE__);
+        abort();
+    }
+    mpfr_basic_vector<mpfr_ball> tmp_right(this->m_size);
+    for (size_t i = 0; i < this->m_size; ++i) {
+        tmp_right[i] = right[this->m_permutation[i]];
+    }
+    mpfr_basic_vector<mpfr_ball> buffer(this->m_size);
+    mpfr_basic_vector<mpfr_ball> solution(this->m_size);
+    for (size_t i = 0; i < this->m_size; ++i) {
+        mpfr_ball sum = tmp_right[i];
+        for (size_t j = 0; j < i; ++j) {
+            sum.submul(mpfr_ball(this->m_lower(i, j).class_value()), buffer[j]);
         }
-        buffer[i] = (tmp_right[i] - sum) / this->m_lower[i][i];
+        buffer[i] = sum / mpfr_ball(this->m_lower(i, i).class_value());
     }
-    for (mpfr_vector::size_t i = this->m_size; i > 0; --i) {
-        mpfr_class sum = 0;
-        for (mpfr_vector::size_t j = this->m_size; j > i; --j) {
-            sum += this->m_upper[i - 1][j - 1] * solution[j - 1];
+    for (size_t i = this->m_size; i > 0; --i) {
+        mpfr_ball sum = buffer[i - 1];
+        for (size_t j = this->m_size; j > i; --j) {
+            sum.submul(mpfr_ball(this->m_upper(i - 1, j - 1).class_value()), solution[j - 1]);
         }
-        solution[i - 1] = (buffer[i - 1] - sum) / this->m_upper[i - 1][i - 1];
+        solution[i - 1] = sum / mpfr_ball(this->m_upper(i - 1, i - 1).class_value());
     }
     return solution;
 }
 
-void ggqr_lu::pivot() {
-    mpfr_matrix original_copy = this->m_original;
-    this->m_pivot = mpfr_matrix::eye_matrix(this->m_size);
-    for (mpfr_matrix::size_t i = 0; i < this->m_size; ++i) {
-        mpfr_matrix::size_t max_j = i;
-        for (mpfr_matrix::size_t j = i; j < this->m_size; ++j) {
-            if (original_copy[j][i].abs_value() > original_copy[max_j][i].abs_value()) {
+template <class T>
+void ggqr_basic_lu<T>::initialize() {
+    if (this->m_original.n_rows() != this->m_original.n_cols()) {
+        printf("ggqr_lu[%s:%d]: Matrix has to be a square matrix.\n", __FILE__, __LINE__);
+        abort();
+    }
+    this->m_decomposed = false;
+    this->m_size = this->m_original.n_rows();
+    this->m_lower = mpfr_basic_matrix<T>(this->m_size, this->m_size);
+    this->m_upper = mpfr_basic_matrix<T>(this->m_size, this->m_size);
+    this->m_pivot = mpfr_basic_matrix<T>(this->m_size, this->m_size);
+}
+
+template <class T>
+void ggqr_basic_lu<T>::pivot() {
+    mpfr_basic_matrix<T> original_copy = this->m_original;
+    this->m_pivot = mpfr_basic_matrix<T>::eye_matrix(this->m_size);
+    this->m_permutation.resize(this->m_size);
+    for (size_t i = 0; i < this->m_size; ++i) {
+        this->m_permutation[i] = i;
+    }
+    for (size_t i = 0; i < this->m_size; ++i) {
+        size_t max_j = i;
+        for (size_t j = i; j < this->m_size; ++j) {
+            if (original_copy(j, i).abs_value() > original_copy(max_j, i).abs_value()) {
                 max_j = j;
             }
         }
         if (max_j != i) {
-            for (mpfr_matrix::size_t k = 0; k < this->m_size; ++k) {
-                mpfr_class tmp = this->m_pivot[i][k];
-                this->m_pivot[i][k] = this->m_pivot[max_j][k];
-                this->m_pivot[max_j][k] = tmp;
-                tmp = original_copy[i][k];
-                original_copy[i][k] = this->m_pivot[max_j][k];
-                original_copy[max_j][k] = tmp;
+            std::swap(this->m_permutation[i], this->m_permutation[max_j]);
+            for (size_t k = 0; k < this->m_size; ++k) {
+                T tmp = std::move(this->m_pivot(i, k));
+                this->m_pivot(i, k) = std::move(this->m_pivot(max_j, k));
+                this->m_pivot(max_j, k) = std::move(tmp);
+                tmp = original_copy(i, k);
+                original_copy(i, k) = this->m_pivot(max_j, k);
+                original_copy(max_j, k) = tmp;
             }
         }
     }
 }
+
+template class ggqr_basic_lu<mpfr_class>;
+template class ggqr_basic_lu<mpfr_fixed128>;
+template class ggqr_basic_lu<mpfr_fixed256>;
+template class ggqr_basic_lu<mpfr_fixed512>;
+template class ggqr_basic_lu<mpfr_fixed1024>;
+template class ggqr_basic_lu<dd_class>;
+template class ggqr_basic_lu<qd_class>;
+template class ggqr_basic_lu<double_class>;
+template class ggqr_basic_lu<ldouble_class>;
+#ifdef HAVE_FLOAT128
+template class ggqr_basic_lu<float128_class>;
+#endif
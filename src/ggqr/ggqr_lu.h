@@ -28,37 +28,56 @@
 #ifndef __GGQR_LU_H__
 #define __GGQR_LU_H__
 
+#include "../utils/mpfr_accumulator.h"
+#include "../utils/mpfr_ball.h"
 #include "../utils/mpfr_class.h"
 #include "../utils/mpfr_vector.h"
 #include "../utils/mpfr_matrix.h"
 
-class ggqr_lu {
+#include <vector>
+
+template <class T>
+class ggqr_basic_lu {
 
 private:
 
     bool m_decomposed;
 
-    mpfr_matrix m_original;
-    mpfr_matrix::size_t m_size;
+    mpfr_basic_matrix<T> m_original;
+    size_t m_size;
+
+    mpfr_basic_matrix<T> m_lower;
+    mpfr_basic_matrix<T> m_upper;
+    mpfr_basic_matrix<T> m_pivot;
+    std::vector<size_t> m_permutation;
 
-    mpfr_matrix m_lower;
-    mpfr_matrix m_upper;
-    mpfr_matrix m_pivot;
+    mutable mpfr_basic_accumulator<T> m_sum;
 
 public:
 
-    ggqr_lu(const mpfr_matrix& original_matrix);
-    ~ggqr_lu();
+    ggqr_basic_lu(const mpfr_basic_matrix<T>& original_matrix);
+    ggqr_basic_lu(mpfr_basic_matrix<T>&& original_matrix);
+    ggqr_basic_lu(const ggqr_basic_lu& other) = default;
+    ggqr_basic_lu(ggqr_basic_lu&& other) = default;
+    ~ggqr_basic_lu();
+
+    ggqr_basic_lu& operator=(const ggqr_basic_lu& other) = default;
+    ggqr_basic_lu& operator=(ggqr_basic_lu&& other) = default;
 
     void decompose();
 
-    mpfr_matrix inverse() const;
-    mpfr_vector solve(const mpfr_vector& right) const;
+    mpfr_basic_matrix<T> inverse() const;
+    mpfr_basic_vector<T> solve(const mpfr_basic_vector<T>& right) const;
+    void solve(const mpfr_basic_vector<T>& right, mpfr_basic_vector<T>& solution) const;
+    mpfr_basic_vector<mpfr_ball> solve_ball(const mpfr_basic_vector<mpfr_ball>& right) const;
 
 private:
 
+    void initialize();
     void pivot();
 
-}; // class ggqr_lu
+}; // class ggqr_basic_lu
+
+typedef ggqr_basic_lu<mpfr_class> ggqr_lu;
 
 #endif // __GGQR_LU_H__
@@ -0,0 +1,980 @@
+//
+//  dd_class.cpp
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#include "dd_class.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <limits>
+#include <vector>
+
+static dd_class dd_constant(int (*constant_func)(mpfr_ptr, mpfr_rnd_t)) {
+    mpfr_class tmp;
+    tmp.set_prec(2 * dd_class::precision);
+    constant_func(tmp.get_raw(), MPFR_RNDN);
+    return dd_class(tmp);
+}
+
+static const int dd_n_inverse_factorials = 40;
+
+// 1/n! for the Taylor series, correctly rounded once from MPFR.
+static std::vector<dd_class> dd_build_inverse_factorials() {
+    std::vector<dd_class> values;
+    mpfr_class tmp;
+    tmp.set_prec(2 * dd_class::precision);
+    mpfr_set_ui(tmp.get_raw(), 1, MPFR_RNDN);
+    for (int n = 0; n < dd_n_inverse_factorials; ++n) {
+        if (n > 1) {
+            mpfr_div_ui(tmp.get_raw(), tmp.get_raw(), n, MPFR_RNDN);
+        }
+        values.push_back(dd_class(tmp));
+    }
+    return values;
+}
+
+static const dd_class* dd_inverse_factorials() {
+    static const std::vector<dd_class> table = dd_build_inverse_factorials();
+    return table.data();
+}
+
+// The exponent k with value = 2^k * m and m in [sqrt(1/2), sqrt(2)).
+static int dd_log_exponent(const double value) {
+    int k;
+    double fraction = std::frexp(value, &k);
+    if (fraction < M_SQRT1_2) {
+        --k;
+    }
+    return k;
+}
+
+dd_class::dd_class() {
+    this->set_nan();
+}
+
+dd_class::dd_class(const int other) {
+    this->m_hi = other;
+    this->m_lo = 0.0;
+}
+
+dd_class::dd_class(const long int other) {
+    double hi = (double)(other >> 32) * 4294967296.0;
+    double lo = (double)(other & 0xFFFFFFFFL);
+    this->m_hi = dd_two_sum(hi, lo, this->m_lo);
+}
+
+dd_class::dd_class(const long long int other) {
+    double hi = (double)(other >> 32) * 4294967296.0;
+    double lo = (double)(other & 0xFFFFFFFFLL);
+    this->m_hi = dd_two_sum(hi, lo, this->m_lo);
+}
+
+dd_class::dd_class(const unsigned int other) {
+    this->m_hi = other;
+    this->m_lo = 0.0;
+}
+
+dd_class::dd_class(const unsigned long int other) {
+    double hi = (double)(other >> 32) * 4294967296.0;
+    double lo = (double)(other & 0xFFFFFFFFUL);
+    this->m_hi = dd_two_sum(hi, lo, this->m_lo);
+}
+
+dd_class::dd_class(const unsigned long long int other) {
+    double hi = (double)(other >> 32) * 4294967296.0;
+    double lo = (double)(other & 0xFFFFFFFFULL);
+    this->m_hi = dd_two_sum(hi, lo, this->m_lo);
+}
+
+dd_class::dd_class(const float other) {
+    this->m_hi = other;
+    this->m_lo = 0.0;
+}
+
+dd_class::dd_class(const double other) {
+    this->m_hi = other;
+    this->m_lo = 0.0;
+}
+
+dd_class::dd_class(const long double other) {
+    this->m_hi = (double)other;
+    this->m_lo = std::isfinite(this->m_hi) ? (double)(other - this->m_hi) : 0.0;
+}
+
+dd_class::dd_class(const char *other) {
+    this->set_str(other, 10);
+}
+
+dd_class::dd_class(const std::string& other) {
+    this->set_str(other, 10);
+}
+
+dd_class::dd_class(const mpfr_class& other) {
+    this->set_raw(other.get_raw());
+}
+
+dd_class& dd_class::operator=(const double other) {
+    this->m_hi = other;
+    this->m_lo = 0.0;
+    return *this;
+}
+
+dd_class operator+(const dd_class& left, const dd_class& right) {
+    double s2, t2;
+    double s1 = dd_two_sum(left.m_hi, right.m_hi, s2);
+    if (!std::isfinite(s1)) {
+        return dd_class(s1, 0.0);
+    }
+    double t1 = dd_two_sum(left.m_lo, right.m_lo, t2);
+    s2 += t1;
+    s1 = dd_quick_two_sum(s1, s2, s2);
+    s2 += t2;
+    s1 = dd_quick_two_sum(s1, s2, s2);
+    return dd_class(s1, s2);
+}
+
+dd_class operator+(const dd_class& left, const double right) {
+    double s2;
+    double s1 = dd_two_sum(left.m_hi, right, s2);
+    if (!std::isfinite(s1)) {
+        return dd_class(s1, 0.0);
+    }
+    s2 += left.m_lo;
+    s1 = dd_quick_two_sum(s1, s2, s2);
+    return dd_class(s1, s2);
+}
+
+dd_class operator+(const double left, const dd_class& right) {
+    return right + left;
+}
+
+dd_class& dd_class::operator+=(const dd_class& other) {
+    *this = *this + other;
+    return *this;
+}
+
+dd_class& dd_class::operator+=(const double other) {
+    *this = *this + other;
+    return *this;
+}
+
+dd_class dd_class::operator+() const {
+    return *this;
+}
+
+dd_class& dd_class::operator++() {
+    *this = *this + 1.0;
+    return *this;
+}
+
+dd_class dd_class::operator++(int) {
+    dd_class tmp = *this;
+    *this = *this + 1.0;
+    return tmp;
+}
+
+dd_class operator-(const dd_class& left, const dd_class& right) {
+    return left + (-right);
+}
+
+dd_class operator-(const dd_class& left, const double right) {
+    return left + (-right);
+}
+
+dd_class operator-(const double left, const dd_class& right) {
+    return (-right) + left;
+}
+
+dd_class& dd_class::operator-=(const dd_class& other) {
+    *this = *this + (-other);
+    return *this;
+}
+
+dd_class& dd_class::operator-=(const double other) {
+    *this = *this + (-other);
+    return *this;
+}
+
+dd_class dd_class::operator-() const {
+    return dd_class(-this->m_hi, -this->m_lo);
+}
+
+dd_class& dd_class::operator--() {
+    *this = *this - 1.0;
+    return *this;
+}
+
+dd_class dd_class::operator--(int) {
+    dd_class tmp = *this;
+    *this = *this - 1.0;
+    return tmp;
+}
+
+dd_class operator*(const dd_class& left, const dd_class& right) {
+    double p2;
+    double p1 = dd_two_prod(left.m_hi, right.m_hi, p2);
+    if (!std::isfinite(p1)) {
+        return dd_class(p1, 0.0);
+    }
+    p2 += (left.m_hi * right.m_lo + left.m_lo * right.m_hi);
+    p1 = dd_quick_two_sum(p1, p2, p2);
+    return dd_class(p1, p2);
+}
+
+dd_class operator*(const dd_class& left, const double right) {
+    double p2;
+    double p1 = dd_two_prod(left.m_hi, right, p2);
+    if (!std::isfinite(p1)) {
+        return dd_class(p1, 0.0);
+    }
+    p2 += left.m_lo * right;
+    p1 = dd_quick_two_sum(p1, p2, p2);
+    return dd_class(p1, p2);
+}
+
+dd_class operator*(const double left, const dd_class& right) {
+    return right * left;
+}
+
+dd_class& dd_class::operator*=(const dd_class& other) {
+    *this = *this * other;
+    return *this;
+}
+
+dd_class& dd_class::operator*=(const double other) {
+    *this = *this * other;
+    return *this;
+}
+
+dd_class operator/(const dd_class& left, const dd_class& right) {
+    double q1 = left.m_hi / right.m_hi;
+    if (!std::isfinite(q1)) {
+        return dd_class(q1, 0.0);
+    }
+    dd_class r = left - right * q1;
+    double q2 = r.m_hi / right.m_hi;
+    r -= right * q2;
+    double q3 = r.m_hi / right.m_hi;
+    q1 = dd_quick_two_sum(q1, q2, q2);
+    return dd_class(q1, q2) + q3;
+}
+
+dd_class operator/(const dd_class& left, const double right) {
+    double q1 = left.m_hi / right;
+    if (!std::isfinite(q1)) {
+        return dd_class(q1, 0.0);
+    }
+    double p2, s2;
+    double p1 = dd_two_prod(q1, right, p2);
+    double s1 = dd_two_sum(left.m_hi, -p1, s2);
+    s2 -= p2;
+    s2 += left.m_lo;
+    double q2 = (s1 + s2) / right;
+    q1 = dd_quick_two_sum(q1, q2, q2);
+    return dd_class(q1, q2);
+}
+
+dd_class operator/(const double left, const dd_class& right) {
+    return dd_class(left) / right;
+}
+
+dd_class& dd_class::operator/=(const dd_class& other) {
+    *this = *this / other;
+    return *this;
+}
+
+dd_class& dd_class::operator/=(const double other) {
+    *this = *this / other;
+    return *this;
+}
+
+dd_class operator^(const dd_class& left, const dd_class& right) {
+    return left.pow_value(right);
+}
+
+dd_class operator^(const dd_class& left, const int right) {
+    return left.pow_value((long int)right);
+}
+
+dd_class operator^(const dd_class& left, const long int right) {
+    return left.pow_value(right);
+}
+
+dd_class operator^(const dd_class& left, const unsigned int right) {
+    return left.pow_value((long int)right);
+}
+
+dd_class operator^(const dd_class& left, const unsigned long int right) {
+    return left.pow_value((long int)right);
+}
+
+dd_class operator^(const dd_class& left, const double right) {
+    return left.pow_value(dd_class(right));
+}
+
+dd_class& dd_class::operator^=(const dd_class& other) {
+    this->to_pow(other);
+    return *this;
+}
+
+dd_class& dd_class::operator^=(const long int other) {
+    this->to_pow(other);
+    return *this;
+}
+
+bool operator==(const dd_class& left, const dd_class& right) {
+    return (left.m_hi == right.m_hi && left.m_lo == right.m_lo);
+}
+
+bool operator==(const dd_class& left, const double right) {
+    return (left.m_hi == right && left.m_lo == 0.0);
+}
+
+bool operator==(const double left, const dd_class& right) {
+    return (right == left);
+}
+
+bool operator!=(const dd_class& left, const dd_class& right) {
+    return (left.m_hi != right.m_hi || left.m_lo != right.m_lo);
+}
+
+bool operator!=(const dd_class& left, const double right) {
+    return (left.m_hi != right || left.m_lo != 0.0);
+}
+
+bool operator!=(const double left, const dd_class& right) {
+    return (right != left);
+}
+
+bool operator<(const dd_class& left, const dd_class& right) {
+    return (left.m_hi < right.m_hi || (left.m_hi == right.m_hi && left.m_lo < right.m_lo));
+}
+
+bool operator<(const dd_class& left, const double right) {
+    return (left.m_hi < right || (left.m_hi == right && left.m_lo < 0.0));
+}
+
+bool operator<(const double left, const dd_class& right) {
+    return (right > left);
+}
+
+bool operator<=(const dd_class& left, const dd_class& right) {
+    return (left.m_hi < right.m_hi || (left.m_hi == right.m_hi && left.m_lo <= right.m_lo));
+}
+
+bool operator<=(const dd_class& left, const double right) {
+    return (left.m_hi < right || (left.m_hi == right && left.m_lo <= 0.0));
+}
+
+bool operator<=(const double left, const dd_class& right) {
+    return (right >= left);
+}
+
+bool operator>(const dd_class& left, const dd_class& right) {
+    return (left.m_hi > right.m_hi || (left.m_hi == right.m_hi && left.m_lo > right.m_lo));
+}
+
+bool operator>(const dd_class& left, const double right) {
+    return (left.m_hi > right || (left.m_hi == right && left.m_lo > 0.0));
+}
+
+bool operator>(const double left, const dd_class& right) {
+    return (right < left);
+}
+
+bool operator>=(const dd_class& left, const dd_class& right) {
+    return (left.m_hi > right.m_hi || (left.m_hi == right.m_hi && left.m_lo >= right.m_lo));
+}
+
+bool operator>=(const dd_class& left, const double right) {
+    return (left.m_hi > right || (left.m_hi == right && left.m_lo >= 0.0));
+}
+
+bool operator>=(const double left, const dd_class& right) {
+    return (right <= left);
+}
+
+// Integral exponents use binary powering, everything else exp(y*log(x)).
+// With x = 2^k * m as in log_value and y*k = n + f this is
+// 2^n * exp(f*log(2) + y*log(m)), so the exponential only sees the part of
+// the argument that is not an exact power of two. The products of k with the
+// parts of y are exact, so f is not polluted by the rounding of y*k.
+dd_class dd_class::pow_value(const dd_class& exponent) const {
+    if (exponent.m_lo == 0.0 && std::fabs(exponent.m_hi) < 2147483648.0 &&
+        exponent.m_hi == std::floor(exponent.m_hi)) {
+        return this->pow_value((long int)exponent.m_hi);
+    }
+    if (!(this->m_hi > 0.0) || !std::isfinite(this->m_hi)) {
+        return (exponent * this->log_value()).exp_value();
+    }
+    int k = dd_log_exponent(this->m_hi);
+    dd_class t = dd_class(exponent.m_hi) * (double)k;
+    double n = std::floor(t.m_hi + 0.5);
+    if (!(std::fabs(n) < 2100.0)) {
+        return (exponent * this->log_value()).exp_value();
+    }
+    dd_class f = (t - n) + dd_class(exponent.m_lo) * (double)k;
+    dd_class m = dd_class::ldexp(*this, -k);
+    dd_class y = f * dd_class::const_log2() + exponent * m.log_reduced();
+    return dd_class::ldexp(y.exp_value(), (int)n);
+}
+
+dd_class dd_class::pow_value(const long int exponent) const {
+    if (exponent == 0) {
+        return dd_class(1.0);
+    }
+    unsigned long int n = (exponent < 0) ? -(unsigned long int)exponent : (unsigned long int)exponent;
+    dd_class base = *this;
+    dd_class result(1.0);
+    while (true) {
+        if (n & 1) {
+            result *= base;
+        }
+        n >>= 1;
+        if (n == 0) {
+            break;
+        }
+        base = dd_class::sqr(base);
+    }
+    if (exponent < 0) {
+        return 1.0 / result;
+    }
+    return result;
+}
+
+void dd_class::to_pow(const dd_class& exponent) {
+    *this = this->pow_value(exponent);
+}
+
+void dd_class::to_pow(const long int exponent) {
+    *this = this->pow_value(exponent);
+}
+
+dd_class& dd_class::fma(const dd_class& left, const dd_class& right, const dd_class& addend) {
+    *this = left * right + addend;
+    return *this;
+}
+
+dd_class& dd_class::fms(const dd_class& left, const dd_class& right, const dd_class& subtrahend) {
+    *this = left * right - subtrahend;
+    return *this;
+}
+
+dd_class& dd_class::addmul(const dd_class& left, const dd_class& right) {
+    *this = *this + left * right;
+    return *this;
+}
+
+dd_class& dd_class::submul(const dd_class& left, const dd_class& right) {
+    *this = *this - left * right;
+    return *this;
+}
+
+long int dd_class::long_value() const {
+    return this->class_value().long_value();
+}
+
+double dd_class::double_value() const {
+    return this->m_hi + this->m_lo;
+}
+
+long double dd_class::ldouble_value() const {
+    return (long double)this->m_hi + (long double)this->m_lo;
+}
+
+mpfr_class dd_class::class_value() const {
+    mpfr_class tmp;
+    tmp.set_prec(dd_class::precision);
+    MPFR_DECL_INIT(hi, DBL_MANT_DIG);
+    MPFR_DECL_INIT(lo, DBL_MANT_DIG);
+    mpfr_set_d(hi, this->m_hi, MPFR_RNDN);
+    mpfr_set_d(lo, this->m_lo, MPFR_RNDN);
+    mpfr_ptr values[2] = {hi, lo};
+    mpfr_sum(tmp.get_raw(), values, 2, MPFR_RNDN);
+    return tmp;
+}
+
+std::ostream& operator<<(std::ostream& left, const dd_class& right) {
+    left << right.get_str();
+    return left;
+}
+
+std::istream& operator>>(std::istream& left, dd_class& right) {
+    std::string tmp_string;
+    left >> tmp_string;
+    right.set_str(tmp_string, 10);
+    return left;
+}
+
+std::string dd_class::get_str() const {
+    return this->class_value().get_str();
+}
+
+std::string dd_class::get_str_with_format(std::string format) const {
+    return this->class_value().get_str_with_format(format);
+}
+
+void dd_class::set_str(const std::string& other, const int base) {
+    mpfr_t tmp;
+    mpfr_init2(tmp, 2 * dd_class::precision);
+    if (mpfr_set_str(tmp, other.c_str(), base, MPFR_RNDN) != 0) {
+        printf("dd_class[%s:%d]: Invalid number string.\n", __FILE__, __LINE__);
+        abort();
+    }
+    this->set_raw(tmp);
+    mpfr_clear(tmp);
+}
+
+dd_class dd_class::abs_value() const {
+    if (this->m_hi < 0.0) {
+        return -*this;
+    }
+    return *this;
+}
+
+void dd_class::to_abs() {
+    *this = this->abs_value();
+}
+
+dd_class dd_class::sqrt_value() const {
+    if (this->m_hi == 0.0 || !std::isfinite(this->m_hi)) {
+        return (this->m_hi < 0.0 && !this->is_zero()) ? dd_class(NAN, 0.0) : *this;
+    }
+    if (this->m_hi < 0.0) {
+        return dd_class(NAN, 0.0);
+    }
+    double x = 1.0 / std::sqrt(this->m_hi);
+    double ax = this->m_hi * x;
+    double correction = (*this - dd_class::sqr(dd_class(ax))).m_hi * (x * 0.5);
+    double lo;
+    double hi = dd_two_sum(ax, correction, lo);
+    return dd_class(hi, lo);
+}
+
+void dd_class::to_sqrt() {
+    *this = this->sqrt_value();
+}
+
+// log(a) = k*log(2) + log(m) with a = 2^k * m and m in [sqrt(1/2), sqrt(2)).
+dd_class dd_class::log_value() const {
+    if (this->is_nan() || this->m_hi < 0.0) {
+        return dd_class(NAN, 0.0);
+    }
+    if (this->m_hi == 0.0) {
+        return dd_class(-INFINITY, 0.0);
+    }
+    if (std::isinf(this->m_hi)) {
+        return *this;
+    }
+    if (*this == 1.0) {
+        return dd_class(0.0);
+    }
+    int k = dd_log_exponent(this->m_hi);
+    dd_class m = dd_class::ldexp(*this, -k);
+    return m.log_reduced() + dd_class::const_log2() * (double)k;
+}
+
+void dd_class::to_log() {
+    *this = this->log_value();
+}
+
+// One Newton step on exp(x) = m from the double log1p(m - 1), written as
+// x + ((m - 1) - expm1(x)) / (1 + expm1(x)) so that neither the start nor the
+// correction loses relative accuracy for m close to one.
+dd_class dd_class::log_reduced() const {
+    dd_class d = *this - 1.0;
+    dd_class x(std::log1p(d.m_hi));
+    dd_class s = x.expm1_reduced();
+    x += (d - s) / (s + 1.0);
+    return x;
+}
+
+// exp(a) = 2^m * exp(r) with |r| <= log(2)/2.
+dd_class dd_class::exp_value() const {
+    if (this->is_nan()) {
+        return *this;
+    }
+    if (this->m_hi > 709.79) {
+        return dd_class(INFINITY, 0.0);
+    }
+    if (this->m_hi < -745.14) {
+        return dd_class(0.0);
+    }
+    if (this->m_hi == 0.0) {
+        return dd_class(1.0);
+    }
+    const dd_class log2 = dd_class::const_log2();
+    double m = std::floor(this->m_hi / log2.m_hi + 0.5);
+    dd_class s = (*this - log2 * m).expm1_reduced();
+    s += 1.0;
+    return dd_class::ldexp(s, (int)m);
+}
+
+void dd_class::to_exp() {
+    *this = this->exp_value();
+}
+
+// exp(a) - 1 = exp(r)^512 - 1 with r = a/512 for |a| <= log(2)/2; the Taylor
+// series gives exp(r) - 1, which is squared nine times as s -> 2*s + s^2.
+dd_class dd_class::expm1_reduced() const {
+    const double threshold = std::ldexp(dd_class::const_epsilon().m_hi, -9);
+    dd_class r = dd_class::ldexp(*this, -9);
+    const dd_class *inverse_factorial = dd_inverse_factorials();
+    dd_class s = r;
+    dd_class p = r;
+    for (int n = 2; n < dd_n_inverse_factorials; ++n) {
+        p *= r;
+        dd_class t = p * inverse_factorial[n];
+        s += t;
+        if (std::fabs(t.m_hi) <= threshold) {
+            break;
+        }
+    }
+    for (int i = 0; i < 9; ++i) {
+        s = dd_class::ldexp(s, 1) + dd_class::sqr(s);
+    }
+    return s;
+}
+
+dd_class dd_class::cos_value() const {
+    dd_class sin_result, cos_result;
+    this->sin_cos(sin_result, cos_result);
+    return cos_result;
+}
+
+void dd_class::to_cos() {
+    *this = this->cos_value();
+}
+
+dd_class dd_class::sin_value() const {
+    dd_class sin_result, cos_result;
+    this->sin_cos(sin_result, cos_result);
+    return sin_result;
+}
+
+void dd_class::to_sin() {
+    *this = this->sin_value();
+}
+
+dd_class dd_class::tan_value() const {
+    dd_class sin_result, cos_result;
+    this->sin_cos(sin_result, cos_result);
+    return sin_result / cos_result;
+}
+
+void dd_class::to_tan() {
+    *this = this->tan_value();
+}
+
+double dd_class::get_hi() const {
+    return this->m_hi;
+}
+
+double dd_class::get_lo() const {
+    return this->m_lo;
+}
+
+mpfr_prec_t dd_class::get_prec() const {
+    return dd_class::precision;
+}
+
+mpfr_exp_t dd_class::get_exp() const {
+    int exponent;
+    double mantissa = std::frexp(this->m_hi, &exponent);
+    if (std::fabs(mantissa) == 0.5 && this->m_hi * this->m_lo < 0.0) {
+        --exponent;
+    }
+    return exponent;
+}
+
+// The precision is fixed; set_prec only resets the value and round_prec
+// rounds it to fewer bits.
+void dd_class::set_prec(mpfr_prec_t prec) {
+    this->set_nan();
+}
+
+void dd_class::round_prec(mpfr_prec_t prec) {
+    if (prec >= dd_class::precision || !this->is_regular()) {
+        return;
+    }
+    mpfr_class tmp = this->class_value();
+    mpfr_prec_round(tmp.get_raw(), prec, MPFR_RNDN);
+    this->set_raw(tmp.get_raw());
+}
+
+bool dd_class::is_nan() const {
+    return std::isnan(this->m_hi);
+}
+
+bool dd_class::is_inf() const {
+    return std::isinf(this->m_hi);
+}
+
+bool dd_class::is_number() const {
+    return std::isfinite(this->m_hi);
+}
+
+bool dd_class::is_zero() const {
+    return this->m_hi == 0.0;
+}
+
+bool dd_class::is_regular() const {
+    return std::isfinite(this->m_hi) && this->m_hi != 0.0;
+}
+
+void dd_class::set_nan() {
+    this->m_hi = std::numeric_limits<double>::quiet_NaN();
+    this->m_lo = std::numeric_limits<double>::quiet_NaN();
+}
+
+void dd_class::set_inf(int sign) {
+    this->m_hi = (sign < 0) ? -INFINITY : INFINITY;
+    this->m_lo = 0.0;
+}
+
+void dd_class::set_zero(int sign) {
+    this->m_hi = (sign < 0) ? -0.0 : 0.0;
+    this->m_lo = 0.0;
+}
+
+void dd_class::set_neg() {
+    this->m_hi = -this->m_hi;
+    this->m_lo = -this->m_lo;
+}
+
+int dd_class::get_sign() const {
+    return (this->m_hi > 0.0) - (this->m_hi < 0.0);
+}
+
+void dd_class::set_sign(int sign) {
+    if ((sign < 0) != (std::signbit(this->m_hi) != 0)) {
+        this->set_neg();
+    }
+}
+
+void dd_class::set_raw(mpfr_srcptr other) {
+    if (mpfr_nan_p(other)) {
+        this->set_nan();
+        return;
+    }
+    if (mpfr_inf_p(other)) {
+        this->set_inf(mpfr_sgn(other));
+        return;
+    }
+    if (mpfr_zero_p(other)) {
+        this->set_zero(mpfr_signbit(other) ? -1 : 1);
+        return;
+    }
+    mpfr_t tmp;
+    mpfr_init2(tmp, mpfr_get_prec(other));
+    mpfr_set(tmp, other, MPFR_RNDN);
+    double hi = mpfr_get_d(tmp, MPFR_RNDN);
+    mpfr_sub_d(tmp, tmp, hi, MPFR_RNDN);
+    double lo = std::isfinite(hi) ? mpfr_get_d(tmp, MPFR_RNDN) : 0.0;
+    mpfr_clear(tmp);
+    this->m_hi = dd_quick_two_sum(hi, lo, this->m_lo);
+}
+
+// Reduction by multiples of pi/2 and Taylor series for sin and cos of the
+// remainder |r| <= pi/4.
+void dd_class::sin_cos(dd_class& sin_result, dd_class& cos_result) const {
+    if (this->m_hi == 0.0) {
+        sin_result = *this;
+        cos_result = dd_class(1.0);
+        return;
+    }
+    if (!std::isfinite(this->m_hi)) {
+        sin_result.set_nan();
+        cos_result.set_nan();
+        return;
+    }
+    const dd_class half_pi = dd_class::ldexp(dd_class::const_pi(), -1);
+    const double epsilon = dd_class::const_epsilon().m_hi;
+    double k = std::floor(this->m_hi / half_pi.m_hi + 0.5);
+    dd_class r = *this - half_pi * k;
+    dd_class r2 = dd_class::sqr(r);
+    const dd_class *inverse_factorial = dd_inverse_factorials();
+    dd_class sin_r = r;
+    dd_class p = r;
+    for (int n = 3; n < dd_n_inverse_factorials; n += 2) {
+        p *= r2;
+        dd_class t = p * inverse_factorial[n];
+        if (n % 4 == 3) {
+            sin_r -= t;
+        } else {
+            sin_r += t;
+        }
+        if (std::fabs(t.m_hi) <= epsilon * std::fabs(r.m_hi)) {
+            break;
+        }
+    }
+    dd_class cos_r(1.0);
+    p = dd_class(1.0);
+    for (int n = 2; n < dd_n_inverse_factorials; n += 2) {
+        p *= r2;
+        dd_class t = p * inverse_factorial[n];
+        if (n % 4 == 2) {
+            cos_r -= t;
+        } else {
+            cos_r += t;
+        }
+        if (std::fabs(t.m_hi) <= epsilon) {
+            break;
+        }
+    }
+    long int quadrant = (long int)std::fmod(k, 4.0);
+    if (quadrant < 0) {
+        quadrant += 4;
+    }
+    switch (quadrant) {
+        case 0: {
+            sin_result = sin_r;
+            cos_result = cos_r;
+        } break;
+        case 1: {
+            sin_result = cos_r;
+            cos_result = -sin_r;
+        } break;
+        case 2: {
+            sin_result = -sin_r;
+            cos_result = -cos_r;
+        } break;
+        default: {
+            sin_result = -cos_r;
+            cos_result = sin_r;
+        }
+    }
+}
+
+dd_class dd_class::sqr(const dd_class& value) {
+    double p2;
+    double p1 = dd_two_prod(value.m_hi, value.m_hi, p2);
+    if (!std::isfinite(p1)) {
+        return dd_class(p1, 0.0);
+    }
+    p2 += 2.0 * value.m_hi * value.m_lo;
+    p2 += value.m_lo * value.m_lo;
+    p1 = dd_quick_two_sum(p1, p2, p2);
+    return dd_class(p1, p2);
+}
+
+dd_class dd_class::ldexp(const dd_class& value, const int exponent) {
+    return dd_class(std::ldexp(value.m_hi, exponent), std::ldexp(value.m_lo, exponent));
+}
+
+void dd_class::set(dd_class& result, const dd_class& value) {
+    result = value;
+}
+
+void dd_class::add(dd_class& result, const dd_class& left, const dd_class& right) {
+    result = left + right;
+}
+
+void dd_class::add(dd_class& result, const dd_class& left, const unsigned long int right) {
+    result = left + (double)right;
+}
+
+void dd_class::sub(dd_class& result, const dd_class& left, const dd_class& right) {
+    result = left - right;
+}
+
+void dd_class::sub(dd_class& result, const dd_class& left, const unsigned long int right) {
+    result = left - (double)right;
+}
+
+void dd_class::sub(dd_class& result, const unsigned long int left, const dd_class& right) {
+    result = (double)left - right;
+}
+
+void dd_class::mul(dd_class& result, const dd_class& left, const dd_class& right) {
+    result = left * right;
+}
+
+void dd_class::mul(dd_class& result, const dd_class& left, const unsigned long int right) {
+    result = left * (double)right;
+}
+
+void dd_class::div(dd_class& result, const dd_class& left, const dd_class& right) {
+    result = left / right;
+}
+
+void dd_class::div(dd_class& result, const dd_class& left, const unsigned long int right) {
+    result = left / (double)right;
+}
+
+void dd_class::div(dd_class& result, const unsigned long int left, const dd_class& right) {
+    result = (double)left / right;
+}
+
+void dd_class::pow(dd_class& result, const dd_class& base, const dd_class& exponent) {
+    result = base.pow_value(exponent);
+}
+
+void dd_class::pow_ui(dd_class& result, const dd_class& base, const unsigned long int exponent) {
+    result = base.pow_value((long int)exponent);
+}
+
+void dd_class::abs_into(dd_class& result, const dd_class& value) {
+    result = value.abs_value();
+}
+
+void dd_class::sqrt_into(dd_class& result, const dd_class& value) {
+    result = value.sqrt_value();
+}
+
+void dd_class::log_into(dd_class& result, const dd_class& value) {
+    result = value.log_value();
+}
+
+void dd_class::exp_into(dd_class& result, const dd_class& value) {
+    result = value.exp_value();
+}
+
+void dd_class::cos_into(dd_class& result, const dd_class& value) {
+    result = value.cos_value();
+}
+
+void dd_class::sin_into(dd_class& result, const dd_class& value) {
+    result = value.sin_value();
+}
+
+void dd_class::tan_into(dd_class& result, const dd_class& value) {
+    result = value.tan_value();
+}
+
+dd_class dd_class::const_log2() {
+    static const dd_class value = dd_constant(mpfr_const_log2);
+    return value;
+}
+
+dd_class dd_class::const_pi() {
+    static const dd_class value = dd_constant(mpfr_const_pi);
+    return value;
+}
+
+dd_class dd_class::const_epsilon() {
+    return dd_class(std::ldexp(1.0, -104), 0.0);
+}
@@ -0,0 +1,324 @@
+//
+//  dd_class.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __DD_CLASS_H__
+#define __DD_CLASS_H__
+
+#include <stdint.h>
+#include <cmath>
+#include <mpfr.h>
+#include <iostream>
+#include <string>
+
+#include "mpfr_class.h"
+#include "mpfr_scalar_traits.h"
+
+// Error-free transformations. The results are exact: a + b == s + err and
+// a * b == p + err. two_prod uses the hardware fused multiply-add where the
+// compiler has one (-mfma) and Dekker's splitting otherwise. Values above
+// 2^996 are scaled down before they are split, so that split * a cannot
+// overflow.
+
+inline double dd_quick_two_sum(const double a, const double b, double& err) {
+    double s = a + b;
+    err = b - (s - a);
+    return s;
+}
+
+inline double dd_two_sum(const double a, const double b, double& err) {
+    double s = a + b;
+    double bb = s - a;
+    err = (a - (s - bb)) + (b - bb);
+    return s;
+}
+
+inline void dd_split(const double a, double& hi, double& lo) {
+    const double split = 134217729.0; // 2^27 + 1
+    const double split_threshold = 6.69692879491417e+299; // 2^996
+    if (a > split_threshold || a < -split_threshold) {
+        double scaled = a * 3.7252902984619140625e-09; // 2^-28
+        double t = split * scaled;
+        hi = t - (t - scaled);
+        lo = scaled - hi;
+        hi *= 268435456.0; // 2^28
+        lo *= 268435456.0;
+    } else {
+        double t = split * a;
+        hi = t - (t - a);
+        lo = a - hi;
+    }
+}
+
+inline double dd_two_prod(const double a, const double b, double& err) {
+    double p = a * b;
+#ifdef FP_FAST_FMA
+    err = std::fma(a, b, -p);
+#else
+    double a_hi, a_lo, b_hi, b_lo;
+    dd_split(a, a_hi, a_lo);
+    dd_split(b, b_hi, b_lo);
+    err = ((a_hi * b_hi - p) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo;
+#endif
+    return p;
+}
+
+// Double-double number: an unevaluated sum hi + lo of two doubles with
+// |lo| <= ulp(hi)/2, giving 106 bits of precision at hardware speed. The
+// interface follows mpfr_class; the rounding mode is always to nearest.
+
+class dd_class {
+
+private:
+
+    double m_hi;
+    double m_lo;
+
+public:
+
+    dd_class();
+
+    dd_class(const dd_class& other) {
+        this->m_hi = other.m_hi;
+        this->m_lo = other.m_lo;
+    }
+
+    dd_class(const double hi, const double lo) {
+        this->m_hi = hi;
+        this->m_lo = lo;
+    }
+
+    dd_class(const int other);
+    dd_class(const long int other);
+    dd_class(const long long int other);
+    dd_class(const unsigned int other);
+    dd_class(const unsigned long int other);
+    dd_class(const unsigned long long int other);
+    dd_class(const float other);
+    dd_class(const double other);
+    dd_class(const long double other);
+    dd_class(const char *other);
+    dd_class(const std::string& other);
+    explicit dd_class(const mpfr_class& other);
+
+    ~dd_class() {
+    }
+
+    dd_class& operator=(const dd_class& other) {
+        this->m_hi = other.m_hi;
+        this->m_lo = other.m_lo;
+        return *this;
+    }
+
+    dd_class& operator=(const double other);
+
+    friend dd_class operator+(const dd_class& left, const dd_class& right);
+    friend dd_class operator+(const dd_class& left, const double right);
+    friend dd_class operator+(const double left, const dd_class& right);
+    dd_class& operator+=(const dd_class& other);
+    dd_class& operator+=(const double other);
+    dd_class operator+() const;
+    dd_class& operator++();
+    dd_class operator++(int);
+
+    friend dd_class operator-(const dd_class& left, const dd_class& right);
+    friend dd_class operator-(const dd_class& left, const double right);
+    friend dd_class operator-(const double left, const dd_class& right);
+    dd_class& operator-=(const dd_class& other);
+    dd_class& operator-=(const double other);
+    dd_class operator-() const;
+    dd_class& operator--();
+    dd_class operator--(int);
+
+    friend dd_class operator*(const dd_class& left, const dd_class& right);
+    friend dd_class operator*(const dd_class& left, const double right);
+    friend dd_class operator*(const double left, const dd_class& right);
+    dd_class& operator*=(const dd_class& other);
+    dd_class& operator*=(const double other);
+
+    friend dd_class operator/(const dd_class& left, const dd_class& right);
+    friend dd_class operator/(const dd_class& left, const double right);
+    friend dd_class operator/(const double left, const dd_class& right);
+    dd_class& operator/=(const dd_class& other);
+    dd_class& operator/=(const double other);
+
+    friend dd_class operator^(const dd_class& left, const dd_class& right);
+    friend dd_class operator^(const dd_class& left, const int right);
+    friend dd_class operator^(const dd_class& left, const long int right);
+    friend dd_class operator^(const dd_class& left, const unsigned int right);
+    friend dd_class operator^(const dd_class& left, const unsigned long int right);
+    friend dd_class operator^(const dd_class& left, const double right);
+    dd_class& operator^=(const dd_class& other);
+    dd_class& operator^=(const long int other);
+
+    friend bool operator==(const dd_class& left, const dd_class& right);
+    friend bool operator==(const dd_class& left, const double right);
+    friend bool operator==(const double left, const dd_class& right);
+
+    friend bool operator!=(const dd_class& left, const dd_class& right);
+    friend bool operator!=(const dd_class& left, const double right);
+    friend bool operator!=(const double left, const dd_class& right);
+
+    friend bool operator<(const dd_class& left, const dd_class& right);
+    friend bool operator<(const dd_class& left, const double right);
+    friend bool operator<(const double left, const dd_class& right);
+
+    friend bool operator<=(const dd_class& left, const dd_class& right);
+    friend bool operator<=(const dd_class& left, const double right);
+    friend bool operator<=(const double left, const dd_class& right);
+
+    friend bool operator>(const dd_class& left, const dd_class& right);
+    friend bool operator>(const dd_class& left, const double right);
+    friend bool operator>(const double left, const dd_class& right);
+
+    friend bool operator>=(const dd_class& left, const dd_class& right);
+    friend bool operator>=(const dd_class& left, const double right);
+    friend bool operator>=(const double left, const dd_class& right);
+
+    dd_class pow_value(const dd_class& exponent) const;
+    dd_class pow_value(const long int exponent) const;
+    void to_pow(const dd_class& exponent);
+    void to_pow(const long int exponent);
+
+    dd_class& fma(const dd_class& left, const dd_class& right, const dd_class& addend);
+    dd_class& fms(const dd_class& left, const dd_class& right, const dd_class& subtrahend);
+    dd_class& addmul(const dd_class& left, const dd_class& right);
+    dd_class& submul(const dd_class& left, const dd_class& right);
+
+    long int long_value() const;
+    double double_value() const;
+    long double ldouble_value() const;
+    mpfr_class class_value() const;
+
+    explicit operator double() const { return this->double_value(); }
+    explicit operator long double() const { return this->ldouble_value(); }
+
+    friend std::ostream& operator<<(std::ostream& left, const dd_class& right);
+    friend std::istream& operator>>(std::istream& left, dd_class& right);
+
+    std::string get_str() const;
+    std::string get_str_with_format(std::string format) const;
+    void set_str(const std::string& other, const int base);
+
+    dd_class abs_value() const;
+    void to_abs();
+
+    dd_class sqrt_value() const;
+    void to_sqrt();
+
+    dd_class log_value() const;
+    void to_log();
+
+    dd_class exp_value() const;
+    void to_exp();
+
+    dd_class cos_value() const;
+    void to_cos();
+
+    dd_class sin_value() const;
+    void to_sin();
+
+    dd_class tan_value() const;
+    void to_tan();
+
+    double get_hi() const;
+    double get_lo() const;
+
+    mpfr_prec_t get_prec() const;
+    mpfr_exp_t get_exp() const;
+    void set_prec(mpfr_prec_t prec);
+    void round_prec(mpfr_prec_t prec);
+
+    bool is_nan() const;
+    bool is_inf() const;
+    bool is_number() const;
+    bool is_zero() const;
+    bool is_regular() const;
+
+    void set_nan();
+    void set_inf(int sign);
+    void set_zero(int sign);
+    void set_neg();
+
+    int get_sign() const;
+    void set_sign(int sign);
+
+private:
+
+    void set_raw(mpfr_srcptr other);
+    void sin_cos(dd_class& sin_result, dd_class& cos_result) const;
+    dd_class log_reduced() const;
+    dd_class expm1_reduced() const;
+
+public:
+
+    static const mpfr_prec_t precision = 106;
+
+    static dd_class sqr(const dd_class& value);
+    static dd_class ldexp(const dd_class& value, const int exponent);
+
+    static void set(dd_class& result, const dd_class& value);
+    static void add(dd_class& result, const dd_class& left, const dd_class& right);
+    static void add(dd_class& result, const dd_class& left, const unsigned long int right);
+    static void sub(dd_class& result, const dd_class& left, const dd_class& right);
+    static void sub(dd_class& result, const dd_class& left, const unsigned long int right);
+    static void sub(dd_class& result, const unsigned long int left, const dd_class& right);
+    static void mul(dd_class& result, const dd_class& left, const dd_class& right);
+    static void mul(dd_class& result, const dd_class& left, const unsigned long int right);
+    static void div(dd_class& result, const dd_class& left, const dd_class& right);
+    static void div(dd_class& result, const dd_class& left, const unsigned long int right);
+    static void div(dd_class& result, const unsigned long int left, const dd_class& right);
+    static void pow(dd_class& result, const dd_class& base, const dd_class& exponent);
+    static void pow_ui(dd_class& result, const dd_class& base, const unsigned long int exponent);
+
+    static void abs_into(dd_class& result, const dd_class& value);
+    static void sqrt_into(dd_class& result, const dd_class& value);
+    static void log_into(dd_class& result, const dd_class& value);
+    static void exp_into(dd_class& result, const dd_class& value);
+    static void cos_into(dd_class& result, const dd_class& value);
+    static void sin_into(dd_class& result, const dd_class& value);
+    static void tan_into(dd_class& result, const dd_class& value);
+
+    static dd_class const_log2();
+    static dd_class const_pi();
+    static dd_class const_epsilon();
+
+}; // class dd_class
+
+template <>
+struct mpfr_scalar_traits<dd_class> {
+    static const bool is_fixed_prec = true;
+    static const mpfr_prec_t fixed_prec = dd_class::precision;
+    static const bool is_mpfr = false;
+};
+
+// dd_class has no expression templates; expressions written for mpfr_class
+// are evaluated eagerly.
+inline const dd_class& mpfr_expr(const dd_class& value) {
+    return value;
+}
+
+#endif // __DD_CLASS_H__
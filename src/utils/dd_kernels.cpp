@@ -0,0 +1,229 @@
+//
+//  dd_kernels.cpp
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#include "dd_kernels.h"
+
+#include <iostream>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DD_KERNELS_AVX2
+#include <immintrin.h>
+#endif
+
+// The kernels read the two doubles of each element in place.
+static_assert(sizeof(dd_class) == 2 * sizeof(double), "dd_kernels: dd_class must consist of two doubles.");
+
+namespace {
+
+// The steps of dd_class addition and multiplication, without the checks for
+// non-finite values.
+inline void dd_kernels_add(double& sum_hi, double& sum_lo, const double hi, const double lo) {
+    double s2, t2;
+    double s1 = dd_two_sum(sum_hi, hi, s2);
+    double t1 = dd_two_sum(sum_lo, lo, t2);
+    s2 += t1;
+    s1 = dd_quick_two_sum(s1, s2, s2);
+    s2 += t2;
+    sum_hi = dd_quick_two_sum(s1, s2, sum_lo);
+}
+
+inline void dd_kernels_addmul(double& sum_hi, double& sum_lo, const double *left, const double *right) {
+    double p2;
+    double p1 = dd_two_prod(left[0], right[0], p2);
+    p2 += (left[0] * right[1] + left[1] * right[0]);
+    p1 = dd_quick_two_sum(p1, p2, p2);
+    dd_kernels_add(sum_hi, sum_lo, p1, p2);
+}
+
+#ifdef DD_KERNELS_AVX2
+
+// Four elements of the given stride, in the lane order 0, 2, 1, 3 that the
+// unpack of two contiguous loads produces.
+__attribute__((target("avx2,fma")))
+inline void dd_kernels_load_avx2(__m256d& hi, __m256d& lo, const double *values, const size_t stride) {
+    if (stride == 1) {
+        __m256d first = _mm256_loadu_pd(values);
+        __m256d second = _mm256_loadu_pd(values + 4);
+        hi = _mm256_unpacklo_pd(first, second);
+        lo = _mm256_unpackhi_pd(first, second);
+    } else {
+        hi = _mm256_set_pd(values[6 * stride], values[2 * stride], values[4 * stride], values[0]);
+        lo = _mm256_set_pd(values[6 * stride + 1], values[2 * stride + 1], values[4 * stride + 1], values[1]);
+    }
+}
+
+__attribute__((target("avx2,fma")))
+inline void dd_kernels_quick_two_sum_avx2(__m256d& s, __m256d& err, const __m256d a, const __m256d b) {
+    s = _mm256_add_pd(a, b);
+    err = _mm256_sub_pd(b, _mm256_sub_pd(s, a));
+}
+
+__attribute__((target("avx2,fma")))
+inline void dd_kernels_two_sum_avx2(__m256d& s, __m256d& err, const __m256d a, const __m256d b) {
+    s = _mm256_add_pd(a, b);
+    __m256d bb = _mm256_sub_pd(s, a);
+    err = _mm256_add_pd(_mm256_sub_pd(a, _mm256_sub_pd(s, bb)), _mm256_sub_pd(b, bb));
+}
+
+__attribute__((target("avx2,fma")))
+inline void dd_kernels_addmul_avx2(__m256d& sum_hi, __m256d& sum_lo, const double *left, const size_t left_stride,
+    const double *right, const size_t right_stride) {
+    __m256d a_hi, a_lo, b_hi, b_lo;
+    dd_kernels_load_avx2(a_hi, a_lo, left, left_stride);
+    dd_kernels_load_avx2(b_hi, b_lo, right, right_stride);
+    __m256d p1 = _mm256_mul_pd(a_hi, b_hi);
+    __m256d p2 = _mm256_fmsub_pd(a_hi, b_hi, p1);
+    p2 = _mm256_add_pd(p2, _mm256_add_pd(_mm256_mul_pd(a_hi, b_lo), _mm256_mul_pd(a_lo, b_hi)));
+    dd_kernels_quick_two_sum_avx2(p1, p2, p1, p2);
+    __m256d s1, s2, t1, t2;
+    dd_kernels_two_sum_avx2(s1, s2, sum_hi, p1);
+    dd_kernels_two_sum_avx2(t1, t2, sum_lo, p2);
+    s2 = _mm256_add_pd(s2, t1);
+    dd_kernels_quick_two_sum_avx2(s1, s2, s1, s2);
+    s2 = _mm256_add_pd(s2, t2);
+    dd_kernels_quick_two_sum_avx2(sum_hi, sum_lo, s1, s2);
+}
+
+// Eight elements per step, the first four into one pair of registers and the
+// second four into the other. Lanes 1 and 2 of each register are swapped when
+// the lanes are loaded and stored.
+__attribute__((target("avx2,fma")))
+size_t dd_kernels_dot_avx2(double *lanes_hi, double *lanes_lo, const double *left, const size_t left_stride,
+    const double *right, const size_t right_stride, const size_t count) {
+    const int order = 0xd8;
+    __m256d first_hi = _mm256_permute4x64_pd(_mm256_loadu_pd(lanes_hi), order);
+    __m256d first_lo = _mm256_permute4x64_pd(_mm256_loadu_pd(lanes_lo), order);
+    __m256d second_hi = _mm256_permute4x64_pd(_mm256_loadu_pd(lanes_hi + 4), order);
+    __m256d second_lo = _mm256_permute4x64_pd(_mm256_loadu_pd(lanes_lo + 4), order);
+    size_t e = 0;
+    for (; e + 8 <= count; e += 8) {
+        dd_kernels_addmul_avx2(first_hi, first_lo, left + 2 * e * left_stride, left_stride,
+            right + 2 * e * right_stride, right_stride);
+        dd_kernels_addmul_avx2(second_hi, second_lo, left + 2 * (e + 4) * left_stride, left_stride,
+            right + 2 * (e + 4) * right_stride, right_stride);
+    }
+    _mm256_storeu_pd(lanes_hi, _mm256_permute4x64_pd(first_hi, order));
+    _mm256_storeu_pd(lanes_lo, _mm256_permute4x64_pd(first_lo, order));
+    _mm256_storeu_pd(lanes_hi + 4, _mm256_permute4x64_pd(second_hi, order));
+    _mm256_storeu_pd(lanes_lo + 4, _mm256_permute4x64_pd(second_lo, order));
+    return e;
+}
+
+#endif // DD_KERNELS_AVX2
+
+} // namespace
+
+dd_kernels::kernel_type dd_kernels::get_kernel() {
+    return current_kernel();
+}
+
+// Kernels the processor cannot run fall back to the best available one.
+void dd_kernels::set_kernel(const kernel_type kernel) {
+    kernel_type best = detect_kernel();
+    current_kernel() = (kernel > best) ? best : kernel;
+}
+
+dd_kernels::kernel_type dd_kernels::detect_kernel() {
+#ifdef DD_KERNELS_AVX2
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return kernel_avx2;
+    }
+#endif
+    return kernel_scalar;
+}
+
+void dd_kernels::addmul_n(dd_class& sum, const dd_class *left, const size_t left_stride,
+    const dd_class *right, const size_t right_stride, const size_t count) {
+    dd_class tmp = dot(left, left_stride, right, right_stride, count);
+    if (!std::isfinite(tmp.get_hi())) {
+        for (size_t i = 0; i < count; ++i) {
+            sum.addmul(left[i * left_stride], right[i * right_stride]);
+        }
+        return;
+    }
+    sum += tmp;
+}
+
+void dd_kernels::submul_n(dd_class& sum, const dd_class *left, const size_t left_stride,
+    const dd_class *right, const size_t right_stride, const size_t count) {
+    dd_class tmp = dot(left, left_stride, right, right_stride, count);
+    if (!std::isfinite(tmp.get_hi())) {
+        for (size_t i = 0; i < count; ++i) {
+            sum.submul(left[i * left_stride], right[i * right_stride]);
+        }
+        return;
+    }
+    sum -= tmp;
+}
+
+dd_kernels::kernel_type& dd_kernels::current_kernel() {
+    static kernel_type kernel = detect_kernel();
+    return kernel;
+}
+
+dd_class dd_kernels::dot(const dd_class *left, const size_t left_stride,
+    const dd_class *right, const size_t right_stride, const size_t count) {
+    const double *left_values = reinterpret_cast<const double*>(left);
+    const double *right_values = reinterpret_cast<const double*>(right);
+    double lanes_hi[n_lanes] = {0};
+    double lanes_lo[n_lanes] = {0};
+    size_t end = count - count % n_lanes;
+    size_t begin = 0;
+    if (current_kernel() == kernel_avx2) {
+        begin = dot_avx2(lanes_hi, lanes_lo, left_values, left_stride, right_values, right_stride, end);
+    }
+    dot_scalar(lanes_hi, lanes_lo, left_values + 2 * begin * left_stride, left_stride,
+        right_values + 2 * begin * right_stride, right_stride, end - begin);
+    for (size_t step = 1; step < n_lanes; step *= 2) {
+        for (size_t k = 0; k < n_lanes; k += 2 * step) {
+            dd_kernels_add(lanes_hi[k], lanes_lo[k], lanes_hi[k + step], lanes_lo[k + step]);
+        }
+    }
+    for (size_t i = end; i < count; ++i) {
+        dd_kernels_addmul(lanes_hi[0], lanes_lo[0], left_values + 2 * i * left_stride, right_values + 2 * i * right_stride);
+    }
+    return dd_class(lanes_hi[0], lanes_lo[0]);
+}
+
+// count is a multiple of n_lanes.
+void dd_kernels::dot_scalar(double *lanes_hi, double *lanes_lo, const double *left, const size_t left_stride,
+    const double *right, const size_t right_stride, const size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        size_t k = i % n_lanes;
+        dd_kernels_addmul(lanes_hi[k], lanes_lo[k], left + 2 * i * left_stride, right + 2 * i * right_stride);
+    }
+}
+
+// Returns the number of elements handled, which is count.
+size_t dd_kernels::dot_avx2(double *lanes_hi, double *lanes_lo, const double *left, const size_t left_stride,
+    const double *right, const size_t right_stride, const size_t count) {
+#ifdef DD_KERNELS_AVX2
+    return dd_kernels_dot_avx2(lanes_hi, lanes_lo, left, left_stride, right, right_stride, count);
+#else
+    return 0;
+#endif
+}
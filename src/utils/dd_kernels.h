@@ -0,0 +1,78 @@
+//
+//  dd_kernels.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __DD_KERNELS_H__
+#define __DD_KERNELS_H__
+
+#include <stddef.h>
+
+#include "dd_class.h"
+
+// Batched double-double dot products. The products are summed in eight
+// interleaved lanes that are combined pairwise at the end, and the tail that
+// does not fill all lanes is added to that total in order. The AVX2 kernel
+// runs two lanes of four elements with the hardware fused multiply-add and is
+// chosen at run time when the processor supports both; the scalar kernel
+// sums the same lanes in the same order, so both give identical results. The
+// sum is recomputed term by term if the total is not finite.
+
+class dd_kernels {
+
+public:
+
+    typedef enum kernel_type {
+        kernel_scalar = 0,
+        kernel_avx2 = 1
+    } kernel_type;
+
+    static const size_t n_lanes = 8;
+
+    static kernel_type get_kernel();
+    static void set_kernel(const kernel_type kernel);
+    static kernel_type detect_kernel();
+
+    // sum += left[i * left_stride] * right[i * right_stride] over count
+    // elements, and the same for sum -=.
+    static void addmul_n(dd_class& sum, const dd_class *left, const size_t left_stride,
+        const dd_class *right, const size_t right_stride, const size_t count);
+    static void submul_n(dd_class& sum, const dd_class *left, const size_t left_stride,
+        const dd_class *right, const size_t right_stride, const size_t count);
+
+private:
+
+    static kernel_type& current_kernel();
+
+    static dd_class dot(const dd_class *left, const size_t left_stride,
+        const dd_class *right, const size_t right_stride, const size_t count);
+    static void dot_scalar(double *lanes_hi, double *lanes_lo, const double *left, const size_t left_stride,
+        const double *right, const size_t right_stride, const size_t count);
+    static size_t dot_avx2(double *lanes_hi, double *lanes_lo, const double *left, const size_t left_stride,
+        const double *right, const size_t right_stride, const size_t count);
+
+}; // class dd_kernels
+
+#endif // __DD_KERNELS_H__
@@ -0,0 +1,491 @@
+//
+//  mpfr_accumulator.cpp
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#include "mpfr_accumulator.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+static const mp_limb_t mpfr_accumulator_high_bit = ((mp_limb_t)1) << (GMP_NUMB_BITS - 1);
+
+static mpfr_exp_t mpfr_accumulator_align(const mpfr_exp_t exp) {
+    mpfr_exp_t quotient = exp / GMP_NUMB_BITS;
+    if (exp % GMP_NUMB_BITS != 0 && exp < 0) {
+        --quotient;
+    }
+    return quotient * GMP_NUMB_BITS;
+}
+
+static size_t mpfr_accumulator_n_limbs(mpfr_srcptr value) {
+    return (mpfr_get_prec(value) + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+}
+
+} // namespace
+
+mpfr_accumulator::mpfr_accumulator() :
+    m_size(0),
+    m_exp(0),
+    m_nan(false),
+    m_inf(0),
+    m_has_rounded(false),
+    m_batch_limbs(0),
+    m_batch_count(0) {
+}
+
+mpfr_accumulator::~mpfr_accumulator() {
+}
+
+void mpfr_accumulator::reset() {
+    this->m_size = 0;
+    this->m_exp = 0;
+    this->m_nan = false;
+    this->m_inf = 0;
+    this->m_has_rounded = false;
+    this->m_batch_count = 0;
+}
+
+void mpfr_accumulator::set(mpfr_srcptr value) {
+    this->reset();
+    this->add_value(value, false);
+}
+
+void mpfr_accumulator::add(mpfr_srcptr value) {
+    this->add_value(value, false);
+}
+
+void mpfr_accumulator::sub(mpfr_srcptr value) {
+    this->add_value(value, true);
+}
+
+void mpfr_accumulator::add_product(mpfr_srcptr left, mpfr_srcptr right) {
+    this->add_product_value(left, right, false);
+}
+
+void mpfr_accumulator::sub_product(mpfr_srcptr left, mpfr_srcptr right) {
+    this->add_product_value(left, right, true);
+}
+
+// Adds the exact sum held by other, whose queued products are flushed first.
+void mpfr_accumulator::merge(mpfr_accumulator& other) {
+    other.flush_products();
+    if (other.m_nan) {
+        this->m_nan = true;
+    }
+    if (other.m_inf != 0) {
+        this->add_special(other.m_inf);
+    }
+    if (other.m_has_rounded) {
+        this->add_rounded(other.m_rounded[0].get_raw());
+    }
+    if (other.m_size == 0) {
+        return;
+    }
+    size_t n = other.m_size;
+    if (this->m_term.size() < n + 1) {
+        this->m_term.resize(n + 1);
+    }
+    bool negative = (other.m_limbs[n - 1] & mpfr_accumulator_high_bit) != 0;
+    if (negative) {
+        mpn_neg(this->m_term.data(), other.m_limbs.data(), (mp_size_t)n);
+    } else {
+        std::copy(other.m_limbs.data(), other.m_limbs.data() + n, this->m_term.data());
+    }
+    this->add_term(this->m_term.data(), n, other.m_exp, negative);
+}
+
+// Multiplies the sum by factor. The product of the register and the
+// significand of factor is formed in full, so the sum stays exact, and so is
+// the product with the rounded partial sum.
+void mpfr_accumulator::scale(mpfr_srcptr factor) {
+    this->flush_products();
+    if (this->m_nan) {
+        return;
+    }
+    if (mpfr_nan_p(factor)) {
+        this->m_nan = true;
+        return;
+    }
+    bool factor_negative = mpfr_signbit(factor) != 0;
+    bool negative = this->m_size > 0 && (this->m_limbs[this->m_size - 1] & mpfr_accumulator_high_bit) != 0;
+    if (this->m_inf != 0 || mpfr_inf_p(factor)) {
+        int sign = (this->m_inf != 0) ? this->m_inf : this->get_sign();
+        if (sign == 0 || mpfr_zero_p(factor)) {
+            this->m_nan = true;
+            return;
+        }
+        this->m_inf = factor_negative ? -sign : sign;
+        return;
+    }
+    if (mpfr_zero_p(factor)) {
+        this->m_size = 0;
+        this->m_has_rounded = false;
+        return;
+    }
+    if (this->m_has_rounded) {
+        mpfr_class& rounded = this->m_rounded[0];
+        rounded.round_prec(mpfr_get_prec(rounded.get_raw()) + mpfr_get_prec(factor));
+        mpfr_mul(rounded.get_raw(), rounded.get_raw(), factor, MPFR_RNDN);
+    }
+    if (this->m_size == 0) {
+        return;
+    }
+    size_t n = this->m_size;
+    size_t n_factor = mpfr_accumulator_n_limbs(factor);
+    if (this->m_scratch.size() < n) {
+        this->m_scratch.resize(n);
+    }
+    if (negative) {
+        mpn_neg(this->m_scratch.data(), this->m_limbs.data(), (mp_size_t)n);
+    } else {
+        std::copy(this->m_limbs.data(), this->m_limbs.data() + n, this->m_scratch.data());
+    }
+    if (this->m_term.size() < n + n_factor + 1) {
+        this->m_term.resize(n + n_factor + 1);
+    }
+    if (n >= n_factor) {
+        mpn_mul(this->m_term.data(), this->m_scratch.data(), (mp_size_t)n, factor->_mpfr_d, (mp_size_t)n_factor);
+    } else {
+        mpn_mul(this->m_term.data(), factor->_mpfr_d, (mp_size_t)n_factor, this->m_scratch.data(), (mp_size_t)n);
+    }
+    mpfr_exp_t exp = this->m_exp + mpfr_get_exp(factor) - (mpfr_exp_t)(n_factor * GMP_NUMB_BITS);
+    this->m_size = 0;
+    this->add_term(this->m_term.data(), n + n_factor, exp, negative != factor_negative);
+}
+
+int mpfr_accumulator::get(mpfr_ptr result, const mpfr_rnd_t rnd) {
+    this->flush_products();
+    if (this->m_nan) {
+        mpfr_set_nan(result);
+        return 0;
+    }
+    if (this->m_inf != 0) {
+        mpfr_set_inf(result, this->m_inf);
+        return 0;
+    }
+    if (this->m_has_rounded) {
+        if (this->m_size == 0) {
+            return mpfr_set(result, this->m_rounded[0].get_raw(), rnd);
+        }
+        mpfr_class& value = this->m_rounded[1];
+        value.set_prec((mpfr_prec_t)(this->m_size * GMP_NUMB_BITS));
+        this->set_register(value.get_raw(), MPFR_RNDN);
+        return mpfr_add(result, value.get_raw(), this->m_rounded[0].get_raw(), rnd);
+    }
+    if (this->m_size == 0) {
+        mpfr_set_zero(result, 1);
+        return 0;
+    }
+    return this->set_register(result, rnd);
+}
+
+bool mpfr_accumulator::is_zero() {
+    this->flush_products();
+    return !this->m_nan && this->m_inf == 0 && this->get_sign() == 0;
+}
+
+size_t mpfr_accumulator::n_limbs() const {
+    return this->m_size;
+}
+
+// Rounds the register alone, which must not be empty.
+int mpfr_accumulator::set_register(mpfr_ptr result, const mpfr_rnd_t rnd) {
+    const mp_limb_t *limbs = this->m_limbs.data();
+    mp_size_t size = (mp_size_t)this->m_size;
+    if (limbs[this->m_size - 1] & mpfr_accumulator_high_bit) {
+        if (this->m_scratch.size() < this->m_size) {
+            this->m_scratch.resize(this->m_size);
+        }
+        mpn_neg(this->m_scratch.data(), limbs, size);
+        limbs = this->m_scratch.data();
+        size = -size;
+    }
+    mpz_t tmp;
+    return mpfr_set_z_2exp(result, mpz_roinit_n(tmp, limbs, size), this->m_exp, rnd);
+}
+
+// Sign of the finite total; the queued products must have been flushed.
+int mpfr_accumulator::get_sign() {
+    if (!this->m_has_rounded) {
+        if (this->m_size == 0) {
+            return 0;
+        }
+        return (this->m_limbs[this->m_size - 1] & mpfr_accumulator_high_bit) ? -1 : 1;
+    }
+    MPFR_DECL_INIT(tmp, GMP_NUMB_BITS);
+    if (this->m_size == 0) {
+        return mpfr_sgn(this->m_rounded[0].get_raw());
+    }
+    mpfr_class& value = this->m_rounded[1];
+    value.set_prec((mpfr_prec_t)(this->m_size * GMP_NUMB_BITS));
+    this->set_register(value.get_raw(), MPFR_RNDN);
+    mpfr_add(tmp, value.get_raw(), this->m_rounded[0].get_raw(), MPFR_RNDN);
+    return mpfr_sgn(tmp);
+}
+
+void mpfr_accumulator::add_value(mpfr_srcptr value, const bool negative) {
+    if (mpfr_nan_p(value)) {
+        this->m_nan = true;
+        return;
+    }
+    bool sign = (mpfr_signbit(value) != 0) != negative;
+    if (mpfr_inf_p(value)) {
+        this->add_special(sign ? -1 : 1);
+        return;
+    }
+    if (mpfr_zero_p(value)) {
+        return;
+    }
+    size_t n = mpfr_accumulator_n_limbs(value);
+    if (this->m_term.size() < n + 1) {
+        this->m_term.resize(n + 1);
+    }
+    std::copy(value->_mpfr_d, value->_mpfr_d + n, this->m_term.data());
+    this->add_term(this->m_term.data(), n, mpfr_get_exp(value) - (mpfr_exp_t)(n * GMP_NUMB_BITS), sign);
+}
+
+void mpfr_accumulator::add_product_value(mpfr_srcptr left, mpfr_srcptr right, const bool negative) {
+    if (mpfr_nan_p(left) || mpfr_nan_p(right)) {
+        this->m_nan = true;
+        return;
+    }
+    bool sign = ((mpfr_signbit(left) != 0) != (mpfr_signbit(right) != 0)) != negative;
+    if (mpfr_inf_p(left) || mpfr_inf_p(right)) {
+        if (mpfr_zero_p(left) || mpfr_zero_p(right)) {
+            this->m_nan = true;
+        } else {
+            this->add_special(sign ? -1 : 1);
+        }
+        return;
+    }
+    if (mpfr_zero_p(left) || mpfr_zero_p(right)) {
+        return;
+    }
+    size_t n_left = mpfr_accumulator_n_limbs(left);
+    size_t n_right = mpfr_accumulator_n_limbs(right);
+    if (n_left == n_right && n_left <= mpfr_limb_kernels::max_limbs) {
+        this->queue_product(left, right, n_left, sign);
+        return;
+    }
+    if (this->m_term.size() < n_left + n_right + 1) {
+        this->m_term.resize(n_left + n_right + 1);
+    }
+    if (n_left >= n_right) {
+        mpn_mul(this->m_term.data(), left->_mpfr_d, (mp_size_t)n_left, right->_mpfr_d, (mp_size_t)n_right);
+    } else {
+        mpn_mul(this->m_term.data(), right->_mpfr_d, (mp_size_t)n_right, left->_mpfr_d, (mp_size_t)n_left);
+    }
+    mpfr_exp_t exp = mpfr_get_exp(left) + mpfr_get_exp(right) - (mpfr_exp_t)((n_left + n_right) * GMP_NUMB_BITS);
+    this->add_term(this->m_term.data(), n_left + n_right, exp, sign);
+}
+
+void mpfr_accumulator::add_special(const int sign) {
+    if (this->m_inf != 0 && this->m_inf != sign) {
+        this->m_nan = true;
+    }
+    this->m_inf = sign;
+}
+
+// The sum is exact, so queued products may be added in any order relative to
+// the other terms.
+void mpfr_accumulator::queue_product(mpfr_srcptr left, mpfr_srcptr right, const size_t n_limbs, const bool negative) {
+    if (this->m_batch_count > 0 && this->m_batch_limbs != n_limbs) {
+        this->flush_products();
+    }
+    if (this->m_batch_left.size() < mpfr_limb_kernels::max_limbs * batch_size) {
+        this->m_batch_left.resize(mpfr_limb_kernels::max_limbs * batch_size);
+        this->m_batch_right.resize(mpfr_limb_kernels::max_limbs * batch_size);
+        this->m_batch_product.resize(2 * mpfr_limb_kernels::max_limbs * batch_size);
+        this->m_batch_exp.resize(batch_size);
+        this->m_batch_negative.resize(batch_size);
+    }
+    size_t e = this->m_batch_count;
+    for (size_t k = 0; k < n_limbs; ++k) {
+        this->m_batch_left[k * batch_size + e] = left->_mpfr_d[k];
+        this->m_batch_right[k * batch_size + e] = right->_mpfr_d[k];
+    }
+    this->m_batch_exp[e] = mpfr_get_exp(left) + mpfr_get_exp(right) - (mpfr_exp_t)(2 * n_limbs * GMP_NUMB_BITS);
+    this->m_batch_negative[e] = negative;
+    this->m_batch_limbs = n_limbs;
+    ++this->m_batch_count;
+    if (this->m_batch_count == batch_size) {
+        this->flush_products();
+    }
+}
+
+void mpfr_accumulator::flush_products() {
+    if (this->m_batch_count == 0) {
+        return;
+    }
+    size_t n_limbs = this->m_batch_limbs;
+    size_t count = this->m_batch_count;
+    this->m_batch_count = 0;
+    mpfr_limb_kernels::mul_n(this->m_batch_product.data(), batch_size, this->m_batch_left.data(),
+        this->m_batch_right.data(), batch_size, n_limbs, count);
+    if (this->m_term.size() < 2 * n_limbs + 1) {
+        this->m_term.resize(2 * n_limbs + 1);
+    }
+    for (size_t e = 0; e < count; ++e) {
+        for (size_t k = 0; k < 2 * n_limbs; ++k) {
+            this->m_term[k] = this->m_batch_product[k * batch_size + e];
+        }
+        this->add_term(this->m_term.data(), 2 * n_limbs, this->m_batch_exp[e], this->m_batch_negative[e]);
+    }
+}
+
+// Adds term * 2^exp. The term is shifted in place onto a limb boundary, so it
+// must provide one spare limb above n_term.
+void mpfr_accumulator::add_term(mp_limb_t *term, size_t n_term, mpfr_exp_t exp, const bool negative) {
+    mpfr_exp_t aligned = mpfr_accumulator_align(exp);
+    unsigned int shift = (unsigned int)(exp - aligned);
+    if (shift > 0) {
+        term[n_term] = mpn_lshift(term, term, (mp_size_t)n_term, shift);
+    } else {
+        term[n_term] = 0;
+    }
+    ++n_term;
+    while (n_term > 1 && term[0] == 0) {
+        ++term;
+        --n_term;
+        aligned += GMP_NUMB_BITS;
+    }
+    while (n_term > 1 && term[n_term - 1] == 0) {
+        --n_term;
+    }
+    mpfr_exp_t low = aligned;
+    mpfr_exp_t high = aligned + (mpfr_exp_t)(n_term * GMP_NUMB_BITS);
+    if (this->m_size > 0) {
+        low = std::min(low, this->m_exp);
+        high = std::max(high, this->m_exp + (mpfr_exp_t)(this->m_size * GMP_NUMB_BITS));
+    }
+    if ((size_t)((high - low) / GMP_NUMB_BITS) + 1 > max_limbs) {
+        this->add_rounded_term(term, n_term, aligned, negative);
+        return;
+    }
+    if (this->m_size == 0) {
+        this->m_exp = aligned;
+    } else if (aligned < this->m_exp) {
+        size_t n_shift = (size_t)((this->m_exp - aligned) / GMP_NUMB_BITS);
+        if (this->m_limbs.size() < this->m_size + n_shift) {
+            this->m_limbs.resize(this->m_size + n_shift);
+        }
+        mp_limb_t *limbs = this->m_limbs.data();
+        std::copy_backward(limbs, limbs + this->m_size, limbs + this->m_size + n_shift);
+        std::fill(limbs, limbs + n_shift, (mp_limb_t)0);
+        this->m_size += n_shift;
+        this->m_exp = aligned;
+    }
+    size_t offset = (size_t)((aligned - this->m_exp) / GMP_NUMB_BITS);
+    this->extend(std::max(this->m_size, offset + n_term) + 1);
+    mp_limb_t *limbs = this->m_limbs.data() + offset;
+    mp_size_t n_limbs = (mp_size_t)(this->m_size - offset);
+    if (negative) {
+        mpn_sub(limbs, limbs, n_limbs, term, (mp_size_t)n_term);
+    } else {
+        mpn_add(limbs, limbs, n_limbs, term, (mp_size_t)n_term);
+    }
+    this->normalize();
+}
+
+void mpfr_accumulator::add_rounded_term(const mp_limb_t *term, const size_t n_term, const mpfr_exp_t exp, const bool negative) {
+    if (this->m_rounded.empty()) {
+        this->m_rounded.resize(2);
+    }
+    mpfr_class& value = this->m_rounded[1];
+    value.set_prec((mpfr_prec_t)(n_term * GMP_NUMB_BITS));
+    mp_size_t size = negative ? -(mp_size_t)n_term : (mp_size_t)n_term;
+    mpz_t tmp;
+    mpfr_set_z_2exp(value.get_raw(), mpz_roinit_n(tmp, term, size), exp, MPFR_RNDN);
+    this->add_rounded(value.get_raw());
+}
+
+// Adds value to the rounded partial sum, whose precision grows to that of the
+// widest term.
+void mpfr_accumulator::add_rounded(mpfr_srcptr value) {
+    if (this->m_rounded.empty()) {
+        this->m_rounded.resize(2);
+    }
+    mpfr_class& sum = this->m_rounded[0];
+    if (!this->m_has_rounded) {
+        sum.set_prec(mpfr_get_prec(value));
+        mpfr_set(sum.get_raw(), value, MPFR_RNDN);
+        this->m_has_rounded = true;
+        return;
+    }
+    if (mpfr_get_prec(sum.get_raw()) < mpfr_get_prec(value)) {
+        sum.round_prec(mpfr_get_prec(value));
+    }
+    mpfr_add(sum.get_raw(), sum.get_raw(), value, MPFR_RNDN);
+}
+
+// Widens the register to size limbs by sign extension.
+void mpfr_accumulator::extend(const size_t size) {
+    if (size <= this->m_size) {
+        return;
+    }
+    if (size > max_limbs) {
+        printf("mpfr_accumulator[%s:%d]: Exponent range of the terms is too wide.\n", __FILE__, __LINE__);
+        abort();
+    }
+    if (this->m_limbs.size() < size) {
+        this->m_limbs.resize(size);
+    }
+    mp_limb_t fill = 0;
+    if (this->m_size > 0 && (this->m_limbs[this->m_size - 1] & mpfr_accumulator_high_bit)) {
+        fill = ~(mp_limb_t)0;
+    }
+    std::fill(this->m_limbs.begin() + this->m_size, this->m_limbs.begin() + size, fill);
+    this->m_size = size;
+}
+
+// Drops redundant sign limbs at the top and zero limbs at the bottom.
+void mpfr_accumulator::normalize() {
+    mp_limb_t *limbs = this->m_limbs.data();
+    while (this->m_size > 1) {
+        mp_limb_t top = limbs[this->m_size - 1];
+        bool next_negative = (limbs[this->m_size - 2] & mpfr_accumulator_high_bit) != 0;
+        if ((top == 0 && !next_negative) || (top == ~(mp_limb_t)0 && next_negative)) {
+            --this->m_size;
+        } else {
+            break;
+        }
+    }
+    if (this->m_size == 1 && limbs[0] == 0) {
+        this->m_size = 0;
+        return;
+    }
+    size_t n_zero = 0;
+    while (n_zero < this->m_size && limbs[n_zero] == 0) {
+        ++n_zero;
+    }
+    if (n_zero > 0) {
+        std::copy(limbs + n_zero, limbs + this->m_size, limbs);
+        this->m_size -= n_zero;
+        this->m_exp += (mpfr_exp_t)(n_zero * GMP_NUMB_BITS);
+    }
+}
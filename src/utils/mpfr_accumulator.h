@@ -0,0 +1,274 @@
+//
+//  mpfr_accumulator.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __MPFR_ACCUMULATOR_H__
+#define __MPFR_ACCUMULATOR_H__
+
+#include <stddef.h>
+#include <vector>
+#include <gmp.h>
+#include <mpfr.h>
+
+#include "dd_kernels.h"
+#include "mpfr_class.h"
+#include "mpfr_limb_kernels.h"
+#include "mpfr_scalar_traits.h"
+#include "mpfr_vector_view.h"
+
+// Exact sums of MPFR values and products. Every term is added without rounding
+// into a two's complement fixed-point register of GMP limbs that widens to the
+// exponents it sees, and the total is rounded once when it is read. Storage is
+// kept across reset(), so a reused accumulator does not allocate. Products of
+// significands of the same small size are queued and multiplied in batches by
+// mpfr_limb_kernels. Terms that would widen the register beyond max_limbs are
+// collected in a rounded partial sum instead, which is added to the register
+// when the total is read.
+
+class mpfr_accumulator {
+
+private:
+
+    std::vector<mp_limb_t> m_limbs;
+    size_t m_size;
+    mpfr_exp_t m_exp;
+
+    bool m_nan;
+    int m_inf;
+
+    std::vector<mpfr_class> m_rounded;
+    bool m_has_rounded;
+
+    std::vector<mp_limb_t> m_term;
+    std::vector<mp_limb_t> m_scratch;
+
+    std::vector<mp_limb_t> m_batch_left;
+    std::vector<mp_limb_t> m_batch_right;
+    std::vector<mp_limb_t> m_batch_product;
+    std::vector<mpfr_exp_t> m_batch_exp;
+    std::vector<bool> m_batch_negative;
+    size_t m_batch_limbs;
+    size_t m_batch_count;
+
+public:
+
+    mpfr_accumulator();
+    ~mpfr_accumulator();
+
+    void reset();
+    void set(mpfr_srcptr value);
+
+    void add(mpfr_srcptr value);
+    void sub(mpfr_srcptr value);
+    void add_product(mpfr_srcptr left, mpfr_srcptr right);
+    void sub_product(mpfr_srcptr left, mpfr_srcptr right);
+    void merge(mpfr_accumulator& other);
+    void scale(mpfr_srcptr factor);
+
+    int get(mpfr_ptr result, const mpfr_rnd_t rnd);
+
+    bool is_zero();
+    size_t n_limbs() const;
+
+private:
+
+    void add_value(mpfr_srcptr value, const bool negative);
+    void add_product_value(mpfr_srcptr left, mpfr_srcptr right, const bool negative);
+    void add_special(const int sign);
+    void queue_product(mpfr_srcptr left, mpfr_srcptr right, const size_t n_limbs, const bool negative);
+    void flush_products();
+    void add_term(mp_limb_t *term, size_t n_term, mpfr_exp_t exp, const bool negative);
+    void add_rounded_term(const mp_limb_t *term, const size_t n_term, const mpfr_exp_t exp, const bool negative);
+    void add_rounded(mpfr_srcptr value);
+    int set_register(mpfr_ptr result, const mpfr_rnd_t rnd);
+    int get_sign();
+    void extend(const size_t size);
+    void normalize();
+
+public:
+
+    static const size_t max_limbs = 1 << 16;
+    static const size_t batch_size = 64;
+
+}; // class mpfr_accumulator
+
+// Sums of the products of two views in the arithmetic of T, term by term.
+// dd_class hands them to the batched dd_kernels.
+
+template <class T>
+struct mpfr_accumulator_products {
+
+    static void addmul_n(T& sum, const mpfr_basic_vector_const_view<T>& left, const mpfr_basic_vector_const_view<T>& right) {
+        for (size_t i = 0; i < left.size(); ++i) {
+            sum.addmul(left[i], right[i]);
+        }
+    }
+
+    static void submul_n(T& sum, const mpfr_basic_vector_const_view<T>& left, const mpfr_basic_vector_const_view<T>& right) {
+        for (size_t i = 0; i < left.size(); ++i) {
+            sum.submul(left[i], right[i]);
+        }
+    }
+
+}; // struct mpfr_accumulator_products
+
+template <>
+struct mpfr_accumulator_products<dd_class> {
+
+    static void addmul_n(dd_class& sum, const mpfr_basic_vector_const_view<dd_class>& left, const mpfr_basic_vector_const_view<dd_class>& right) {
+        dd_kernels::addmul_n(sum, left.data(), left.stride(), right.data(), right.stride(), left.size());
+    }
+
+    static void submul_n(dd_class& sum, const mpfr_basic_vector_const_view<dd_class>& left, const mpfr_basic_vector_const_view<dd_class>& right) {
+        dd_kernels::submul_n(sum, left.data(), left.stride(), right.data(), right.stride(), left.size());
+    }
+
+}; // struct mpfr_accumulator_products
+
+// Dot products in the arithmetic of T. MPFR types go through mpfr_accumulator
+// and are rounded once into the precision of the result, everything else
+// accumulates in its own arithmetic. addmul_n and submul_n take the products
+// of two views of the same size.
+
+template <class T, bool IsMpfr = mpfr_scalar_traits<T>::is_mpfr>
+class mpfr_basic_accumulator {
+
+private:
+
+    mpfr_accumulator m_accumulator;
+
+public:
+
+    void reset() {
+        this->m_accumulator.reset();
+    }
+
+    void set(const T& value) {
+        this->m_accumulator.set(value.get_raw());
+    }
+
+    void add(const T& value) {
+        this->m_accumulator.add(value.get_raw());
+    }
+
+    void sub(const T& value) {
+        this->m_accumulator.sub(value.get_raw());
+    }
+
+    void addmul(const T& left, const T& right) {
+        this->m_accumulator.add_product(left.get_raw(), right.get_raw());
+    }
+
+    void submul(const T& left, const T& right) {
+        this->m_accumulator.sub_product(left.get_raw(), right.get_raw());
+    }
+
+    void addmul_n(const mpfr_basic_vector_const_view<T>& left, const mpfr_basic_vector_const_view<T>& right) {
+        for (size_t i = 0; i < left.size(); ++i) {
+            this->m_accumulator.add_product(left[i].get_raw(), right[i].get_raw());
+        }
+    }
+
+    void submul_n(const mpfr_basic_vector_const_view<T>& left, const mpfr_basic_vector_const_view<T>& right) {
+        for (size_t i = 0; i < left.size(); ++i) {
+            this->m_accumulator.sub_product(left[i].get_raw(), right[i].get_raw());
+        }
+    }
+
+    void merge(mpfr_basic_accumulator& other) {
+        this->m_accumulator.merge(other.m_accumulator);
+    }
+
+    void scale(const T& factor) {
+        this->m_accumulator.scale(factor.get_raw());
+    }
+
+    void get(T& result) {
+        this->m_accumulator.get(result.get_raw(), mpfr_class::get_default_rnd());
+    }
+
+}; // class mpfr_basic_accumulator
+
+template <class T>
+class mpfr_basic_accumulator<T, false> {
+
+private:
+
+    T m_sum;
+
+public:
+
+    mpfr_basic_accumulator() :
+        m_sum(0) {
+    }
+
+    void reset() {
+        this->m_sum = 0;
+    }
+
+    void set(const T& value) {
+        this->m_sum = value;
+    }
+
+    void add(const T& value) {
+        this->m_sum += value;
+    }
+
+    void sub(const T& value) {
+        this->m_sum -= value;
+    }
+
+    void addmul(const T& left, const T& right) {
+        this->m_sum.addmul(left, right);
+    }
+
+    void submul(const T& left, const T& right) {
+        this->m_sum.submul(left, right);
+    }
+
+    void addmul_n(const mpfr_basic_vector_const_view<T>& left, const mpfr_basic_vector_const_view<T>& right) {
+        mpfr_accumulator_products<T>::addmul_n(this->m_sum, left, right);
+    }
+
+    void submul_n(const mpfr_basic_vector_const_view<T>& left, const mpfr_basic_vector_const_view<T>& right) {
+        mpfr_accumulator_products<T>::submul_n(this->m_sum, left, right);
+    }
+
+    void merge(mpfr_basic_accumulator& other) {
+        this->m_sum += other.m_sum;
+    }
+
+    void scale(const T& factor) {
+        this->m_sum *= factor;
+    }
+
+    void get(T& result) {
+        result = this->m_sum;
+    }
+
+}; // class mpfr_basic_accumulator
+
+#endif // __MPFR_ACCUMULATOR_H__
@@ -0,0 +1,489 @@
+//
+//  mpfr_ball.cpp
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#include "mpfr_ball.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <utility>
+
+// Bounds for the radius computations: |value| rounded up or down to the
+// radius precision.
+static void mpfr_ball_abs_up(mpfr_ptr result, mpfr_srcptr value) {
+    mpfr_abs(result, value, MPFR_RNDU);
+}
+
+static void mpfr_ball_abs_down(mpfr_ptr result, mpfr_srcptr value) {
+    mpfr_abs(result, value, MPFR_RNDD);
+}
+
+mpfr_ball::mpfr_ball() :
+    m_rad(mpfr_ball::zero_radius()) {
+}
+
+mpfr_ball::mpfr_ball(const mpfr_ball& other) :
+    m_mid(other.m_mid),
+    m_rad(other.m_rad) {
+}
+
+mpfr_ball::mpfr_ball(mpfr_ball&& other) noexcept :
+    m_mid(std::move(other.m_mid)),
+    m_rad(std::move(other.m_rad)) {
+}
+
+mpfr_ball::mpfr_ball(const int other) :
+    m_rad(mpfr_ball::zero_radius()) {
+    this->add_error(mpfr_set_si(this->m_mid.get_raw(), other, MPFR_RNDN));
+}
+
+mpfr_ball::mpfr_ball(const long int other) :
+    m_rad(mpfr_ball::zero_radius()) {
+    this->add_error(mpfr_set_si(this->m_mid.get_raw(), other, MPFR_RNDN));
+}
+
+mpfr_ball::mpfr_ball(const unsigned int other) :
+    m_rad(mpfr_ball::zero_radius()) {
+    this->add_error(mpfr_set_ui(this->m_mid.get_raw(), other, MPFR_RNDN));
+}
+
+mpfr_ball::mpfr_ball(const unsigned long int other) :
+    m_rad(mpfr_ball::zero_radius()) {
+    this->add_error(mpfr_set_ui(this->m_mid.get_raw(), other, MPFR_RNDN));
+}
+
+mpfr_ball::mpfr_ball(const double other) :
+    m_rad(mpfr_ball::zero_radius()) {
+    this->add_error(mpfr_set_d(this->m_mid.get_raw(), other, MPFR_RNDN));
+}
+
+mpfr_ball::mpfr_ball(const char *other) :
+    m_rad(mpfr_ball::zero_radius()) {
+    char *end;
+    int ternary = mpfr_strtofr(this->m_mid.get_raw(), other, &end, 10, MPFR_RNDN);
+    if (end == other || *end != '\0') {
+        printf("mpfr_ball[%s:%d]: Invalid number string.\n", __FILE__, __LINE__);
+        abort();
+    }
+    this->add_error(ternary);
+}
+
+mpfr_ball::mpfr_ball(const std::string& other) :
+    mpfr_ball(other.c_str()) {
+}
+
+mpfr_ball::mpfr_ball(const mpfr_class& mid) :
+    m_rad(mpfr_ball::zero_radius()) {
+    this->add_error(mpfr_set(this->m_mid.get_raw(), mid.get_raw(), MPFR_RNDN));
+}
+
+mpfr_ball::mpfr_ball(const mpfr_class& mid, const mpfr_class& rad) :
+    m_rad(mpfr_ball::zero_radius()) {
+    mpfr_abs(this->m_rad.get_raw(), rad.get_raw(), MPFR_RNDU);
+    this->add_error(mpfr_set(this->m_mid.get_raw(), mid.get_raw(), MPFR_RNDN));
+}
+
+mpfr_ball::~mpfr_ball() {
+}
+
+mpfr_ball& mpfr_ball::operator=(const mpfr_ball& other) {
+    this->m_mid = other.m_mid;
+    this->m_rad = other.m_rad;
+    return *this;
+}
+
+mpfr_ball& mpfr_ball::operator=(mpfr_ball&& other) noexcept {
+    this->m_mid = std::move(other.m_mid);
+    this->m_rad = std::move(other.m_rad);
+    return *this;
+}
+
+mpfr_ball operator+(const mpfr_ball& left, const mpfr_ball& right) {
+    mpfr_ball result;
+    int ternary = mpfr_add(result.m_mid.get_raw(), left.m_mid.get_raw(), right.m_mid.get_raw(), MPFR_RNDN);
+    mpfr_add(result.m_rad.get_raw(), left.m_rad.get_raw(), right.m_rad.get_raw(), MPFR_RNDU);
+    result.add_error(ternary);
+    return result;
+}
+
+mpfr_ball& mpfr_ball::operator+=(const mpfr_ball& other) {
+    *this = *this + other;
+    return *this;
+}
+
+mpfr_ball mpfr_ball::operator+() const {
+    return mpfr_ball(*this);
+}
+
+mpfr_ball operator-(const mpfr_ball& left, const mpfr_ball& right) {
+    mpfr_ball result;
+    int ternary = mpfr_sub(result.m_mid.get_raw(), left.m_mid.get_raw(), right.m_mid.get_raw(), MPFR_RNDN);
+    mpfr_add(result.m_rad.get_raw(), left.m_rad.get_raw(), right.m_rad.get_raw(), MPFR_RNDU);
+    result.add_error(ternary);
+    return result;
+}
+
+mpfr_ball& mpfr_ball::operator-=(const mpfr_ball& other) {
+    *this = *this - other;
+    return *this;
+}
+
+mpfr_ball mpfr_ball::operator-() const {
+    mpfr_ball result(*this);
+    result.set_neg();
+    return result;
+}
+
+// |xy - ab| <= |a| r_y + |b| r_x + r_x r_y
+mpfr_ball operator*(const mpfr_ball& left, const mpfr_ball& right) {
+    mpfr_ball result;
+    int ternary = mpfr_mul(result.m_mid.get_raw(), left.m_mid.get_raw(), right.m_mid.get_raw(), MPFR_RNDN);
+    MPFR_DECL_INIT(tmp, mpfr_ball::radius_precision);
+    mpfr_ball_abs_up(tmp, left.m_mid.get_raw());
+    mpfr_mul(result.m_rad.get_raw(), tmp, right.m_rad.get_raw(), MPFR_RNDU);
+    mpfr_ball_abs_up(tmp, right.m_mid.get_raw());
+    mpfr_mul(tmp, tmp, left.m_rad.get_raw(), MPFR_RNDU);
+    mpfr_add(result.m_rad.get_raw(), result.m_rad.get_raw(), tmp, MPFR_RNDU);
+    mpfr_mul(tmp, left.m_rad.get_raw(), right.m_rad.get_raw(), MPFR_RNDU);
+    mpfr_add(result.m_rad.get_raw(), result.m_rad.get_raw(), tmp, MPFR_RNDU);
+    result.add_error(ternary);
+    return result;
+}
+
+mpfr_ball& mpfr_ball::operator*=(const mpfr_ball& other) {
+    *this = *this * other;
+    return *this;
+}
+
+// |x/y - a/b| <= (r_x + |a/b| r_y) / (|b| - r_y)
+mpfr_ball operator/(const mpfr_ball& left, const mpfr_ball& right) {
+    mpfr_ball result;
+    if (right.contains_zero()) {
+        result.set_nan();
+        return result;
+    }
+    int ternary = mpfr_div(result.m_mid.get_raw(), left.m_mid.get_raw(), right.m_mid.get_raw(), MPFR_RNDN);
+    MPFR_DECL_INIT(quotient, mpfr_ball::radius_precision);
+    MPFR_DECL_INIT(denominator, mpfr_ball::radius_precision);
+    mpfr_ball_abs_up(quotient, result.m_mid.get_raw());
+    if (ternary != 0 && mpfr_regular_p(result.m_mid.get_raw())) {
+        MPFR_DECL_INIT(ulp, mpfr_ball::radius_precision);
+        mpfr_set_ui_2exp(ulp, 1, mpfr_get_exp(result.m_mid.get_raw()) - mpfr_get_prec(result.m_mid.get_raw()), MPFR_RNDU);
+        mpfr_add(quotient, quotient, ulp, MPFR_RNDU);
+    }
+    mpfr_mul(quotient, quotient, right.m_rad.get_raw(), MPFR_RNDU);
+    mpfr_add(quotient, quotient, left.m_rad.get_raw(), MPFR_RNDU);
+    mpfr_ball_abs_down(denominator, right.m_mid.get_raw());
+    mpfr_sub(denominator, denominator, right.m_rad.get_raw(), MPFR_RNDD);
+    mpfr_div(result.m_rad.get_raw(), quotient, denominator, MPFR_RNDU);
+    result.add_error(ternary);
+    return result;
+}
+
+mpfr_ball& mpfr_ball::operator/=(const mpfr_ball& other) {
+    *this = *this / other;
+    return *this;
+}
+
+// For an exact exponent e and x > 0:
+// |x^e - a^e| <= |e| max((a - r)^(e-1), (a + r)^(e-1)) r
+mpfr_ball operator^(const mpfr_ball& left, const mpfr_ball& right) {
+    if (!mpfr_zero_p(right.m_rad.get_raw())) {
+        return (right * left.log_value()).exp_value();
+    }
+    mpfr_ball result;
+    MPFR_DECL_INIT(lower, mpfr_ball::radius_precision);
+    mpfr_sub(lower, left.m_mid.get_raw(), left.m_rad.get_raw(), MPFR_RNDD);
+    if (mpfr_sgn(lower) <= 0) {
+        result.set_nan();
+        return result;
+    }
+    int ternary = mpfr_pow(result.m_mid.get_raw(), left.m_mid.get_raw(), right.m_mid.get_raw(), MPFR_RNDN);
+    if (!mpfr_zero_p(left.m_rad.get_raw())) {
+        // t^(e-1) = t^e / t, rounded up at both endpoints.
+        MPFR_DECL_INIT(upper, mpfr_ball::radius_precision);
+        MPFR_DECL_INIT(tmp, mpfr_ball::radius_precision);
+        mpfr_add(upper, left.m_mid.get_raw(), left.m_rad.get_raw(), MPFR_RNDU);
+        mpfr_pow(tmp, lower, right.m_mid.get_raw(), MPFR_RNDU);
+        mpfr_div(lower, tmp, lower, MPFR_RNDU);
+        mpfr_pow(tmp, upper, right.m_mid.get_raw(), MPFR_RNDU);
+        mpfr_div(upper, tmp, upper, MPFR_RNDU);
+        if (mpfr_less_p(upper, lower)) {
+            mpfr_swap(upper, lower);
+        }
+        mpfr_abs(tmp, right.m_mid.get_raw(), MPFR_RNDU);
+        mpfr_mul(upper, upper, tmp, MPFR_RNDU);
+        mpfr_mul(result.m_rad.get_raw(), upper, left.m_rad.get_raw(), MPFR_RNDU);
+    }
+    result.add_error(ternary);
+    return result;
+}
+
+// |x^n - a^n| <= (|a| + r)^n - |a|^n
+// |x^n - a^n| <= n (|a| + r)^(n-1) r
+mpfr_ball operator^(const mpfr_ball& left, const unsigned long int right) {
+    mpfr_ball result;
+    int ternary = mpfr_pow_ui(result.m_mid.get_raw(), left.m_mid.get_raw(), right, MPFR_RNDN);
+    if (!mpfr_zero_p(left.m_rad.get_raw()) && right > 0) {
+        MPFR_DECL_INIT(tmp, mpfr_ball::radius_precision);
+        mpfr_ball_abs_up(tmp, left.m_mid.get_raw());
+        mpfr_add(tmp, tmp, left.m_rad.get_raw(), MPFR_RNDU);
+        mpfr_pow_ui(tmp, tmp, right - 1, MPFR_RNDU);
+        mpfr_mul_ui(tmp, tmp, right, MPFR_RNDU);
+        mpfr_mul(result.m_rad.get_raw(), tmp, left.m_rad.get_raw(), MPFR_RNDU);
+    }
+    result.add_error(ternary);
+    return result;
+}
+
+bool operator==(const mpfr_ball& left, const mpfr_ball& right) {
+    return mpfr_equal_p(left.m_mid.get_raw(), right.m_mid.get_raw()) != 0;
+}
+
+bool operator!=(const mpfr_ball& left, const mpfr_ball& right) {
+    return !(left == right);
+}
+
+bool operator<(const mpfr_ball& left, const mpfr_ball& right) {
+    return mpfr_less_p(left.m_mid.get_raw(), right.m_mid.get_raw()) != 0;
+}
+
+bool operator<=(const mpfr_ball& left, const mpfr_ball& right) {
+    return mpfr_lessequal_p(left.m_mid.get_raw(), right.m_mid.get_raw()) != 0;
+}
+
+bool operator>(const mpfr_ball& left, const mpfr_ball& right) {
+    return mpfr_greater_p(left.m_mid.get_raw(), right.m_mid.get_raw()) != 0;
+}
+
+bool operator>=(const mpfr_ball& left, const mpfr_ball& right) {
+    return mpfr_greaterequal_p(left.m_mid.get_raw(), right.m_mid.get_raw()) != 0;
+}
+
+mpfr_ball& mpfr_ball::addmul(const mpfr_ball& left, const mpfr_ball& right) {
+    *this = *this + left * right;
+    return *this;
+}
+
+mpfr_ball& mpfr_ball::submul(const mpfr_ball& left, const mpfr_ball& right) {
+    *this = *this - left * right;
+    return *this;
+}
+
+std::ostream& operator<<(std::ostream& left, const mpfr_ball& right) {
+    left << right.get_str();
+    return left;
+}
+
+std::string mpfr_ball::get_str() const {
+    return this->m_mid.get_str() + " +/- " + this->m_rad.get_str_with_format("%.3RUE");
+}
+
+// The format applies to the midpoint.
+std::string mpfr_ball::get_str_with_format(std::string format) const {
+    return this->m_mid.get_str_with_format(format);
+}
+
+mpfr_ball mpfr_ball::abs_value() const {
+    mpfr_ball result(*this);
+    result.to_abs();
+    return result;
+}
+
+void mpfr_ball::to_abs() {
+    if (!this->contains_zero()) {
+        mpfr_abs(this->m_mid.get_raw(), this->m_mid.get_raw(), MPFR_RNDN);
+        return;
+    }
+    // [0, |a| + r]
+    MPFR_DECL_INIT(tmp, mpfr_ball::radius_precision);
+    mpfr_ball_abs_up(tmp, this->m_mid.get_raw());
+    mpfr_add(tmp, tmp, this->m_rad.get_raw(), MPFR_RNDU);
+    mpfr_div_2ui(this->m_rad.get_raw(), tmp, 1, MPFR_RNDU);
+    this->add_error(mpfr_div_2ui(this->m_mid.get_raw(), tmp, 1, MPFR_RNDN));
+}
+
+mpfr_ball mpfr_ball::sqrt_value() const {
+    mpfr_ball result(*this);
+    result.to_sqrt();
+    return result;
+}
+
+// |sqrt(x) - sqrt(a)| <= r / sqrt(a - r)
+void mpfr_ball::to_sqrt() {
+    MPFR_DECL_INIT(lower, mpfr_ball::radius_precision);
+    mpfr_sub(lower, this->m_mid.get_raw(), this->m_rad.get_raw(), MPFR_RNDD);
+    if (mpfr_sgn(lower) <= 0) {
+        // [0, sqrt(a + r)]
+        MPFR_DECL_INIT(upper, mpfr_ball::radius_precision);
+        mpfr_add(upper, this->m_mid.get_raw(), this->m_rad.get_raw(), MPFR_RNDU);
+        if (mpfr_sgn(upper) < 0) {
+            this->set_nan();
+            return;
+        }
+        mpfr_sqrt(upper, upper, MPFR_RNDU);
+        mpfr_div_2ui(this->m_rad.get_raw(), upper, 1, MPFR_RNDU);
+        this->add_error(mpfr_div_2ui(this->m_mid.get_raw(), upper, 1, MPFR_RNDN));
+        return;
+    }
+    mpfr_sqrt(lower, lower, MPFR_RNDD);
+    mpfr_div(this->m_rad.get_raw(), this->m_rad.get_raw(), lower, MPFR_RNDU);
+    this->add_error(mpfr_sqrt(this->m_mid.get_raw(), this->m_mid.get_raw(), MPFR_RNDN));
+}
+
+mpfr_ball mpfr_ball::log_value() const {
+    mpfr_ball result(*this);
+    result.to_log();
+    return result;
+}
+
+// |log(x) - log(a)| <= r / (a - r)
+void mpfr_ball::to_log() {
+    MPFR_DECL_INIT(lower, mpfr_ball::radius_precision);
+    mpfr_sub(lower, this->m_mid.get_raw(), this->m_rad.get_raw(), MPFR_RNDD);
+    if (mpfr_sgn(lower) <= 0) {
+        this->set_nan();
+        return;
+    }
+    mpfr_div(this->m_rad.get_raw(), this->m_rad.get_raw(), lower, MPFR_RNDU);
+    this->add_error(mpfr_log(this->m_mid.get_raw(), this->m_mid.get_raw(), MPFR_RNDN));
+}
+
+mpfr_ball mpfr_ball::exp_value() const {
+    mpfr_ball result(*this);
+    result.to_exp();
+    return result;
+}
+
+// |exp(x) - exp(a)| <= exp(a) (exp(r) - 1)
+void mpfr_ball::to_exp() {
+    MPFR_DECL_INIT(tmp, mpfr_ball::radius_precision);
+    mpfr_exp(tmp, this->m_mid.get_raw(), MPFR_RNDU);
+    mpfr_expm1(this->m_rad.get_raw(), this->m_rad.get_raw(), MPFR_RNDU);
+    mpfr_mul(this->m_rad.get_raw(), this->m_rad.get_raw(), tmp, MPFR_RNDU);
+    this->add_error(mpfr_exp(this->m_mid.get_raw(), this->m_mid.get_raw(), MPFR_RNDN));
+}
+
+const mpfr_class& mpfr_ball::get_mid() const {
+    return this->m_mid;
+}
+
+const mpfr_class& mpfr_ball::get_rad() const {
+    return this->m_rad;
+}
+
+// Upper bound of |x| over the ball.
+mpfr_class mpfr_ball::get_magnitude() const {
+    mpfr_class result = mpfr_ball::zero_radius();
+    mpfr_ball_abs_up(result.get_raw(), this->m_mid.get_raw());
+    mpfr_add(result.get_raw(), result.get_raw(), this->m_rad.get_raw(), MPFR_RNDU);
+    return result;
+}
+
+bool mpfr_ball::contains_zero() const {
+    return mpfr_cmpabs(this->m_mid.get_raw(), this->m_rad.get_raw()) <= 0;
+}
+
+mpfr_prec_t mpfr_ball::get_prec() const {
+    return mpfr_get_prec(this->m_mid.get_raw());
+}
+
+void mpfr_ball::set_prec(mpfr_prec_t prec) {
+    this->m_mid.set_prec(prec);
+    this->set_nan();
+}
+
+void mpfr_ball::round_prec(mpfr_prec_t prec) {
+    this->add_error(mpfr_prec_round(this->m_mid.get_raw(), prec, MPFR_RNDN));
+}
+
+bool mpfr_ball::is_nan() const {
+    return mpfr_nan_p(this->m_mid.get_raw()) || mpfr_nan_p(this->m_rad.get_raw());
+}
+
+bool mpfr_ball::is_inf() const {
+    return mpfr_inf_p(this->m_mid.get_raw()) || mpfr_inf_p(this->m_rad.get_raw());
+}
+
+bool mpfr_ball::is_number() const {
+    return !this->is_nan() && !this->is_inf();
+}
+
+bool mpfr_ball::is_zero() const {
+    return mpfr_zero_p(this->m_mid.get_raw()) && mpfr_zero_p(this->m_rad.get_raw());
+}
+
+void mpfr_ball::set_nan() {
+    mpfr_set_nan(this->m_mid.get_raw());
+    mpfr_set_zero(this->m_rad.get_raw(), 1);
+}
+
+void mpfr_ball::set_inf(int sign) {
+    mpfr_set_inf(this->m_mid.get_raw(), sign);
+    mpfr_set_zero(this->m_rad.get_raw(), 1);
+}
+
+void mpfr_ball::set_zero(int sign) {
+    mpfr_set_zero(this->m_mid.get_raw(), sign);
+    mpfr_set_zero(this->m_rad.get_raw(), 1);
+}
+
+void mpfr_ball::set_neg() {
+    mpfr_neg(this->m_mid.get_raw(), this->m_mid.get_raw(), MPFR_RNDN);
+}
+
+// Widens the radius by one ulp of the midpoint if it was rounded. An overflow
+// or underflow of the midpoint loses the enclosure.
+void mpfr_ball::add_error(const int ternary) {
+    if (ternary == 0) {
+        return;
+    }
+    if (!mpfr_regular_p(this->m_mid.get_raw())) {
+        mpfr_set_inf(this->m_rad.get_raw(), 1);
+        return;
+    }
+    MPFR_DECL_INIT(ulp, mpfr_ball::radius_precision);
+    mpfr_set_ui_2exp(ulp, 1, mpfr_get_exp(this->m_mid.get_raw()) - mpfr_get_prec(this->m_mid.get_raw()), MPFR_RNDU);
+    mpfr_add(this->m_rad.get_raw(), this->m_rad.get_raw(), ulp, MPFR_RNDU);
+}
+
+mpfr_class mpfr_ball::zero_radius() {
+    return mpfr_class(0, mpfr_ball::radius_precision, MPFR_RNDU);
+}
+
+void mpfr_ball::log_into(mpfr_ball& result, const mpfr_ball& value) {
+    result = value;
+    result.to_log();
+}
+
+void mpfr_ball::exp_into(mpfr_ball& result, const mpfr_ball& value) {
+    result = value;
+    result.to_exp();
+}
+
+void mpfr_ball::pow(mpfr_ball& result, const mpfr_ball& base, const mpfr_ball& exponent) {
+    result = base ^ exponent;
+}
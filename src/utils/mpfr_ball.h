@@ -0,0 +1,162 @@
+//
+//  mpfr_ball.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __MPFR_BALL_H__
+#define __MPFR_BALL_H__
+
+#include <mpfr.h>
+#include <iostream>
+#include <string>
+
+#include "mpfr_class.h"
+#include "mpfr_scalar_traits.h"
+
+// Midpoint-radius ball [mid - rad, mid + rad]. The midpoint is rounded to
+// nearest at the default precision, the radius is kept at a low precision and
+// rounded upwards so that every operation returns a ball containing all exact
+// results for arguments taken from the operand balls. Comparisons only look at
+// the midpoints.
+
+class mpfr_ball {
+
+private:
+
+    mpfr_class m_mid;
+    mpfr_class m_rad;
+
+public:
+
+    mpfr_ball();
+    mpfr_ball(const mpfr_ball& other);
+    mpfr_ball(mpfr_ball&& other) noexcept;
+    mpfr_ball(const int other);
+    mpfr_ball(const long int other);
+    mpfr_ball(const unsigned int other);
+    mpfr_ball(const unsigned long int other);
+    mpfr_ball(const double other);
+    mpfr_ball(const char *other);
+    mpfr_ball(const std::string& other);
+    explicit mpfr_ball(const mpfr_class& mid);
+    mpfr_ball(const mpfr_class& mid, const mpfr_class& rad);
+    ~mpfr_ball();
+
+    mpfr_ball& operator=(const mpfr_ball& other);
+    mpfr_ball& operator=(mpfr_ball&& other) noexcept;
+
+    friend mpfr_ball operator+(const mpfr_ball& left, const mpfr_ball& right);
+    mpfr_ball& operator+=(const mpfr_ball& other);
+    mpfr_ball operator+() const;
+
+    friend mpfr_ball operator-(const mpfr_ball& left, const mpfr_ball& right);
+    mpfr_ball& operator-=(const mpfr_ball& other);
+    mpfr_ball operator-() const;
+
+    friend mpfr_ball operator*(const mpfr_ball& left, const mpfr_ball& right);
+    mpfr_ball& operator*=(const mpfr_ball& other);
+
+    friend mpfr_ball operator/(const mpfr_ball& left, const mpfr_ball& right);
+    mpfr_ball& operator/=(const mpfr_ball& other);
+
+    friend mpfr_ball operator^(const mpfr_ball& left, const mpfr_ball& right);
+    friend mpfr_ball operator^(const mpfr_ball& left, const unsigned long int right);
+
+    friend bool operator==(const mpfr_ball& left, const mpfr_ball& right);
+    friend bool operator!=(const mpfr_ball& left, const mpfr_ball& right);
+    friend bool operator<(const mpfr_ball& left, const mpfr_ball& right);
+    friend bool operator<=(const mpfr_ball& left, const mpfr_ball& right);
+    friend bool operator>(const mpfr_ball& left, const mpfr_ball& right);
+    friend bool operator>=(const mpfr_ball& left, const mpfr_ball& right);
+
+    mpfr_ball& addmul(const mpfr_ball& left, const mpfr_ball& right);
+    mpfr_ball& submul(const mpfr_ball& left, const mpfr_ball& right);
+
+    friend std::ostream& operator<<(std::ostream& left, const mpfr_ball& right);
+
+    std::string get_str() const;
+    std::string get_str_with_format(std::string format) const;
+
+    mpfr_ball abs_value() const;
+    void to_abs();
+
+    mpfr_ball sqrt_value() const;
+    void to_sqrt();
+
+    mpfr_ball log_value() const;
+    void to_log();
+
+    mpfr_ball exp_value() const;
+    void to_exp();
+
+    const mpfr_class& get_mid() const;
+    const mpfr_class& get_rad() const;
+    mpfr_class get_magnitude() const;
+    bool contains_zero() const;
+
+    mpfr_prec_t get_prec() const;
+    void set_prec(mpfr_prec_t prec);
+    void round_prec(mpfr_prec_t prec);
+
+    bool is_nan() const;
+    bool is_inf() const;
+    bool is_number() const;
+    bool is_zero() const;
+
+    void set_nan();
+    void set_inf(int sign);
+    void set_zero(int sign);
+    void set_neg();
+
+private:
+
+    void add_error(const int ternary);
+
+public:
+
+    static const mpfr_prec_t radius_precision = 64;
+
+    static mpfr_class zero_radius();
+
+    static void log_into(mpfr_ball& result, const mpfr_ball& value);
+    static void exp_into(mpfr_ball& result, const mpfr_ball& value);
+    static void pow(mpfr_ball& result, const mpfr_ball& base, const mpfr_ball& exponent);
+
+}; // class mpfr_ball
+
+template <>
+struct mpfr_scalar_traits<mpfr_ball> {
+    static const bool is_fixed_prec = false;
+    static const mpfr_prec_t fixed_prec = 0;
+    static const bool is_mpfr = false;
+};
+
+// mpfr_ball has no expression templates; expressions written for mpfr_class
+// are evaluated eagerly.
+inline const mpfr_ball& mpfr_expr(const mpfr_ball& value) {
+    return value;
+}
+
+#endif // __MPFR_BALL_H__
@@ -0,0 +1,135 @@
+//
+//  mpfr_cache.cpp
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#include "mpfr_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+mpfr_cache::mpfr_cache() {
+    this->m_max_entries = mpfr_cache::default_max_entries;
+    this->m_statistics.n_hits = 0;
+    this->m_statistics.n_misses = 0;
+    this->m_statistics.n_flushes = 0;
+    this->m_statistics.n_entries = 0;
+}
+
+mpfr_cache::~mpfr_cache() {
+    this->clear_entries();
+}
+
+void mpfr_cache::constant(mpfr_ptr result, const constant_type constant, const mpfr_rnd_t rnd) {
+    if (constant == cache_literal) {
+        printf("mpfr_cache[%s:%d]: Literals have to be looked up by their string.\n", __FILE__, __LINE__);
+        abort();
+    }
+    this->lookup(result, constant, std::string(), rnd);
+}
+
+void mpfr_cache::literal(mpfr_ptr result, const std::string& literal, const mpfr_rnd_t rnd) {
+    this->lookup(result, cache_literal, literal, rnd);
+}
+
+void mpfr_cache::set_max_entries(const size_t max_entries) {
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    this->m_max_entries = (max_entries > 0) ? max_entries : 1;
+    if (this->m_entries.size() > this->m_max_entries) {
+        this->clear_entries();
+        ++this->m_statistics.n_flushes;
+    }
+}
+
+void mpfr_cache::flush() {
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    this->clear_entries();
+    ++this->m_statistics.n_flushes;
+}
+
+mpfr_cache_statistics mpfr_cache::get_statistics() {
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    mpfr_cache_statistics statistics = this->m_statistics;
+    statistics.n_entries = this->m_entries.size();
+    return statistics;
+}
+
+void mpfr_cache::lookup(mpfr_ptr result, const constant_type constant, const std::string& literal, const mpfr_rnd_t rnd) {
+    mpfr_prec_t prec = mpfr_get_prec(result);
+    key entry_key(constant, literal, prec, rnd);
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    std::map<key, mpfr_ptr>::iterator it = this->m_entries.find(entry_key);
+    if (it != this->m_entries.end()) {
+        ++this->m_statistics.n_hits;
+        mpfr_set(result, it->second, rnd);
+        return;
+    }
+    ++this->m_statistics.n_misses;
+    if (this->m_entries.size() >= this->m_max_entries) {
+        this->clear_entries();
+        ++this->m_statistics.n_flushes;
+    }
+    mpfr_ptr value = new __mpfr_struct;
+    mpfr_init2(value, prec);
+    switch (constant) {
+        case cache_log2: {
+            mpfr_const_log2(value, rnd);
+        } break;
+        case cache_pi: {
+            mpfr_const_pi(value, rnd);
+        } break;
+        case cache_euler: {
+            mpfr_const_euler(value, rnd);
+        } break;
+        case cache_catalan: {
+            mpfr_const_catalan(value, rnd);
+        } break;
+        case cache_literal: {
+            if (mpfr_set_str(value, literal.c_str(), 10, rnd) != 0) {
+                mpfr_set_nan(value);
+            }
+        } break;
+    }
+    this->m_entries.insert(std::make_pair(entry_key, value));
+    mpfr_set(result, value, rnd);
+}
+
+void mpfr_cache::clear_entries() {
+    for (std::map<key, mpfr_ptr>::iterator it = this->m_entries.begin(); it != this->m_entries.end(); ++it) {
+        mpfr_clear(it->second);
+        delete it->second;
+    }
+    this->m_entries.clear();
+}
+
+mpfr_cache& mpfr_cache::global() {
+    static mpfr_cache cache;
+    return cache;
+}
+
+void mpfr_cache::free_cache() {
+    mpfr_cache::global().flush();
+    mpfr_free_cache();
+}
@@ -0,0 +1,103 @@
+//
+//  mpfr_cache.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __MPFR_CACHE_H__
+#define __MPFR_CACHE_H__
+
+#include <stddef.h>
+#include <mutex>
+#include <map>
+#include <string>
+#include <tuple>
+#include <mpfr.h>
+
+// Process-wide cache of mathematical constants and decimal literals, keyed by
+// precision and rounding mode. A lookup rounds the cached value into the
+// destination, so it has to have the precision it was requested with. When
+// the cache is full it is flushed as a whole.
+
+typedef struct mpfr_cache_statistics {
+    size_t n_hits;
+    size_t n_misses;
+    size_t n_flushes;
+    size_t n_entries;
+} mpfr_cache_statistics;
+
+class mpfr_cache {
+
+public:
+
+    typedef enum constant_type {
+        cache_log2 = 0,
+        cache_pi = 1,
+        cache_euler = 2,
+        cache_catalan = 3,
+        cache_literal = 4
+    } constant_type;
+
+private:
+
+    typedef std::tuple<int, std::string, mpfr_prec_t, int> key;
+
+    std::mutex m_mutex;
+    std::map<key, mpfr_ptr> m_entries;
+    size_t m_max_entries;
+    mpfr_cache_statistics m_statistics;
+
+public:
+
+    mpfr_cache();
+    ~mpfr_cache();
+
+    mpfr_cache(const mpfr_cache& other) = delete;
+    mpfr_cache& operator=(const mpfr_cache& other) = delete;
+
+    void constant(mpfr_ptr result, const constant_type constant, const mpfr_rnd_t rnd);
+    void literal(mpfr_ptr result, const std::string& literal, const mpfr_rnd_t rnd);
+
+    void set_max_entries(const size_t max_entries);
+    void flush();
+
+    mpfr_cache_statistics get_statistics();
+
+private:
+
+    void lookup(mpfr_ptr result, const constant_type constant, const std::string& literal, const mpfr_rnd_t rnd);
+    void clear_entries();
+
+public:
+
+    static const size_t default_max_entries = 256;
+
+    static mpfr_cache& global();
+
+    // Also releases the caches MPFR keeps for the calling thread.
+    static void free_cache();
+
+}; // class mpfr_cache
+
+#endif // __MPFR_CACHE_H__
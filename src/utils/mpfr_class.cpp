@@ -26,77 +26,96 @@
 //
 
 #include "mpfr_class.h"
+#include "mpfr_cache.h"
+#include "mpfr_pool.h"
 
+#include <limits.h>
+#include <float.h>
 #include <iostream>
+#include <utility>
+
+static thread_local mpfr_prec_t tls_default_prec = DBL_MANT_DIG;
+static thread_local mpfr_rnd_t tls_default_rnd = MPFR_RNDN;
+static thread_local mpfr_precision_mode tls_precision_mode = mpfr_precision_default;
 
 mpfr_class::mpfr_class() {
-    mpfr_init2(this->m_raw, mpfr_class::get_default_prec());
+    mpfr_pool::init(this->m_raw, mpfr_class::get_default_prec());
     mpfr_set_nan(this->m_raw);
 }
 
 mpfr_class::mpfr_class(const mpfr_class& other) {
-    mpfr_init2(this->m_raw, mpfr_get_prec(other.m_raw));
+    mpfr_pool::init(this->m_raw, mpfr_get_prec(other.m_raw));
     mpfr_set(this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
 }
 
+mpfr_class::mpfr_class(mpfr_class&& other) noexcept {
+    if (other.m_shared) {
+        mpfr_pool::init(this->m_raw, mpfr_get_prec(other.m_raw));
+        mpfr_set(this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+        return;
+    }
+    this->set_uninitialized();
+    mpfr_swap(this->m_raw, other.m_raw);
+}
+
 mpfr_class::mpfr_class(const mpfr_ptr other) {
-    mpfr_init2(this->m_raw, mpfr_get_prec(other));
+    mpfr_pool::init(this->m_raw, mpfr_get_prec(other));
     mpfr_set(this->m_raw, other, mpfr_class::get_default_rnd());
 }
 
 mpfr_class::mpfr_class(const int other, const mpfr_prec_t prec, const mpfr_rnd_t rnd) {
-    mpfr_init2(this->m_raw, prec);
+    mpfr_pool::init(this->m_raw, prec);
     mpfr_set_si(this->m_raw, other, rnd);
 }
 
 mpfr_class::mpfr_class(const long int other, const mpfr_prec_t prec, const mpfr_rnd_t rnd) {
-    mpfr_init2(this->m_raw, prec);
+    mpfr_pool::init(this->m_raw, prec);
     mpfr_set_si(this->m_raw, other, rnd);
 }
 
 mpfr_class::mpfr_class(const long long int other, const mpfr_prec_t prec, const mpfr_rnd_t rnd) {
-    mpfr_init2(this->m_raw, prec);
+    mpfr_pool::init(this->m_raw, prec);
     mpfr_set_sj(this->m_raw, other, rnd);
 }
 
 mpfr_class::mpfr_class(const unsigned int other, const mpfr_prec_t prec, const mpfr_rnd_t rnd) {
-    mpfr_init2(this->m_raw, prec);
+    mpfr_pool::init(this->m_raw, prec);
     mpfr_set_ui(this->m_raw, other, rnd);
 }
 
 mpfr_class::mpfr_class(const unsigned long int other, const mpfr_prec_t prec, const mpfr_rnd_t rnd) {
-    mpfr_init2(this->m_raw, prec);
+    mpfr_pool::init(this->m_raw, prec);
     mpfr_set_ui(this->m_raw, other, rnd);
 }
 
 mpfr_class::mpfr_class(const unsigned long long int other, const mpfr_prec_t prec, const mpfr_rnd_t rnd) {
-    mpfr_init2(this->m_raw, prec);
+    mpfr_pool::init(this->m_raw, prec);
     mpfr_set_uj(this->m_raw, other, rnd);
 }
 
 mpfr_class::mpfr_class(const float other, const mpfr_prec_t prec, const mpfr_rnd_t rnd) {
-    mpfr_init2(this->m_raw, prec);
+    mpfr_pool::init(this->m_raw, prec);
     mpfr_set_flt(this->m_raw, other, rnd);
 }
 
 mpfr_class::mpfr_class(const double other, const mpfr_prec_t prec, const mpfr_rnd_t rnd) {
-    mpfr_init2(this->m_raw, prec);
+    mpfr_pool::init(this->m_raw, prec);
     mpfr_set_d(this->m_raw, other, rnd);
 }
 
 mpfr_class::mpfr_class(const long double other, const mpfr_prec_t prec, const mpfr_rnd_t rnd) {
-    mpfr_init2(this->m_raw, prec);
+    mpfr_pool::init(this->m_raw, prec);
     mpfr_set_ld(this->m_raw, other, rnd);
 }
 
 mpfr_class::mpfr_class(const char *other, const mpfr_prec_t prec, const int base, const mpfr_rnd_t rnd) {
-    mpfr_init2(this->m_raw, prec);
+    mpfr_pool::init(this->m_raw, prec);
     std::string tmp_other = other;
     this->set_str(tmp_other, base, rnd);
 }
 
 mpfr_class::mpfr_class(const std::string& other, const mpfr_prec_t prec, const int base, const mpfr_rnd_t rnd) {
-    mpfr_init2(this->m_raw, prec);
+    mpfr_pool::init(this->m_raw, prec);
     this->set_str(other, base, rnd);
 }
 
@@ -106,68 +125,80 @@ mpfr_class::~mpfr_class() {
 
 mpfr_class& mpfr_class::operator=(const mpfr_class& other) {
     if (&other != this) {
-        mpfr_set_prec(this->m_raw, mpfr_get_prec(other.m_raw));
+        this->reinit(mpfr_get_prec(other.m_raw));
         mpfr_set(this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
     }
     return *this;
 }
 
+mpfr_class& mpfr_class::operator=(mpfr_class&& other) noexcept {
+    if (&other != this) {
+        if (this->m_shared || other.m_shared) {
+            this->reinit(mpfr_get_prec(other.m_raw));
+            mpfr_set(this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+        } else {
+            mpfr_swap(this->m_raw, other.m_raw);
+        }
+    }
+    return *this;
+}
+
 mpfr_class& mpfr_class::operator=(const mpfr_ptr other) {
-    mpfr_set_prec(this->m_raw, mpfr_get_prec(other));
+    this->reinit(mpfr_get_prec(other));
     mpfr_set(this->m_raw, other, mpfr_class::get_default_rnd());
     return *this;
 }
 
 mpfr_class& mpfr_class::operator=(const int other) {
-    mpfr_init2(this->m_raw, mpfr_class::get_default_prec());
+    this->reinit(mpfr_class::get_default_prec());
     mpfr_set_si(this->m_raw, other, mpfr_class::get_default_rnd());
     return *this;
 }
 
 mpfr_class& mpfr_class::operator=(const long int other) {
-    mpfr_init2(this->m_raw, mpfr_class::get_default_prec());
+    this->reinit(mpfr_class::get_default_prec());
     mpfr_set_si(this->m_raw, other, mpfr_class::get_default_rnd());
     return *this;
 }
 
 mpfr_class& mpfr_class::operator=(const long long int other) {
-    mpfr_init2(this->m_raw, mpfr_class::get_default_prec());
+    this->reinit(mpfr_class::get_default_prec());
     mpfr_set_sj(this->m_raw, other, mpfr_class::get_default_rnd());
     return *this;
 }
 
 mpfr_class& mpfr_class::operator=(const unsigned int other) {
-    mpfr_init2(this->m_raw, mpfr_class::get_default_prec());
+    this->reinit(mpfr_class::get_default_prec());
     mpfr_set_ui(this->m_raw, other, mpfr_class::get_default_rnd());
     return *this;
 }
 
 mpfr_class& mpfr_class::operator=(const unsigned long int other) {
-    mpfr_init2(this->m_raw, mpfr_class::get_default_prec());
+    this->reinit(mpfr_class::get_default_prec());
     mpfr_set_ui(this->m_raw, other, mpfr_class::get_default_rnd());
     return *this;
 }
 
 mpfr_class& mpfr_class::operator=(const unsigned long long int other) {
-    mpfr_init2(this->m_raw, mpfr_class::get_default_prec());
+    this->reinit(mpfr_class::get_default_prec());
     mpfr_set_uj(this->m_raw, other, mpfr_class::get_default_rnd());
     return *this;
 }
 
 mpfr_class& mpfr_class::operator=(const float other) {
-    mpfr_init2(this->m_raw, mpfr_class::get_default_prec());
+    this->reinit(mpfr_class::get_default_prec());
     mpfr_set_flt(this->m_raw, other, mpfr_class::get_default_rnd());
     return *this;
 }
 
 mpfr_class& mpfr_class::operator=(const double other) {
-    mpfr_init2(this->m_raw, mpfr_class::get_default_prec());
+    this->reinit(mpfr_class::get_default_prec());
     mpfr_set_d(this->m_raw, other, mpfr_class::get_default_rnd());
     return *this;
 }
 
 mpfr_class& mpfr_class::operator=(const long double other) {
-    mpfr_init2(this->m_raw, mpfr_class::get_default_prec());
+    this->reinit(mpfr_class::get_default_prec());
     mpfr_set_ld(this->m_raw, other, mpfr_class::get_default_rnd());
     return *this;
 }
@@ -183,110 +214,303 @@ mpfr_class& mpfr_class::operator=(const std::string& other) {
     return *this;
 }
 
-mpfr_class mpfr_class::operator+(const mpfr_class& other) const {
+mpfr_class mpfr_class::operator+(const mpfr_class& other) const& {
     mpfr_class tmp = *this;
+    tmp.widen_prec(other.m_raw);
     mpfr_add(tmp.m_raw, tmp.m_raw, other.m_raw, mpfr_class::get_default_rnd());
     return tmp;
 }
 
-mpfr_class mpfr_class::operator+(const mpfr_ptr other) const {
-    mpfr_class tmp_other(other);
-    return this->operator+(tmp_other);
+mpfr_class mpfr_class::operator+(const mpfr_class& other) && {
+    this->widen_prec(other.m_raw);
+    mpfr_add(this->m_raw, this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator+(const mpfr_ptr other) const& {
+    mpfr_class tmp = *this;
+    tmp.widen_prec(other);
+    tmp += other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator+(const mpfr_ptr other) && {
+    this->widen_prec(other);
+    this->operator+=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator+(const int other) const& {
+    mpfr_class tmp = *this;
+    tmp += other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator+(const int other) && {
+    this->operator+=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator+(const long int other) const& {
+    mpfr_class tmp = *this;
+    tmp += other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator+(const long int other) && {
+    this->operator+=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator+(const long long int other) const& {
+    mpfr_class tmp = *this;
+    tmp += other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator+(const long long int other) && {
+    this->operator+=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator+(const unsigned int other) const& {
+    mpfr_class tmp = *this;
+    tmp += other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator+(const unsigned int other) && {
+    this->operator+=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator+(const unsigned long int other) const& {
+    mpfr_class tmp = *this;
+    tmp += other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator+(const unsigned long int other) && {
+    this->operator+=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator+(const unsigned long long int other) const& {
+    mpfr_class tmp = *this;
+    tmp += other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator+(const unsigned long long int other) && {
+    this->operator+=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator+(const float other) const& {
+    mpfr_class tmp = *this;
+    tmp += other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator+(const float other) && {
+    this->operator+=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator+(const double other) const& {
+    mpfr_class tmp = *this;
+    tmp += other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator+(const double other) && {
+    this->operator+=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator+(const long double other) const& {
+    mpfr_class tmp = *this;
+    tmp += other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator+(const long double other) && {
+    this->operator+=(other);
+    return std::move(*this);
+}
+
+mpfr_class operator+(const mpfr_class& left, mpfr_class&& right) {
+    if (mpfr_get_prec(left.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left.operator+(right);
+    }
+    mpfr_add(right.m_raw, left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator+(mpfr_class&& left, mpfr_class&& right) {
+    return std::move(left) + right;
 }
 
-mpfr_class mpfr_class::operator+(const int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator+(tmp_other);
+mpfr_class operator+(const mpfr_ptr left, mpfr_class&& right) {
+    if (mpfr_get_prec(left) != mpfr_get_prec(right.m_raw)) {
+        return left + static_cast<const mpfr_class&>(right);
+    }
+    mpfr_add(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator+(const int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left + static_cast<const mpfr_class&>(right);
+    }
+    mpfr_add_si(right.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator+(const long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator+(tmp_other);
+mpfr_class operator+(const long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left + static_cast<const mpfr_class&>(right);
+    }
+    mpfr_add_si(right.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator+(const long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator+(tmp_other);
+mpfr_class operator+(const long long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left + static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_add(right.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator+(const unsigned int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator+(tmp_other);
+mpfr_class operator+(const unsigned int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left + static_cast<const mpfr_class&>(right);
+    }
+    mpfr_add_ui(right.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator+(const unsigned long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator+(tmp_other);
+mpfr_class operator+(const unsigned long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left + static_cast<const mpfr_class&>(right);
+    }
+    mpfr_add_ui(right.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator+(const unsigned long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator+(tmp_other);
+mpfr_class operator+(const unsigned long long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left + static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_add(right.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator+(const float other) const {
-    mpfr_class tmp_other(other);
-    return this->operator+(tmp_other);
+mpfr_class operator+(const float left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left + static_cast<const mpfr_class&>(right);
+    }
+    mpfr_add_d(right.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator+(const double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator+(tmp_other);
+mpfr_class operator+(const double left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left + static_cast<const mpfr_class&>(right);
+    }
+    mpfr_add_d(right.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator+(const long double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator+(tmp_other);
+mpfr_class operator+(const long double left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left + static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_add(right.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
 mpfr_class operator+(const mpfr_ptr left, const mpfr_class& right) {
     mpfr_class tmp_left(left);
-    return tmp_left.operator+(right);
+    tmp_left.widen_prec(right.m_raw);
+    mpfr_add(tmp_left.m_raw, tmp_left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp_left;
 }
 
 mpfr_class operator+(const int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator+(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_add_si(tmp.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator+(const long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator+(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_add_si(tmp.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator+(const long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator+(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_add(tmp.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator+(const unsigned int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator+(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_add_ui(tmp.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator+(const unsigned long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator+(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_add_ui(tmp.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator+(const unsigned long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator+(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_add(tmp.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator+(const float left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator+(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_add_d(tmp.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator+(const double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator+(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_add_d(tmp.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator+(const long double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator+(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_add(tmp.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class& mpfr_class::operator+=(const mpfr_class& other) {
@@ -295,53 +519,59 @@ mpfr_class& mpfr_class::operator+=(const mpfr_class& other) {
 }
 
 mpfr_class& mpfr_class::operator+=(const mpfr_ptr other) {
-    mpfr_class tmp_other(other);
-    return this->operator+=(tmp_other);
+    mpfr_add(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator+=(const int other) {
-    mpfr_class tmp_other(other);
-    return this->operator+=(tmp_other);
+    mpfr_add_si(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator+=(const long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator+=(tmp_other);
+    mpfr_add_si(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator+=(const long long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator+=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_add(this->m_raw, this->m_raw, tmp_other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator+=(const unsigned int other) {
-    mpfr_class tmp_other(other);
-    return this->operator+=(tmp_other);
+    mpfr_add_ui(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator+=(const unsigned long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator+=(tmp_other);
+    mpfr_add_ui(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator+=(const unsigned long long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator+=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_add(this->m_raw, this->m_raw, tmp_other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator+=(const float other) {
-    mpfr_class tmp_other(other);
-    return this->operator+=(tmp_other);
+    mpfr_add_d(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator+=(const double other) {
-    mpfr_class tmp_other(other);
-    return this->operator+=(tmp_other);
+    mpfr_add_d(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator+=(const long double other) {
-    mpfr_class tmp_other(other);
-    return this->operator+=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_add(this->m_raw, this->m_raw, tmp_other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class mpfr_class::operator+() const {
@@ -358,110 +588,303 @@ mpfr_class& mpfr_class::operator++() {
     return this->operator+=((unsigned int)1);
 }
 
-mpfr_class mpfr_class::operator-(const mpfr_class& other) const {
+mpfr_class mpfr_class::operator-(const mpfr_class& other) const& {
     mpfr_class tmp = *this;
+    tmp.widen_prec(other.m_raw);
     mpfr_sub(tmp.m_raw, tmp.m_raw, other.m_raw, mpfr_class::get_default_rnd());
     return tmp;
 }
 
-mpfr_class mpfr_class::operator-(const mpfr_ptr other) const {
-    mpfr_class tmp_other(other);
-    return this->operator-(tmp_other);
+mpfr_class mpfr_class::operator-(const mpfr_class& other) && {
+    this->widen_prec(other.m_raw);
+    mpfr_sub(this->m_raw, this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator-(const mpfr_ptr other) const& {
+    mpfr_class tmp = *this;
+    tmp.widen_prec(other);
+    tmp -= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator-(const mpfr_ptr other) && {
+    this->widen_prec(other);
+    this->operator-=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator-(const int other) const& {
+    mpfr_class tmp = *this;
+    tmp -= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator-(const int other) && {
+    this->operator-=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator-(const long int other) const& {
+    mpfr_class tmp = *this;
+    tmp -= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator-(const long int other) && {
+    this->operator-=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator-(const long long int other) const& {
+    mpfr_class tmp = *this;
+    tmp -= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator-(const long long int other) && {
+    this->operator-=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator-(const unsigned int other) const& {
+    mpfr_class tmp = *this;
+    tmp -= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator-(const unsigned int other) && {
+    this->operator-=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator-(const unsigned long int other) const& {
+    mpfr_class tmp = *this;
+    tmp -= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator-(const unsigned long int other) && {
+    this->operator-=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator-(const unsigned long long int other) const& {
+    mpfr_class tmp = *this;
+    tmp -= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator-(const unsigned long long int other) && {
+    this->operator-=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator-(const float other) const& {
+    mpfr_class tmp = *this;
+    tmp -= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator-(const float other) && {
+    this->operator-=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator-(const double other) const& {
+    mpfr_class tmp = *this;
+    tmp -= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator-(const double other) && {
+    this->operator-=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator-(const long double other) const& {
+    mpfr_class tmp = *this;
+    tmp -= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator-(const long double other) && {
+    this->operator-=(other);
+    return std::move(*this);
+}
+
+mpfr_class operator-(const mpfr_class& left, mpfr_class&& right) {
+    if (mpfr_get_prec(left.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left.operator-(right);
+    }
+    mpfr_sub(right.m_raw, left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator-(mpfr_class&& left, mpfr_class&& right) {
+    return std::move(left) - right;
+}
+
+mpfr_class operator-(const mpfr_ptr left, mpfr_class&& right) {
+    if (mpfr_get_prec(left) != mpfr_get_prec(right.m_raw)) {
+        return left - static_cast<const mpfr_class&>(right);
+    }
+    mpfr_sub(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator-(const int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator-(tmp_other);
+mpfr_class operator-(const int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left - static_cast<const mpfr_class&>(right);
+    }
+    mpfr_si_sub(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator-(const long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator-(tmp_other);
+mpfr_class operator-(const long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left - static_cast<const mpfr_class&>(right);
+    }
+    mpfr_si_sub(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator-(const long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator-(tmp_other);
+mpfr_class operator-(const long long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left - static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_sub(right.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator-(const unsigned int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator-(tmp_other);
+mpfr_class operator-(const unsigned int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left - static_cast<const mpfr_class&>(right);
+    }
+    mpfr_ui_sub(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator-(const unsigned long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator-(tmp_other);
+mpfr_class operator-(const unsigned long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left - static_cast<const mpfr_class&>(right);
+    }
+    mpfr_ui_sub(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator-(const unsigned long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator-(tmp_other);
+mpfr_class operator-(const unsigned long long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left - static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_sub(right.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator-(const float other) const {
-    mpfr_class tmp_other(other);
-    return this->operator-(tmp_other);
+mpfr_class operator-(const float left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left - static_cast<const mpfr_class&>(right);
+    }
+    mpfr_d_sub(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator-(const double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator-(tmp_other);
+mpfr_class operator-(const double left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left - static_cast<const mpfr_class&>(right);
+    }
+    mpfr_d_sub(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator-(const long double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator-(tmp_other);
+mpfr_class operator-(const long double left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left - static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_sub(right.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
 mpfr_class operator-(const mpfr_ptr left, const mpfr_class& right) {
     mpfr_class tmp_left(left);
-    return tmp_left.operator-(right);
+    tmp_left.widen_prec(right.m_raw);
+    mpfr_sub(tmp_left.m_raw, tmp_left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp_left;
 }
 
 mpfr_class operator-(const int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator-(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_si_sub(tmp.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator-(const long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator-(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_si_sub(tmp.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator-(const long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator-(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_sub(tmp.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator-(const unsigned int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator-(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_ui_sub(tmp.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator-(const unsigned long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator-(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_ui_sub(tmp.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator-(const unsigned long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator-(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_sub(tmp.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator-(const float left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator-(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_d_sub(tmp.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator-(const double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator-(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_d_sub(tmp.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator-(const long double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator-(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_sub(tmp.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class& mpfr_class::operator-=(const mpfr_class& other) {
@@ -470,61 +893,72 @@ mpfr_class& mpfr_class::operator-=(const mpfr_class& other) {
 }
 
 mpfr_class& mpfr_class::operator-=(const mpfr_ptr other) {
-    mpfr_class tmp_other(other);
-    return this->operator-=(tmp_other);
+    mpfr_sub(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator-=(const int other) {
-    mpfr_class tmp_other(other);
-    return this->operator-=(tmp_other);
+    mpfr_sub_si(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator-=(const long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator-=(tmp_other);
+    mpfr_sub_si(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator-=(const long long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator-=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_sub(this->m_raw, this->m_raw, tmp_other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator-=(const unsigned int other) {
-    mpfr_class tmp_other(other);
-    return this->operator-=(tmp_other);
+    mpfr_sub_ui(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator-=(const unsigned long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator-=(tmp_other);
+    mpfr_sub_ui(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator-=(const unsigned long long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator-=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_sub(this->m_raw, this->m_raw, tmp_other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator-=(const float other) {
-    mpfr_class tmp_other(other);
-    return this->operator-=(tmp_other);
+    mpfr_sub_d(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator-=(const double other) {
-    mpfr_class tmp_other(other);
-    return this->operator-=(tmp_other);
+    mpfr_sub_d(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator-=(const long double other) {
-    mpfr_class tmp_other(other);
-    return this->operator-=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_sub(this->m_raw, this->m_raw, tmp_other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
-mpfr_class mpfr_class::operator-() const {
+mpfr_class mpfr_class::operator-() const& {
     mpfr_class tmp = *this;
     tmp.set_neg();
     return tmp;
 }
 
+mpfr_class mpfr_class::operator-() && {
+    this->set_neg();
+    return std::move(*this);
+}
+
 mpfr_class mpfr_class::operator--(int) {
     mpfr_class tmp = *this;
     this->operator-=((unsigned int)1);
@@ -535,110 +969,303 @@ mpfr_class& mpfr_class::operator--() {
     return this->operator-=((unsigned int)1);
 }
 
-mpfr_class mpfr_class::operator*(const mpfr_class& other) const {
+mpfr_class mpfr_class::operator*(const mpfr_class& other) const& {
     mpfr_class tmp = *this;
+    tmp.widen_prec(other.m_raw);
     mpfr_mul(tmp.m_raw, tmp.m_raw, other.m_raw, mpfr_class::get_default_rnd());
     return tmp;
 }
 
-mpfr_class mpfr_class::operator*(const mpfr_ptr other) const {
-    mpfr_class tmp_other(other);
-    return this->operator*(tmp_other);
+mpfr_class mpfr_class::operator*(const mpfr_class& other) && {
+    this->widen_prec(other.m_raw);
+    mpfr_mul(this->m_raw, this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+    return std::move(*this);
 }
 
-mpfr_class mpfr_class::operator*(const int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator*(tmp_other);
+mpfr_class mpfr_class::operator*(const mpfr_ptr other) const& {
+    mpfr_class tmp = *this;
+    tmp.widen_prec(other);
+    tmp *= other;
+    return tmp;
 }
 
-mpfr_class mpfr_class::operator*(const long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator*(tmp_other);
+mpfr_class mpfr_class::operator*(const mpfr_ptr other) && {
+    this->widen_prec(other);
+    this->operator*=(other);
+    return std::move(*this);
 }
 
-mpfr_class mpfr_class::operator*(const long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator*(tmp_other);
+mpfr_class mpfr_class::operator*(const int other) const& {
+    mpfr_class tmp = *this;
+    tmp *= other;
+    return tmp;
 }
 
-mpfr_class mpfr_class::operator*(const unsigned int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator*(tmp_other);
+mpfr_class mpfr_class::operator*(const int other) && {
+    this->operator*=(other);
+    return std::move(*this);
 }
 
-mpfr_class mpfr_class::operator*(const unsigned long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator*(tmp_other);
+mpfr_class mpfr_class::operator*(const long int other) const& {
+    mpfr_class tmp = *this;
+    tmp *= other;
+    return tmp;
 }
 
-mpfr_class mpfr_class::operator*(const unsigned long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator*(tmp_other);
+mpfr_class mpfr_class::operator*(const long int other) && {
+    this->operator*=(other);
+    return std::move(*this);
 }
 
-mpfr_class mpfr_class::operator*(const float other) const {
-    mpfr_class tmp_other(other);
-    return this->operator*(tmp_other);
+mpfr_class mpfr_class::operator*(const long long int other) const& {
+    mpfr_class tmp = *this;
+    tmp *= other;
+    return tmp;
 }
 
-mpfr_class mpfr_class::operator*(const double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator*(tmp_other);
+mpfr_class mpfr_class::operator*(const long long int other) && {
+    this->operator*=(other);
+    return std::move(*this);
 }
 
-mpfr_class mpfr_class::operator*(const long double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator*(tmp_other);
+mpfr_class mpfr_class::operator*(const unsigned int other) const& {
+    mpfr_class tmp = *this;
+    tmp *= other;
+    return tmp;
 }
 
-mpfr_class operator*(const mpfr_ptr left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator*(right);
+mpfr_class mpfr_class::operator*(const unsigned int other) && {
+    this->operator*=(other);
+    return std::move(*this);
 }
 
-mpfr_class operator*(const int left, const mpfr_class& right) {
+mpfr_class mpfr_class::operator*(const unsigned long int other) const& {
+    mpfr_class tmp = *this;
+    tmp *= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator*(const unsigned long int other) && {
+    this->operator*=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator*(const unsigned long long int other) const& {
+    mpfr_class tmp = *this;
+    tmp *= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator*(const unsigned long long int other) && {
+    this->operator*=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator*(const float other) const& {
+    mpfr_class tmp = *this;
+    tmp *= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator*(const float other) && {
+    this->operator*=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator*(const double other) const& {
+    mpfr_class tmp = *this;
+    tmp *= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator*(const double other) && {
+    this->operator*=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator*(const long double other) const& {
+    mpfr_class tmp = *this;
+    tmp *= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator*(const long double other) && {
+    this->operator*=(other);
+    return std::move(*this);
+}
+
+mpfr_class operator*(const mpfr_class& left, mpfr_class&& right) {
+    if (mpfr_get_prec(left.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left.operator*(right);
+    }
+    mpfr_mul(right.m_raw, left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator*(mpfr_class&& left, mpfr_class&& right) {
+    return std::move(left) * right;
+}
+
+mpfr_class operator*(const mpfr_ptr left, mpfr_class&& right) {
+    if (mpfr_get_prec(left) != mpfr_get_prec(right.m_raw)) {
+        return left * static_cast<const mpfr_class&>(right);
+    }
+    mpfr_mul(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator*(const int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left * static_cast<const mpfr_class&>(right);
+    }
+    mpfr_mul_si(right.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator*(const long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left * static_cast<const mpfr_class&>(right);
+    }
+    mpfr_mul_si(right.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator*(const long long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left * static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_mul(right.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator*(const unsigned int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left * static_cast<const mpfr_class&>(right);
+    }
+    mpfr_mul_ui(right.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator*(const unsigned long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left * static_cast<const mpfr_class&>(right);
+    }
+    mpfr_mul_ui(right.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator*(const unsigned long long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left * static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_mul(right.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator*(const float left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left * static_cast<const mpfr_class&>(right);
+    }
+    mpfr_mul_d(right.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator*(const double left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left * static_cast<const mpfr_class&>(right);
+    }
+    mpfr_mul_d(right.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator*(const long double left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left * static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_mul(right.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator*(const mpfr_ptr left, const mpfr_class& right) {
     mpfr_class tmp_left(left);
-    return tmp_left.operator*(right);
+    tmp_left.widen_prec(right.m_raw);
+    mpfr_mul(tmp_left.m_raw, tmp_left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp_left;
+}
+
+mpfr_class operator*(const int left, const mpfr_class& right) {
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_mul_si(tmp.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator*(const long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator*(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_mul_si(tmp.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator*(const long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator*(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_mul(tmp.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator*(const unsigned int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator*(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_mul_ui(tmp.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator*(const unsigned long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator*(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_mul_ui(tmp.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator*(const unsigned long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator*(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_mul(tmp.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator*(const float left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator*(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_mul_d(tmp.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator*(const double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator*(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_mul_d(tmp.m_raw, right.m_raw, left, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator*(const long double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator*(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_mul(tmp.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class& mpfr_class::operator*=(const mpfr_class& other) {
@@ -647,159 +1274,358 @@ mpfr_class& mpfr_class::operator*=(const mpfr_class& other) {
 }
 
 mpfr_class& mpfr_class::operator*=(const mpfr_ptr other) {
-    mpfr_class tmp_other(other);
-    return this->operator*=(tmp_other);
+    mpfr_mul(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator*=(const int other) {
-    mpfr_class tmp_other(other);
-    return this->operator*=(tmp_other);
+    mpfr_mul_si(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator*=(const long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator*=(tmp_other);
+    mpfr_mul_si(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator*=(const long long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator*=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_mul(this->m_raw, this->m_raw, tmp_other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator*=(const unsigned int other) {
-    mpfr_class tmp_other(other);
-    return this->operator*=(tmp_other);
+    mpfr_mul_ui(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator*=(const unsigned long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator*=(tmp_other);
+    mpfr_mul_ui(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator*=(const unsigned long long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator*=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_mul(this->m_raw, this->m_raw, tmp_other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator*=(const float other) {
-    mpfr_class tmp_other(other);
-    return this->operator*=(tmp_other);
+    mpfr_mul_d(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator*=(const double other) {
-    mpfr_class tmp_other(other);
-    return this->operator*=(tmp_other);
+    mpfr_mul_d(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator*=(const long double other) {
-    mpfr_class tmp_other(other);
-    return this->operator*=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_mul(this->m_raw, this->m_raw, tmp_other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
-mpfr_class mpfr_class::operator/(const mpfr_class& other) const {
+mpfr_class mpfr_class::operator/(const mpfr_class& other) const& {
     mpfr_class tmp = *this;
+    tmp.widen_prec(other.m_raw);
     mpfr_div(tmp.m_raw, tmp.m_raw, other.m_raw, mpfr_class::get_default_rnd());
     return tmp;
 }
 
-mpfr_class mpfr_class::operator/(const mpfr_ptr other) const {
-    mpfr_class tmp_other(other);
-    return this->operator/(tmp_other);
+mpfr_class mpfr_class::operator/(const mpfr_class& other) && {
+    this->widen_prec(other.m_raw);
+    mpfr_div(this->m_raw, this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator/(const mpfr_ptr other) const& {
+    mpfr_class tmp = *this;
+    tmp.widen_prec(other);
+    tmp /= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator/(const mpfr_ptr other) && {
+    this->widen_prec(other);
+    this->operator/=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator/(const int other) const& {
+    mpfr_class tmp = *this;
+    tmp /= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator/(const int other) && {
+    this->operator/=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator/(const long int other) const& {
+    mpfr_class tmp = *this;
+    tmp /= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator/(const long int other) && {
+    this->operator/=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator/(const long long int other) const& {
+    mpfr_class tmp = *this;
+    tmp /= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator/(const long long int other) && {
+    this->operator/=(other);
+    return std::move(*this);
 }
 
-mpfr_class mpfr_class::operator/(const int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator/(tmp_other);
+mpfr_class mpfr_class::operator/(const unsigned int other) const& {
+    mpfr_class tmp = *this;
+    tmp /= other;
+    return tmp;
 }
 
-mpfr_class mpfr_class::operator/(const long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator/(tmp_other);
+mpfr_class mpfr_class::operator/(const unsigned int other) && {
+    this->operator/=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator/(const unsigned long int other) const& {
+    mpfr_class tmp = *this;
+    tmp /= other;
+    return tmp;
 }
 
-mpfr_class mpfr_class::operator/(const long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator/(tmp_other);
+mpfr_class mpfr_class::operator/(const unsigned long int other) && {
+    this->operator/=(other);
+    return std::move(*this);
 }
 
-mpfr_class mpfr_class::operator/(const unsigned int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator/(tmp_other);
+mpfr_class mpfr_class::operator/(const unsigned long long int other) const& {
+    mpfr_class tmp = *this;
+    tmp /= other;
+    return tmp;
 }
 
-mpfr_class mpfr_class::operator/(const unsigned long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator/(tmp_other);
+mpfr_class mpfr_class::operator/(const unsigned long long int other) && {
+    this->operator/=(other);
+    return std::move(*this);
 }
 
-mpfr_class mpfr_class::operator/(const unsigned long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator/(tmp_other);
+mpfr_class mpfr_class::operator/(const float other) const& {
+    mpfr_class tmp = *this;
+    tmp /= other;
+    return tmp;
 }
 
-mpfr_class mpfr_class::operator/(const float other) const {
-    mpfr_class tmp_other(other);
-    return this->operator/(tmp_other);
+mpfr_class mpfr_class::operator/(const float other) && {
+    this->operator/=(other);
+    return std::move(*this);
 }
 
-mpfr_class mpfr_class::operator/(const double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator/(tmp_other);
+mpfr_class mpfr_class::operator/(const double other) const& {
+    mpfr_class tmp = *this;
+    tmp /= other;
+    return tmp;
 }
 
-mpfr_class mpfr_class::operator/(const long double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator/(tmp_other);
+mpfr_class mpfr_class::operator/(const double other) && {
+    this->operator/=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator/(const long double other) const& {
+    mpfr_class tmp = *this;
+    tmp /= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator/(const long double other) && {
+    this->operator/=(other);
+    return std::move(*this);
+}
+
+mpfr_class operator/(const mpfr_class& left, mpfr_class&& right) {
+    if (mpfr_get_prec(left.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left.operator/(right);
+    }
+    mpfr_div(right.m_raw, left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator/(mpfr_class&& left, mpfr_class&& right) {
+    return std::move(left) / right;
+}
+
+mpfr_class operator/(const mpfr_ptr left, mpfr_class&& right) {
+    if (mpfr_get_prec(left) != mpfr_get_prec(right.m_raw)) {
+        return left / static_cast<const mpfr_class&>(right);
+    }
+    mpfr_div(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator/(const int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left / static_cast<const mpfr_class&>(right);
+    }
+    mpfr_si_div(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator/(const long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left / static_cast<const mpfr_class&>(right);
+    }
+    mpfr_si_div(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator/(const long long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left / static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_div(right.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator/(const unsigned int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left / static_cast<const mpfr_class&>(right);
+    }
+    mpfr_ui_div(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator/(const unsigned long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left / static_cast<const mpfr_class&>(right);
+    }
+    mpfr_ui_div(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator/(const unsigned long long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left / static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_div(right.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator/(const float left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left / static_cast<const mpfr_class&>(right);
+    }
+    mpfr_d_div(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator/(const double left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left / static_cast<const mpfr_class&>(right);
+    }
+    mpfr_d_div(right.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
+}
+
+mpfr_class operator/(const long double left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left / static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_div(right.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return std::move(right);
 }
 
 mpfr_class operator/(const mpfr_ptr left, const mpfr_class& right) {
     mpfr_class tmp_left(left);
-    return tmp_left.operator/(right);
+    tmp_left.widen_prec(right.m_raw);
+    mpfr_div(tmp_left.m_raw, tmp_left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp_left;
 }
 
 mpfr_class operator/(const int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator/(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_si_div(tmp.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator/(const long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator/(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_si_div(tmp.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator/(const long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator/(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_div(tmp.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator/(const unsigned int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator/(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_ui_div(tmp.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator/(const unsigned long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator/(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_ui_div(tmp.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator/(const unsigned long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator/(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_div(tmp.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator/(const float left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator/(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_d_div(tmp.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator/(const double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator/(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    mpfr_d_div(tmp.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class operator/(const long double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator/(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_div(tmp.m_raw, tmp_left, right.m_raw, mpfr_class::get_default_rnd());
+    return tmp;
 }
 
 mpfr_class& mpfr_class::operator/=(const mpfr_class& other) {
@@ -808,214 +1634,455 @@ mpfr_class& mpfr_class::operator/=(const mpfr_class& other) {
 }
 
 mpfr_class& mpfr_class::operator/=(const mpfr_ptr other) {
-    mpfr_class tmp_other(other);
-    return this->operator/=(tmp_other);
+    mpfr_div(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
+}
+
+mpfr_class& mpfr_class::operator/=(const int other) {
+    mpfr_div_si(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
+}
+
+mpfr_class& mpfr_class::operator/=(const long int other) {
+    mpfr_div_si(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
+}
+
+mpfr_class& mpfr_class::operator/=(const long long int other) {
+    MPFR_DECL_INIT(tmp_other, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_div(this->m_raw, this->m_raw, tmp_other, mpfr_class::get_default_rnd());
+    return *this;
+}
+
+mpfr_class& mpfr_class::operator/=(const unsigned int other) {
+    mpfr_div_ui(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
+}
+
+mpfr_class& mpfr_class::operator/=(const unsigned long int other) {
+    mpfr_div_ui(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
+}
+
+mpfr_class& mpfr_class::operator/=(const unsigned long long int other) {
+    MPFR_DECL_INIT(tmp_other, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_div(this->m_raw, this->m_raw, tmp_other, mpfr_class::get_default_rnd());
+    return *this;
+}
+
+mpfr_class& mpfr_class::operator/=(const float other) {
+    mpfr_div_d(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
+}
+
+mpfr_class& mpfr_class::operator/=(const double other) {
+    mpfr_div_d(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
+}
+
+mpfr_class& mpfr_class::operator/=(const long double other) {
+    MPFR_DECL_INIT(tmp_other, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_div(this->m_raw, this->m_raw, tmp_other, mpfr_class::get_default_rnd());
+    return *this;
+}
+
+mpfr_class mpfr_class::operator^(const mpfr_class& other) const& {
+    mpfr_class tmp = *this;
+    tmp.widen_prec(other.m_raw);
+    mpfr_class::pow_raw(tmp.m_raw, tmp.m_raw, other.m_raw);
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator^(const mpfr_class& other) && {
+    this->widen_prec(other.m_raw);
+    mpfr_class::pow_raw(this->m_raw, this->m_raw, other.m_raw);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator^(const mpfr_ptr other) const& {
+    mpfr_class tmp = *this;
+    tmp.widen_prec(other);
+    tmp ^= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator^(const mpfr_ptr other) && {
+    this->widen_prec(other);
+    this->operator^=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator^(const int other) const& {
+    mpfr_class tmp = *this;
+    tmp ^= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator^(const int other) && {
+    this->operator^=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator^(const long int other) const& {
+    mpfr_class tmp = *this;
+    tmp ^= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator^(const long int other) && {
+    this->operator^=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator^(const long long int other) const& {
+    mpfr_class tmp = *this;
+    tmp ^= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator^(const long long int other) && {
+    this->operator^=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator^(const unsigned int other) const& {
+    mpfr_class tmp = *this;
+    tmp ^= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator^(const unsigned int other) && {
+    this->operator^=(other);
+    return std::move(*this);
+}
+
+mpfr_class mpfr_class::operator^(const unsigned long int other) const& {
+    mpfr_class tmp = *this;
+    tmp ^= other;
+    return tmp;
+}
+
+mpfr_class mpfr_class::operator^(const unsigned long int other) && {
+    this->operator^=(other);
+    return std::move(*this);
 }
 
-mpfr_class& mpfr_class::operator/=(const int other) {
-    mpfr_class tmp_other(other);
-    return this->operator/=(tmp_other);
+mpfr_class mpfr_class::operator^(const unsigned long long int other) const& {
+    mpfr_class tmp = *this;
+    tmp ^= other;
+    return tmp;
 }
 
-mpfr_class& mpfr_class::operator/=(const long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator/=(tmp_other);
+mpfr_class mpfr_class::operator^(const unsigned long long int other) && {
+    this->operator^=(other);
+    return std::move(*this);
 }
 
-mpfr_class& mpfr_class::operator/=(const long long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator/=(tmp_other);
+mpfr_class mpfr_class::operator^(const float other) const& {
+    mpfr_class tmp = *this;
+    tmp ^= other;
+    return tmp;
 }
 
-mpfr_class& mpfr_class::operator/=(const unsigned int other) {
-    mpfr_class tmp_other(other);
-    return this->operator/=(tmp_other);
+mpfr_class mpfr_class::operator^(const float other) && {
+    this->operator^=(other);
+    return std::move(*this);
 }
 
-mpfr_class& mpfr_class::operator/=(const unsigned long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator/=(tmp_other);
+mpfr_class mpfr_class::operator^(const double other) const& {
+    mpfr_class tmp = *this;
+    tmp ^= other;
+    return tmp;
 }
 
-mpfr_class& mpfr_class::operator/=(const unsigned long long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator/=(tmp_other);
+mpfr_class mpfr_class::operator^(const double other) && {
+    this->operator^=(other);
+    return std::move(*this);
 }
 
-mpfr_class& mpfr_class::operator/=(const float other) {
-    mpfr_class tmp_other(other);
-    return this->operator/=(tmp_other);
+mpfr_class mpfr_class::operator^(const long double other) const& {
+    mpfr_class tmp = *this;
+    tmp ^= other;
+    return tmp;
 }
 
-mpfr_class& mpfr_class::operator/=(const double other) {
-    mpfr_class tmp_other(other);
-    return this->operator/=(tmp_other);
+mpfr_class mpfr_class::operator^(const long double other) && {
+    this->operator^=(other);
+    return std::move(*this);
 }
 
-mpfr_class& mpfr_class::operator/=(const long double other) {
-    mpfr_class tmp_other(other);
-    return this->operator/=(tmp_other);
+mpfr_class operator^(const mpfr_class& left, mpfr_class&& right) {
+    if (mpfr_get_prec(left.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left.operator^(right);
+    }
+    mpfr_class::pow_raw(right.m_raw, left.m_raw, right.m_raw);
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator^(const mpfr_class& other) const {
-    mpfr_class tmp = *this;
-    mpfr_pow(tmp.m_raw, tmp.m_raw, other.m_raw, mpfr_class::get_default_rnd());
-    return tmp;
+mpfr_class operator^(mpfr_class&& left, mpfr_class&& right) {
+    return std::move(left) ^ right;
 }
 
-mpfr_class mpfr_class::operator^(const mpfr_ptr other) const {
-    mpfr_class tmp_other(other);
-    return this->operator^(tmp_other);
+mpfr_class operator^(const mpfr_ptr left, mpfr_class&& right) {
+    if (mpfr_get_prec(left) != mpfr_get_prec(right.m_raw)) {
+        return left ^ static_cast<const mpfr_class&>(right);
+    }
+    mpfr_class::pow_raw(right.m_raw, left, right.m_raw);
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator^(const int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator^(tmp_other);
+mpfr_class operator^(const int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left ^ static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(long int) * CHAR_BIT);
+    mpfr_set_si(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(right.m_raw, tmp_left, right.m_raw);
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator^(const long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator^(tmp_other);
+mpfr_class operator^(const long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left ^ static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(long int) * CHAR_BIT);
+    mpfr_set_si(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(right.m_raw, tmp_left, right.m_raw);
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator^(const long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator^(tmp_other);
+mpfr_class operator^(const long long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left ^ static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(right.m_raw, tmp_left, right.m_raw);
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator^(const unsigned int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator^(tmp_other);
+mpfr_class operator^(const unsigned int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left ^ static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(long int) * CHAR_BIT);
+    mpfr_set_ui(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(right.m_raw, tmp_left, right.m_raw);
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator^(const unsigned long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator^(tmp_other);
+mpfr_class operator^(const unsigned long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left ^ static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(long int) * CHAR_BIT);
+    mpfr_set_ui(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(right.m_raw, tmp_left, right.m_raw);
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator^(const unsigned long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator^(tmp_other);
+mpfr_class operator^(const unsigned long long int left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left ^ static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(right.m_raw, tmp_left, right.m_raw);
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator^(const float other) const {
-    mpfr_class tmp_other(other);
-    return this->operator^(tmp_other);
+mpfr_class operator^(const float left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left ^ static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, DBL_MANT_DIG);
+    mpfr_set_d(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(right.m_raw, tmp_left, right.m_raw);
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator^(const double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator^(tmp_other);
+mpfr_class operator^(const double left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left ^ static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, DBL_MANT_DIG);
+    mpfr_set_d(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(right.m_raw, tmp_left, right.m_raw);
+    return std::move(right);
 }
 
-mpfr_class mpfr_class::operator^(const long double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator^(tmp_other);
+mpfr_class operator^(const long double left, mpfr_class&& right) {
+    if (mpfr_class::result_prec(right.m_raw) != mpfr_get_prec(right.m_raw)) {
+        return left ^ static_cast<const mpfr_class&>(right);
+    }
+    MPFR_DECL_INIT(tmp_left, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(right.m_raw, tmp_left, right.m_raw);
+    return std::move(right);
 }
 
 mpfr_class operator^(const mpfr_ptr left, const mpfr_class& right) {
     mpfr_class tmp_left(left);
-    return tmp_left.operator^(right);
+    tmp_left.widen_prec(right.m_raw);
+    mpfr_class::pow_raw(tmp_left.m_raw, tmp_left.m_raw, right.m_raw);
+    return tmp_left;
 }
 
 mpfr_class operator^(const int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator^(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(long int) * CHAR_BIT);
+    mpfr_set_si(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(tmp.m_raw, tmp_left, right.m_raw);
+    return tmp;
 }
 
 mpfr_class operator^(const long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator^(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(long int) * CHAR_BIT);
+    mpfr_set_si(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(tmp.m_raw, tmp_left, right.m_raw);
+    return tmp;
 }
 
 mpfr_class operator^(const long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator^(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(tmp.m_raw, tmp_left, right.m_raw);
+    return tmp;
 }
 
 mpfr_class operator^(const unsigned int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator^(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(long int) * CHAR_BIT);
+    mpfr_set_ui(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(tmp.m_raw, tmp_left, right.m_raw);
+    return tmp;
 }
 
 mpfr_class operator^(const unsigned long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator^(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(long int) * CHAR_BIT);
+    mpfr_set_ui(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(tmp.m_raw, tmp_left, right.m_raw);
+    return tmp;
 }
 
 mpfr_class operator^(const unsigned long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator^(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(tmp.m_raw, tmp_left, right.m_raw);
+    return tmp;
 }
 
 mpfr_class operator^(const float left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator^(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, DBL_MANT_DIG);
+    mpfr_set_d(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(tmp.m_raw, tmp_left, right.m_raw);
+    return tmp;
 }
 
 mpfr_class operator^(const double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator^(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, DBL_MANT_DIG);
+    mpfr_set_d(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(tmp.m_raw, tmp_left, right.m_raw);
+    return tmp;
 }
 
 mpfr_class operator^(const long double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator^(right);
+    mpfr_class tmp;
+    tmp.reinit(mpfr_class::result_prec(right.m_raw));
+    MPFR_DECL_INIT(tmp_left, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_left, left, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(tmp.m_raw, tmp_left, right.m_raw);
+    return tmp;
 }
 
 mpfr_class& mpfr_class::operator^=(const mpfr_class& other) {
-    mpfr_pow(this->m_raw, this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(this->m_raw, this->m_raw, other.m_raw);
     return *this;
 }
 
 mpfr_class& mpfr_class::operator^=(const mpfr_ptr other) {
-    mpfr_class tmp_other(other);
-    return this->operator^=(tmp_other);
+    mpfr_class::pow_raw(this->m_raw, this->m_raw, other);
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator^=(const int other) {
-    mpfr_class tmp_other(other);
-    return this->operator^=(tmp_other);
+    mpfr_pow_si(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator^=(const long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator^=(tmp_other);
+    mpfr_pow_si(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator^=(const long long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator^=(tmp_other);
+    if (other >= LONG_MIN && other <= LONG_MAX) {
+        mpfr_pow_si(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    } else {
+        MPFR_DECL_INIT(tmp_other, sizeof(long long int) * CHAR_BIT);
+        mpfr_set_sj(tmp_other, other, mpfr_class::get_default_rnd());
+        mpfr_class::pow_raw(this->m_raw, this->m_raw, tmp_other);
+    }
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator^=(const unsigned int other) {
-    mpfr_class tmp_other(other);
-    return this->operator^=(tmp_other);
+    mpfr_pow_ui(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator^=(const unsigned long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator^=(tmp_other);
+    mpfr_pow_ui(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator^=(const unsigned long long int other) {
-    mpfr_class tmp_other(other);
-    return this->operator^=(tmp_other);
+    if (other <= ULONG_MAX) {
+        mpfr_pow_ui(this->m_raw, this->m_raw, other, mpfr_class::get_default_rnd());
+    } else {
+        MPFR_DECL_INIT(tmp_other, sizeof(unsigned long long int) * CHAR_BIT);
+        mpfr_set_uj(tmp_other, other, mpfr_class::get_default_rnd());
+        mpfr_class::pow_raw(this->m_raw, this->m_raw, tmp_other);
+    }
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator^=(const float other) {
-    mpfr_class tmp_other(other);
-    return this->operator^=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, DBL_MANT_DIG);
+    mpfr_set_d(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(this->m_raw, this->m_raw, tmp_other);
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator^=(const double other) {
-    mpfr_class tmp_other(other);
-    return this->operator^=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, DBL_MANT_DIG);
+    mpfr_set_d(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(this->m_raw, this->m_raw, tmp_other);
+    return *this;
 }
 
 mpfr_class& mpfr_class::operator^=(const long double other) {
-    mpfr_class tmp_other(other);
-    return this->operator^=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_other, other, mpfr_class::get_default_rnd());
+    mpfr_class::pow_raw(this->m_raw, this->m_raw, tmp_other);
+    return *this;
 }
 
 bool mpfr_class::operator==(const mpfr_class& other) const {
@@ -1023,103 +2090,87 @@ bool mpfr_class::operator==(const mpfr_class& other) const {
 }
 
 bool mpfr_class::operator==(const mpfr_ptr other) const {
-    mpfr_class tmp_other(other);
-    return this->operator==(tmp_other);
+    return (mpfr_cmp(this->m_raw, other) == 0);
 }
 
 bool mpfr_class::operator==(const int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator==(tmp_other);
+    return (mpfr_cmp_si(this->m_raw, other) == 0);
 }
 
 bool mpfr_class::operator==(const long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator==(tmp_other);
+    return (mpfr_cmp_si(this->m_raw, other) == 0);
 }
 
 bool mpfr_class::operator==(const long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator==(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_other, other, mpfr_class::get_default_rnd());
+    return (mpfr_cmp(this->m_raw, tmp_other) == 0);
 }
 
 bool mpfr_class::operator==(const unsigned int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator==(tmp_other);
+    return (mpfr_cmp_ui(this->m_raw, other) == 0);
 }
 
 bool mpfr_class::operator==(const unsigned long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator==(tmp_other);
+    return (mpfr_cmp_ui(this->m_raw, other) == 0);
 }
 
 bool mpfr_class::operator==(const unsigned long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator==(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_other, other, mpfr_class::get_default_rnd());
+    return (mpfr_cmp(this->m_raw, tmp_other) == 0);
 }
 
 bool mpfr_class::operator==(const float other) const {
-    mpfr_class tmp_other(other);
-    return this->operator==(tmp_other);
+    return (mpfr_cmp_d(this->m_raw, other) == 0);
 }
 
 bool mpfr_class::operator==(const double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator==(tmp_other);
+    return (mpfr_cmp_d(this->m_raw, other) == 0);
 }
 
 bool mpfr_class::operator==(const long double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator==(tmp_other);
+    return (mpfr_cmp_ld(this->m_raw, other) == 0);
 }
 
 bool operator==(const mpfr_ptr left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator==(right);
+    return right.operator==(left);
 }
 
 bool operator==(const int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator==(right);
+    return right.operator==(left);
 }
 
 bool operator==(const long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator==(right);
+    return right.operator==(left);
 }
 
 bool operator==(const long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator==(right);
+    return right.operator==(left);
 }
 
 bool operator==(const unsigned int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator==(right);
+    return right.operator==(left);
 }
 
 bool operator==(const unsigned long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator==(right);
+    return right.operator==(left);
 }
 
 bool operator==(const unsigned long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator==(right);
+    return right.operator==(left);
 }
 
 bool operator==(const float left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator==(right);
+    return right.operator==(left);
 }
 
 bool operator==(const double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator==(right);
+    return right.operator==(left);
 }
 
 bool operator==(const long double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator==(right);
+    return right.operator==(left);
 }
 
 bool mpfr_class::operator!=(const mpfr_class& other) const {
@@ -1127,103 +2178,87 @@ bool mpfr_class::operator!=(const mpfr_class& other) const {
 }
 
 bool mpfr_class::operator!=(const mpfr_ptr other) const {
-    mpfr_class tmp_other(other);
-    return this->operator!=(tmp_other);
+    return (mpfr_cmp(this->m_raw, other) != 0);
 }
 
 bool mpfr_class::operator!=(const int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator!=(tmp_other);
+    return (mpfr_cmp_si(this->m_raw, other) != 0);
 }
 
 bool mpfr_class::operator!=(const long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator!=(tmp_other);
+    return (mpfr_cmp_si(this->m_raw, other) != 0);
 }
 
 bool mpfr_class::operator!=(const long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator!=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_other, other, mpfr_class::get_default_rnd());
+    return (mpfr_cmp(this->m_raw, tmp_other) != 0);
 }
 
 bool mpfr_class::operator!=(const unsigned int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator!=(tmp_other);
+    return (mpfr_cmp_ui(this->m_raw, other) != 0);
 }
 
 bool mpfr_class::operator!=(const unsigned long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator!=(tmp_other);
+    return (mpfr_cmp_ui(this->m_raw, other) != 0);
 }
 
 bool mpfr_class::operator!=(const unsigned long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator!=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_other, other, mpfr_class::get_default_rnd());
+    return (mpfr_cmp(this->m_raw, tmp_other) != 0);
 }
 
 bool mpfr_class::operator!=(const float other) const {
-    mpfr_class tmp_other(other);
-    return this->operator!=(tmp_other);
+    return (mpfr_cmp_d(this->m_raw, other) != 0);
 }
 
 bool mpfr_class::operator!=(const double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator!=(tmp_other);
+    return (mpfr_cmp_d(this->m_raw, other) != 0);
 }
 
 bool mpfr_class::operator!=(const long double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator!=(tmp_other);
+    return (mpfr_cmp_ld(this->m_raw, other) != 0);
 }
 
 bool operator!=(const mpfr_ptr left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator!=(right);
+    return right.operator!=(left);
 }
 
 bool operator!=(const int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator!=(right);
+    return right.operator!=(left);
 }
 
 bool operator!=(const long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator!=(right);
+    return right.operator!=(left);
 }
 
 bool operator!=(const long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator!=(right);
+    return right.operator!=(left);
 }
 
 bool operator!=(const unsigned int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator!=(right);
+    return right.operator!=(left);
 }
 
 bool operator!=(const unsigned long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator!=(right);
+    return right.operator!=(left);
 }
 
 bool operator!=(const unsigned long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator!=(right);
+    return right.operator!=(left);
 }
 
 bool operator!=(const float left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator!=(right);
+    return right.operator!=(left);
 }
 
 bool operator!=(const double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator!=(right);
+    return right.operator!=(left);
 }
 
 bool operator!=(const long double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator!=(right);
+    return right.operator!=(left);
 }
 
 bool mpfr_class::operator<(const mpfr_class& other) const {
@@ -1231,103 +2266,87 @@ bool mpfr_class::operator<(const mpfr_class& other) const {
 }
 
 bool mpfr_class::operator<(const mpfr_ptr other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<(tmp_other);
+    return (mpfr_cmp(this->m_raw, other) < 0);
 }
 
 bool mpfr_class::operator<(const int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<(tmp_other);
+    return (mpfr_cmp_si(this->m_raw, other) < 0);
 }
 
 bool mpfr_class::operator<(const long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<(tmp_other);
+    return (mpfr_cmp_si(this->m_raw, other) < 0);
 }
 
 bool mpfr_class::operator<(const long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_other, other, mpfr_class::get_default_rnd());
+    return (mpfr_cmp(this->m_raw, tmp_other) < 0);
 }
 
 bool mpfr_class::operator<(const unsigned int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<(tmp_other);
+    return (mpfr_cmp_ui(this->m_raw, other) < 0);
 }
 
 bool mpfr_class::operator<(const unsigned long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<(tmp_other);
+    return (mpfr_cmp_ui(this->m_raw, other) < 0);
 }
 
 bool mpfr_class::operator<(const unsigned long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_other, other, mpfr_class::get_default_rnd());
+    return (mpfr_cmp(this->m_raw, tmp_other) < 0);
 }
 
 bool mpfr_class::operator<(const float other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<(tmp_other);
+    return (mpfr_cmp_d(this->m_raw, other) < 0);
 }
 
 bool mpfr_class::operator<(const double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<(tmp_other);
+    return (mpfr_cmp_d(this->m_raw, other) < 0);
 }
 
 bool mpfr_class::operator<(const long double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<(tmp_other);
+    return (mpfr_cmp_ld(this->m_raw, other) < 0);
 }
 
 bool operator<(const mpfr_ptr left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<(right);
+    return right.operator>(left);
 }
 
 bool operator<(const int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<(right);
+    return right.operator>(left);
 }
 
 bool operator<(const long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<(right);
+    return right.operator>(left);
 }
 
 bool operator<(const long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<(right);
+    return right.operator>(left);
 }
 
 bool operator<(const unsigned int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<(right);
+    return right.operator>(left);
 }
 
 bool operator<(const unsigned long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<(right);
+    return right.operator>(left);
 }
 
 bool operator<(const unsigned long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<(right);
+    return right.operator>(left);
 }
 
 bool operator<(const float left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<(right);
+    return right.operator>(left);
 }
 
 bool operator<(const double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<(right);
+    return right.operator>(left);
 }
 
 bool operator<(const long double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<(right);
+    return right.operator>(left);
 }
 
 bool mpfr_class::operator<=(const mpfr_class& other) const {
@@ -1335,103 +2354,87 @@ bool mpfr_class::operator<=(const mpfr_class& other) const {
 }
 
 bool mpfr_class::operator<=(const mpfr_ptr other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<=(tmp_other);
+    return (mpfr_cmp(this->m_raw, other) <= 0);
 }
 
 bool mpfr_class::operator<=(const int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<=(tmp_other);
+    return (mpfr_cmp_si(this->m_raw, other) <= 0);
 }
 
 bool mpfr_class::operator<=(const long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<=(tmp_other);
+    return (mpfr_cmp_si(this->m_raw, other) <= 0);
 }
 
 bool mpfr_class::operator<=(const long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_other, other, mpfr_class::get_default_rnd());
+    return (mpfr_cmp(this->m_raw, tmp_other) <= 0);
 }
 
 bool mpfr_class::operator<=(const unsigned int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<=(tmp_other);
+    return (mpfr_cmp_ui(this->m_raw, other) <= 0);
 }
 
 bool mpfr_class::operator<=(const unsigned long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<=(tmp_other);
+    return (mpfr_cmp_ui(this->m_raw, other) <= 0);
 }
 
 bool mpfr_class::operator<=(const unsigned long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_other, other, mpfr_class::get_default_rnd());
+    return (mpfr_cmp(this->m_raw, tmp_other) <= 0);
 }
 
 bool mpfr_class::operator<=(const float other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<=(tmp_other);
+    return (mpfr_cmp_d(this->m_raw, other) <= 0);
 }
 
 bool mpfr_class::operator<=(const double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<=(tmp_other);
+    return (mpfr_cmp_d(this->m_raw, other) <= 0);
 }
 
 bool mpfr_class::operator<=(const long double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator<=(tmp_other);
+    return (mpfr_cmp_ld(this->m_raw, other) <= 0);
 }
 
 bool operator<=(const mpfr_ptr left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<=(right);
+    return right.operator>=(left);
 }
 
 bool operator<=(const int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<=(right);
+    return right.operator>=(left);
 }
 
 bool operator<=(const long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<=(right);
+    return right.operator>=(left);
 }
 
 bool operator<=(const long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<=(right);
+    return right.operator>=(left);
 }
 
 bool operator<=(const unsigned int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<=(right);
+    return right.operator>=(left);
 }
 
 bool operator<=(const unsigned long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<=(right);
+    return right.operator>=(left);
 }
 
 bool operator<=(const unsigned long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<=(right);
+    return right.operator>=(left);
 }
 
 bool operator<=(const float left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<=(right);
+    return right.operator>=(left);
 }
 
 bool operator<=(const double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<=(right);
+    return right.operator>=(left);
 }
 
 bool operator<=(const long double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator<=(right);
+    return right.operator>=(left);
 }
 
 bool mpfr_class::operator>(const mpfr_class& other) const {
@@ -1439,103 +2442,87 @@ bool mpfr_class::operator>(const mpfr_class& other) const {
 }
 
 bool mpfr_class::operator>(const mpfr_ptr other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>(tmp_other);
+    return (mpfr_cmp(this->m_raw, other) > 0);
 }
 
 bool mpfr_class::operator>(const int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>(tmp_other);
+    return (mpfr_cmp_si(this->m_raw, other) > 0);
 }
 
 bool mpfr_class::operator>(const long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>(tmp_other);
+    return (mpfr_cmp_si(this->m_raw, other) > 0);
 }
 
 bool mpfr_class::operator>(const long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_other, other, mpfr_class::get_default_rnd());
+    return (mpfr_cmp(this->m_raw, tmp_other) > 0);
 }
 
 bool mpfr_class::operator>(const unsigned int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>(tmp_other);
+    return (mpfr_cmp_ui(this->m_raw, other) > 0);
 }
 
 bool mpfr_class::operator>(const unsigned long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>(tmp_other);
+    return (mpfr_cmp_ui(this->m_raw, other) > 0);
 }
 
 bool mpfr_class::operator>(const unsigned long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_other, other, mpfr_class::get_default_rnd());
+    return (mpfr_cmp(this->m_raw, tmp_other) > 0);
 }
 
 bool mpfr_class::operator>(const float other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>(tmp_other);
+    return (mpfr_cmp_d(this->m_raw, other) > 0);
 }
 
 bool mpfr_class::operator>(const double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>(tmp_other);
+    return (mpfr_cmp_d(this->m_raw, other) > 0);
 }
 
 bool mpfr_class::operator>(const long double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>(tmp_other);
+    return (mpfr_cmp_ld(this->m_raw, other) > 0);
 }
 
 bool operator>(const mpfr_ptr left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>(right);
+    return right.operator<(left);
 }
 
 bool operator>(const int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>(right);
+    return right.operator<(left);
 }
 
 bool operator>(const long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>(right);
+    return right.operator<(left);
 }
 
 bool operator>(const long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>(right);
+    return right.operator<(left);
 }
 
 bool operator>(const unsigned int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>(right);
+    return right.operator<(left);
 }
 
 bool operator>(const unsigned long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>(right);
+    return right.operator<(left);
 }
 
 bool operator>(const unsigned long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>(right);
+    return right.operator<(left);
 }
 
 bool operator>(const float left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>(right);
+    return right.operator<(left);
 }
 
 bool operator>(const double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>(right);
+    return right.operator<(left);
 }
 
 bool operator>(const long double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>(right);
+    return right.operator<(left);
 }
 
 bool mpfr_class::operator>=(const mpfr_class& other) const {
@@ -1543,113 +2530,133 @@ bool mpfr_class::operator>=(const mpfr_class& other) const {
 }
 
 bool mpfr_class::operator>=(const mpfr_ptr other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>=(tmp_other);
+    return (mpfr_cmp(this->m_raw, other) >= 0);
 }
 
 bool mpfr_class::operator>=(const int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>=(tmp_other);
+    return (mpfr_cmp_si(this->m_raw, other) >= 0);
 }
 
 bool mpfr_class::operator>=(const long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>=(tmp_other);
+    return (mpfr_cmp_si(this->m_raw, other) >= 0);
 }
 
 bool mpfr_class::operator>=(const long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_other, other, mpfr_class::get_default_rnd());
+    return (mpfr_cmp(this->m_raw, tmp_other) >= 0);
 }
 
 bool mpfr_class::operator>=(const unsigned int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>=(tmp_other);
+    return (mpfr_cmp_ui(this->m_raw, other) >= 0);
 }
 
 bool mpfr_class::operator>=(const unsigned long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>=(tmp_other);
+    return (mpfr_cmp_ui(this->m_raw, other) >= 0);
 }
 
 bool mpfr_class::operator>=(const unsigned long long int other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>=(tmp_other);
+    MPFR_DECL_INIT(tmp_other, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_other, other, mpfr_class::get_default_rnd());
+    return (mpfr_cmp(this->m_raw, tmp_other) >= 0);
 }
 
 bool mpfr_class::operator>=(const float other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>=(tmp_other);
+    return (mpfr_cmp_d(this->m_raw, other) >= 0);
 }
 
 bool mpfr_class::operator>=(const double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>=(tmp_other);
+    return (mpfr_cmp_d(this->m_raw, other) >= 0);
 }
 
 bool mpfr_class::operator>=(const long double other) const {
-    mpfr_class tmp_other(other);
-    return this->operator>=(tmp_other);
+    return (mpfr_cmp_ld(this->m_raw, other) >= 0);
 }
 
 bool operator>=(const mpfr_ptr left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>=(right);
+    return right.operator<=(left);
 }
 
 bool operator>=(const int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>=(right);
+    return right.operator<=(left);
 }
 
 bool operator>=(const long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>=(right);
+    return right.operator<=(left);
 }
 
 bool operator>=(const long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>=(right);
+    return right.operator<=(left);
 }
 
 bool operator>=(const unsigned int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>=(right);
+    return right.operator<=(left);
 }
 
 bool operator>=(const unsigned long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>=(right);
+    return right.operator<=(left);
 }
 
 bool operator>=(const unsigned long long int left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>=(right);
+    return right.operator<=(left);
 }
 
 bool operator>=(const float left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>=(right);
+    return right.operator<=(left);
 }
 
 bool operator>=(const double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>=(right);
+    return right.operator<=(left);
 }
 
 bool operator>=(const long double left, const mpfr_class& right) {
-    mpfr_class tmp_left(left);
-    return tmp_left.operator>=(right);
+    return right.operator<=(left);
 }
 
 mpfr_class mpfr_class::pow_value(const mpfr_class& exponent) const {
     mpfr_class tmp;
-    mpfr_pow(tmp.m_raw, this->m_raw, exponent.m_raw, mpfr_class::get_default_rnd());
+    tmp.reinit(mpfr_class::result_prec(this->m_raw, exponent.m_raw));
+    mpfr_class::pow(tmp, *this, exponent);
     return tmp;
 }
 
 void mpfr_class::to_pow(const mpfr_class& exponent) {
-    mpfr_pow(this->m_raw, this->m_raw, exponent.m_raw, mpfr_class::get_default_rnd());
+    mpfr_class::pow(*this, *this, exponent);
+}
+
+mpfr_class& mpfr_class::fma(const mpfr_class& left, const mpfr_class& right, const mpfr_class& addend) {
+    if (!this->is_initialized()) {
+        mpfr_pool::init(this->m_raw, mpfr_class::get_default_prec());
+    }
+    mpfr_fma(this->m_raw, left.m_raw, right.m_raw, addend.m_raw, mpfr_class::get_default_rnd());
+    return *this;
+}
+
+mpfr_class& mpfr_class::fms(const mpfr_class& left, const mpfr_class& right, const mpfr_class& subtrahend) {
+    if (!this->is_initialized()) {
+        mpfr_pool::init(this->m_raw, mpfr_class::get_default_prec());
+    }
+    mpfr_fms(this->m_raw, left.m_raw, right.m_raw, subtrahend.m_raw, mpfr_class::get_default_rnd());
+    return *this;
+}
+
+mpfr_class& mpfr_class::addmul(const mpfr_class& left, const mpfr_class& right) {
+    mpfr_fma(this->m_raw, left.m_raw, right.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    return *this;
+}
+
+// this - left*right is computed as -(left*right - this), so the directed
+// rounding modes have to be swapped before the exact negation.
+mpfr_class& mpfr_class::submul(const mpfr_class& left, const mpfr_class& right) {
+    mpfr_rnd_t rnd = mpfr_class::get_default_rnd();
+    if (rnd == MPFR_RNDU) {
+        rnd = MPFR_RNDD;
+    } else if (rnd == MPFR_RNDD) {
+        rnd = MPFR_RNDU;
+    }
+    mpfr_fms(this->m_raw, left.m_raw, right.m_raw, this->m_raw, rnd);
+    mpfr_neg(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    return *this;
 }
 
 int mpfr_class::int_value() const {
@@ -1688,6 +2695,10 @@ long double mpfr_class::ldouble_value() const {
     return mpfr_get_ld(this->m_raw, mpfr_class::get_default_rnd());
 }
 
+mpfr_class mpfr_class::class_value() const {
+    return mpfr_class(*this);
+}
+
 std::ostream& operator<<(std::ostream& left, const mpfr_class& right) {
     left << right.get_str();
     return left;
@@ -1726,120 +2737,170 @@ void mpfr_class::set_str(const std::string& other, const int base, const mpfr_rn
 
 mpfr_class mpfr_class::sqrt_value() const {
     mpfr_class tmp;
-    mpfr_sqrt(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    tmp.reinit(mpfr_class::result_prec(this->m_raw));
+    mpfr_class::sqrt_into(tmp, *this);
     return tmp;
 }
 
 void mpfr_class::to_sqrt() {
-    mpfr_sqrt(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    mpfr_class::sqrt_into(*this, *this);
 }
 
 mpfr_class mpfr_class::abs_value() const {
     mpfr_class tmp;
-    mpfr_abs(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    tmp.reinit(mpfr_class::result_prec(this->m_raw));
+    mpfr_class::abs_into(tmp, *this);
     return tmp;
 }
 
 void mpfr_class::to_abs() {
-    mpfr_abs(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    mpfr_class::abs_into(*this, *this);
 }
 
 mpfr_class mpfr_class::log_value() const {
     mpfr_class tmp;
-    mpfr_log(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    tmp.reinit(mpfr_class::result_prec(this->m_raw));
+    mpfr_class::log_into(tmp, *this);
     return tmp;
 }
 
 void mpfr_class::to_log() {
-    mpfr_log(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    mpfr_class::log_into(*this, *this);
 }
 
 mpfr_class mpfr_class::log2_value() const {
     mpfr_class tmp;
-    mpfr_log2(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    tmp.reinit(mpfr_class::result_prec(this->m_raw));
+    mpfr_class::log2_into(tmp, *this);
     return tmp;
 }
 
 void mpfr_class::to_log2() {
-    mpfr_log2(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    mpfr_class::log2_into(*this, *this);
 }
 
 mpfr_class mpfr_class::log10_value() const {
     mpfr_class tmp;
-    mpfr_log10(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    tmp.reinit(mpfr_class::result_prec(this->m_raw));
+    mpfr_class::log10_into(tmp, *this);
     return tmp;
 }
 
 void mpfr_class::to_log10() {
-    mpfr_log10(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    mpfr_class::log10_into(*this, *this);
 }
 
 mpfr_class mpfr_class::exp_value() const {
     mpfr_class tmp;
-    mpfr_exp(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    tmp.reinit(mpfr_class::result_prec(this->m_raw));
+    mpfr_class::exp_into(tmp, *this);
     return tmp;
 }
 
 void mpfr_class::to_exp() {
-    mpfr_exp(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    mpfr_class::exp_into(*this, *this);
 }
 
 mpfr_class mpfr_class::exp2_value() const {
     mpfr_class tmp;
-    mpfr_exp2(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    tmp.reinit(mpfr_class::result_prec(this->m_raw));
+    mpfr_class::exp2_into(tmp, *this);
     return tmp;
 }
 
 void mpfr_class::to_exp2() {
-    mpfr_exp2(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    mpfr_class::exp2_into(*this, *this);
 }
 
 mpfr_class mpfr_class::exp10_value() const {
     mpfr_class tmp;
-    mpfr_exp10(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    tmp.reinit(mpfr_class::result_prec(this->m_raw));
+    mpfr_class::exp10_into(tmp, *this);
     return tmp;
 }
 
 void mpfr_class::to_exp10() {
-    mpfr_exp10(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    mpfr_class::exp10_into(*this, *this);
 }
 
 mpfr_class mpfr_class::cos_value() const {
     mpfr_class tmp;
-    mpfr_cos(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    tmp.reinit(mpfr_class::result_prec(this->m_raw));
+    mpfr_class::cos_into(tmp, *this);
     return tmp;
 }
 
 void mpfr_class::to_cos() {
-    mpfr_cos(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    mpfr_class::cos_into(*this, *this);
 }
 
 mpfr_class mpfr_class::sin_value() const {
     mpfr_class tmp;
-    mpfr_sin(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    tmp.reinit(mpfr_class::result_prec(this->m_raw));
+    mpfr_class::sin_into(tmp, *this);
     return tmp;
 }
 
 void mpfr_class::to_sin() {
-    mpfr_sin(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    mpfr_class::sin_into(*this, *this);
 }
 
 mpfr_class mpfr_class::tan_value() const {
     mpfr_class tmp;
-    mpfr_tan(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    tmp.reinit(mpfr_class::result_prec(this->m_raw));
+    mpfr_class::tan_into(tmp, *this);
     return tmp;
 }
 
 void mpfr_class::to_tan() {
-    mpfr_tan(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    mpfr_class::tan_into(*this, *this);
+}
+
+mpfr_ptr mpfr_class::get_raw() {
+    return this->m_raw;
+}
+
+mpfr_srcptr mpfr_class::get_raw() const {
+    return this->m_raw;
 }
 
 mpfr_prec_t mpfr_class::get_prec() const {
     return mpfr_get_prec(this->m_raw);
 }
 
+mpfr_exp_t mpfr_class::get_exp() const {
+    return mpfr_get_exp(this->m_raw);
+}
+
 void mpfr_class::set_prec(mpfr_prec_t prec) {
-    return mpfr_set_prec(this->m_raw, prec);
+    if (!this->is_initialized()) {
+        mpfr_pool::init(this->m_raw, prec);
+        return;
+    }
+    if (this->m_shared) {
+        if (prec != mpfr_get_prec(this->m_raw)) {
+            printf("mpfr_class[%s:%d]: Cannot change the precision of shared limbs.\n", __FILE__, __LINE__);
+            abort();
+        }
+        mpfr_set_nan(this->m_raw);
+        return;
+    }
+    mpfr_set_prec(this->m_raw, prec);
+}
+
+void mpfr_class::round_prec(mpfr_prec_t prec) {
+    if (!this->is_initialized()) {
+        mpfr_pool::init(this->m_raw, prec);
+        return;
+    }
+    if (this->m_shared) {
+        if (prec != mpfr_get_prec(this->m_raw)) {
+            printf("mpfr_class[%s:%d]: Cannot change the precision of shared limbs.\n", __FILE__, __LINE__);
+            abort();
+        }
+        return;
+    }
+    mpfr_prec_round(this->m_raw, prec, mpfr_class::get_default_rnd());
 }
 
 bool mpfr_class::is_nan() const {
@@ -1887,45 +2948,313 @@ void mpfr_class::set_sign(int sign) {
 }
 
 void mpfr_class::clear() {
-    mpfr_clear(this->m_raw);
+    if (this->m_shared) {
+        this->m_shared = false;
+        this->set_uninitialized();
+    } else if (this->is_initialized()) {
+        mpfr_pool::clear(this->m_raw);
+        this->set_uninitialized();
+    }
+}
+
+// The limbs must hold mpfr_custom_get_size(prec) bytes and stay valid until
+// the value is unshared, relocated or destroyed.
+void mpfr_class::share_limbs(mp_limb_t *limbs, const mpfr_prec_t prec) {
+    mpfr_t tmp;
+    mpfr_custom_init(limbs, prec);
+    mpfr_custom_init_set(tmp, MPFR_NAN_KIND, 0, prec, limbs);
+    if (this->is_initialized()) {
+        mpfr_set(tmp, this->m_raw, mpfr_class::get_default_rnd());
+    }
+    this->clear();
+    this->m_raw[0] = tmp[0];
+    this->m_shared = true;
+}
+
+// Follows limbs that the container has moved, contents included.
+void mpfr_class::relocate_limbs(mp_limb_t *limbs) {
+    mpfr_custom_move(this->m_raw, limbs);
+}
+
+void mpfr_class::unshare_limbs() {
+    if (!this->m_shared) {
+        return;
+    }
+    mpfr_t tmp;
+    mpfr_pool::init(tmp, mpfr_get_prec(this->m_raw));
+    mpfr_set(tmp, this->m_raw, mpfr_class::get_default_rnd());
+    this->m_raw[0] = tmp[0];
+    this->m_shared = false;
+}
+
+bool mpfr_class::has_shared_limbs() const {
+    return this->m_shared;
+}
+
+// A moved-from object holds no limbs; it may only be destroyed or assigned to.
+bool mpfr_class::is_initialized() const {
+    return this->m_raw->_mpfr_d != NULL;
+}
+
+void mpfr_class::set_uninitialized() {
+    this->m_raw->_mpfr_prec = MPFR_PREC_MIN;
+    this->m_raw->_mpfr_sign = 1;
+    this->m_raw->_mpfr_exp = 0;
+    this->m_raw->_mpfr_d = NULL;
+}
+
+void mpfr_class::reinit(mpfr_prec_t prec) {
+    if (this->m_shared) {
+        return;
+    }
+    if (!this->is_initialized()) {
+        mpfr_pool::init(this->m_raw, prec);
+    } else if (mpfr_get_prec(this->m_raw) != prec) {
+        mpfr_set_prec(this->m_raw, prec);
+    }
+}
+
+// In the operand precision mode a result gets the largest precision of its
+// mpfr operands; otherwise the left operand or the default precision decides.
+void mpfr_class::widen_prec(mpfr_srcptr other) {
+    if (tls_precision_mode == mpfr_precision_operands && !this->m_shared && mpfr_get_prec(other) > mpfr_get_prec(this->m_raw)) {
+        mpfr_prec_round(this->m_raw, mpfr_get_prec(other), mpfr_class::get_default_rnd());
+    }
+}
+
+mpfr_prec_t mpfr_class::result_prec(mpfr_srcptr value) {
+    if (tls_precision_mode == mpfr_precision_operands) {
+        return mpfr_get_prec(value);
+    }
+    return mpfr_class::get_default_prec();
+}
+
+mpfr_prec_t mpfr_class::result_prec(mpfr_srcptr left, mpfr_srcptr right) {
+    if (tls_precision_mode == mpfr_precision_operands) {
+        return (mpfr_get_prec(left) > mpfr_get_prec(right)) ? mpfr_get_prec(left) : mpfr_get_prec(right);
+    }
+    return mpfr_class::get_default_prec();
+}
+
+// Integral exponents are handed to mpfr_sqr, mpfr_pow_si or mpfr_pow_z, and
+// half-integral exponents n/2 of a positive base to a (reciprocal) square root
+// raised to the power |n|. The latter is evaluated with guard bits and only used
+// when it can be rounded correctly; mpfr_pow handles everything else.
+void mpfr_class::pow_raw(mpfr_ptr result, mpfr_srcptr base, mpfr_srcptr exponent) {
+    mpfr_rnd_t rnd = mpfr_class::get_default_rnd();
+    if (!mpfr_regular_p(exponent)) {
+        mpfr_pow(result, base, exponent, rnd);
+        return;
+    }
+    mpfr_exp_t lowest_bit = mpfr_get_exp(exponent) - mpfr_min_prec(exponent);
+    if (lowest_bit >= 0) {
+        if (mpfr_fits_slong_p(exponent, rnd)) {
+            long int n = mpfr_get_si(exponent, rnd);
+            if (n == 2) {
+                mpfr_sqr(result, base, rnd);
+            } else {
+                mpfr_pow_si(result, base, n, rnd);
+            }
+        } else {
+            mpz_t n;
+            mpz_init(n);
+            mpfr_get_z(n, exponent, rnd);
+            mpfr_pow_z(result, base, n, rnd);
+            mpz_clear(n);
+        }
+        return;
+    }
+    long int half = mpfr_fits_slong_p(exponent, MPFR_RNDZ) ? mpfr_get_si(exponent, MPFR_RNDZ) : LONG_MAX;
+    if (lowest_bit == -1 && half > LONG_MIN / 2 && half < LONG_MAX / 2 && mpfr_regular_p(base) && mpfr_sgn(base) > 0) {
+        bool is_negative = mpfr_sgn(exponent) < 0;
+        unsigned long int n = 2 * (unsigned long int) (is_negative ? -half : half) + 1;
+        if (n == 1) {
+            if (is_negative) {
+                mpfr_rec_sqrt(result, base, rnd);
+            } else {
+                mpfr_sqrt(result, base, rnd);
+            }
+            return;
+        }
+        mpfr_prec_t prec = mpfr_get_prec(result);
+        mpfr_prec_t error_bits = 1;
+        for (unsigned long int k = n + 2; k > 1; k >>= 1) {
+            ++error_bits;
+        }
+        mpfr_t tmp;
+        mpfr_init2(tmp, prec + error_bits + 32);
+        if (is_negative) {
+            mpfr_rec_sqrt(tmp, base, MPFR_RNDN);
+        } else {
+            mpfr_sqrt(tmp, base, MPFR_RNDN);
+        }
+        mpfr_pow_ui(tmp, tmp, n, MPFR_RNDN);
+        if (mpfr_can_round(tmp, prec + 32, MPFR_RNDN, MPFR_RNDZ, prec + (rnd == MPFR_RNDN))) {
+            mpfr_set(result, tmp, rnd);
+        } else {
+            mpfr_pow(result, base, exponent, rnd);
+        }
+        mpfr_clear(tmp);
+        return;
+    }
+    mpfr_pow(result, base, exponent, rnd);
+}
+
+// The destination keeps its own precision, as with the MPFR functions; only a
+// moved-from destination is initialized with the default precision first.
+mpfr_ptr mpfr_class::destination(mpfr_class& result) {
+    if (!result.is_initialized()) {
+        mpfr_pool::init(result.m_raw, mpfr_class::get_default_prec());
+    }
+    return result.m_raw;
+}
+
+void mpfr_class::set(mpfr_class& result, const mpfr_class& value) {
+    mpfr_set(mpfr_class::destination(result), value.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::add(mpfr_class& result, const mpfr_class& left, const mpfr_class& right) {
+    mpfr_add(mpfr_class::destination(result), left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::add(mpfr_class& result, const mpfr_class& left, const unsigned long int right) {
+    mpfr_add_ui(mpfr_class::destination(result), left.m_raw, right, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::sub(mpfr_class& result, const mpfr_class& left, const mpfr_class& right) {
+    mpfr_sub(mpfr_class::destination(result), left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::sub(mpfr_class& result, const mpfr_class& left, const unsigned long int right) {
+    mpfr_sub_ui(mpfr_class::destination(result), left.m_raw, right, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::sub(mpfr_class& result, const unsigned long int left, const mpfr_class& right) {
+    mpfr_ui_sub(mpfr_class::destination(result), left, right.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::mul(mpfr_class& result, const mpfr_class& left, const mpfr_class& right) {
+    mpfr_mul(mpfr_class::destination(result), left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::mul(mpfr_class& result, const mpfr_class& left, const unsigned long int right) {
+    mpfr_mul_ui(mpfr_class::destination(result), left.m_raw, right, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::div(mpfr_class& result, const mpfr_class& left, const mpfr_class& right) {
+    mpfr_div(mpfr_class::destination(result), left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::div(mpfr_class& result, const mpfr_class& left, const unsigned long int right) {
+    mpfr_div_ui(mpfr_class::destination(result), left.m_raw, right, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::div(mpfr_class& result, const unsigned long int left, const mpfr_class& right) {
+    mpfr_ui_div(mpfr_class::destination(result), left, right.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::pow(mpfr_class& result, const mpfr_class& base, const mpfr_class& exponent) {
+    mpfr_class::pow_raw(mpfr_class::destination(result), base.m_raw, exponent.m_raw);
+}
+
+void mpfr_class::pow_ui(mpfr_class& result, const mpfr_class& base, const unsigned long int exponent) {
+    mpfr_pow_ui(mpfr_class::destination(result), base.m_raw, exponent, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::abs_into(mpfr_class& result, const mpfr_class& value) {
+    mpfr_abs(mpfr_class::destination(result), value.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::sqrt_into(mpfr_class& result, const mpfr_class& value) {
+    mpfr_sqrt(mpfr_class::destination(result), value.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::log_into(mpfr_class& result, const mpfr_class& value) {
+    mpfr_log(mpfr_class::destination(result), value.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::log2_into(mpfr_class& result, const mpfr_class& value) {
+    mpfr_log2(mpfr_class::destination(result), value.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::log10_into(mpfr_class& result, const mpfr_class& value) {
+    mpfr_log10(mpfr_class::destination(result), value.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::exp_into(mpfr_class& result, const mpfr_class& value) {
+    mpfr_exp(mpfr_class::destination(result), value.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::exp2_into(mpfr_class& result, const mpfr_class& value) {
+    mpfr_exp2(mpfr_class::destination(result), value.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::exp10_into(mpfr_class& result, const mpfr_class& value) {
+    mpfr_exp10(mpfr_class::destination(result), value.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::cos_into(mpfr_class& result, const mpfr_class& value) {
+    mpfr_cos(mpfr_class::destination(result), value.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::sin_into(mpfr_class& result, const mpfr_class& value) {
+    mpfr_sin(mpfr_class::destination(result), value.m_raw, mpfr_class::get_default_rnd());
+}
+
+void mpfr_class::tan_into(mpfr_class& result, const mpfr_class& value) {
+    mpfr_tan(mpfr_class::destination(result), value.m_raw, mpfr_class::get_default_rnd());
 }
 
 mpfr_rnd_t mpfr_class::get_default_rnd() {
-    return mpfr_get_default_rounding_mode();
+    return tls_default_rnd;
 }
 
 void mpfr_class::set_default_rnd(mpfr_rnd_t rnd) {
-    mpfr_set_default_rounding_mode(rnd);
+    tls_default_rnd = rnd;
 }
 
 mpfr_prec_t mpfr_class::get_default_prec() {
-    return mpfr_get_default_prec();
+    return tls_default_prec;
 }
 
 void mpfr_class::set_default_prec(mpfr_prec_t prec) {
-    mpfr_set_default_prec(prec);
+    tls_default_prec = prec;
+}
+
+mpfr_precision_mode mpfr_class::get_precision_mode() {
+    return tls_precision_mode;
+}
+
+void mpfr_class::set_precision_mode(mpfr_precision_mode mode) {
+    tls_precision_mode = mode;
 }
 
 mpfr_class mpfr_class::const_log2() {
     mpfr_class tmp;
-    mpfr_const_log2(tmp.m_raw, mpfr_class::get_default_rnd());
+    mpfr_cache::global().constant(tmp.m_raw, mpfr_cache::cache_log2, mpfr_class::get_default_rnd());
     return tmp;
 }
 
 mpfr_class mpfr_class::const_pi() {
     mpfr_class tmp;
-    mpfr_const_pi(tmp.m_raw, mpfr_class::get_default_rnd());
+    mpfr_cache::global().constant(tmp.m_raw, mpfr_cache::cache_pi, mpfr_class::get_default_rnd());
     return tmp;
 }
 
 mpfr_class mpfr_class::const_euler() {
     mpfr_class tmp;
-    mpfr_const_euler(tmp.m_raw, mpfr_class::get_default_rnd());
+    mpfr_cache::global().constant(tmp.m_raw, mpfr_cache::cache_euler, mpfr_class::get_default_rnd());
     return tmp;
 }
 
 mpfr_class mpfr_class::const_catalan() {
     mpfr_class tmp(0);
-    mpfr_const_catalan(tmp.m_raw, mpfr_class::get_default_rnd());
+    mpfr_cache::global().constant(tmp.m_raw, mpfr_cache::cache_catalan, mpfr_class::get_default_rnd());
+    return tmp;
+}
+
+mpfr_class mpfr_class::literal(const std::string& literal) {
+    mpfr_class tmp;
+    mpfr_cache::global().literal(tmp.m_raw, literal, mpfr_class::get_default_rnd());
     return tmp;
 }
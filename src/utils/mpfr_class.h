@@ -32,16 +32,29 @@
 #include <mpfr.h>
 #include <string>
 
+template <class E> class mpfr_expression;
+
+// Precision of the results of arithmetic operators and elementary functions.
+// By default a new result gets the default precision of the thread (or that of
+// the left operand); in the operand mode it gets the largest precision of its
+// mpfr operands, so values of different precisions can be mixed.
+typedef enum mpfr_precision_mode {
+    mpfr_precision_default = 0,
+    mpfr_precision_operands = 1
+} mpfr_precision_mode;
+
 class mpfr_class {
 
 private:
 
     mpfr_t m_raw;
+    bool m_shared = false;
 
 public:
 
     mpfr_class();
     mpfr_class(const mpfr_class& other);
+    mpfr_class(mpfr_class&& other) noexcept;
     mpfr_class(const mpfr_ptr other);
     mpfr_class(const int other, const mpfr_prec_t prec = mpfr_class::get_default_prec(), const mpfr_rnd_t rnd = mpfr_class::get_default_rnd());
     mpfr_class(const long int other, const mpfr_prec_t prec = mpfr_class::get_default_prec(), const mpfr_rnd_t rnd = mpfr_class::get_default_rnd());
@@ -54,9 +67,11 @@ public:
     mpfr_class(const long double other, const mpfr_prec_t prec = mpfr_class::get_default_prec(), const mpfr_rnd_t rnd = mpfr_class::get_default_rnd());
     mpfr_class(const char *other, const mpfr_prec_t prec = mpfr_class::get_default_prec(), const int base = 10, const mpfr_rnd_t rnd = mpfr_class::get_default_rnd());
     mpfr_class(const std::string& other, const mpfr_prec_t prec = mpfr_class::get_default_prec(), const int base = 10, const mpfr_rnd_t rnd = mpfr_class::get_default_rnd());
+    template <class E> explicit mpfr_class(const mpfr_expression<E>& other);
     ~mpfr_class();
 
     mpfr_class& operator=(const mpfr_class& other);
+    mpfr_class& operator=(mpfr_class&& other) noexcept;
     mpfr_class& operator=(const mpfr_ptr other);
     mpfr_class& operator=(const int other);
     mpfr_class& operator=(const long int other);
@@ -69,18 +84,43 @@ public:
     mpfr_class& operator=(const long double other);
     mpfr_class& operator=(const char *other);
     mpfr_class& operator=(const std::string& other);
-
-    mpfr_class operator+(const mpfr_class& other) const;
-    mpfr_class operator+(const mpfr_ptr other) const;
-    mpfr_class operator+(const int other) const;
-    mpfr_class operator+(const long int other) const;
-    mpfr_class operator+(const long long int other) const;
-    mpfr_class operator+(const unsigned int other) const;
-    mpfr_class operator+(const unsigned long int other) const;
-    mpfr_class operator+(const unsigned long long int other) const;
-    mpfr_class operator+(const float other) const;
-    mpfr_class operator+(const double other) const;
-    mpfr_class operator+(const long double other) const;
+    template <class E> mpfr_class& operator=(const mpfr_expression<E>& other);
+
+    mpfr_class operator+(const mpfr_class& other) const&;
+    mpfr_class operator+(const mpfr_class& other) &&;
+    mpfr_class operator+(const mpfr_ptr other) const&;
+    mpfr_class operator+(const mpfr_ptr other) &&;
+    mpfr_class operator+(const int other) const&;
+    mpfr_class operator+(const int other) &&;
+    mpfr_class operator+(const long int other) const&;
+    mpfr_class operator+(const long int other) &&;
+    mpfr_class operator+(const long long int other) const&;
+    mpfr_class operator+(const long long int other) &&;
+    mpfr_class operator+(const unsigned int other) const&;
+    mpfr_class operator+(const unsigned int other) &&;
+    mpfr_class operator+(const unsigned long int other) const&;
+    mpfr_class operator+(const unsigned long int other) &&;
+    mpfr_class operator+(const unsigned long long int other) const&;
+    mpfr_class operator+(const unsigned long long int other) &&;
+    mpfr_class operator+(const float other) const&;
+    mpfr_class operator+(const float other) &&;
+    mpfr_class operator+(const double other) const&;
+    mpfr_class operator+(const double other) &&;
+    mpfr_class operator+(const long double other) const&;
+    mpfr_class operator+(const long double other) &&;
+
+    friend mpfr_class operator+(const mpfr_class& left, mpfr_class&& right);
+    friend mpfr_class operator+(mpfr_class&& left, mpfr_class&& right);
+    friend mpfr_class operator+(const mpfr_ptr left, mpfr_class&& right);
+    friend mpfr_class operator+(const int left, mpfr_class&& right);
+    friend mpfr_class operator+(const long int left, mpfr_class&& right);
+    friend mpfr_class operator+(const long long int left, mpfr_class&& right);
+    friend mpfr_class operator+(const unsigned int left, mpfr_class&& right);
+    friend mpfr_class operator+(const unsigned long int left, mpfr_class&& right);
+    friend mpfr_class operator+(const unsigned long long int left, mpfr_class&& right);
+    friend mpfr_class operator+(const float left, mpfr_class&& right);
+    friend mpfr_class operator+(const double left, mpfr_class&& right);
+    friend mpfr_class operator+(const long double left, mpfr_class&& right);
 
     friend mpfr_class operator+(const mpfr_ptr left, const mpfr_class& right);
     friend mpfr_class operator+(const int left, const mpfr_class& right);
@@ -104,23 +144,48 @@ public:
     mpfr_class& operator+=(const float other);
     mpfr_class& operator+=(const double other);
     mpfr_class& operator+=(const long double other);
+    template <class E> mpfr_class& operator+=(const mpfr_expression<E>& other);
 
     mpfr_class operator+() const;
 
     mpfr_class operator++(int);
     mpfr_class& operator++();
 
-    mpfr_class operator-(const mpfr_class& other) const;
-    mpfr_class operator-(const mpfr_ptr other) const;
-    mpfr_class operator-(const int other) const;
-    mpfr_class operator-(const long int other) const;
-    mpfr_class operator-(const long long int other) const;
-    mpfr_class operator-(const unsigned int other) const;
-    mpfr_class operator-(const unsigned long int other) const;
-    mpfr_class operator-(const unsigned long long int other) const;
-    mpfr_class operator-(const float other) const;
-    mpfr_class operator-(const double other) const;
-    mpfr_class operator-(const long double other) const;
+    mpfr_class operator-(const mpfr_class& other) const&;
+    mpfr_class operator-(const mpfr_class& other) &&;
+    mpfr_class operator-(const mpfr_ptr other) const&;
+    mpfr_class operator-(const mpfr_ptr other) &&;
+    mpfr_class operator-(const int other) const&;
+    mpfr_class operator-(const int other) &&;
+    mpfr_class operator-(const long int other) const&;
+    mpfr_class operator-(const long int other) &&;
+    mpfr_class operator-(const long long int other) const&;
+    mpfr_class operator-(const long long int other) &&;
+    mpfr_class operator-(const unsigned int other) const&;
+    mpfr_class operator-(const unsigned int other) &&;
+    mpfr_class operator-(const unsigned long int other) const&;
+    mpfr_class operator-(const unsigned long int other) &&;
+    mpfr_class operator-(const unsigned long long int other) const&;
+    mpfr_class operator-(const unsigned long long int other) &&;
+    mpfr_class operator-(const float other) const&;
+    mpfr_class operator-(const float other) &&;
+    mpfr_class operator-(const double other) const&;
+    mpfr_class operator-(const double other) &&;
+    mpfr_class operator-(const long double other) const&;
+    mpfr_class operator-(const long double other) &&;
+
+    friend mpfr_class operator-(const mpfr_class& left, mpfr_class&& right);
+    friend mpfr_class operator-(mpfr_class&& left, mpfr_class&& right);
+    friend mpfr_class operator-(const mpfr_ptr left, mpfr_class&& right);
+    friend mpfr_class operator-(const int left, mpfr_class&& right);
+    friend mpfr_class operator-(const long int left, mpfr_class&& right);
+    friend mpfr_class operator-(const long long int left, mpfr_class&& right);
+    friend mpfr_class operator-(const unsigned int left, mpfr_class&& right);
+    friend mpfr_class operator-(const unsigned long int left, mpfr_class&& right);
+    friend mpfr_class operator-(const unsigned long long int left, mpfr_class&& right);
+    friend mpfr_class operator-(const float left, mpfr_class&& right);
+    friend mpfr_class operator-(const double left, mpfr_class&& right);
+    friend mpfr_class operator-(const long double left, mpfr_class&& right);
 
     friend mpfr_class operator-(const mpfr_ptr left, const mpfr_class& right);
     friend mpfr_class operator-(const int left, const mpfr_class& right);
@@ -144,23 +209,49 @@ public:
     mpfr_class& operator-=(const float other);
     mpfr_class& operator-=(const double other);
     mpfr_class& operator-=(const long double other);
+    template <class E> mpfr_class& operator-=(const mpfr_expression<E>& other);
 
-    mpfr_class operator-() const;
+    mpfr_class operator-() const&;
+    mpfr_class operator-() &&;
 
     mpfr_class operator--(int);
     mpfr_class& operator--();
 
-    mpfr_class operator*(const mpfr_class& other) const;
-    mpfr_class operator*(const mpfr_ptr other) const;
-    mpfr_class operator*(const int other) const;
-    mpfr_class operator*(const long int other) const;
-    mpfr_class operator*(const long long int other) const;
-    mpfr_class operator*(const unsigned int other) const;
-    mpfr_class operator*(const unsigned long int other) const;
-    mpfr_class operator*(const unsigned long long int other) const;
-    mpfr_class operator*(const float other) const;
-    mpfr_class operator*(const double other) const;
-    mpfr_class operator*(const long double other) const;
+    mpfr_class operator*(const mpfr_class& other) const&;
+    mpfr_class operator*(const mpfr_class& other) &&;
+    mpfr_class operator*(const mpfr_ptr other) const&;
+    mpfr_class operator*(const mpfr_ptr other) &&;
+    mpfr_class operator*(const int other) const&;
+    mpfr_class operator*(const int other) &&;
+    mpfr_class operator*(const long int other) const&;
+    mpfr_class operator*(const long int other) &&;
+    mpfr_class operator*(const long long int other) const&;
+    mpfr_class operator*(const long long int other) &&;
+    mpfr_class operator*(const unsigned int other) const&;
+    mpfr_class operator*(const unsigned int other) &&;
+    mpfr_class operator*(const unsigned long int other) const&;
+    mpfr_class operator*(const unsigned long int other) &&;
+    mpfr_class operator*(const unsigned long long int other) const&;
+    mpfr_class operator*(const unsigned long long int other) &&;
+    mpfr_class operator*(const float other) const&;
+    mpfr_class operator*(const float other) &&;
+    mpfr_class operator*(const double other) const&;
+    mpfr_class operator*(const double other) &&;
+    mpfr_class operator*(const long double other) const&;
+    mpfr_class operator*(const long double other) &&;
+
+    friend mpfr_class operator*(const mpfr_class& left, mpfr_class&& right);
+    friend mpfr_class operator*(mpfr_class&& left, mpfr_class&& right);
+    friend mpfr_class operator*(const mpfr_ptr left, mpfr_class&& right);
+    friend mpfr_class operator*(const int left, mpfr_class&& right);
+    friend mpfr_class operator*(const long int left, mpfr_class&& right);
+    friend mpfr_class operator*(const long long int left, mpfr_class&& right);
+    friend mpfr_class operator*(const unsigned int left, mpfr_class&& right);
+    friend mpfr_class operator*(const unsigned long int left, mpfr_class&& right);
+    friend mpfr_class operator*(const unsigned long long int left, mpfr_class&& right);
+    friend mpfr_class operator*(const float left, mpfr_class&& right);
+    friend mpfr_class operator*(const double left, mpfr_class&& right);
+    friend mpfr_class operator*(const long double left, mpfr_class&& right);
 
     friend mpfr_class operator*(const mpfr_ptr left, const mpfr_class& right);
     friend mpfr_class operator*(const int left, const mpfr_class& right);
@@ -184,18 +275,43 @@ public:
     mpfr_class& operator*=(const float other);
     mpfr_class& operator*=(const double other);
     mpfr_class& operator*=(const long double other);
-
-    mpfr_class operator/(const mpfr_class& other) const;
-    mpfr_class operator/(const mpfr_ptr other) const;
-    mpfr_class operator/(const int other) const;
-    mpfr_class operator/(const long int other) const;
-    mpfr_class operator/(const long long int other) const;
-    mpfr_class operator/(const unsigned int other) const;
-    mpfr_class operator/(const unsigned long int other) const;
-    mpfr_class operator/(const unsigned long long int other) const;
-    mpfr_class operator/(const float other) const;
-    mpfr_class operator/(const double other) const;
-    mpfr_class operator/(const long double other) const;
+    template <class E> mpfr_class& operator*=(const mpfr_expression<E>& other);
+
+    mpfr_class operator/(const mpfr_class& other) const&;
+    mpfr_class operator/(const mpfr_class& other) &&;
+    mpfr_class operator/(const mpfr_ptr other) const&;
+    mpfr_class operator/(const mpfr_ptr other) &&;
+    mpfr_class operator/(const int other) const&;
+    mpfr_class operator/(const int other) &&;
+    mpfr_class operator/(const long int other) const&;
+    mpfr_class operator/(const long int other) &&;
+    mpfr_class operator/(const long long int other) const&;
+    mpfr_class operator/(const long long int other) &&;
+    mpfr_class operator/(const unsigned int other) const&;
+    mpfr_class operator/(const unsigned int other) &&;
+    mpfr_class operator/(const unsigned long int other) const&;
+    mpfr_class operator/(const unsigned long int other) &&;
+    mpfr_class operator/(const unsigned long long int other) const&;
+    mpfr_class operator/(const unsigned long long int other) &&;
+    mpfr_class operator/(const float other) const&;
+    mpfr_class operator/(const float other) &&;
+    mpfr_class operator/(const double other) const&;
+    mpfr_class operator/(const double other) &&;
+    mpfr_class operator/(const long double other) const&;
+    mpfr_class operator/(const long double other) &&;
+
+    friend mpfr_class operator/(const mpfr_class& left, mpfr_class&& right);
+    friend mpfr_class operator/(mpfr_class&& left, mpfr_class&& right);
+    friend mpfr_class operator/(const mpfr_ptr left, mpfr_class&& right);
+    friend mpfr_class operator/(const int left, mpfr_class&& right);
+    friend mpfr_class operator/(const long int left, mpfr_class&& right);
+    friend mpfr_class operator/(const long long int left, mpfr_class&& right);
+    friend mpfr_class operator/(const unsigned int left, mpfr_class&& right);
+    friend mpfr_class operator/(const unsigned long int left, mpfr_class&& right);
+    friend mpfr_class operator/(const unsigned long long int left, mpfr_class&& right);
+    friend mpfr_class operator/(const float left, mpfr_class&& right);
+    friend mpfr_class operator/(const double left, mpfr_class&& right);
+    friend mpfr_class operator/(const long double left, mpfr_class&& right);
 
     friend mpfr_class operator/(const mpfr_ptr left, const mpfr_class& right);
     friend mpfr_class operator/(const int left, const mpfr_class& right);
@@ -219,18 +335,43 @@ public:
     mpfr_class& operator/=(const float other);
     mpfr_class& operator/=(const double other);
     mpfr_class& operator/=(const long double other);
-
-    mpfr_class operator^(const mpfr_class& other) const;
-    mpfr_class operator^(const mpfr_ptr other) const;
-    mpfr_class operator^(const int other) const;
-    mpfr_class operator^(const long int other) const;
-    mpfr_class operator^(const long long int other) const;
-    mpfr_class operator^(const unsigned int other) const;
-    mpfr_class operator^(const unsigned long int other) const;
-    mpfr_class operator^(const unsigned long long int other) const;
-    mpfr_class operator^(const float other) const;
-    mpfr_class operator^(const double other) const;
-    mpfr_class operator^(const long double other) const;
+    template <class E> mpfr_class& operator/=(const mpfr_expression<E>& other);
+
+    mpfr_class operator^(const mpfr_class& other) const&;
+    mpfr_class operator^(const mpfr_class& other) &&;
+    mpfr_class operator^(const mpfr_ptr other) const&;
+    mpfr_class operator^(const mpfr_ptr other) &&;
+    mpfr_class operator^(const int other) const&;
+    mpfr_class operator^(const int other) &&;
+    mpfr_class operator^(const long int other) const&;
+    mpfr_class operator^(const long int other) &&;
+    mpfr_class operator^(const long long int other) const&;
+    mpfr_class operator^(const long long int other) &&;
+    mpfr_class operator^(const unsigned int other) const&;
+    mpfr_class operator^(const unsigned int other) &&;
+    mpfr_class operator^(const unsigned long int other) const&;
+    mpfr_class operator^(const unsigned long int other) &&;
+    mpfr_class operator^(const unsigned long long int other) const&;
+    mpfr_class operator^(const unsigned long long int other) &&;
+    mpfr_class operator^(const float other) const&;
+    mpfr_class operator^(const float other) &&;
+    mpfr_class operator^(const double other) const&;
+    mpfr_class operator^(const double other) &&;
+    mpfr_class operator^(const long double other) const&;
+    mpfr_class operator^(const long double other) &&;
+
+    friend mpfr_class operator^(const mpfr_class& left, mpfr_class&& right);
+    friend mpfr_class operator^(mpfr_class&& left, mpfr_class&& right);
+    friend mpfr_class operator^(const mpfr_ptr left, mpfr_class&& right);
+    friend mpfr_class operator^(const int left, mpfr_class&& right);
+    friend mpfr_class operator^(const long int left, mpfr_class&& right);
+    friend mpfr_class operator^(const long long int left, mpfr_class&& right);
+    friend mpfr_class operator^(const unsigned int left, mpfr_class&& right);
+    friend mpfr_class operator^(const unsigned long int left, mpfr_class&& right);
+    friend mpfr_class operator^(const unsigned long long int left, mpfr_class&& right);
+    friend mpfr_class operator^(const float left, mpfr_class&& right);
+    friend mpfr_class operator^(const double left, mpfr_class&& right);
+    friend mpfr_class operator^(const long double left, mpfr_class&& right);
 
     friend mpfr_class operator^(const mpfr_ptr left, const mpfr_class& right);
     friend mpfr_class operator^(const int left, const mpfr_class& right);
@@ -396,6 +537,11 @@ public:
     mpfr_class pow_value(const mpfr_class& exponent) const;
     void to_pow(const mpfr_class& exponent);
 
+    mpfr_class& fma(const mpfr_class& left, const mpfr_class& right, const mpfr_class& addend);
+    mpfr_class& fms(const mpfr_class& left, const mpfr_class& right, const mpfr_class& subtrahend);
+    mpfr_class& addmul(const mpfr_class& left, const mpfr_class& right);
+    mpfr_class& submul(const mpfr_class& left, const mpfr_class& right);
+
     int int_value() const;
     long int long_value() const;
     long long int llong_value() const;
@@ -405,6 +551,7 @@ public:
     float float_value() const;
     double double_value() const;
     long double ldouble_value() const;
+    mpfr_class class_value() const;
 
 #if __has_feature(cxx_explicit_conversions)
     explicit operator int() const { return this->int_value(); }
@@ -458,8 +605,13 @@ public:
     mpfr_class tan_value() const;
     void to_tan();
 
+    mpfr_ptr get_raw();
+    mpfr_srcptr get_raw() const;
+
     mpfr_prec_t get_prec() const;
+    mpfr_exp_t get_exp() const;
     void set_prec(mpfr_prec_t prec);
+    void round_prec(mpfr_prec_t prec);
 
     bool is_nan() const;
     bool is_inf() const;
@@ -477,6 +629,27 @@ public:
 
     void clear();
 
+    // Storage handed out by containers. Shared limbs belong to the container
+    // and keep their precision: values assigned or moved in are rounded, and
+    // moving out copies.
+    void share_limbs(mp_limb_t *limbs, const mpfr_prec_t prec);
+    void relocate_limbs(mp_limb_t *limbs);
+    void unshare_limbs();
+    bool has_shared_limbs() const;
+
+private:
+
+    bool is_initialized() const;
+    void set_uninitialized();
+    void reinit(mpfr_prec_t prec);
+    void widen_prec(mpfr_srcptr other);
+
+    template <class E> void evaluate(const E& expression);
+
+    static mpfr_ptr destination(mpfr_class& result);
+    static mpfr_prec_t result_prec(mpfr_srcptr value);
+    static mpfr_prec_t result_prec(mpfr_srcptr left, mpfr_srcptr right);
+
 public:
 
     static mpfr_rnd_t get_default_rnd();
@@ -485,11 +658,44 @@ public:
     static mpfr_prec_t get_default_prec();
     static void set_default_prec(mpfr_prec_t prec);
 
+    static mpfr_precision_mode get_precision_mode();
+    static void set_precision_mode(mpfr_precision_mode mode);
+
+    static void pow_raw(mpfr_ptr result, mpfr_srcptr base, mpfr_srcptr exponent);
+
+    static void set(mpfr_class& result, const mpfr_class& value);
+    static void add(mpfr_class& result, const mpfr_class& left, const mpfr_class& right);
+    static void add(mpfr_class& result, const mpfr_class& left, const unsigned long int right);
+    static void sub(mpfr_class& result, const mpfr_class& left, const mpfr_class& right);
+    static void sub(mpfr_class& result, const mpfr_class& left, const unsigned long int right);
+    static void sub(mpfr_class& result, const unsigned long int left, const mpfr_class& right);
+    static void mul(mpfr_class& result, const mpfr_class& left, const mpfr_class& right);
+    static void mul(mpfr_class& result, const mpfr_class& left, const unsigned long int right);
+    static void div(mpfr_class& result, const mpfr_class& left, const mpfr_class& right);
+    static void div(mpfr_class& result, const mpfr_class& left, const unsigned long int right);
+    static void div(mpfr_class& result, const unsigned long int left, const mpfr_class& right);
+    static void pow(mpfr_class& result, const mpfr_class& base, const mpfr_class& exponent);
+    static void pow_ui(mpfr_class& result, const mpfr_class& base, const unsigned long int exponent);
+
+    static void abs_into(mpfr_class& result, const mpfr_class& value);
+    static void sqrt_into(mpfr_class& result, const mpfr_class& value);
+    static void log_into(mpfr_class& result, const mpfr_class& value);
+    static void log2_into(mpfr_class& result, const mpfr_class& value);
+    static void log10_into(mpfr_class& result, const mpfr_class& value);
+    static void exp_into(mpfr_class& result, const mpfr_class& value);
+    static void exp2_into(mpfr_class& result, const mpfr_class& value);
+    static void exp10_into(mpfr_class& result, const mpfr_class& value);
+    static void cos_into(mpfr_class& result, const mpfr_class& value);
+    static void sin_into(mpfr_class& result, const mpfr_class& value);
+    static void tan_into(mpfr_class& result, const mpfr_class& value);
+
     static mpfr_class const_log2();
     static mpfr_class const_pi();
     static mpfr_class const_euler();
     static mpfr_class const_catalan();
 
+    static mpfr_class literal(const std::string& literal);
+
 }; // class mpfr_class
 
 #endif // __MPFR_CLASS_H__
@@ -0,0 +1,49 @@
+//
+//  mpfr_context.cpp
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#include "mpfr_context.h"
+
+mpfr_context::mpfr_context(const mpfr_prec_t prec, const mpfr_rnd_t rnd) {
+    this->m_previous_prec = mpfr_class::get_default_prec();
+    this->m_previous_rnd = mpfr_class::get_default_rnd();
+    mpfr_class::set_default_prec(prec);
+    mpfr_class::set_default_rnd(rnd);
+}
+
+mpfr_context::~mpfr_context() {
+    mpfr_class::set_default_prec(this->m_previous_prec);
+    mpfr_class::set_default_rnd(this->m_previous_rnd);
+}
+
+mpfr_precision_mode_context::mpfr_precision_mode_context(const mpfr_precision_mode mode) {
+    this->m_previous_mode = mpfr_class::get_precision_mode();
+    mpfr_class::set_precision_mode(mode);
+}
+
+mpfr_precision_mode_context::~mpfr_precision_mode_context() {
+    mpfr_class::set_precision_mode(this->m_previous_mode);
+}
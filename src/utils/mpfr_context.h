@@ -0,0 +1,71 @@
+//
+//  mpfr_context.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __MPFR_CONTEXT_H__
+#define __MPFR_CONTEXT_H__
+
+#include "mpfr_class.h"
+
+// Sets the default precision and rounding mode of the calling thread for its
+// lifetime and restores the previous ones afterwards. Contexts nest.
+
+class mpfr_context {
+
+private:
+
+    mpfr_prec_t m_previous_prec;
+    mpfr_rnd_t m_previous_rnd;
+
+public:
+
+    explicit mpfr_context(const mpfr_prec_t prec, const mpfr_rnd_t rnd = mpfr_class::get_default_rnd());
+    ~mpfr_context();
+
+    mpfr_context(const mpfr_context& other) = delete;
+    mpfr_context& operator=(const mpfr_context& other) = delete;
+
+}; // class mpfr_context
+
+// Sets the precision mode of the calling thread for its lifetime.
+
+class mpfr_precision_mode_context {
+
+private:
+
+    mpfr_precision_mode m_previous_mode;
+
+public:
+
+    explicit mpfr_precision_mode_context(const mpfr_precision_mode mode);
+    ~mpfr_precision_mode_context();
+
+    mpfr_precision_mode_context(const mpfr_precision_mode_context& other) = delete;
+    mpfr_precision_mode_context& operator=(const mpfr_precision_mode_context& other) = delete;
+
+}; // class mpfr_precision_mode_context
+
+#endif // __MPFR_CONTEXT_H__
@@ -0,0 +1,67 @@
+//
+//  mpfr_expression.cpp
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#include "mpfr_expression.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+mpfr_expression_registers::mpfr_expression_registers() {
+    this->m_size = 0;
+}
+
+mpfr_expression_registers::~mpfr_expression_registers() {
+    for (size_t i = 0; i < this->m_size; ++i) {
+        mpfr_clear(this->m_raw[i]);
+    }
+}
+
+void mpfr_expression_registers::reserve(const size_t size, const mpfr_prec_t prec) {
+    if (size > mpfr_expression_max_registers) {
+        printf("mpfr_expression_registers[%s:%d]: Too many registers requested.\n", __FILE__, __LINE__);
+        abort();
+    }
+    for (size_t i = 0; i < size; ++i) {
+        if (i >= this->m_size) {
+            mpfr_init2(this->m_raw[i], prec);
+        } else if (mpfr_get_prec(this->m_raw[i]) != prec) {
+            mpfr_set_prec(this->m_raw[i], prec);
+        }
+    }
+    if (size > this->m_size) {
+        this->m_size = size;
+    }
+}
+
+mpfr_ptr mpfr_expression_registers::operator[](const size_t index) {
+    return this->m_raw[index];
+}
+
+mpfr_expression_registers& mpfr_expression_registers::local() {
+    static thread_local mpfr_expression_registers registers;
+    return registers;
+}
@@ -0,0 +1,860 @@
+//
+//  mpfr_expression.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __MPFR_EXPRESSION_H__
+#define __MPFR_EXPRESSION_H__
+
+#include <stddef.h>
+#include <limits.h>
+#include <float.h>
+#include <mpfr.h>
+
+#include "mpfr_class.h"
+#include "mpfr_pool.h"
+
+// Lazy arithmetic on mpfr_class. Wrapping an operand with mpfr_expr() turns the
+// surrounding arithmetic into an expression tree which is evaluated into the
+// destination on assignment, using a few thread-local scratch registers at the
+// precision of the destination. Products that are added or subtracted are fused
+// into mpfr_fma/mpfr_fms. Leaves refer to their operands, so an expression must
+// be assigned within the full-expression that created it.
+
+const size_t mpfr_expression_max_registers = 8;
+
+class mpfr_expression_registers {
+
+private:
+
+    mpfr_t m_raw[mpfr_expression_max_registers];
+    size_t m_size;
+
+public:
+
+    mpfr_expression_registers();
+    ~mpfr_expression_registers();
+
+    void reserve(const size_t size, const mpfr_prec_t prec);
+
+    mpfr_ptr operator[](const size_t index);
+
+    static mpfr_expression_registers& local();
+
+}; // class mpfr_expression_registers
+
+constexpr size_t mpfr_expression_max(const size_t left, const size_t right) {
+    return (left > right) ? left : right;
+}
+
+template <class E>
+struct mpfr_expression_operand_registers {
+    static const size_t value = E::is_leaf ? 0 : E::n_registers + 1;
+};
+
+template <class E>
+class mpfr_expression {
+
+public:
+
+    const E& self() const {
+        return *static_cast<const E*>(this);
+    }
+
+}; // class mpfr_expression
+
+class mpfr_expression_value : public mpfr_expression<mpfr_expression_value> {
+
+private:
+
+    mpfr_srcptr m_raw;
+
+public:
+
+    static const bool is_leaf = true;
+    static const size_t n_registers = 0;
+
+    explicit mpfr_expression_value(const mpfr_class& value) : m_raw(value.get_raw()) {}
+    explicit mpfr_expression_value(mpfr_srcptr raw) : m_raw(raw) {}
+
+    bool aliases(mpfr_srcptr raw) const {
+        return this->m_raw == raw;
+    }
+
+    mpfr_prec_t precision() const {
+        return mpfr_get_prec(this->m_raw);
+    }
+
+    void evaluate(mpfr_ptr result, mpfr_expression_registers& registers, const size_t index) const {
+        mpfr_set(result, this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_srcptr operand(mpfr_expression_registers& registers, const size_t index) const {
+        return this->m_raw;
+    }
+
+}; // class mpfr_expression_value
+
+inline mpfr_expression_value mpfr_expr(const mpfr_class& value) {
+    return mpfr_expression_value(value);
+}
+
+template <class T>
+struct mpfr_expression_scalar {};
+
+template <> struct mpfr_expression_scalar<int> { typedef long int type; };
+template <> struct mpfr_expression_scalar<long int> { typedef long int type; };
+template <> struct mpfr_expression_scalar<long long int> { typedef long long int type; };
+template <> struct mpfr_expression_scalar<unsigned int> { typedef unsigned long int type; };
+template <> struct mpfr_expression_scalar<unsigned long int> { typedef unsigned long int type; };
+template <> struct mpfr_expression_scalar<unsigned long long int> { typedef unsigned long long int type; };
+template <> struct mpfr_expression_scalar<float> { typedef double type; };
+template <> struct mpfr_expression_scalar<double> { typedef double type; };
+template <> struct mpfr_expression_scalar<long double> { typedef long double type; };
+
+inline mpfr_rnd_t mpfr_expression_negated_rnd(const mpfr_rnd_t rnd) {
+    switch (rnd) {
+        case MPFR_RNDU: return MPFR_RNDD;
+        case MPFR_RNDD: return MPFR_RNDU;
+        default: return rnd;
+    }
+}
+
+struct mpfr_expression_add {
+    static void apply(mpfr_ptr result, mpfr_srcptr left, mpfr_srcptr right) {
+        mpfr_add(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const long int right) {
+        mpfr_add_si(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const unsigned long int right) {
+        mpfr_add_ui(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const double right) {
+        mpfr_add_d(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const long int left, mpfr_srcptr right) {
+        mpfr_add_si(result, right, left, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const unsigned long int left, mpfr_srcptr right) {
+        mpfr_add_ui(result, right, left, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const double left, mpfr_srcptr right) {
+        mpfr_add_d(result, right, left, mpfr_class::get_default_rnd());
+    }
+};
+
+struct mpfr_expression_sub {
+    static void apply(mpfr_ptr result, mpfr_srcptr left, mpfr_srcptr right) {
+        mpfr_sub(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const long int right) {
+        mpfr_sub_si(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const unsigned long int right) {
+        mpfr_sub_ui(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const double right) {
+        mpfr_sub_d(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const long int left, mpfr_srcptr right) {
+        mpfr_si_sub(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const unsigned long int left, mpfr_srcptr right) {
+        mpfr_ui_sub(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const double left, mpfr_srcptr right) {
+        mpfr_d_sub(result, left, right, mpfr_class::get_default_rnd());
+    }
+};
+
+struct mpfr_expression_mul {
+    static void apply(mpfr_ptr result, mpfr_srcptr left, mpfr_srcptr right) {
+        mpfr_mul(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const long int right) {
+        mpfr_mul_si(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const unsigned long int right) {
+        mpfr_mul_ui(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const double right) {
+        mpfr_mul_d(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const long int left, mpfr_srcptr right) {
+        mpfr_mul_si(result, right, left, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const unsigned long int left, mpfr_srcptr right) {
+        mpfr_mul_ui(result, right, left, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const double left, mpfr_srcptr right) {
+        mpfr_mul_d(result, right, left, mpfr_class::get_default_rnd());
+    }
+};
+
+struct mpfr_expression_div {
+    static void apply(mpfr_ptr result, mpfr_srcptr left, mpfr_srcptr right) {
+        mpfr_div(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const long int right) {
+        mpfr_div_si(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const unsigned long int right) {
+        mpfr_div_ui(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const double right) {
+        mpfr_div_d(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const long int left, mpfr_srcptr right) {
+        mpfr_si_div(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const unsigned long int left, mpfr_srcptr right) {
+        mpfr_ui_div(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const double left, mpfr_srcptr right) {
+        mpfr_d_div(result, left, right, mpfr_class::get_default_rnd());
+    }
+};
+
+struct mpfr_expression_pow {
+    static void apply(mpfr_ptr result, mpfr_srcptr left, mpfr_srcptr right) {
+        mpfr_pow(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const long int right) {
+        mpfr_pow_si(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const unsigned long int right) {
+        mpfr_pow_ui(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, mpfr_srcptr left, const double right) {
+        MPFR_DECL_INIT(tmp_right, DBL_MANT_DIG);
+        mpfr_set_d(tmp_right, right, mpfr_class::get_default_rnd());
+        mpfr_pow(result, left, tmp_right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const long int left, mpfr_srcptr right) {
+        MPFR_DECL_INIT(tmp_left, sizeof(long int) * CHAR_BIT);
+        mpfr_set_si(tmp_left, left, mpfr_class::get_default_rnd());
+        mpfr_pow(result, tmp_left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const unsigned long int left, mpfr_srcptr right) {
+        mpfr_ui_pow(result, left, right, mpfr_class::get_default_rnd());
+    }
+    static void apply(mpfr_ptr result, const double left, mpfr_srcptr right) {
+        MPFR_DECL_INIT(tmp_left, DBL_MANT_DIG);
+        mpfr_set_d(tmp_left, left, mpfr_class::get_default_rnd());
+        mpfr_pow(result, tmp_left, right, mpfr_class::get_default_rnd());
+    }
+};
+
+template <class Op>
+void mpfr_expression_apply(mpfr_ptr result, mpfr_srcptr left, const long int right) {
+    Op::apply(result, left, right);
+}
+
+template <class Op>
+void mpfr_expression_apply(mpfr_ptr result, mpfr_srcptr left, const unsigned long int right) {
+    Op::apply(result, left, right);
+}
+
+template <class Op>
+void mpfr_expression_apply(mpfr_ptr result, mpfr_srcptr left, const double right) {
+    Op::apply(result, left, right);
+}
+
+template <class Op>
+void mpfr_expression_apply(mpfr_ptr result, mpfr_srcptr left, const long long int right) {
+    MPFR_DECL_INIT(tmp_right, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_right, right, mpfr_class::get_default_rnd());
+    Op::apply(result, left, tmp_right);
+}
+
+template <class Op>
+void mpfr_expression_apply(mpfr_ptr result, mpfr_srcptr left, const unsigned long long int right) {
+    MPFR_DECL_INIT(tmp_right, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_right, right, mpfr_class::get_default_rnd());
+    Op::apply(result, left, tmp_right);
+}
+
+template <class Op>
+void mpfr_expression_apply(mpfr_ptr result, mpfr_srcptr left, const long double right) {
+    MPFR_DECL_INIT(tmp_right, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_right, right, mpfr_class::get_default_rnd());
+    Op::apply(result, left, tmp_right);
+}
+
+template <class Op>
+void mpfr_expression_apply(mpfr_ptr result, const long int left, mpfr_srcptr right) {
+    Op::apply(result, left, right);
+}
+
+template <class Op>
+void mpfr_expression_apply(mpfr_ptr result, const unsigned long int left, mpfr_srcptr right) {
+    Op::apply(result, left, right);
+}
+
+template <class Op>
+void mpfr_expression_apply(mpfr_ptr result, const double left, mpfr_srcptr right) {
+    Op::apply(result, left, right);
+}
+
+template <class Op>
+void mpfr_expression_apply(mpfr_ptr result, const long long int left, mpfr_srcptr right) {
+    MPFR_DECL_INIT(tmp_left, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_left, left, mpfr_class::get_default_rnd());
+    Op::apply(result, tmp_left, right);
+}
+
+template <class Op>
+void mpfr_expression_apply(mpfr_ptr result, const unsigned long long int left, mpfr_srcptr right) {
+    MPFR_DECL_INIT(tmp_left, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_left, left, mpfr_class::get_default_rnd());
+    Op::apply(result, tmp_left, right);
+}
+
+template <class Op>
+void mpfr_expression_apply(mpfr_ptr result, const long double left, mpfr_srcptr right) {
+    MPFR_DECL_INIT(tmp_left, LDBL_MANT_DIG);
+    mpfr_set_ld(tmp_left, left, mpfr_class::get_default_rnd());
+    Op::apply(result, tmp_left, right);
+}
+
+template <class Op, class L, class R>
+struct mpfr_expression_kernel {
+    static const size_t n_registers = mpfr_expression_max(L::n_registers, mpfr_expression_operand_registers<R>::value);
+    static void evaluate(const L& left, const R& right, mpfr_ptr result, mpfr_expression_registers& registers, const size_t index) {
+        if (L::is_leaf) {
+            Op::apply(result, left.operand(registers, index), right.operand(registers, index));
+        } else {
+            left.evaluate(result, registers, index);
+            Op::apply(result, result, right.operand(registers, index));
+        }
+    }
+};
+
+template <class Op, class L, class R>
+class mpfr_expression_binary : public mpfr_expression<mpfr_expression_binary<Op, L, R> > {
+
+private:
+
+    typedef mpfr_expression_kernel<Op, L, R> kernel;
+
+    const L m_left;
+    const R m_right;
+
+public:
+
+    static const bool is_leaf = false;
+    static const size_t n_registers = kernel::n_registers;
+
+    mpfr_expression_binary(const L& left, const R& right) : m_left(left), m_right(right) {}
+
+    const L& get_left() const {
+        return this->m_left;
+    }
+
+    const R& get_right() const {
+        return this->m_right;
+    }
+
+    bool aliases(mpfr_srcptr raw) const {
+        return this->m_left.aliases(raw) || this->m_right.aliases(raw);
+    }
+
+    mpfr_prec_t precision() const {
+        mpfr_prec_t left = this->m_left.precision();
+        mpfr_prec_t right = this->m_right.precision();
+        return (left > right) ? left : right;
+    }
+
+    void evaluate(mpfr_ptr result, mpfr_expression_registers& registers, const size_t index) const {
+        kernel::evaluate(this->m_left, this->m_right, result, registers, index);
+    }
+
+    mpfr_srcptr operand(mpfr_expression_registers& registers, const size_t index) const {
+        this->evaluate(registers[index], registers, index + 1);
+        return registers[index];
+    }
+
+}; // class mpfr_expression_binary
+
+template <class A, class B, class R>
+struct mpfr_expression_kernel<mpfr_expression_add, mpfr_expression_binary<mpfr_expression_mul, A, B>, R> {
+    typedef mpfr_expression_binary<mpfr_expression_mul, A, B> L;
+    static const size_t n_registers = mpfr_expression_operand_registers<A>::value +
+                                      mpfr_expression_operand_registers<B>::value +
+                                      mpfr_expression_operand_registers<R>::value;
+    static void evaluate(const L& left, const R& right, mpfr_ptr result, mpfr_expression_registers& registers, const size_t index) {
+        const size_t index_b = index + mpfr_expression_operand_registers<A>::value;
+        const size_t index_c = index_b + mpfr_expression_operand_registers<B>::value;
+        mpfr_fma(result,
+                 left.get_left().operand(registers, index),
+                 left.get_right().operand(registers, index_b),
+                 right.operand(registers, index_c),
+                 mpfr_class::get_default_rnd());
+    }
+};
+
+template <class L, class A, class B>
+struct mpfr_expression_kernel<mpfr_expression_add, L, mpfr_expression_binary<mpfr_expression_mul, A, B> > {
+    typedef mpfr_expression_binary<mpfr_expression_mul, A, B> R;
+    static const size_t n_registers = mpfr_expression_operand_registers<A>::value +
+                                      mpfr_expression_operand_registers<B>::value +
+                                      mpfr_expression_operand_registers<L>::value;
+    static void evaluate(const L& left, const R& right, mpfr_ptr result, mpfr_expression_registers& registers, const size_t index) {
+        const size_t index_b = index + mpfr_expression_operand_registers<A>::value;
+        const size_t index_c = index_b + mpfr_expression_operand_registers<B>::value;
+        mpfr_fma(result,
+                 right.get_left().operand(registers, index),
+                 right.get_right().operand(registers, index_b),
+                 left.operand(registers, index_c),
+                 mpfr_class::get_default_rnd());
+    }
+};
+
+template <class A, class B, class C, class D>
+struct mpfr_expression_kernel<mpfr_expression_add, mpfr_expression_binary<mpfr_expression_mul, A, B>, mpfr_expression_binary<mpfr_expression_mul, C, D> > {
+    typedef mpfr_expression_binary<mpfr_expression_mul, A, B> L;
+    typedef mpfr_expression_binary<mpfr_expression_mul, C, D> R;
+    static const size_t n_registers = mpfr_expression_operand_registers<A>::value +
+                                      mpfr_expression_operand_registers<B>::value +
+                                      mpfr_expression_operand_registers<R>::value;
+    static void evaluate(const L& left, const R& right, mpfr_ptr result, mpfr_expression_registers& registers, const size_t index) {
+        const size_t index_b = index + mpfr_expression_operand_registers<A>::value;
+        const size_t index_c = index_b + mpfr_expression_operand_registers<B>::value;
+        mpfr_fma(result,
+                 left.get_left().operand(registers, index),
+                 left.get_right().operand(registers, index_b),
+                 right.operand(registers, index_c),
+                 mpfr_class::get_default_rnd());
+    }
+};
+
+template <class A, class B, class R>
+struct mpfr_expression_kernel<mpfr_expression_sub, mpfr_expression_binary<mpfr_expression_mul, A, B>, R> {
+    typedef mpfr_expression_binary<mpfr_expression_mul, A, B> L;
+    static const size_t n_registers = mpfr_expression_operand_registers<A>::value +
+                                      mpfr_expression_operand_registers<B>::value +
+                                      mpfr_expression_operand_registers<R>::value;
+    static void evaluate(const L& left, const R& right, mpfr_ptr result, mpfr_expression_registers& registers, const size_t index) {
+        const size_t index_b = index + mpfr_expression_operand_registers<A>::value;
+        const size_t index_c = index_b + mpfr_expression_operand_registers<B>::value;
+        mpfr_fms(result,
+                 left.get_left().operand(registers, index),
+                 left.get_right().operand(registers, index_b),
+                 right.operand(registers, index_c),
+                 mpfr_class::get_default_rnd());
+    }
+};
+
+// c - a*b is evaluated as -(a*b - c) with the directed rounding modes swapped.
+template <class L, class A, class B>
+struct mpfr_expression_kernel<mpfr_expression_sub, L, mpfr_expression_binary<mpfr_expression_mul, A, B> > {
+    typedef mpfr_expression_binary<mpfr_expression_mul, A, B> R;
+    static const size_t n_registers = mpfr_expression_operand_registers<A>::value +
+                                      mpfr_expression_operand_registers<B>::value +
+                                      mpfr_expression_operand_registers<L>::value;
+    static void evaluate(const L& left, const R& right, mpfr_ptr result, mpfr_expression_registers& registers, const size_t index) {
+        const size_t index_b = index + mpfr_expression_operand_registers<A>::value;
+        const size_t index_c = index_b + mpfr_expression_operand_registers<B>::value;
+        mpfr_fms(result,
+                 right.get_left().operand(registers, index),
+                 right.get_right().operand(registers, index_b),
+                 left.operand(registers, index_c),
+                 mpfr_expression_negated_rnd(mpfr_class::get_default_rnd()));
+        mpfr_neg(result, result, mpfr_class::get_default_rnd());
+    }
+};
+
+template <class A, class B, class C, class D>
+struct mpfr_expression_kernel<mpfr_expression_sub, mpfr_expression_binary<mpfr_expression_mul, A, B>, mpfr_expression_binary<mpfr_expression_mul, C, D> > {
+    typedef mpfr_expression_binary<mpfr_expression_mul, A, B> L;
+    typedef mpfr_expression_binary<mpfr_expression_mul, C, D> R;
+    static const size_t n_registers = mpfr_expression_operand_registers<A>::value +
+                                      mpfr_expression_operand_registers<B>::value +
+                                      mpfr_expression_operand_registers<R>::value;
+    static void evaluate(const L& left, const R& right, mpfr_ptr result, mpfr_expression_registers& registers, const size_t index) {
+        const size_t index_b = index + mpfr_expression_operand_registers<A>::value;
+        const size_t index_c = index_b + mpfr_expression_operand_registers<B>::value;
+        mpfr_fms(result,
+                 left.get_left().operand(registers, index),
+                 left.get_right().operand(registers, index_b),
+                 right.operand(registers, index_c),
+                 mpfr_class::get_default_rnd());
+    }
+};
+
+template <class Op, class L, class T>
+class mpfr_expression_binary_scalar : public mpfr_expression<mpfr_expression_binary_scalar<Op, L, T> > {
+
+private:
+
+    const L m_left;
+    const T m_right;
+
+public:
+
+    static const bool is_leaf = false;
+    static const size_t n_registers = L::n_registers;
+
+    mpfr_expression_binary_scalar(const L& left, const T right) : m_left(left), m_right(right) {}
+
+    bool aliases(mpfr_srcptr raw) const {
+        return this->m_left.aliases(raw);
+    }
+
+    mpfr_prec_t precision() const {
+        return this->m_left.precision();
+    }
+
+    void evaluate(mpfr_ptr result, mpfr_expression_registers& registers, const size_t index) const {
+        if (L::is_leaf) {
+            mpfr_expression_apply<Op>(result, this->m_left.operand(registers, index), this->m_right);
+        } else {
+            this->m_left.evaluate(result, registers, index);
+            mpfr_expression_apply<Op>(result, result, this->m_right);
+        }
+    }
+
+    mpfr_srcptr operand(mpfr_expression_registers& registers, const size_t index) const {
+        this->evaluate(registers[index], registers, index + 1);
+        return registers[index];
+    }
+
+}; // class mpfr_expression_binary_scalar
+
+template <class Op, class T, class R>
+class mpfr_expression_scalar_binary : public mpfr_expression<mpfr_expression_scalar_binary<Op, T, R> > {
+
+private:
+
+    const T m_left;
+    const R m_right;
+
+public:
+
+    static const bool is_leaf = false;
+    static const size_t n_registers = R::n_registers;
+
+    mpfr_expression_scalar_binary(const T left, const R& right) : m_left(left), m_right(right) {}
+
+    bool aliases(mpfr_srcptr raw) const {
+        return this->m_right.aliases(raw);
+    }
+
+    mpfr_prec_t precision() const {
+        return this->m_right.precision();
+    }
+
+    void evaluate(mpfr_ptr result, mpfr_expression_registers& registers, const size_t index) const {
+        if (R::is_leaf) {
+            mpfr_expression_apply<Op>(result, this->m_left, this->m_right.operand(registers, index));
+        } else {
+            this->m_right.evaluate(result, registers, index);
+            mpfr_expression_apply<Op>(result, this->m_left, result);
+        }
+    }
+
+    mpfr_srcptr operand(mpfr_expression_registers& registers, const size_t index) const {
+        this->evaluate(registers[index], registers, index + 1);
+        return registers[index];
+    }
+
+}; // class mpfr_expression_scalar_binary
+
+template <class E>
+class mpfr_expression_negate : public mpfr_expression<mpfr_expression_negate<E> > {
+
+private:
+
+    const E m_value;
+
+public:
+
+    static const bool is_leaf = false;
+    static const size_t n_registers = E::n_registers;
+
+    explicit mpfr_expression_negate(const E& value) : m_value(value) {}
+
+    bool aliases(mpfr_srcptr raw) const {
+        return this->m_value.aliases(raw);
+    }
+
+    mpfr_prec_t precision() const {
+        return this->m_value.precision();
+    }
+
+    void evaluate(mpfr_ptr result, mpfr_expression_registers& registers, const size_t index) const {
+        if (E::is_leaf) {
+            mpfr_neg(result, this->m_value.operand(registers, index), mpfr_class::get_default_rnd());
+        } else {
+            this->m_value.evaluate(result, registers, index);
+            mpfr_neg(result, result, mpfr_class::get_default_rnd());
+        }
+    }
+
+    mpfr_srcptr operand(mpfr_expression_registers& registers, const size_t index) const {
+        this->evaluate(registers[index], registers, index + 1);
+        return registers[index];
+    }
+
+}; // class mpfr_expression_negate
+
+template <class E>
+mpfr_expression_negate<E> operator-(const mpfr_expression<E>& value) {
+    return mpfr_expression_negate<E>(value.self());
+}
+
+template <class L, class R>
+mpfr_expression_binary<mpfr_expression_add, L, R> operator+(const mpfr_expression<L>& left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_add, L, R>(left.self(), right.self());
+}
+
+template <class L>
+mpfr_expression_binary<mpfr_expression_add, L, mpfr_expression_value> operator+(const mpfr_expression<L>& left, const mpfr_class& right) {
+    return mpfr_expression_binary<mpfr_expression_add, L, mpfr_expression_value>(left.self(), mpfr_expression_value(right));
+}
+
+template <class L>
+mpfr_expression_binary<mpfr_expression_add, L, mpfr_expression_value> operator+(const mpfr_expression<L>& left, const mpfr_ptr right) {
+    return mpfr_expression_binary<mpfr_expression_add, L, mpfr_expression_value>(left.self(), mpfr_expression_value(right));
+}
+
+template <class L, class T>
+mpfr_expression_binary_scalar<mpfr_expression_add, L, typename mpfr_expression_scalar<T>::type> operator+(const mpfr_expression<L>& left, const T right) {
+    return mpfr_expression_binary_scalar<mpfr_expression_add, L, typename mpfr_expression_scalar<T>::type>(left.self(), right);
+}
+
+template <class R>
+mpfr_expression_binary<mpfr_expression_add, mpfr_expression_value, R> operator+(const mpfr_class& left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_add, mpfr_expression_value, R>(mpfr_expression_value(left), right.self());
+}
+
+template <class R>
+mpfr_expression_binary<mpfr_expression_add, mpfr_expression_value, R> operator+(const mpfr_ptr left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_add, mpfr_expression_value, R>(mpfr_expression_value(left), right.self());
+}
+
+template <class T, class R>
+mpfr_expression_scalar_binary<mpfr_expression_add, typename mpfr_expression_scalar<T>::type, R> operator+(const T left, const mpfr_expression<R>& right) {
+    return mpfr_expression_scalar_binary<mpfr_expression_add, typename mpfr_expression_scalar<T>::type, R>(left, right.self());
+}
+
+template <class L, class R>
+mpfr_expression_binary<mpfr_expression_sub, L, R> operator-(const mpfr_expression<L>& left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_sub, L, R>(left.self(), right.self());
+}
+
+template <class L>
+mpfr_expression_binary<mpfr_expression_sub, L, mpfr_expression_value> operator-(const mpfr_expression<L>& left, const mpfr_class& right) {
+    return mpfr_expression_binary<mpfr_expression_sub, L, mpfr_expression_value>(left.self(), mpfr_expression_value(right));
+}
+
+template <class L>
+mpfr_expression_binary<mpfr_expression_sub, L, mpfr_expression_value> operator-(const mpfr_expression<L>& left, const mpfr_ptr right) {
+    return mpfr_expression_binary<mpfr_expression_sub, L, mpfr_expression_value>(left.self(), mpfr_expression_value(right));
+}
+
+template <class L, class T>
+mpfr_expression_binary_scalar<mpfr_expression_sub, L, typename mpfr_expression_scalar<T>::type> operator-(const mpfr_expression<L>& left, const T right) {
+    return mpfr_expression_binary_scalar<mpfr_expression_sub, L, typename mpfr_expression_scalar<T>::type>(left.self(), right);
+}
+
+template <class R>
+mpfr_expression_binary<mpfr_expression_sub, mpfr_expression_value, R> operator-(const mpfr_class& left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_sub, mpfr_expression_value, R>(mpfr_expression_value(left), right.self());
+}
+
+template <class R>
+mpfr_expression_binary<mpfr_expression_sub, mpfr_expression_value, R> operator-(const mpfr_ptr left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_sub, mpfr_expression_value, R>(mpfr_expression_value(left), right.self());
+}
+
+template <class T, class R>
+mpfr_expression_scalar_binary<mpfr_expression_sub, typename mpfr_expression_scalar<T>::type, R> operator-(const T left, const mpfr_expression<R>& right) {
+    return mpfr_expression_scalar_binary<mpfr_expression_sub, typename mpfr_expression_scalar<T>::type, R>(left, right.self());
+}
+
+template <class L, class R>
+mpfr_expression_binary<mpfr_expression_mul, L, R> operator*(const mpfr_expression<L>& left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_mul, L, R>(left.self(), right.self());
+}
+
+template <class L>
+mpfr_expression_binary<mpfr_expression_mul, L, mpfr_expression_value> operator*(const mpfr_expression<L>& left, const mpfr_class& right) {
+    return mpfr_expression_binary<mpfr_expression_mul, L, mpfr_expression_value>(left.self(), mpfr_expression_value(right));
+}
+
+template <class L>
+mpfr_expression_binary<mpfr_expression_mul, L, mpfr_expression_value> operator*(const mpfr_expression<L>& left, const mpfr_ptr right) {
+    return mpfr_expression_binary<mpfr_expression_mul, L, mpfr_expression_value>(left.self(), mpfr_expression_value(right));
+}
+
+template <class L, class T>
+mpfr_expression_binary_scalar<mpfr_expression_mul, L, typename mpfr_expression_scalar<T>::type> operator*(const mpfr_expression<L>& left, const T right) {
+    return mpfr_expression_binary_scalar<mpfr_expression_mul, L, typename mpfr_expression_scalar<T>::type>(left.self(), right);
+}
+
+template <class R>
+mpfr_expression_binary<mpfr_expression_mul, mpfr_expression_value, R> operator*(const mpfr_class& left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_mul, mpfr_expression_value, R>(mpfr_expression_value(left), right.self());
+}
+
+template <class R>
+mpfr_expression_binary<mpfr_expression_mul, mpfr_expression_value, R> operator*(const mpfr_ptr left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_mul, mpfr_expression_value, R>(mpfr_expression_value(left), right.self());
+}
+
+template <class T, class R>
+mpfr_expression_scalar_binary<mpfr_expression_mul, typename mpfr_expression_scalar<T>::type, R> operator*(const T left, const mpfr_expression<R>& right) {
+    return mpfr_expression_scalar_binary<mpfr_expression_mul, typename mpfr_expression_scalar<T>::type, R>(left, right.self());
+}
+
+template <class L, class R>
+mpfr_expression_binary<mpfr_expression_div, L, R> operator/(const mpfr_expression<L>& left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_div, L, R>(left.self(), right.self());
+}
+
+template <class L>
+mpfr_expression_binary<mpfr_expression_div, L, mpfr_expression_value> operator/(const mpfr_expression<L>& left, const mpfr_class& right) {
+    return mpfr_expression_binary<mpfr_expression_div, L, mpfr_expression_value>(left.self(), mpfr_expression_value(right));
+}
+
+template <class L>
+mpfr_expression_binary<mpfr_expression_div, L, mpfr_expression_value> operator/(const mpfr_expression<L>& left, const mpfr_ptr right) {
+    return mpfr_expression_binary<mpfr_expression_div, L, mpfr_expression_value>(left.self(), mpfr_expression_value(right));
+}
+
+template <class L, class T>
+mpfr_expression_binary_scalar<mpfr_expression_div, L, typename mpfr_expression_scalar<T>::type> operator/(const mpfr_expression<L>& left, const T right) {
+    return mpfr_expression_binary_scalar<mpfr_expression_div, L, typename mpfr_expression_scalar<T>::type>(left.self(), right);
+}
+
+template <class R>
+mpfr_expression_binary<mpfr_expression_div, mpfr_expression_value, R> operator/(const mpfr_class& left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_div, mpfr_expression_value, R>(mpfr_expression_value(left), right.self());
+}
+
+template <class R>
+mpfr_expression_binary<mpfr_expression_div, mpfr_expression_value, R> operator/(const mpfr_ptr left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_div, mpfr_expression_value, R>(mpfr_expression_value(left), right.self());
+}
+
+template <class T, class R>
+mpfr_expression_scalar_binary<mpfr_expression_div, typename mpfr_expression_scalar<T>::type, R> operator/(const T left, const mpfr_expression<R>& right) {
+    return mpfr_expression_scalar_binary<mpfr_expression_div, typename mpfr_expression_scalar<T>::type, R>(left, right.self());
+}
+
+template <class L, class R>
+mpfr_expression_binary<mpfr_expression_pow, L, R> operator^(const mpfr_expression<L>& left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_pow, L, R>(left.self(), right.self());
+}
+
+template <class L>
+mpfr_expression_binary<mpfr_expression_pow, L, mpfr_expression_value> operator^(const mpfr_expression<L>& left, const mpfr_class& right) {
+    return mpfr_expression_binary<mpfr_expression_pow, L, mpfr_expression_value>(left.self(), mpfr_expression_value(right));
+}
+
+template <class L>
+mpfr_expression_binary<mpfr_expression_pow, L, mpfr_expression_value> operator^(const mpfr_expression<L>& left, const mpfr_ptr right) {
+    return mpfr_expression_binary<mpfr_expression_pow, L, mpfr_expression_value>(left.self(), mpfr_expression_value(right));
+}
+
+template <class L, class T>
+mpfr_expression_binary_scalar<mpfr_expression_pow, L, typename mpfr_expression_scalar<T>::type> operator^(const mpfr_expression<L>& left, const T right) {
+    return mpfr_expression_binary_scalar<mpfr_expression_pow, L, typename mpfr_expression_scalar<T>::type>(left.self(), right);
+}
+
+template <class R>
+mpfr_expression_binary<mpfr_expression_pow, mpfr_expression_value, R> operator^(const mpfr_class& left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_pow, mpfr_expression_value, R>(mpfr_expression_value(left), right.self());
+}
+
+template <class R>
+mpfr_expression_binary<mpfr_expression_pow, mpfr_expression_value, R> operator^(const mpfr_ptr left, const mpfr_expression<R>& right) {
+    return mpfr_expression_binary<mpfr_expression_pow, mpfr_expression_value, R>(mpfr_expression_value(left), right.self());
+}
+
+template <class T, class R>
+mpfr_expression_scalar_binary<mpfr_expression_pow, typename mpfr_expression_scalar<T>::type, R> operator^(const T left, const mpfr_expression<R>& right) {
+    return mpfr_expression_scalar_binary<mpfr_expression_pow, typename mpfr_expression_scalar<T>::type, R>(left, right.self());
+}
+
+template <class E>
+mpfr_class::mpfr_class(const mpfr_expression<E>& other) {
+    if (mpfr_class::get_precision_mode() == mpfr_precision_operands) {
+        mpfr_pool::init(this->m_raw, other.self().precision());
+    } else {
+        mpfr_pool::init(this->m_raw, mpfr_class::get_default_prec());
+    }
+    this->evaluate(other.self());
+}
+
+template <class E>
+mpfr_class& mpfr_class::operator=(const mpfr_expression<E>& other) {
+    if (!this->is_initialized()) {
+        mpfr_pool::init(this->m_raw, mpfr_class::get_default_prec());
+    }
+    this->evaluate(other.self());
+    return *this;
+}
+
+template <class E>
+mpfr_class& mpfr_class::operator+=(const mpfr_expression<E>& other) {
+    return this->operator=(mpfr_expression_value(this->m_raw) + other);
+}
+
+template <class E>
+mpfr_class& mpfr_class::operator-=(const mpfr_expression<E>& other) {
+    return this->operator=(mpfr_expression_value(this->m_raw) - other);
+}
+
+template <class E>
+mpfr_class& mpfr_class::operator*=(const mpfr_expression<E>& other) {
+    return this->operator=(mpfr_expression_value(this->m_raw) * other);
+}
+
+template <class E>
+mpfr_class& mpfr_class::operator/=(const mpfr_expression<E>& other) {
+    return this->operator=(mpfr_expression_value(this->m_raw) / other);
+}
+
+template <class E>
+void mpfr_class::evaluate(const E& expression) {
+    static_assert(E::n_registers < mpfr_expression_max_registers, "mpfr_expression: expression needs too many registers.");
+    mpfr_expression_registers& registers = mpfr_expression_registers::local();
+    registers.reserve(E::n_registers + 1, mpfr_get_prec(this->m_raw));
+    if (expression.aliases(this->m_raw)) {
+        expression.evaluate(registers[E::n_registers], registers, 0);
+        if (this->m_shared) {
+            mpfr_set(this->m_raw, registers[E::n_registers], mpfr_class::get_default_rnd());
+        } else {
+            mpfr_swap(this->m_raw, registers[E::n_registers]);
+        }
+    } else {
+        expression.evaluate(this->m_raw, registers, 0);
+    }
+}
+
+#endif // __MPFR_EXPRESSION_H__
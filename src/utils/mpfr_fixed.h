@@ -0,0 +1,960 @@
+//
+//  mpfr_fixed.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __MPFR_FIXED_H__
+#define __MPFR_FIXED_H__
+
+#include <stddef.h>
+#include <limits.h>
+#include <float.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <iostream>
+#include <string>
+
+#include "mpfr_cache.h"
+#include "mpfr_class.h"
+#include "mpfr_expression.h"
+#include "mpfr_scalar_traits.h"
+
+// Floating-point number whose precision is fixed at compile time. The limbs are
+// stored inside the object through MPFR's custom interface, so creating, copying
+// or destroying a value never allocates and arrays of values are contiguous.
+// The interface follows mpfr_class; every result has Bits of precision.
+
+inline void mpfr_fixed_set(mpfr_ptr result, const long int value) {
+    mpfr_set_si(result, value, mpfr_class::get_default_rnd());
+}
+
+inline void mpfr_fixed_set(mpfr_ptr result, const unsigned long int value) {
+    mpfr_set_ui(result, value, mpfr_class::get_default_rnd());
+}
+
+inline void mpfr_fixed_set(mpfr_ptr result, const long long int value) {
+    mpfr_set_sj(result, value, mpfr_class::get_default_rnd());
+}
+
+inline void mpfr_fixed_set(mpfr_ptr result, const unsigned long long int value) {
+    mpfr_set_uj(result, value, mpfr_class::get_default_rnd());
+}
+
+inline void mpfr_fixed_set(mpfr_ptr result, const double value) {
+    mpfr_set_d(result, value, mpfr_class::get_default_rnd());
+}
+
+inline void mpfr_fixed_set(mpfr_ptr result, const long double value) {
+    mpfr_set_ld(result, value, mpfr_class::get_default_rnd());
+}
+
+inline int mpfr_fixed_cmp(mpfr_srcptr left, mpfr_srcptr right) {
+    return mpfr_cmp(left, right);
+}
+
+inline int mpfr_fixed_cmp(mpfr_srcptr left, const long int right) {
+    return mpfr_cmp_si(left, right);
+}
+
+inline int mpfr_fixed_cmp(mpfr_srcptr left, const unsigned long int right) {
+    return mpfr_cmp_ui(left, right);
+}
+
+inline int mpfr_fixed_cmp(mpfr_srcptr left, const long long int right) {
+    MPFR_DECL_INIT(tmp_right, sizeof(long long int) * CHAR_BIT);
+    mpfr_set_sj(tmp_right, right, mpfr_class::get_default_rnd());
+    return mpfr_cmp(left, tmp_right);
+}
+
+inline int mpfr_fixed_cmp(mpfr_srcptr left, const unsigned long long int right) {
+    MPFR_DECL_INIT(tmp_right, sizeof(unsigned long long int) * CHAR_BIT);
+    mpfr_set_uj(tmp_right, right, mpfr_class::get_default_rnd());
+    return mpfr_cmp(left, tmp_right);
+}
+
+inline int mpfr_fixed_cmp(mpfr_srcptr left, const double right) {
+    return mpfr_cmp_d(left, right);
+}
+
+inline int mpfr_fixed_cmp(mpfr_srcptr left, const long double right) {
+    return mpfr_cmp_ld(left, right);
+}
+
+template <mpfr_prec_t Bits>
+class mpfr_fixed {
+
+    static_assert(Bits >= MPFR_PREC_MIN, "mpfr_fixed: precision is too small.");
+
+public:
+
+    static const size_t n_limbs = (Bits + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+
+private:
+
+    mpfr_t m_raw;
+    mp_limb_t m_limbs[n_limbs];
+
+public:
+
+    mpfr_fixed() {
+        this->init();
+    }
+
+    mpfr_fixed(const mpfr_fixed& other) {
+        this->init();
+        mpfr_set(this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_fixed(mpfr_fixed&& other) noexcept {
+        this->init();
+        mpfr_set(this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    explicit mpfr_fixed(const mpfr_class& other) {
+        this->init();
+        mpfr_set(this->m_raw, other.get_raw(), mpfr_class::get_default_rnd());
+    }
+
+    mpfr_fixed(const mpfr_ptr other) {
+        this->init();
+        mpfr_set(this->m_raw, other, mpfr_class::get_default_rnd());
+    }
+
+    template <class T, class S = typename mpfr_expression_scalar<T>::type>
+    mpfr_fixed(const T other) {
+        this->init();
+        mpfr_fixed_set(this->m_raw, (S)other);
+    }
+
+    mpfr_fixed(const char *other, const int base = 10) {
+        this->init();
+        this->set_str(other, base, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_fixed(const std::string& other, const int base = 10) {
+        this->init();
+        this->set_str(other, base, mpfr_class::get_default_rnd());
+    }
+
+    template <class E>
+    explicit mpfr_fixed(const mpfr_expression<E>& other) {
+        this->init();
+        this->evaluate(other.self());
+    }
+
+    ~mpfr_fixed() {
+    }
+
+    mpfr_fixed& operator=(const mpfr_fixed& other) {
+        mpfr_set(this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    mpfr_fixed& operator=(mpfr_fixed&& other) noexcept {
+        mpfr_set(this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    mpfr_fixed& operator=(const mpfr_class& other) {
+        mpfr_set(this->m_raw, other.get_raw(), mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    mpfr_fixed& operator=(const mpfr_ptr other) {
+        mpfr_set(this->m_raw, other, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    template <class T, class S = typename mpfr_expression_scalar<T>::type>
+    mpfr_fixed& operator=(const T other) {
+        mpfr_fixed_set(this->m_raw, (S)other);
+        return *this;
+    }
+
+    mpfr_fixed& operator=(const char *other) {
+        this->set_str(other, 10, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    mpfr_fixed& operator=(const std::string& other) {
+        this->set_str(other, 10, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    template <class E>
+    mpfr_fixed& operator=(const mpfr_expression<E>& other) {
+        this->evaluate(other.self());
+        return *this;
+    }
+
+    mpfr_fixed& operator+=(const mpfr_fixed& other) {
+        mpfr_add(this->m_raw, this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    template <class T, class S = typename mpfr_expression_scalar<T>::type>
+    mpfr_fixed& operator+=(const T other) {
+        mpfr_expression_apply<mpfr_expression_add>(this->m_raw, this->m_raw, (S)other);
+        return *this;
+    }
+
+    template <class E>
+    mpfr_fixed& operator+=(const mpfr_expression<E>& other) {
+        return this->operator=(mpfr_expression_value(this->m_raw) + other);
+    }
+
+    mpfr_fixed operator+() const {
+        return mpfr_fixed(*this);
+    }
+
+    mpfr_fixed operator++(int) {
+        mpfr_fixed tmp = *this;
+        mpfr_add_ui(this->m_raw, this->m_raw, 1, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    mpfr_fixed& operator++() {
+        mpfr_add_ui(this->m_raw, this->m_raw, 1, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    mpfr_fixed& operator-=(const mpfr_fixed& other) {
+        mpfr_sub(this->m_raw, this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    template <class T, class S = typename mpfr_expression_scalar<T>::type>
+    mpfr_fixed& operator-=(const T other) {
+        mpfr_expression_apply<mpfr_expression_sub>(this->m_raw, this->m_raw, (S)other);
+        return *this;
+    }
+
+    template <class E>
+    mpfr_fixed& operator-=(const mpfr_expression<E>& other) {
+        return this->operator=(mpfr_expression_value(this->m_raw) - other);
+    }
+
+    mpfr_fixed operator-() const {
+        mpfr_fixed tmp;
+        mpfr_neg(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    mpfr_fixed operator--(int) {
+        mpfr_fixed tmp = *this;
+        mpfr_sub_ui(this->m_raw, this->m_raw, 1, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    mpfr_fixed& operator--() {
+        mpfr_sub_ui(this->m_raw, this->m_raw, 1, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    mpfr_fixed& operator*=(const mpfr_fixed& other) {
+        mpfr_mul(this->m_raw, this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    template <class T, class S = typename mpfr_expression_scalar<T>::type>
+    mpfr_fixed& operator*=(const T other) {
+        mpfr_expression_apply<mpfr_expression_mul>(this->m_raw, this->m_raw, (S)other);
+        return *this;
+    }
+
+    template <class E>
+    mpfr_fixed& operator*=(const mpfr_expression<E>& other) {
+        return this->operator=(mpfr_expression_value(this->m_raw) * other);
+    }
+
+    mpfr_fixed& operator/=(const mpfr_fixed& other) {
+        mpfr_div(this->m_raw, this->m_raw, other.m_raw, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    template <class T, class S = typename mpfr_expression_scalar<T>::type>
+    mpfr_fixed& operator/=(const T other) {
+        mpfr_expression_apply<mpfr_expression_div>(this->m_raw, this->m_raw, (S)other);
+        return *this;
+    }
+
+    template <class E>
+    mpfr_fixed& operator/=(const mpfr_expression<E>& other) {
+        return this->operator=(mpfr_expression_value(this->m_raw) / other);
+    }
+
+    mpfr_fixed& operator^=(const mpfr_fixed& other) {
+        mpfr_class::pow_raw(this->m_raw, this->m_raw, other.m_raw);
+        return *this;
+    }
+
+    template <class T, class S = typename mpfr_expression_scalar<T>::type>
+    mpfr_fixed& operator^=(const T other) {
+        mpfr_expression_apply<mpfr_expression_pow>(this->m_raw, this->m_raw, (S)other);
+        return *this;
+    }
+
+    mpfr_fixed pow_value(const mpfr_fixed& exponent) const {
+        mpfr_fixed tmp;
+        mpfr_class::pow_raw(tmp.m_raw, this->m_raw, exponent.m_raw);
+        return tmp;
+    }
+
+    void to_pow(const mpfr_fixed& exponent) {
+        mpfr_class::pow_raw(this->m_raw, this->m_raw, exponent.m_raw);
+    }
+
+    mpfr_fixed& fma(const mpfr_fixed& left, const mpfr_fixed& right, const mpfr_fixed& addend) {
+        mpfr_fma(this->m_raw, left.m_raw, right.m_raw, addend.m_raw, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    mpfr_fixed& fms(const mpfr_fixed& left, const mpfr_fixed& right, const mpfr_fixed& subtrahend) {
+        mpfr_fms(this->m_raw, left.m_raw, right.m_raw, subtrahend.m_raw, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    mpfr_fixed& addmul(const mpfr_fixed& left, const mpfr_fixed& right) {
+        mpfr_fma(this->m_raw, left.m_raw, right.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    mpfr_fixed& submul(const mpfr_fixed& left, const mpfr_fixed& right) {
+        mpfr_fms(this->m_raw, left.m_raw, right.m_raw, this->m_raw, mpfr_expression_negated_rnd(mpfr_class::get_default_rnd()));
+        mpfr_neg(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return *this;
+    }
+
+    int int_value() const {
+        return mpfr_get_si(this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    long int long_value() const {
+        return mpfr_get_si(this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    long long int llong_value() const {
+        return mpfr_get_sj(this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    unsigned int uint_value() const {
+        return mpfr_get_ui(this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    unsigned long int ulong_value() const {
+        return mpfr_get_ui(this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    unsigned long long int ullong_value() const {
+        return mpfr_get_uj(this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    float float_value() const {
+        return mpfr_get_flt(this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    double double_value() const {
+        return mpfr_get_d(this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    long double ldouble_value() const {
+        return mpfr_get_ld(this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    explicit operator double() const {
+        return this->double_value();
+    }
+
+    mpfr_class class_value() const {
+        mpfr_class tmp(0, Bits);
+        mpfr_set(tmp.get_raw(), this->m_raw, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    std::string get_str() const {
+        char buffer[256];
+        mpfr_sprintf(buffer, "%+RG", this->m_raw);
+        return std::string(buffer);
+    }
+
+    std::string get_str_with_format(std::string format) const {
+        char buffer[256];
+        mpfr_sprintf(buffer, format.c_str(), this->m_raw);
+        return std::string(buffer);
+    }
+
+    void set_str(const std::string& other, const int base, const mpfr_rnd_t rnd) {
+        if (mpfr_set_str(this->m_raw, other.c_str(), base, rnd) != 0) {
+            mpfr_set_nan(this->m_raw);
+        }
+    }
+
+    mpfr_fixed abs_value() const {
+        mpfr_fixed tmp;
+        mpfr_abs(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    void to_abs() {
+        mpfr_abs(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_fixed sqrt_value() const {
+        mpfr_fixed tmp;
+        mpfr_sqrt(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    void to_sqrt() {
+        mpfr_sqrt(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_fixed log_value() const {
+        mpfr_fixed tmp;
+        mpfr_log(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    void to_log() {
+        mpfr_log(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_fixed log2_value() const {
+        mpfr_fixed tmp;
+        mpfr_log2(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    void to_log2() {
+        mpfr_log2(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_fixed log10_value() const {
+        mpfr_fixed tmp;
+        mpfr_log10(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    void to_log10() {
+        mpfr_log10(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_fixed exp_value() const {
+        mpfr_fixed tmp;
+        mpfr_exp(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    void to_exp() {
+        mpfr_exp(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_fixed exp2_value() const {
+        mpfr_fixed tmp;
+        mpfr_exp2(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    void to_exp2() {
+        mpfr_exp2(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_fixed exp10_value() const {
+        mpfr_fixed tmp;
+        mpfr_exp10(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    void to_exp10() {
+        mpfr_exp10(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_fixed cos_value() const {
+        mpfr_fixed tmp;
+        mpfr_cos(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    void to_cos() {
+        mpfr_cos(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_fixed sin_value() const {
+        mpfr_fixed tmp;
+        mpfr_sin(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    void to_sin() {
+        mpfr_sin(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_fixed tan_value() const {
+        mpfr_fixed tmp;
+        mpfr_tan(tmp.m_raw, this->m_raw, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    void to_tan() {
+        mpfr_tan(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    mpfr_ptr get_raw() {
+        return this->m_raw;
+    }
+
+    mpfr_srcptr get_raw() const {
+        return this->m_raw;
+    }
+
+    mpfr_prec_t get_prec() const {
+        return Bits;
+    }
+
+    mpfr_exp_t get_exp() const {
+        return mpfr_get_exp(this->m_raw);
+    }
+
+    // The storage cannot change size; set_prec only resets the value and
+    // round_prec rounds it to fewer bits.
+    void set_prec(mpfr_prec_t prec) {
+        mpfr_set_nan(this->m_raw);
+    }
+
+    void round_prec(mpfr_prec_t prec) {
+        if (prec >= Bits) {
+            return;
+        }
+        mpfr_t tmp;
+        mpfr_init2(tmp, prec);
+        mpfr_set(tmp, this->m_raw, mpfr_class::get_default_rnd());
+        mpfr_set(this->m_raw, tmp, mpfr_class::get_default_rnd());
+        mpfr_clear(tmp);
+    }
+
+    bool is_nan() const {
+        return mpfr_nan_p(this->m_raw) != 0;
+    }
+
+    bool is_inf() const {
+        return mpfr_inf_p(this->m_raw) != 0;
+    }
+
+    bool is_number() const {
+        return mpfr_number_p(this->m_raw) != 0;
+    }
+
+    bool is_zero() const {
+        return mpfr_zero_p(this->m_raw) != 0;
+    }
+
+    bool is_regular() const {
+        return mpfr_regular_p(this->m_raw) != 0;
+    }
+
+    void set_nan() {
+        mpfr_set_nan(this->m_raw);
+    }
+
+    void set_inf(int sign) {
+        mpfr_set_inf(this->m_raw, sign);
+    }
+
+    void set_zero(int sign) {
+        mpfr_set_zero(this->m_raw, sign);
+    }
+
+    void set_neg() {
+        mpfr_neg(this->m_raw, this->m_raw, mpfr_class::get_default_rnd());
+    }
+
+    int get_sign() const {
+        return mpfr_sgn(this->m_raw);
+    }
+
+    void set_sign(int sign) {
+        mpfr_setsign(this->m_raw, this->m_raw, sign, mpfr_class::get_default_rnd());
+    }
+
+private:
+
+    void init() {
+        mpfr_custom_init(this->m_limbs, Bits);
+        mpfr_custom_init_set(this->m_raw, MPFR_NAN_KIND, 0, Bits, this->m_limbs);
+    }
+
+    template <class E>
+    void evaluate(const E& expression) {
+        static_assert(E::n_registers < mpfr_expression_max_registers, "mpfr_expression: expression needs too many registers.");
+        mpfr_expression_registers& registers = mpfr_expression_registers::local();
+        registers.reserve(E::n_registers + 1, Bits);
+        if (expression.aliases(this->m_raw)) {
+            expression.evaluate(registers[E::n_registers], registers, 0);
+            mpfr_set(this->m_raw, registers[E::n_registers], mpfr_class::get_default_rnd());
+        } else {
+            expression.evaluate(this->m_raw, registers, 0);
+        }
+    }
+
+public:
+
+    static void set(mpfr_fixed& result, const mpfr_fixed& value) {
+        mpfr_set(result.m_raw, value.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void add(mpfr_fixed& result, const mpfr_fixed& left, const mpfr_fixed& right) {
+        mpfr_add(result.m_raw, left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void add(mpfr_fixed& result, const mpfr_fixed& left, const unsigned long int right) {
+        mpfr_add_ui(result.m_raw, left.m_raw, right, mpfr_class::get_default_rnd());
+    }
+
+    static void sub(mpfr_fixed& result, const mpfr_fixed& left, const mpfr_fixed& right) {
+        mpfr_sub(result.m_raw, left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void sub(mpfr_fixed& result, const mpfr_fixed& left, const unsigned long int right) {
+        mpfr_sub_ui(result.m_raw, left.m_raw, right, mpfr_class::get_default_rnd());
+    }
+
+    static void sub(mpfr_fixed& result, const unsigned long int left, const mpfr_fixed& right) {
+        mpfr_ui_sub(result.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void mul(mpfr_fixed& result, const mpfr_fixed& left, const mpfr_fixed& right) {
+        mpfr_mul(result.m_raw, left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void mul(mpfr_fixed& result, const mpfr_fixed& left, const unsigned long int right) {
+        mpfr_mul_ui(result.m_raw, left.m_raw, right, mpfr_class::get_default_rnd());
+    }
+
+    static void div(mpfr_fixed& result, const mpfr_fixed& left, const mpfr_fixed& right) {
+        mpfr_div(result.m_raw, left.m_raw, right.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void div(mpfr_fixed& result, const mpfr_fixed& left, const unsigned long int right) {
+        mpfr_div_ui(result.m_raw, left.m_raw, right, mpfr_class::get_default_rnd());
+    }
+
+    static void div(mpfr_fixed& result, const unsigned long int left, const mpfr_fixed& right) {
+        mpfr_ui_div(result.m_raw, left, right.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void pow(mpfr_fixed& result, const mpfr_fixed& base, const mpfr_fixed& exponent) {
+        mpfr_class::pow_raw(result.m_raw, base.m_raw, exponent.m_raw);
+    }
+
+    static void pow_ui(mpfr_fixed& result, const mpfr_fixed& base, const unsigned long int exponent) {
+        mpfr_pow_ui(result.m_raw, base.m_raw, exponent, mpfr_class::get_default_rnd());
+    }
+
+    static void abs_into(mpfr_fixed& result, const mpfr_fixed& value) {
+        mpfr_abs(result.m_raw, value.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void sqrt_into(mpfr_fixed& result, const mpfr_fixed& value) {
+        mpfr_sqrt(result.m_raw, value.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void log_into(mpfr_fixed& result, const mpfr_fixed& value) {
+        mpfr_log(result.m_raw, value.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void log2_into(mpfr_fixed& result, const mpfr_fixed& value) {
+        mpfr_log2(result.m_raw, value.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void log10_into(mpfr_fixed& result, const mpfr_fixed& value) {
+        mpfr_log10(result.m_raw, value.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void exp_into(mpfr_fixed& result, const mpfr_fixed& value) {
+        mpfr_exp(result.m_raw, value.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void exp2_into(mpfr_fixed& result, const mpfr_fixed& value) {
+        mpfr_exp2(result.m_raw, value.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void exp10_into(mpfr_fixed& result, const mpfr_fixed& value) {
+        mpfr_exp10(result.m_raw, value.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void cos_into(mpfr_fixed& result, const mpfr_fixed& value) {
+        mpfr_cos(result.m_raw, value.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void sin_into(mpfr_fixed& result, const mpfr_fixed& value) {
+        mpfr_sin(result.m_raw, value.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static void tan_into(mpfr_fixed& result, const mpfr_fixed& value) {
+        mpfr_tan(result.m_raw, value.m_raw, mpfr_class::get_default_rnd());
+    }
+
+    static mpfr_fixed const_log2() {
+        mpfr_fixed tmp;
+        mpfr_cache::global().constant(tmp.m_raw, mpfr_cache::cache_log2, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    static mpfr_fixed const_pi() {
+        mpfr_fixed tmp;
+        mpfr_cache::global().constant(tmp.m_raw, mpfr_cache::cache_pi, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    static mpfr_fixed const_euler() {
+        mpfr_fixed tmp;
+        mpfr_cache::global().constant(tmp.m_raw, mpfr_cache::cache_euler, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+    static mpfr_fixed const_catalan() {
+        mpfr_fixed tmp;
+        mpfr_cache::global().constant(tmp.m_raw, mpfr_cache::cache_catalan, mpfr_class::get_default_rnd());
+        return tmp;
+    }
+
+}; // class mpfr_fixed
+
+typedef mpfr_fixed<128> mpfr_fixed128;
+typedef mpfr_fixed<256> mpfr_fixed256;
+typedef mpfr_fixed<512> mpfr_fixed512;
+typedef mpfr_fixed<1024> mpfr_fixed1024;
+
+template <mpfr_prec_t Bits>
+struct mpfr_scalar_traits< mpfr_fixed<Bits> > {
+    static const bool is_fixed_prec = true;
+    static const mpfr_prec_t fixed_prec = Bits;
+    static const bool is_mpfr = true;
+};
+
+template <mpfr_prec_t Bits>
+mpfr_expression_value mpfr_expr(const mpfr_fixed<Bits>& value) {
+    return mpfr_expression_value(value.get_raw());
+}
+
+template <mpfr_prec_t Bits>
+mpfr_fixed<Bits> operator+(const mpfr_fixed<Bits>& left, const mpfr_fixed<Bits>& right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_add(tmp.get_raw(), left.get_raw(), right.get_raw(), mpfr_class::get_default_rnd());
+    return tmp;
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+mpfr_fixed<Bits> operator+(const mpfr_fixed<Bits>& left, const T right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_expression_apply<mpfr_expression_add>(tmp.get_raw(), left.get_raw(), (S)right);
+    return tmp;
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+mpfr_fixed<Bits> operator+(const T left, const mpfr_fixed<Bits>& right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_expression_apply<mpfr_expression_add>(tmp.get_raw(), (S)left, right.get_raw());
+    return tmp;
+}
+template <mpfr_prec_t Bits>
+mpfr_fixed<Bits> operator-(const mpfr_fixed<Bits>& left, const mpfr_fixed<Bits>& right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_sub(tmp.get_raw(), left.get_raw(), right.get_raw(), mpfr_class::get_default_rnd());
+    return tmp;
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+mpfr_fixed<Bits> operator-(const mpfr_fixed<Bits>& left, const T right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_expression_apply<mpfr_expression_sub>(tmp.get_raw(), left.get_raw(), (S)right);
+    return tmp;
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+mpfr_fixed<Bits> operator-(const T left, const mpfr_fixed<Bits>& right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_expression_apply<mpfr_expression_sub>(tmp.get_raw(), (S)left, right.get_raw());
+    return tmp;
+}
+template <mpfr_prec_t Bits>
+mpfr_fixed<Bits> operator*(const mpfr_fixed<Bits>& left, const mpfr_fixed<Bits>& right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_mul(tmp.get_raw(), left.get_raw(), right.get_raw(), mpfr_class::get_default_rnd());
+    return tmp;
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+mpfr_fixed<Bits> operator*(const mpfr_fixed<Bits>& left, const T right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_expression_apply<mpfr_expression_mul>(tmp.get_raw(), left.get_raw(), (S)right);
+    return tmp;
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+mpfr_fixed<Bits> operator*(const T left, const mpfr_fixed<Bits>& right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_expression_apply<mpfr_expression_mul>(tmp.get_raw(), (S)left, right.get_raw());
+    return tmp;
+}
+template <mpfr_prec_t Bits>
+mpfr_fixed<Bits> operator/(const mpfr_fixed<Bits>& left, const mpfr_fixed<Bits>& right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_div(tmp.get_raw(), left.get_raw(), right.get_raw(), mpfr_class::get_default_rnd());
+    return tmp;
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+mpfr_fixed<Bits> operator/(const mpfr_fixed<Bits>& left, const T right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_expression_apply<mpfr_expression_div>(tmp.get_raw(), left.get_raw(), (S)right);
+    return tmp;
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+mpfr_fixed<Bits> operator/(const T left, const mpfr_fixed<Bits>& right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_expression_apply<mpfr_expression_div>(tmp.get_raw(), (S)left, right.get_raw());
+    return tmp;
+}
+template <mpfr_prec_t Bits>
+mpfr_fixed<Bits> operator^(const mpfr_fixed<Bits>& left, const mpfr_fixed<Bits>& right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_class::pow_raw(tmp.get_raw(), left.get_raw(), right.get_raw());
+    return tmp;
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+mpfr_fixed<Bits> operator^(const mpfr_fixed<Bits>& left, const T right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_expression_apply<mpfr_expression_pow>(tmp.get_raw(), left.get_raw(), (S)right);
+    return tmp;
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+mpfr_fixed<Bits> operator^(const T left, const mpfr_fixed<Bits>& right) {
+    mpfr_fixed<Bits> tmp;
+    mpfr_expression_apply<mpfr_expression_pow>(tmp.get_raw(), (S)left, right.get_raw());
+    return tmp;
+}
+template <mpfr_prec_t Bits>
+bool operator==(const mpfr_fixed<Bits>& left, const mpfr_fixed<Bits>& right) {
+    return (mpfr_fixed_cmp(left.get_raw(), right.get_raw()) == 0);
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+bool operator==(const mpfr_fixed<Bits>& left, const T right) {
+    return (mpfr_fixed_cmp(left.get_raw(), (S)right) == 0);
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+bool operator==(const T left, const mpfr_fixed<Bits>& right) {
+    return (0 == mpfr_fixed_cmp(right.get_raw(), (S)left));
+}
+template <mpfr_prec_t Bits>
+bool operator!=(const mpfr_fixed<Bits>& left, const mpfr_fixed<Bits>& right) {
+    return (mpfr_fixed_cmp(left.get_raw(), right.get_raw()) != 0);
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+bool operator!=(const mpfr_fixed<Bits>& left, const T right) {
+    return (mpfr_fixed_cmp(left.get_raw(), (S)right) != 0);
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+bool operator!=(const T left, const mpfr_fixed<Bits>& right) {
+    return (0 != mpfr_fixed_cmp(right.get_raw(), (S)left));
+}
+template <mpfr_prec_t Bits>
+bool operator<(const mpfr_fixed<Bits>& left, const mpfr_fixed<Bits>& right) {
+    return (mpfr_fixed_cmp(left.get_raw(), right.get_raw()) < 0);
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+bool operator<(const mpfr_fixed<Bits>& left, const T right) {
+    return (mpfr_fixed_cmp(left.get_raw(), (S)right) < 0);
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+bool operator<(const T left, const mpfr_fixed<Bits>& right) {
+    return (0 < mpfr_fixed_cmp(right.get_raw(), (S)left));
+}
+template <mpfr_prec_t Bits>
+bool operator<=(const mpfr_fixed<Bits>& left, const mpfr_fixed<Bits>& right) {
+    return (mpfr_fixed_cmp(left.get_raw(), right.get_raw()) <= 0);
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+bool operator<=(const mpfr_fixed<Bits>& left, const T right) {
+    return (mpfr_fixed_cmp(left.get_raw(), (S)right) <= 0);
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+bool operator<=(const T left, const mpfr_fixed<Bits>& right) {
+    return (0 <= mpfr_fixed_cmp(right.get_raw(), (S)left));
+}
+template <mpfr_prec_t Bits>
+bool operator>(const mpfr_fixed<Bits>& left, const mpfr_fixed<Bits>& right) {
+    return (mpfr_fixed_cmp(left.get_raw(), right.get_raw()) > 0);
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+bool operator>(const mpfr_fixed<Bits>& left, const T right) {
+    return (mpfr_fixed_cmp(left.get_raw(), (S)right) > 0);
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+bool operator>(const T left, const mpfr_fixed<Bits>& right) {
+    return (0 > mpfr_fixed_cmp(right.get_raw(), (S)left));
+}
+template <mpfr_prec_t Bits>
+bool operator>=(const mpfr_fixed<Bits>& left, const mpfr_fixed<Bits>& right) {
+    return (mpfr_fixed_cmp(left.get_raw(), right.get_raw()) >= 0);
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+bool operator>=(const mpfr_fixed<Bits>& left, const T right) {
+    return (mpfr_fixed_cmp(left.get_raw(), (S)right) >= 0);
+}
+
+template <mpfr_prec_t Bits, class T, class S = typename mpfr_expression_scalar<T>::type>
+bool operator>=(const T left, const mpfr_fixed<Bits>& right) {
+    return (0 >= mpfr_fixed_cmp(right.get_raw(), (S)left));
+}
+template <mpfr_prec_t Bits>
+std::ostream& operator<<(std::ostream& left, const mpfr_fixed<Bits>& right) {
+    left << right.get_str();
+    return left;
+}
+
+template <mpfr_prec_t Bits>
+std::istream& operator>>(std::istream& left, mpfr_fixed<Bits>& right) {
+    std::string tmp_string;
+    left >> tmp_string;
+    right.set_str(tmp_string, 10, mpfr_class::get_default_rnd());
+    return left;
+}
+
+#endif // __MPFR_FIXED_H__
@@ -0,0 +1,237 @@
+//
+//  mpfr_limb_kernels.cpp
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#include "mpfr_limb_kernels.h"
+
+#include <iostream>
+
+#if defined(__GNUC__) && defined(__x86_64__) && GMP_NUMB_BITS == 64
+#define MPFR_LIMB_KERNELS_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__SIZEOF_INT128__) && GMP_NUMB_BITS == 64
+#define MPFR_LIMB_KERNELS_INT128
+#endif
+
+namespace {
+
+#ifdef MPFR_LIMB_KERNELS_INT128
+
+template <size_t N>
+void mpfr_limb_kernels_mul_scalar(mp_limb_t *result, const size_t result_stride,
+    const mp_limb_t *left, const mp_limb_t *right, const size_t stride,
+    const size_t begin, const size_t end) {
+    for (size_t e = begin; e < end; ++e) {
+        mp_limb_t x[N], y[N], r[2 * N];
+        for (size_t k = 0; k < N; ++k) {
+            x[k] = left[k * stride + e];
+            y[k] = right[k * stride + e];
+            r[k] = 0;
+        }
+#pragma GCC unroll 4
+        for (size_t i = 0; i < N; ++i) {
+            unsigned __int128 carry = 0;
+#pragma GCC unroll 4
+            for (size_t j = 0; j < N; ++j) {
+                carry += (unsigned __int128)x[i] * y[j] + r[i + j];
+                r[i + j] = (mp_limb_t)carry;
+                carry >>= 64;
+            }
+            r[i + N] = (mp_limb_t)carry;
+        }
+        for (size_t k = 0; k < 2 * N; ++k) {
+            result[k * result_stride + e] = r[k];
+        }
+    }
+}
+
+#endif // MPFR_LIMB_KERNELS_INT128
+
+#ifdef MPFR_LIMB_KERNELS_AVX2
+
+// Four elements per step. Every limb is split into two 32-bit digits and the
+// product is formed column by column; the low and high halves of the 64-bit
+// partial products are summed separately, so no column can overflow before
+// its carry is propagated.
+template <size_t N>
+__attribute__((target("avx2")))
+size_t mpfr_limb_kernels_mul_avx2(mp_limb_t *result, const size_t result_stride,
+    const mp_limb_t *left, const mp_limb_t *right, const size_t stride,
+    const size_t count) {
+    const __m256i mask = _mm256_set1_epi64x(0xffffffffLL);
+    size_t e = 0;
+    for (; e + 4 <= count; e += 4) {
+        __m256i x[2 * N], y[2 * N];
+#pragma GCC unroll 8
+        for (size_t k = 0; k < N; ++k) {
+            x[2 * k] = _mm256_loadu_si256((const __m256i*)(left + k * stride + e));
+            x[2 * k + 1] = _mm256_srli_epi64(x[2 * k], 32);
+            y[2 * k] = _mm256_loadu_si256((const __m256i*)(right + k * stride + e));
+            y[2 * k + 1] = _mm256_srli_epi64(y[2 * k], 32);
+        }
+        __m256i carry = _mm256_setzero_si256();
+        __m256i high_previous = _mm256_setzero_si256();
+        __m256i digit_previous = _mm256_setzero_si256();
+#pragma GCC unroll 16
+        for (size_t c = 0; c < 4 * N; ++c) {
+            __m256i low = _mm256_setzero_si256();
+            __m256i high = _mm256_setzero_si256();
+            size_t i_begin = (c < 2 * N) ? 0 : c - 2 * N + 1;
+            size_t i_end = (c < 2 * N) ? c + 1 : 2 * N;
+#pragma GCC unroll 8
+            for (size_t i = i_begin; i < i_end; ++i) {
+                __m256i product = _mm256_mul_epu32(x[i], y[c - i]);
+                low = _mm256_add_epi64(low, _mm256_and_si256(product, mask));
+                high = _mm256_add_epi64(high, _mm256_srli_epi64(product, 32));
+            }
+            __m256i column = _mm256_add_epi64(_mm256_add_epi64(low, high_previous), carry);
+            __m256i digit = _mm256_and_si256(column, mask);
+            carry = _mm256_srli_epi64(column, 32);
+            high_previous = high;
+            if (c % 2 == 1) {
+                __m256i limb = _mm256_or_si256(digit_previous, _mm256_slli_epi64(digit, 32));
+                _mm256_storeu_si256((__m256i*)(result + (c / 2) * result_stride + e), limb);
+            }
+            digit_previous = digit;
+        }
+    }
+    return e;
+}
+
+#endif // MPFR_LIMB_KERNELS_AVX2
+
+} // namespace
+
+mpfr_limb_kernels::kernel_type mpfr_limb_kernels::get_kernel() {
+    return current_kernel();
+}
+
+// Kernels the processor cannot run fall back to the best available one.
+void mpfr_limb_kernels::set_kernel(const kernel_type kernel) {
+    kernel_type best = detect_kernel();
+    current_kernel() = (kernel > best) ? best : kernel;
+}
+
+mpfr_limb_kernels::kernel_type mpfr_limb_kernels::detect_kernel() {
+#ifdef MPFR_LIMB_KERNELS_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        return kernel_avx2;
+    }
+#endif
+#ifdef MPFR_LIMB_KERNELS_INT128
+    return kernel_scalar;
+#else
+    return kernel_generic;
+#endif
+}
+
+void mpfr_limb_kernels::mul_n(mp_limb_t *result, const size_t result_stride,
+    const mp_limb_t *left, const mp_limb_t *right, const size_t stride,
+    const size_t n_limbs, const size_t count) {
+    if (n_limbs == 0 || n_limbs > max_limbs) {
+        printf("mpfr_limb_kernels[%s:%d]: Unsupported number of limbs.\n", __FILE__, __LINE__);
+        abort();
+    }
+    size_t begin = 0;
+    kernel_type kernel = current_kernel();
+    if (kernel == kernel_avx2) {
+        begin = mul_n_avx2(result, result_stride, left, right, stride, n_limbs, count);
+    }
+    if (kernel == kernel_generic) {
+        mul_n_generic(result, result_stride, left, right, stride, n_limbs, begin, count);
+    } else {
+        mul_n_scalar(result, result_stride, left, right, stride, n_limbs, begin, count);
+    }
+}
+
+mpfr_limb_kernels::kernel_type& mpfr_limb_kernels::current_kernel() {
+    static kernel_type kernel = detect_kernel();
+    return kernel;
+}
+
+void mpfr_limb_kernels::mul_n_generic(mp_limb_t *result, const size_t result_stride,
+    const mp_limb_t *left, const mp_limb_t *right, const size_t stride,
+    const size_t n_limbs, const size_t begin, const size_t end) {
+    for (size_t e = begin; e < end; ++e) {
+        mp_limb_t x[max_limbs], y[max_limbs], r[2 * max_limbs];
+        for (size_t k = 0; k < n_limbs; ++k) {
+            x[k] = left[k * stride + e];
+            y[k] = right[k * stride + e];
+        }
+        mpn_mul_n(r, x, y, (mp_size_t)n_limbs);
+        for (size_t k = 0; k < 2 * n_limbs; ++k) {
+            result[k * result_stride + e] = r[k];
+        }
+    }
+}
+
+void mpfr_limb_kernels::mul_n_scalar(mp_limb_t *result, const size_t result_stride,
+    const mp_limb_t *left, const mp_limb_t *right, const size_t stride,
+    const size_t n_limbs, const size_t begin, const size_t end) {
+#ifdef MPFR_LIMB_KERNELS_INT128
+    switch (n_limbs) {
+        case 1: {
+            mpfr_limb_kernels_mul_scalar<1>(result, result_stride, left, right, stride, begin, end);
+        } break;
+        case 2: {
+            mpfr_limb_kernels_mul_scalar<2>(result, result_stride, left, right, stride, begin, end);
+        } break;
+        case 3: {
+            mpfr_limb_kernels_mul_scalar<3>(result, result_stride, left, right, stride, begin, end);
+        } break;
+        default: {
+            mpfr_limb_kernels_mul_scalar<4>(result, result_stride, left, right, stride, begin, end);
+        }
+    }
+#else
+    mul_n_generic(result, result_stride, left, right, stride, n_limbs, begin, end);
+#endif
+}
+
+size_t mpfr_limb_kernels::mul_n_avx2(mp_limb_t *result, const size_t result_stride,
+    const mp_limb_t *left, const mp_limb_t *right, const size_t stride,
+    const size_t n_limbs, const size_t count) {
+#ifdef MPFR_LIMB_KERNELS_AVX2
+    switch (n_limbs) {
+        case 1: {
+            return mpfr_limb_kernels_mul_avx2<1>(result, result_stride, left, right, stride, count);
+        }
+        case 2: {
+            return mpfr_limb_kernels_mul_avx2<2>(result, result_stride, left, right, stride, count);
+        }
+        case 3: {
+            return mpfr_limb_kernels_mul_avx2<3>(result, result_stride, left, right, stride, count);
+        }
+        default: {
+            return mpfr_limb_kernels_mul_avx2<4>(result, result_stride, left, right, stride, count);
+        }
+    }
+#else
+    return 0;
+#endif
+}
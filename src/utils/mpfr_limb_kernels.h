@@ -0,0 +1,78 @@
+//
+//  mpfr_limb_kernels.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __MPFR_LIMB_KERNELS_H__
+#define __MPFR_LIMB_KERNELS_H__
+
+#include <stddef.h>
+#include <gmp.h>
+
+// Batched exact products of many independent significands of the same small
+// number of limbs. Operands and results are stored limb-major: limb k of
+// element e lives at [k * stride + e], so one vector register holds the same
+// limb of consecutive elements. The AVX2 kernel is chosen at run time when
+// the processor supports it, otherwise a portable scalar kernel is used.
+
+class mpfr_limb_kernels {
+
+public:
+
+    typedef enum kernel_type {
+        kernel_generic = 0,
+        kernel_scalar = 1,
+        kernel_avx2 = 2
+    } kernel_type;
+
+    static const size_t max_limbs = 4;
+
+    static kernel_type get_kernel();
+    static void set_kernel(const kernel_type kernel);
+    static kernel_type detect_kernel();
+
+    // result[0 .. 2 * n_limbs) = left[0 .. n_limbs) * right[0 .. n_limbs) for
+    // count elements. The result must not overlap the operands.
+    static void mul_n(mp_limb_t *result, const size_t result_stride,
+        const mp_limb_t *left, const mp_limb_t *right, const size_t stride,
+        const size_t n_limbs, const size_t count);
+
+private:
+
+    static kernel_type& current_kernel();
+
+    static void mul_n_generic(mp_limb_t *result, const size_t result_stride,
+        const mp_limb_t *left, const mp_limb_t *right, const size_t stride,
+        const size_t n_limbs, const size_t begin, const size_t end);
+    static void mul_n_scalar(mp_limb_t *result, const size_t result_stride,
+        const mp_limb_t *left, const mp_limb_t *right, const size_t stride,
+        const size_t n_limbs, const size_t begin, const size_t end);
+    static size_t mul_n_avx2(mp_limb_t *result, const size_t result_stride,
+        const mp_limb_t *left, const mp_limb_t *right, const size_t stride,
+        const size_t n_limbs, const size_t count);
+
+}; // class mpfr_limb_kernels
+
+#endif // __MPFR_LIMB_KERNELS_H__
@@ -27,54 +27,233 @@
 
 #include "mpfr_matrix.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <utility>
+
+#include "mpfr_context.h"
+#include "mpfr_thread_pool.h"
+
+// Computes the entries of c in square tiles. Every entry is accumulated
+// exactly for MPFR types, scaled by alpha, added to beta times its old value
+// and rounded once into its precision.
+template <class T>
+struct mpfr_matrix_gemm_kernel {
+
+    const T& alpha;
+    const mpfr_basic_matrix_const_view<T>& a;
+    const mpfr_basic_matrix_const_view<T>& b;
+    const T& beta;
+    const mpfr_basic_matrix_view<T>& c;
+    size_t tile;
+    size_t n_col_tiles;
+
+    void operator()(const size_t begin, const size_t end) const {
+        mpfr_basic_accumulator<T> sum;
+        bool has_beta = !this->beta.is_zero();
+        for (size_t t = begin; t < end; ++t) {
+            size_t row = (t / this->n_col_tiles) * this->tile;
+            size_t col = (t % this->n_col_tiles) * this->tile;
+            size_t row_end = std::min(row + this->tile, this->c.n_rows());
+            size_t col_end = std::min(col + this->tile, this->c.n_cols());
+            for (size_t i = row; i < row_end; ++i) {
+                for (size_t j = col; j < col_end; ++j) {
+                    sum.reset();
+                    sum.addmul_n(this->a.row(i), this->b.col(j));
+                    sum.scale(this->alpha);
+                    if (has_beta) {
+                        sum.addmul(this->beta, this->c(i, j));
+                    }
+                    sum.get(this->c(i, j));
+                }
+            }
+        }
+    }
 
-mpfr_matrix::mpfr_matrix() {
-}
+}; // struct mpfr_matrix_gemm_kernel
 
-mpfr_matrix::mpfr_matrix(const mpfr_matrix& other) :
-    m_data(other.m_data) {
+// Largest tile edge whose rows of a and columns of b fit into the cache,
+// reduced while there are fewer than four tiles per thread.
+template <class T>
+static size_t mpfr_matrix_gemm_tile(const size_t n_rows, const size_t n_cols, const size_t depth, const mpfr_prec_t prec) {
+    size_t entry_bytes = sizeof(T);
+    if (mpfr_scalar_traits<T>::is_mpfr) {
+        entry_bytes += (size_t)(prec + 7) / 8;
+    }
+    size_t tile = mpfr_basic_matrix<T>::gemm_cache_bytes / (2 * std::max(depth, (size_t)1) * entry_bytes);
+    tile = std::min(std::max(tile, (size_t)4), (size_t)64);
+    size_t n_tasks = 4 * mpfr_thread_pool::global().n_threads();
+    while (tile > 4 && ((n_rows + tile - 1) / tile) * ((n_cols + tile - 1) / tile) < n_tasks) {
+        tile /= 2;
+    }
+    return tile;
+}
+
+// Winograd's variant of Strassen's algorithm: 7 half-size products and 15
+// block additions per level, in the schedule of Boyer, Dumas, Pernet and Zhou
+// that keeps the intermediate results in c and three temporaries. An odd last
+// row, column or inner index is peeled off and handled by gemm, and so are
+// products below the crossover. c is overwritten and the temporaries take
+// the default precision.
+template <class T>
+static void mpfr_matrix_strassen(const mpfr_basic_matrix_const_view<T>& a, const mpfr_basic_matrix_const_view<T>& b, const mpfr_basic_matrix_view<T>& c, const size_t crossover) {
+    size_t m = a.n_rows();
+    size_t k = a.n_cols();
+    size_t n = b.n_cols();
+    if (m < crossover || k < crossover || n < crossover) {
+        mpfr_basic_matrix<T>::gemm(1, a, b, 0, c);
+        return;
+    }
+    size_t m2 = m / 2;
+    size_t k2 = k / 2;
+    size_t n2 = n / 2;
+    mpfr_basic_matrix_const_view<T> a11 = a.block(0, 0, m2, k2);
+    mpfr_basic_matrix_const_view<T> a12 = a.block(0, k2, m2, k2);
+    mpfr_basic_matrix_const_view<T> a21 = a.block(m2, 0, m2, k2);
+    mpfr_basic_matrix_const_view<T> a22 = a.block(m2, k2, m2, k2);
+    mpfr_basic_matrix_const_view<T> b11 = b.block(0, 0, k2, n2);
+    mpfr_basic_matrix_const_view<T> b12 = b.block(0, n2, k2, n2);
+    mpfr_basic_matrix_const_view<T> b21 = b.block(k2, 0, k2, n2);
+    mpfr_basic_matrix_const_view<T> b22 = b.block(k2, n2, k2, n2);
+    mpfr_basic_matrix_view<T> c11 = c.block(0, 0, m2, n2);
+    mpfr_basic_matrix_view<T> c12 = c.block(0, n2, m2, n2);
+    mpfr_basic_matrix_view<T> c21 = c.block(m2, 0, m2, n2);
+    mpfr_basic_matrix_view<T> c22 = c.block(m2, n2, m2, n2);
+    mpfr_basic_matrix<T> x(m2, k2);
+    mpfr_basic_matrix<T> y(k2, n2);
+    mpfr_basic_matrix<T> p1(m2, n2);
+    x.view().assign(a11); // S3 = A11 - A21
+    x.view() -= a21;
+    y.view().assign(b22); // T3 = B22 - B12
+    y.view() -= b12;
+    mpfr_matrix_strassen<T>(x, y, c21, crossover); // P7 = S3 T3
+    x.view().assign(a21); // S1 = A21 + A22
+    x.view() += a22;
+    y.view().assign(b12); // T1 = B12 - B11
+    y.view() -= b11;
+    mpfr_matrix_strassen<T>(x, y, c22, crossover); // P5 = S1 T1
+    x.view() -= a11; // S2 = S1 - A11
+    y.set_neg(); // T2 = B22 - T1
+    y.view() += b22;
+    mpfr_matrix_strassen<T>(x, y, c12, crossover); // P6 = S2 T2
+    x.set_neg(); // S4 = A12 - S2
+    x.view() += a12;
+    mpfr_matrix_strassen<T>(x, b22, c11, crossover); // P3 = S4 B22
+    mpfr_matrix_strassen<T>(a11, b11, p1, crossover); // P1 = A11 B11
+    c12 += p1; // U2 = P1 + P6
+    c21 += c12; // U3 = U2 + P7
+    c12 += c22; // U4 = U2 + P5
+    c22 += c21; // U7 = U3 + P5
+    c12 += c11; // U5 = U4 + P3
+    y.view() -= b21; // T4 = T2 - B21
+    mpfr_matrix_strassen<T>(a22, y, c11, crossover); // P4 = A22 T4
+    c21 -= c11; // U6 = U3 - P4
+    mpfr_matrix_strassen<T>(a12, b21, c11, crossover); // P2 = A12 B21
+    c11 += p1; // U1 = P1 + P2
+    if (k % 2 == 1) {
+        mpfr_basic_matrix<T>::gemm(1, a.block(0, k - 1, 2 * m2, 1), b.block(k - 1, 0, 1, 2 * n2), 1, c.block(0, 0, 2 * m2, 2 * n2));
+    }
+    if (n % 2 == 1) {
+        mpfr_basic_matrix<T>::gemm(1, a.block(0, 0, 2 * m2, k), b.block(0, n - 1, k, 1), 0, c.block(0, n - 1, 2 * m2, 1));
+    }
+    if (m % 2 == 1) {
+        mpfr_basic_matrix<T>::gemm(1, a.block(m - 1, 0, 1, k), b, 0, c.block(m - 1, 0, 1, n));
+    }
 }
 
-mpfr_matrix::mpfr_matrix(size_t n_rows, size_t n_cols) {
-    mpfr_class initial_value;
-    mpfr_vector row(n_cols, initial_value);
-    for (size_t i = 0; i < n_rows; ++i) {
-        this->m_data.push_back(row);
+template <class T>
+mpfr_basic_matrix<T>::mpfr_basic_matrix() :
+    m_n_rows(0),
+    m_n_cols(0),
+    m_layout(mpfr_matrix_row_major) {
+}
+
+template <class T>
+mpfr_basic_matrix<T>::mpfr_basic_matrix(const mpfr_basic_matrix& other) :
+    m_data(other.m_data),
+    m_n_rows(other.m_n_rows),
+    m_n_cols(other.m_n_cols),
+    m_layout(other.m_layout) {
+}
+
+template <class T>
+mpfr_basic_matrix<T>::mpfr_basic_matrix(mpfr_basic_matrix&& other) noexcept :
+    m_data(std::move(other.m_data)),
+    m_n_rows(other.m_n_rows),
+    m_n_cols(other.m_n_cols),
+    m_layout(other.m_layout) {
+    other.m_n_rows = 0;
+    other.m_n_cols = 0;
+}
+
+template <class T>
+mpfr_basic_matrix<T>::mpfr_basic_matrix(size_t n_rows, size_t n_cols, const mpfr_matrix_layout layout) :
+    m_n_rows(n_rows),
+    m_n_cols(n_cols),
+    m_layout(layout) {
+    T initial_value;
+    this->m_data = mpfr_basic_vector<T>(n_rows * n_cols, initial_value);
+    if (mpfr_basic_vector<T>::supports_contiguous_storage() && this->m_data.size() > 0) {
+        this->m_data.set_contiguous_storage(initial_value.get_prec());
     }
 }
 
-mpfr_matrix::mpfr_matrix(size_t n_rows, size_t n_cols, const mpfr_class& initial_value) {
-    mpfr_vector row(n_cols, initial_value);
-    for (size_t i = 0; i < n_rows; ++i) {
-        this->m_data.push_back(row);
+template <class T>
+mpfr_basic_matrix<T>::mpfr_basic_matrix(size_t n_rows, size_t n_cols, const T& initial_value, const mpfr_matrix_layout layout) :
+    m_data(n_rows * n_cols, initial_value),
+    m_n_rows(n_rows),
+    m_n_cols(n_cols),
+    m_layout(layout) {
+    if (mpfr_basic_vector<T>::supports_contiguous_storage() && this->m_data.size() > 0) {
+        this->m_data.set_contiguous_storage(initial_value.get_prec());
     }
 }
 
-mpfr_matrix::~mpfr_matrix() {
+template <class T>
+mpfr_basic_matrix<T>::~mpfr_basic_matrix() {
 }
 
-mpfr_matrix& mpfr_matrix::operator=(const mpfr_matrix& other) {
-    this->m_data = other.m_data;
+template <class T>
+mpfr_basic_matrix<T>& mpfr_basic_matrix<T>::operator=(const mpfr_basic_matrix& other) {
+    if (&other != this) {
+        this->m_data = other.m_data;
+        this->m_n_rows = other.m_n_rows;
+        this->m_n_cols = other.m_n_cols;
+        this->m_layout = other.m_layout;
+    }
     return *this;
 }
 
-mpfr_matrix mpfr_matrix::operator+(const mpfr_matrix& other) const {
-    mpfr_matrix tmp = *this;
-    if (tmp.n_rows() == other.n_rows() && tmp.n_cols() == other.n_cols()) {
-        for (size_t i = 0; i < tmp.m_data.size(); ++i) {
-            tmp.m_data[i] += other.m_data[i];
-        }
-    } else {
-        tmp.set_nan();
+template <class T>
+mpfr_basic_matrix<T>& mpfr_basic_matrix<T>::operator=(mpfr_basic_matrix&& other) noexcept {
+    if (&other != this) {
+        this->m_data = std::move(other.m_data);
+        std::swap(this->m_n_rows, other.m_n_rows);
+        std::swap(this->m_n_cols, other.m_n_cols);
+        std::swap(this->m_layout, other.m_layout);
     }
+    return *this;
+}
+
+template <class T>
+mpfr_basic_matrix<T> mpfr_basic_matrix<T>::operator+(const mpfr_basic_matrix& other) const {
+    mpfr_basic_matrix tmp = *this;
+    tmp += other;
     return tmp;
 }
 
-mpfr_matrix& mpfr_matrix::operator+=(const mpfr_matrix& other) {
-    if (this->n_rows() == other.n_rows() && this->n_cols() == other.n_cols()) {
-        for (size_t i = 0; i < this->m_data.size(); ++i) {
-            this->m_data[i] += other.m_data[i];
+// Matrices of the same layout are added as flat vectors, otherwise row by
+// row through strided views.
+template <class T>
+mpfr_basic_matrix<T>& mpfr_basic_matrix<T>::operator+=(const mpfr_basic_matrix& other) {
+    if (this->m_n_rows == other.m_n_rows && this->m_n_cols == other.m_n_cols) {
+        if (this->m_layout == other.m_layout) {
+            this->m_data += other.m_data;
+        } else {
+            for (size_t i = 0; i < this->m_n_rows; ++i) {
+                this->row(i) += other.row(i);
+            }
         }
     } else {
         this->set_nan();
@@ -82,26 +261,27 @@ mpfr_matrix& mpfr_matrix::operator+=(const mpfr_matrix& other) {
     return *this;
 }
 
-mpfr_matrix mpfr_matrix::operator+() const {
-    return mpfr_matrix(*this);
+template <class T>
+mpfr_basic_matrix<T> mpfr_basic_matrix<T>::operator+() const {
+    return mpfr_basic_matrix(*this);
 }
 
-mpfr_matrix mpfr_matrix::operator-(const mpfr_matrix& other) const {
-    mpfr_matrix tmp = *this;
-    if (tmp.n_rows() == other.n_rows() && tmp.n_cols() == other.n_cols()) {
-        for (size_t i = 0; i < tmp.m_data.size(); ++i) {
-            tmp.m_data[i] -= other.m_data[i];
-        }
-    } else {
-        tmp.set_nan();
-    }
+template <class T>
+mpfr_basic_matrix<T> mpfr_basic_matrix<T>::operator-(const mpfr_basic_matrix& other) const {
+    mpfr_basic_matrix tmp = *this;
+    tmp -= other;
     return tmp;
 }
 
-mpfr_matrix& mpfr_matrix::operator-=(const mpfr_matrix& other) {
-    if (this->n_rows() == other.n_rows() && this->n_cols() == other.n_cols()) {
-        for (size_t i = 0; i < this->m_data.size(); ++i) {
-            this->m_data[i] -= other.m_data[i];
+template <class T>
+mpfr_basic_matrix<T>& mpfr_basic_matrix<T>::operator-=(const mpfr_basic_matrix& other) {
+    if (this->m_n_rows == other.m_n_rows && this->m_n_cols == other.m_n_cols) {
+        if (this->m_layout == other.m_layout) {
+            this->m_data -= other.m_data;
+        } else {
+            for (size_t i = 0; i < this->m_n_rows; ++i) {
+                this->row(i) -= other.row(i);
+            }
         }
     } else {
         this->set_nan();
@@ -109,184 +289,322 @@ mpfr_matrix& mpfr_matrix::operator-=(const mpfr_matrix& other) {
     return *this;
 }
 
-mpfr_matrix mpfr_matrix::operator-() const {
-    mpfr_matrix tmp = *this;
-    for (size_t i = 0; i < tmp.m_data.size(); ++i) {
-        tmp.m_data[i].set_neg();
-    }
+template <class T>
+mpfr_basic_matrix<T> mpfr_basic_matrix<T>::operator-() const& {
+    mpfr_basic_matrix tmp = *this;
+    tmp.set_neg();
     return tmp;
 }
 
-mpfr_matrix mpfr_matrix::operator*(const mpfr_matrix& other) const {
-    mpfr_matrix tmp(this->n_rows(), other.n_cols());
-    if (this->n_cols() == other.n_rows()) {
-        for (size_t i = 0; i < this->n_rows(); ++i) {
-            for (size_t j = 0; j < other.n_cols(); ++j) {
-                mpfr_class tmp_value = 0;
-                for (size_t k = 0; k < this->n_cols(); ++k) {
-                    tmp_value += this->m_data[i][k] * other.m_data[k][j];
-                }
-                tmp.m_data[i][j] = tmp_value;
-            }
-        }
-    }
-    return tmp;
+template <class T>
+mpfr_basic_matrix<T> mpfr_basic_matrix<T>::operator-() && {
+    this->set_neg();
+    return std::move(*this);
 }
 
-mpfr_vector mpfr_matrix::operator*(const mpfr_vector& other) const {
-    mpfr_vector tmp(this->n_rows(), 1);
-    if (this->n_cols() == other.size()) {
-        for (size_t i = 0; i < tmp.size(); ++i) {
-            mpfr_class tmp_value = 0;
-            for (size_t j = 0; j < this->n_cols(); ++j) {
-                tmp_value += this->m_data[i][j] * other[j];
-            }
-            tmp[i] = tmp_value;
-        }
+template <class T>
+mpfr_basic_matrix<T> mpfr_basic_matrix<T>::operator*(const mpfr_basic_matrix& other) const {
+    mpfr_basic_matrix tmp(this->m_n_rows, other.m_n_cols);
+    if (this->m_n_cols == other.m_n_rows) {
+        mpfr_basic_matrix::multiply(*this, other, tmp);
     }
     return tmp;
 }
 
-mpfr_matrix mpfr_matrix::operator*(const mpfr_class& other) const {
-    mpfr_matrix tmp = *this;
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        tmp.m_data[i] *= other;
-    }
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_matrix<T>::operator*(const mpfr_basic_vector_const_view<T>& other) const {
+    return this->view() * other;
+}
+
+template <class T>
+mpfr_basic_matrix<T> mpfr_basic_matrix<T>::operator*(const T& other) const {
+    mpfr_basic_matrix tmp = *this;
+    tmp.m_data *= other;
     return tmp;
 }
 
-mpfr_matrix& mpfr_matrix::operator*=(const mpfr_class& other) {
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        this->m_data[i] *= other;
-    }
+template <class T>
+mpfr_basic_matrix<T>& mpfr_basic_matrix<T>::operator*=(const T& other) {
+    this->m_data *= other;
     return *this;
 }
 
-mpfr_matrix mpfr_matrix::operator/(const mpfr_class& other) const {
-    mpfr_matrix tmp = *this;
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        tmp.m_data[i] /= other;
-    }
+template <class T>
+mpfr_basic_matrix<T> mpfr_basic_matrix<T>::operator/(const T& other) const {
+    mpfr_basic_matrix tmp = *this;
+    tmp.m_data /= other;
     return tmp;
 }
 
-mpfr_matrix& mpfr_matrix::operator/=(const mpfr_class& other) {
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        this->m_data[i] /= other;
-    }
+template <class T>
+mpfr_basic_matrix<T>& mpfr_basic_matrix<T>::operator/=(const T& other) {
+    this->m_data /= other;
     return *this;
 }
 
-mpfr_vector& mpfr_matrix::operator[](const size_t offset) {
-    return this->m_data[offset];
+template <class T>
+mpfr_basic_vector_view<T> mpfr_basic_matrix<T>::operator[](const size_t offset) {
+    return this->row(offset);
 }
 
-const mpfr_vector& mpfr_matrix::operator[](const size_t offset) const {
-    return this->m_data[offset];
+template <class T>
+mpfr_basic_vector_const_view<T> mpfr_basic_matrix<T>::operator[](const size_t offset) const {
+    return this->row(offset);
 }
 
-std::ostream& operator<<(std::ostream& left, const mpfr_matrix& right) {
-    left << '{';
-    for (size_t i = 0; i < right.m_data.size(); ++i) {
-        if (i > 0) {
-            left << ',';
-        }
-        left << '{';
-        for (size_t j = 0; j < right.m_data.size(); ++j) {
-            if (j > 0) {
-                left << ',';
-            }
-            left << right.m_data[i][j];
-        }
-        left << '}';
-    }
-    left << '}';
-    return left;
+template <class T>
+T& mpfr_basic_matrix<T>::operator()(const size_t row, const size_t col) {
+    return this->m_data[row * this->row_stride() + col * this->col_stride()];
 }
 
-void mpfr_matrix::set_prec(mpfr_prec_t prec) {
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        this->m_data[i].set_prec(prec);
-    }
+template <class T>
+const T& mpfr_basic_matrix<T>::operator()(const size_t row, const size_t col) const {
+    return this->m_data[row * this->row_stride() + col * this->col_stride()];
 }
 
-bool mpfr_matrix::contains_nan() const {
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        if (this->m_data[i].contains_nan()) {
-            return true;
-        }
-    }
-    return false;
+template <class T>
+mpfr_basic_matrix_view<T> mpfr_basic_matrix<T>::view() {
+    return mpfr_basic_matrix_view<T>(this->data(), this->m_n_rows, this->m_n_cols, this->row_stride(), this->col_stride());
 }
 
-bool mpfr_matrix::contains_inf() const {
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        if (this->m_data[i].contains_inf()) {
-            return true;
+template <class T>
+mpfr_basic_matrix_const_view<T> mpfr_basic_matrix<T>::view() const {
+    return mpfr_basic_matrix_const_view<T>(this->data(), this->m_n_rows, this->m_n_cols, this->row_stride(), this->col_stride());
+}
+
+template <class T>
+mpfr_basic_matrix_view<T> mpfr_basic_matrix<T>::block(const size_t row, const size_t col, const size_t n_rows, const size_t n_cols) {
+    return this->view().block(row, col, n_rows, n_cols);
+}
+
+template <class T>
+mpfr_basic_matrix_const_view<T> mpfr_basic_matrix<T>::block(const size_t row, const size_t col, const size_t n_rows, const size_t n_cols) const {
+    return this->view().block(row, col, n_rows, n_cols);
+}
+
+template <class T>
+mpfr_basic_vector_view<T> mpfr_basic_matrix<T>::row(const size_t row) {
+    return mpfr_basic_vector_view<T>(this->data() + row * this->row_stride(), this->m_n_cols, this->col_stride());
+}
+
+template <class T>
+mpfr_basic_vector_const_view<T> mpfr_basic_matrix<T>::row(const size_t row) const {
+    return mpfr_basic_vector_const_view<T>(this->data() + row * this->row_stride(), this->m_n_cols, this->col_stride());
+}
+
+template <class T>
+mpfr_basic_vector_view<T> mpfr_basic_matrix<T>::col(const size_t col) {
+    return mpfr_basic_vector_view<T>(this->data() + col * this->col_stride(), this->m_n_rows, this->row_stride());
+}
+
+template <class T>
+mpfr_basic_vector_const_view<T> mpfr_basic_matrix<T>::col(const size_t col) const {
+    return mpfr_basic_vector_const_view<T>(this->data() + col * this->col_stride(), this->m_n_rows, this->row_stride());
+}
+
+template <class T>
+mpfr_matrix_layout mpfr_basic_matrix<T>::get_layout() const {
+    return this->m_layout;
+}
+
+// Reorders the entries through a copy, which keeps the storage mode and the
+// precision of the entries.
+template <class T>
+void mpfr_basic_matrix<T>::set_layout(const mpfr_matrix_layout layout) {
+    if (layout == this->m_layout) {
+        return;
+    }
+    mpfr_basic_vector<T> tmp = this->m_data;
+    size_t row_stride = (layout == mpfr_matrix_row_major) ? this->m_n_cols : 1;
+    size_t col_stride = (layout == mpfr_matrix_row_major) ? 1 : this->m_n_rows;
+    for (size_t i = 0; i < this->m_n_rows; ++i) {
+        for (size_t j = 0; j < this->m_n_cols; ++j) {
+            tmp[i * row_stride + j * col_stride] = (*this)(i, j);
         }
     }
-    return false;
+    this->m_data = std::move(tmp);
+    this->m_layout = layout;
+}
+
+template <class T>
+void mpfr_basic_matrix<T>::set_prec(mpfr_prec_t prec) {
+    this->m_data.set_prec(prec);
+}
+
+template <class T>
+void mpfr_basic_matrix<T>::round_prec(mpfr_prec_t prec) {
+    this->m_data.round_prec(prec);
 }
 
-bool mpfr_matrix::is_zero() const {
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        if (this->m_data[i].is_zero()) {
+template <class T>
+bool mpfr_basic_matrix<T>::contains_nan() const {
+    return this->m_data.contains_nan();
+}
+
+template <class T>
+bool mpfr_basic_matrix<T>::contains_inf() const {
+    return this->m_data.contains_inf();
+}
+
+template <class T>
+bool mpfr_basic_matrix<T>::is_zero() const {
+    for (size_t i = 0; i < this->m_n_rows; ++i) {
+        if (this->row(i).is_zero()) {
             return true;
         }
     }
     return false;
 }
 
-void mpfr_matrix::set_nan() {
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        this->m_data[i].set_nan();
-    }
+template <class T>
+void mpfr_basic_matrix<T>::set_nan() {
+    this->m_data.set_nan();
 }
 
-void mpfr_matrix::set_inf(int sign) {
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        this->m_data[i].set_inf(sign);
-    }
+template <class T>
+void mpfr_basic_matrix<T>::set_inf(int sign) {
+    this->m_data.set_inf(sign);
 }
 
-void mpfr_matrix::set_zero(int sign) {
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        this->m_data[i].set_zero(sign);
-    }
+template <class T>
+void mpfr_basic_matrix<T>::set_zero(int sign) {
+    this->m_data.set_zero(sign);
 }
 
-void mpfr_matrix::set_neg() {
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        this->m_data[i].set_neg();
-    }
+template <class T>
+void mpfr_basic_matrix<T>::set_neg() {
+    this->m_data.set_neg();
 }
 
-size_t mpfr_matrix::size() const {
-    if (this->m_data.size() == 0) {
-        return 0;
-    }
-    return this->m_data.size() * this->m_data[0].size();
+template <class T>
+T *mpfr_basic_matrix<T>::data() {
+    return this->m_data.view().data();
 }
 
-size_t mpfr_matrix::n_rows() const {
+template <class T>
+const T *mpfr_basic_matrix<T>::data() const {
+    return this->m_data.view().data();
+}
+
+template <class T>
+typename mpfr_basic_matrix<T>::size_t mpfr_basic_matrix<T>::size() const {
     return this->m_data.size();
 }
 
-size_t mpfr_matrix::n_cols() const {
-    if (this->m_data.size() == 0) {
-        return 0;
-    }
-    return this->m_data[0].size();
+template <class T>
+typename mpfr_basic_matrix<T>::size_t mpfr_basic_matrix<T>::n_rows() const {
+    return this->m_n_rows;
 }
 
-mpfr_matrix mpfr_matrix::zero_matrix(const size_t n_rows, const size_t n_cols) {
-    return mpfr_matrix(n_rows, n_cols, 0);
+template <class T>
+typename mpfr_basic_matrix<T>::size_t mpfr_basic_matrix<T>::n_cols() const {
+    return this->m_n_cols;
 }
 
-mpfr_matrix mpfr_matrix::eye_matrix(const size_t size) {
-    mpfr_matrix tmp(size, size, 0);
+template <class T>
+typename mpfr_basic_matrix<T>::size_t mpfr_basic_matrix<T>::row_stride() const {
+    return (this->m_layout == mpfr_matrix_row_major) ? this->m_n_cols : 1;
+}
+
+template <class T>
+typename mpfr_basic_matrix<T>::size_t mpfr_basic_matrix<T>::col_stride() const {
+    return (this->m_layout == mpfr_matrix_row_major) ? 1 : this->m_n_rows;
+}
+
+template <class T>
+mpfr_basic_matrix<T> mpfr_basic_matrix<T>::zero_matrix(const size_t n_rows, const size_t n_cols) {
+    return mpfr_basic_matrix(n_rows, n_cols, 0);
+}
+
+template <class T>
+mpfr_basic_matrix<T> mpfr_basic_matrix<T>::eye_matrix(const size_t size) {
+    mpfr_basic_matrix tmp(size, size, 0);
     for (size_t i = 0; i < size; ++i) {
-        tmp[i][i] = 1;
+        tmp(i, i) = 1;
     }
     return tmp;
 }
+
+// In-place c = alpha * a * b + beta * c. The old entries of c are not read
+// if beta is zero. The entries of c keep their precision and must not overlap
+// those of a or b. On a size mismatch c is set to NaN.
+template <class T>
+void mpfr_basic_matrix<T>::gemm(const T& alpha, const mpfr_basic_matrix_const_view<T>& a, const mpfr_basic_matrix_const_view<T>& b, const T& beta, const mpfr_basic_matrix_view<T>& c) {
+    if (a.n_cols() != b.n_rows() || c.n_rows() != a.n_rows() || c.n_cols() != b.n_cols()) {
+        c.set_nan();
+        return;
+    }
+    if (c.n_rows() == 0 || c.n_cols() == 0) {
+        return;
+    }
+    const T *c_begin = &c(0, 0);
+    const T *c_end = &c(c.n_rows() - 1, c.n_cols() - 1) + 1;
+    if ((a.n_cols() > 0 && c_begin <= &a(a.n_rows() - 1, a.n_cols() - 1) && &a(0, 0) < c_end) ||
+        (b.n_rows() > 0 && c_begin <= &b(b.n_rows() - 1, b.n_cols() - 1) && &b(0, 0) < c_end)) {
+        printf("mpfr_matrix[%s:%d]: The result must not alias a factor.\n", __FILE__, __LINE__);
+        abort();
+    }
+    mpfr_prec_t prec = c(0, 0).get_prec();
+    size_t tile = mpfr_matrix_gemm_tile<T>(c.n_rows(), c.n_cols(), a.n_cols(), prec);
+    size_t n_row_tiles = (c.n_rows() + tile - 1) / tile;
+    size_t n_col_tiles = (c.n_cols() + tile - 1) / tile;
+    mpfr_matrix_gemm_kernel<T> kernel = {alpha, a, b, beta, c, tile, n_col_tiles};
+    mpfr_thread_pool::global().parallel_for(kernel, n_row_tiles * n_col_tiles, tile * tile * std::max(a.n_cols(), (size_t)1) * prec, gemm_grain);
+}
+
+// Product a * b into c. MPFR values whose precision can be raised switch to
+// Strassen-Winograd once every dimension reaches the crossover for the
+// precision of c. The recursion then runs with enough guard bits that
+// Higham's normwise bound for it, ((n / n0)^log2(18) (n0^2 + 6 n0) - 6 n) u
+// ||a|| ||b|| with n0 the size at which it stops, stays below one unit of the
+// precision of c, and the result is rounded into c. Everything else goes to
+// gemm.
+template <class T>
+void mpfr_basic_matrix<T>::multiply(const mpfr_basic_matrix_const_view<T>& a, const mpfr_basic_matrix_const_view<T>& b, const mpfr_basic_matrix_view<T>& c) {
+    if (a.n_cols() != b.n_rows() || c.n_rows() != a.n_rows() || c.n_cols() != b.n_cols()) {
+        c.set_nan();
+        return;
+    }
+    if (c.n_rows() == 0 || c.n_cols() == 0) {
+        return;
+    }
+    mpfr_prec_t prec = c(0, 0).get_prec();
+    size_t crossover = mpfr_basic_matrix::strassen_crossover(prec);
+    size_t dimension = std::min(std::min(a.n_rows(), a.n_cols()), b.n_cols());
+    if (!mpfr_scalar_traits<T>::is_mpfr || mpfr_scalar_traits<T>::is_fixed_prec || dimension < crossover) {
+        mpfr_basic_matrix::gemm(1, a, b, 0, c);
+        return;
+    }
+    size_t levels = 0;
+    while (dimension >= crossover) {
+        ++levels;
+        dimension /= 2;
+    }
+    mpfr_prec_t guard = (mpfr_prec_t)std::ceil(levels * std::log2(18.0) + std::log2((double)(dimension * dimension + 6 * dimension)));
+    mpfr_context context(prec + guard);
+    mpfr_basic_matrix tmp(c.n_rows(), c.n_cols());
+    mpfr_matrix_strassen<T>(a, b, tmp, crossover);
+    c.assign(tmp);
+}
+
+// A product costs about as many additions as its operands have limbs, so
+// the savings of a level grow with the precision.
+template <class T>
+typename mpfr_basic_matrix<T>::size_t mpfr_basic_matrix<T>::strassen_crossover(const mpfr_prec_t prec) {
+    size_t n_limbs = (size_t)(prec + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+    size_t crossover = strassen_limbs / ((n_limbs > 0) ? n_limbs : 1);
+    return (crossover > strassen_min_size) ? crossover : strassen_min_size;
+}
+
+template class mpfr_basic_matrix<mpfr_class>;
+template class mpfr_basic_matrix<mpfr_fixed128>;
+template class mpfr_basic_matrix<mpfr_fixed256>;
+template class mpfr_basic_matrix<mpfr_fixed512>;
+template class mpfr_basic_matrix<mpfr_fixed1024>;
+template class mpfr_basic_matrix<dd_class>;
+template class mpfr_basic_matrix<qd_class>;
+template class mpfr_basic_matrix<double_class>;
+template class mpfr_basic_matrix<ldouble_class>;
+#ifdef HAVE_FLOAT128
+template class mpfr_basic_matrix<float128_class>;
+#endif
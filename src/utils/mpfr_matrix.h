@@ -28,53 +28,114 @@
 #ifndef __MPFR_MATRIX_H__
 #define __MPFR_MATRIX_H__
 
+#include <iostream>
+#include <utility>
 #include <vector>
 
+#include "mpfr_accumulator.h"
 #include "mpfr_class.h"
+#include "mpfr_matrix_view.h"
 #include "mpfr_vector.h"
 
-class mpfr_matrix {
+typedef enum mpfr_matrix_layout {
+    mpfr_matrix_row_major = 0,
+    mpfr_matrix_column_major = 1
+} mpfr_matrix_layout;
+
+// The entries are kept in one flat vector, row after row or column after
+// column. For mpfr_class the vector uses contiguous storage at the precision
+// of the initial value, so all limbs come from a single buffer and values
+// assigned to entries are rounded into that precision.
+template <class T>
+class mpfr_basic_matrix {
 
 public:
 
-    typedef std::vector<mpfr_vector>::size_type size_t;
+    typedef typename std::vector<T>::size_type size_t;
 
 private:
 
-    std::vector<mpfr_vector> m_data;
+    mpfr_basic_vector<T> m_data;
+    size_t m_n_rows;
+    size_t m_n_cols;
+    mpfr_matrix_layout m_layout;
 
 public:
 
-    mpfr_matrix();
-    mpfr_matrix(const mpfr_matrix& other);
-    mpfr_matrix(size_t n_rows, size_t n_cols);
-    mpfr_matrix(size_t n_rows, size_t n_cols, const mpfr_class& initial_value);
-    ~mpfr_matrix();
-
-    mpfr_matrix& operator=(const mpfr_matrix& other);
-
-    mpfr_matrix operator+(const mpfr_matrix& other) const;
-    mpfr_matrix& operator+=(const mpfr_matrix& other);
-    mpfr_matrix operator+() const;
-
-    mpfr_matrix operator-(const mpfr_matrix& other) const;
-    mpfr_matrix& operator-=(const mpfr_matrix& other);
-    mpfr_matrix operator-() const;
-
-    mpfr_matrix operator*(const mpfr_matrix& other) const;
-    mpfr_vector operator*(const mpfr_vector& other) const;
-    mpfr_matrix operator*(const mpfr_class& other) const;
-    mpfr_matrix& operator*=(const mpfr_class& other);
-
-    mpfr_matrix operator/(const mpfr_class& other) const;
-    mpfr_matrix& operator/=(const mpfr_class& other);
-
-    mpfr_vector& operator[](const size_t offset);
-    const mpfr_vector& operator[](const size_t offset) const;
-
-    friend std::ostream& operator<<(std::ostream& left, const mpfr_matrix& right);
+    mpfr_basic_matrix();
+    mpfr_basic_matrix(const mpfr_basic_matrix& other);
+    mpfr_basic_matrix(mpfr_basic_matrix&& other) noexcept;
+    mpfr_basic_matrix(size_t n_rows, size_t n_cols, const mpfr_matrix_layout layout = mpfr_matrix_row_major);
+    mpfr_basic_matrix(size_t n_rows, size_t n_cols, const T& initial_value, const mpfr_matrix_layout layout = mpfr_matrix_row_major);
+    ~mpfr_basic_matrix();
+
+    mpfr_basic_matrix& operator=(const mpfr_basic_matrix& other);
+    mpfr_basic_matrix& operator=(mpfr_basic_matrix&& other) noexcept;
+
+    mpfr_basic_matrix operator+(const mpfr_basic_matrix& other) const;
+    friend mpfr_basic_matrix operator+(mpfr_basic_matrix&& left, const mpfr_basic_matrix& right) {
+        left += right;
+        return std::move(left);
+    }
+    mpfr_basic_matrix& operator+=(const mpfr_basic_matrix& other);
+    mpfr_basic_matrix operator+() const;
+
+    mpfr_basic_matrix operator-(const mpfr_basic_matrix& other) const;
+    friend mpfr_basic_matrix operator-(mpfr_basic_matrix&& left, const mpfr_basic_matrix& right) {
+        left -= right;
+        return std::move(left);
+    }
+    mpfr_basic_matrix& operator-=(const mpfr_basic_matrix& other);
+    mpfr_basic_matrix operator-() const&;
+    mpfr_basic_matrix operator-() &&;
+
+    mpfr_basic_matrix operator*(const mpfr_basic_matrix& other) const;
+    mpfr_basic_vector<T> operator*(const mpfr_basic_vector_const_view<T>& other) const;
+    mpfr_basic_matrix operator*(const T& other) const;
+    friend mpfr_basic_matrix operator*(mpfr_basic_matrix&& left, const T& right) {
+        left *= right;
+        return std::move(left);
+    }
+    mpfr_basic_matrix& operator*=(const T& other);
+
+    mpfr_basic_matrix operator/(const T& other) const;
+    friend mpfr_basic_matrix operator/(mpfr_basic_matrix&& left, const T& right) {
+        left /= right;
+        return std::move(left);
+    }
+    mpfr_basic_matrix& operator/=(const T& other);
+
+    mpfr_basic_vector_view<T> operator[](const size_t offset);
+    mpfr_basic_vector_const_view<T> operator[](const size_t offset) const;
+    T& operator()(const size_t row, const size_t col);
+    const T& operator()(const size_t row, const size_t col) const;
+
+    friend std::ostream& operator<<(std::ostream& left, const mpfr_basic_matrix& right) {
+        left << '{';
+        for (size_t i = 0; i < right.m_n_rows; ++i) {
+            if (i > 0) {
+                left << ',';
+            }
+            left << right[i];
+        }
+        left << '}';
+        return left;
+    }
+
+    mpfr_basic_matrix_view<T> view();
+    mpfr_basic_matrix_const_view<T> view() const;
+    mpfr_basic_matrix_view<T> block(const size_t row, const size_t col, const size_t n_rows, const size_t n_cols);
+    mpfr_basic_matrix_const_view<T> block(const size_t row, const size_t col, const size_t n_rows, const size_t n_cols) const;
+    mpfr_basic_vector_view<T> row(const size_t row);
+    mpfr_basic_vector_const_view<T> row(const size_t row) const;
+    mpfr_basic_vector_view<T> col(const size_t col);
+    mpfr_basic_vector_const_view<T> col(const size_t col) const;
+
+    mpfr_matrix_layout get_layout() const;
+    void set_layout(const mpfr_matrix_layout layout);
 
     void set_prec(mpfr_prec_t prec);
+    void round_prec(mpfr_prec_t prec);
 
     bool contains_nan() const;
     bool contains_inf() const;
@@ -85,15 +146,37 @@ public:
     void set_zero(int sign);
     void set_neg();
 
+    T *data();
+    const T *data() const;
     size_t size() const;
     size_t n_rows() const;
     size_t n_cols() const;
+    size_t row_stride() const;
+    size_t col_stride() const;
 
 public:
 
-    static mpfr_matrix zero_matrix(const size_t n_rows, const size_t n_cols);
-    static mpfr_matrix eye_matrix(const size_t size);
+    static mpfr_basic_matrix zero_matrix(const size_t n_rows, const size_t n_cols);
+    static mpfr_basic_matrix eye_matrix(const size_t size);
+
+    static void gemm(const T& alpha, const mpfr_basic_matrix_const_view<T>& a, const mpfr_basic_matrix_const_view<T>& b, const T& beta, const mpfr_basic_matrix_view<T>& c);
+    static void multiply(const mpfr_basic_matrix_const_view<T>& a, const mpfr_basic_matrix_const_view<T>& b, const mpfr_basic_matrix_view<T>& c);
+    static size_t strassen_crossover(const mpfr_prec_t prec);
+
+    // Bytes of the rows and columns that one output tile of gemm reads, and
+    // the minimum number of multiplications times precision in bits handed to
+    // one thread.
+    static const size_t gemm_cache_bytes = 1 << 18;
+    static const size_t gemm_grain = 1 << 20;
+
+    // Strassen-Winograd is used once every dimension reaches
+    // strassen_limbs divided by the number of limbs of the precision, but
+    // never below strassen_min_size.
+    static const size_t strassen_min_size = 32;
+    static const size_t strassen_limbs = 2048;
+
+}; // class mpfr_basic_matrix
 
-}; // class mpfr_matrix
+typedef mpfr_basic_matrix<mpfr_class> mpfr_matrix;
 
 #endif // __MPFR_MATRIX_H__
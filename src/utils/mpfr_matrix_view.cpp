@@ -0,0 +1,317 @@
+//
+//  mpfr_matrix_view.cpp
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#include "mpfr_matrix_view.h"
+
+#include "mpfr_matrix.h"
+
+template <class T>
+mpfr_basic_matrix_const_view<T>::mpfr_basic_matrix_const_view() :
+    m_data(NULL),
+    m_n_rows(0),
+    m_n_cols(0),
+    m_row_stride(0),
+    m_col_stride(1) {
+}
+
+template <class T>
+mpfr_basic_matrix_const_view<T>::mpfr_basic_matrix_const_view(const T *data, const size_t n_rows, const size_t n_cols, const size_t row_stride, const size_t col_stride) :
+    m_data(data),
+    m_n_rows(n_rows),
+    m_n_cols(n_cols),
+    m_row_stride(row_stride),
+    m_col_stride(col_stride) {
+}
+
+template <class T>
+mpfr_basic_matrix_const_view<T>::mpfr_basic_matrix_const_view(const mpfr_basic_matrix<T>& other) :
+    m_data(other.data()),
+    m_n_rows(other.n_rows()),
+    m_n_cols(other.n_cols()),
+    m_row_stride(other.row_stride()),
+    m_col_stride(other.col_stride()) {
+}
+
+template <class T>
+mpfr_basic_matrix_const_view<T>::mpfr_basic_matrix_const_view(const mpfr_basic_matrix_view<T>& other) :
+    m_data(other.data()),
+    m_n_rows(other.n_rows()),
+    m_n_cols(other.n_cols()),
+    m_row_stride(other.row_stride()),
+    m_col_stride(other.col_stride()) {
+}
+
+template <class T>
+const T& mpfr_basic_matrix_const_view<T>::operator()(const size_t row, const size_t col) const {
+    return this->m_data[row * this->m_row_stride + col * this->m_col_stride];
+}
+
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_matrix_const_view<T>::operator*(const mpfr_basic_vector_const_view<T>& other) const {
+    mpfr_basic_vector<T> tmp(this->m_n_rows, 1);
+    if (this->m_n_cols == other.size()) {
+        for (size_t i = 0; i < this->m_n_rows; ++i) {
+            tmp[i] = this->row(i).dot(other);
+        }
+    }
+    return tmp;
+}
+
+template <class T>
+mpfr_basic_vector_const_view<T> mpfr_basic_matrix_const_view<T>::row(const size_t row) const {
+    return mpfr_basic_vector_const_view<T>(this->m_data + row * this->m_row_stride, this->m_n_cols, this->m_col_stride);
+}
+
+template <class T>
+mpfr_basic_vector_const_view<T> mpfr_basic_matrix_const_view<T>::col(const size_t col) const {
+    return mpfr_basic_vector_const_view<T>(this->m_data + col * this->m_col_stride, this->m_n_rows, this->m_row_stride);
+}
+
+template <class T>
+mpfr_basic_matrix_const_view<T> mpfr_basic_matrix_const_view<T>::block(const size_t row, const size_t col, const size_t n_rows, const size_t n_cols) const {
+    if (row + n_rows > this->m_n_rows || col + n_cols > this->m_n_cols) {
+        printf("mpfr_basic_matrix_const_view[%s:%d]: The block exceeds the view.\n", __FILE__, __LINE__);
+        abort();
+    }
+    return mpfr_basic_matrix_const_view(this->m_data + row * this->m_row_stride + col * this->m_col_stride, n_rows, n_cols, this->m_row_stride, this->m_col_stride);
+}
+
+template <class T>
+mpfr_basic_matrix_const_view<T> mpfr_basic_matrix_const_view<T>::transpose() const {
+    return mpfr_basic_matrix_const_view(this->m_data, this->m_n_cols, this->m_n_rows, this->m_col_stride, this->m_row_stride);
+}
+
+template <class T>
+bool mpfr_basic_matrix_const_view<T>::contains_nan() const {
+    for (size_t i = 0; i < this->m_n_rows; ++i) {
+        if (this->row(i).contains_nan()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class T>
+bool mpfr_basic_matrix_const_view<T>::contains_inf() const {
+    for (size_t i = 0; i < this->m_n_rows; ++i) {
+        if (this->row(i).contains_inf()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class T>
+const T *mpfr_basic_matrix_const_view<T>::data() const {
+    return this->m_data;
+}
+
+template <class T>
+typename mpfr_basic_matrix_const_view<T>::size_t mpfr_basic_matrix_const_view<T>::n_rows() const {
+    return this->m_n_rows;
+}
+
+template <class T>
+typename mpfr_basic_matrix_const_view<T>::size_t mpfr_basic_matrix_const_view<T>::n_cols() const {
+    return this->m_n_cols;
+}
+
+template <class T>
+typename mpfr_basic_matrix_const_view<T>::size_t mpfr_basic_matrix_const_view<T>::row_stride() const {
+    return this->m_row_stride;
+}
+
+template <class T>
+typename mpfr_basic_matrix_const_view<T>::size_t mpfr_basic_matrix_const_view<T>::col_stride() const {
+    return this->m_col_stride;
+}
+
+template <class T>
+mpfr_basic_matrix_view<T>::mpfr_basic_matrix_view() :
+    m_data(NULL),
+    m_n_rows(0),
+    m_n_cols(0),
+    m_row_stride(0),
+    m_col_stride(1) {
+}
+
+template <class T>
+mpfr_basic_matrix_view<T>::mpfr_basic_matrix_view(T *data, const size_t n_rows, const size_t n_cols, const size_t row_stride, const size_t col_stride) :
+    m_data(data),
+    m_n_rows(n_rows),
+    m_n_cols(n_cols),
+    m_row_stride(row_stride),
+    m_col_stride(col_stride) {
+}
+
+template <class T>
+mpfr_basic_matrix_view<T>::mpfr_basic_matrix_view(mpfr_basic_matrix<T>& other) :
+    m_data(other.data()),
+    m_n_rows(other.n_rows()),
+    m_n_cols(other.n_cols()),
+    m_row_stride(other.row_stride()),
+    m_col_stride(other.col_stride()) {
+}
+
+template <class T>
+T& mpfr_basic_matrix_view<T>::operator()(const size_t row, const size_t col) const {
+    return this->m_data[row * this->m_row_stride + col * this->m_col_stride];
+}
+
+template <class T>
+mpfr_basic_vector_view<T> mpfr_basic_matrix_view<T>::row(const size_t row) const {
+    return mpfr_basic_vector_view<T>(this->m_data + row * this->m_row_stride, this->m_n_cols, this->m_col_stride);
+}
+
+template <class T>
+mpfr_basic_vector_view<T> mpfr_basic_matrix_view<T>::col(const size_t col) const {
+    return mpfr_basic_vector_view<T>(this->m_data + col * this->m_col_stride, this->m_n_rows, this->m_row_stride);
+}
+
+template <class T>
+mpfr_basic_matrix_view<T> mpfr_basic_matrix_view<T>::block(const size_t row, const size_t col, const size_t n_rows, const size_t n_cols) const {
+    if (row + n_rows > this->m_n_rows || col + n_cols > this->m_n_cols) {
+        printf("mpfr_basic_matrix_view[%s:%d]: The block exceeds the view.\n", __FILE__, __LINE__);
+        abort();
+    }
+    return mpfr_basic_matrix_view(this->m_data + row * this->m_row_stride + col * this->m_col_stride, n_rows, n_cols, this->m_row_stride, this->m_col_stride);
+}
+
+template <class T>
+mpfr_basic_matrix_view<T> mpfr_basic_matrix_view<T>::transpose() const {
+    return mpfr_basic_matrix_view(this->m_data, this->m_n_cols, this->m_n_rows, this->m_col_stride, this->m_row_stride);
+}
+
+// Copies the values of other into the viewed entries, which keep their
+// precision.
+template <class T>
+void mpfr_basic_matrix_view<T>::assign(const mpfr_basic_matrix_const_view<T>& other) const {
+    if (this->m_n_rows != other.n_rows() || this->m_n_cols != other.n_cols()) {
+        this->set_nan();
+        return;
+    }
+    for (size_t i = 0; i < this->m_n_rows; ++i) {
+        this->row(i).assign(other.row(i));
+    }
+}
+
+template <class T>
+const mpfr_basic_matrix_view<T>& mpfr_basic_matrix_view<T>::operator+=(const mpfr_basic_matrix_const_view<T>& other) const {
+    if (this->m_n_rows != other.n_rows() || this->m_n_cols != other.n_cols()) {
+        this->set_nan();
+        return *this;
+    }
+    for (size_t i = 0; i < this->m_n_rows; ++i) {
+        this->row(i) += other.row(i);
+    }
+    return *this;
+}
+
+template <class T>
+const mpfr_basic_matrix_view<T>& mpfr_basic_matrix_view<T>::operator-=(const mpfr_basic_matrix_const_view<T>& other) const {
+    if (this->m_n_rows != other.n_rows() || this->m_n_cols != other.n_cols()) {
+        this->set_nan();
+        return *this;
+    }
+    for (size_t i = 0; i < this->m_n_rows; ++i) {
+        this->row(i) -= other.row(i);
+    }
+    return *this;
+}
+
+template <class T>
+const mpfr_basic_matrix_view<T>& mpfr_basic_matrix_view<T>::operator*=(const T& other) const {
+    for (size_t i = 0; i < this->m_n_rows; ++i) {
+        this->row(i) *= other;
+    }
+    return *this;
+}
+
+template <class T>
+void mpfr_basic_matrix_view<T>::set_nan() const {
+    for (size_t i = 0; i < this->m_n_rows; ++i) {
+        this->row(i).set_nan();
+    }
+}
+
+template <class T>
+void mpfr_basic_matrix_view<T>::set_zero(int sign) const {
+    for (size_t i = 0; i < this->m_n_rows; ++i) {
+        this->row(i).set_zero(sign);
+    }
+}
+
+template <class T>
+T *mpfr_basic_matrix_view<T>::data() const {
+    return this->m_data;
+}
+
+template <class T>
+typename mpfr_basic_matrix_view<T>::size_t mpfr_basic_matrix_view<T>::n_rows() const {
+    return this->m_n_rows;
+}
+
+template <class T>
+typename mpfr_basic_matrix_view<T>::size_t mpfr_basic_matrix_view<T>::n_cols() const {
+    return this->m_n_cols;
+}
+
+template <class T>
+typename mpfr_basic_matrix_view<T>::size_t mpfr_basic_matrix_view<T>::row_stride() const {
+    return this->m_row_stride;
+}
+
+template <class T>
+typename mpfr_basic_matrix_view<T>::size_t mpfr_basic_matrix_view<T>::col_stride() const {
+    return this->m_col_stride;
+}
+
+template class mpfr_basic_matrix_const_view<mpfr_class>;
+template class mpfr_basic_matrix_const_view<mpfr_fixed128>;
+template class mpfr_basic_matrix_const_view<mpfr_fixed256>;
+template class mpfr_basic_matrix_const_view<mpfr_fixed512>;
+template class mpfr_basic_matrix_const_view<mpfr_fixed1024>;
+template class mpfr_basic_matrix_const_view<dd_class>;
+template class mpfr_basic_matrix_const_view<qd_class>;
+template class mpfr_basic_matrix_const_view<double_class>;
+template class mpfr_basic_matrix_const_view<ldouble_class>;
+#ifdef HAVE_FLOAT128
+template class mpfr_basic_matrix_const_view<float128_class>;
+#endif
+
+template class mpfr_basic_matrix_view<mpfr_class>;
+template class mpfr_basic_matrix_view<mpfr_fixed128>;
+template class mpfr_basic_matrix_view<mpfr_fixed256>;
+template class mpfr_basic_matrix_view<mpfr_fixed512>;
+template class mpfr_basic_matrix_view<mpfr_fixed1024>;
+template class mpfr_basic_matrix_view<dd_class>;
+template class mpfr_basic_matrix_view<qd_class>;
+template class mpfr_basic_matrix_view<double_class>;
+template class mpfr_basic_matrix_view<ldouble_class>;
+#ifdef HAVE_FLOAT128
+template class mpfr_basic_matrix_view<float128_class>;
+#endif
@@ -0,0 +1,138 @@
+//
+//  mpfr_matrix_view.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __MPFR_MATRIX_VIEW_H__
+#define __MPFR_MATRIX_VIEW_H__
+
+#include <vector>
+
+#include "mpfr_class.h"
+#include "mpfr_vector.h"
+#include "mpfr_vector_view.h"
+
+// Non-owning views of a rectangular block of a matrix whose entries lie
+// row_stride elements apart down a column and col_stride elements apart
+// along a row. Rows and columns are vector views, so kernels on vector views
+// run on them without copying. Like the vector views they are shallow and
+// must not outlive the matrix.
+
+template <class T>
+class mpfr_basic_matrix;
+
+template <class T>
+class mpfr_basic_matrix_view;
+
+template <class T>
+class mpfr_basic_matrix_const_view {
+
+public:
+
+    typedef typename std::vector<T>::size_type size_t;
+
+private:
+
+    const T *m_data;
+    size_t m_n_rows;
+    size_t m_n_cols;
+    size_t m_row_stride;
+    size_t m_col_stride;
+
+public:
+
+    mpfr_basic_matrix_const_view();
+    mpfr_basic_matrix_const_view(const T *data, const size_t n_rows, const size_t n_cols, const size_t row_stride, const size_t col_stride);
+    mpfr_basic_matrix_const_view(const mpfr_basic_matrix<T>& other);
+    mpfr_basic_matrix_const_view(const mpfr_basic_matrix_view<T>& other);
+
+    const T& operator()(const size_t row, const size_t col) const;
+
+    mpfr_basic_vector<T> operator*(const mpfr_basic_vector_const_view<T>& other) const;
+
+    mpfr_basic_vector_const_view<T> row(const size_t row) const;
+    mpfr_basic_vector_const_view<T> col(const size_t col) const;
+    mpfr_basic_matrix_const_view block(const size_t row, const size_t col, const size_t n_rows, const size_t n_cols) const;
+    mpfr_basic_matrix_const_view transpose() const;
+
+    bool contains_nan() const;
+    bool contains_inf() const;
+
+    const T *data() const;
+    size_t n_rows() const;
+    size_t n_cols() const;
+    size_t row_stride() const;
+    size_t col_stride() const;
+
+}; // class mpfr_basic_matrix_const_view
+
+template <class T>
+class mpfr_basic_matrix_view {
+
+public:
+
+    typedef typename std::vector<T>::size_type size_t;
+
+private:
+
+    T *m_data;
+    size_t m_n_rows;
+    size_t m_n_cols;
+    size_t m_row_stride;
+    size_t m_col_stride;
+
+public:
+
+    mpfr_basic_matrix_view();
+    mpfr_basic_matrix_view(T *data, const size_t n_rows, const size_t n_cols, const size_t row_stride, const size_t col_stride);
+    mpfr_basic_matrix_view(mpfr_basic_matrix<T>& other);
+
+    T& operator()(const size_t row, const size_t col) const;
+
+    mpfr_basic_vector_view<T> row(const size_t row) const;
+    mpfr_basic_vector_view<T> col(const size_t col) const;
+    mpfr_basic_matrix_view block(const size_t row, const size_t col, const size_t n_rows, const size_t n_cols) const;
+    mpfr_basic_matrix_view transpose() const;
+
+    void assign(const mpfr_basic_matrix_const_view<T>& other) const;
+    const mpfr_basic_matrix_view& operator+=(const mpfr_basic_matrix_const_view<T>& other) const;
+    const mpfr_basic_matrix_view& operator-=(const mpfr_basic_matrix_const_view<T>& other) const;
+    const mpfr_basic_matrix_view& operator*=(const T& other) const;
+
+    void set_nan() const;
+    void set_zero(int sign) const;
+
+    T *data() const;
+    size_t n_rows() const;
+    size_t n_cols() const;
+    size_t row_stride() const;
+    size_t col_stride() const;
+
+}; // class mpfr_basic_matrix_view
+
+typedef mpfr_basic_matrix_view<mpfr_class> mpfr_matrix_view;
+typedef mpfr_basic_matrix_const_view<mpfr_class> mpfr_matrix_const_view;
+
+#endif // __MPFR_MATRIX_VIEW_H__
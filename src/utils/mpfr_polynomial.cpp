@@ -28,45 +28,69 @@
 #include "mpfr_polynomial.h"
 
 #include <iostream>
+#include <utility>
 
-mpfr_polynomial::mpfr_polynomial() {
-    mpfr_class initial_value;
+template <class T>
+mpfr_basic_polynomial<T>::mpfr_basic_polynomial() {
+    T initial_value;
     this->m_data.push_back(initial_value);
 }
 
-mpfr_polynomial::mpfr_polynomial(const mpfr_polynomial& other) :
+template <class T>
+mpfr_basic_polynomial<T>::mpfr_basic_polynomial(const mpfr_basic_polynomial& other) :
     m_data(other.m_data) {
 }
 
-mpfr_polynomial::mpfr_polynomial(size_t max_degree) {
-    mpfr_class initial_value;
+template <class T>
+mpfr_basic_polynomial<T>::mpfr_basic_polynomial(mpfr_basic_polynomial&& other) noexcept :
+    m_data(std::move(other.m_data)) {
+}
+
+template <class T>
+mpfr_basic_polynomial<T>::mpfr_basic_polynomial(size_t max_degree) {
+    T initial_value;
+    this->m_data.reserve(max_degree + 1);
     for (size_t i = 0; i < max_degree + 1; ++i) {
         this->m_data.push_back(initial_value);
     }
 }
 
-mpfr_polynomial::mpfr_polynomial(size_t max_degree, const mpfr_class& initial_value) {
+template <class T>
+mpfr_basic_polynomial<T>::mpfr_basic_polynomial(size_t max_degree, const T& initial_value) {
+    this->m_data.reserve(max_degree + 1);
     for (size_t i = 0; i < max_degree + 1; ++i) {
         this->m_data.push_back(initial_value);
     }
 }
 
-mpfr_polynomial::~mpfr_polynomial() {
+template <class T>
+mpfr_basic_polynomial<T>::~mpfr_basic_polynomial() {
 }
 
-mpfr_polynomial& mpfr_polynomial::operator=(const mpfr_polynomial& other) {
+template <class T>
+mpfr_basic_polynomial<T>& mpfr_basic_polynomial<T>::operator=(const mpfr_basic_polynomial& other) {
     this->m_data = other.m_data;
     return *this;
 }
 
-mpfr_polynomial& mpfr_polynomial::operator=(const mpfr_class& other) {
+template <class T>
+mpfr_basic_polynomial<T>& mpfr_basic_polynomial<T>::operator=(mpfr_basic_polynomial&& other) noexcept {
+    if (&other != this) {
+        this->m_data.swap(other.m_data);
+    }
+    return *this;
+}
+
+template <class T>
+mpfr_basic_polynomial<T>& mpfr_basic_polynomial<T>::operator=(const T& other) {
     this->set_max_degree(0);
     this->m_data[0] = other;
     return *this;
 }
 
-mpfr_polynomial mpfr_polynomial::operator+(const mpfr_polynomial& other) const {
-    mpfr_polynomial tmp = *this;
+template <class T>
+mpfr_basic_polynomial<T> mpfr_basic_polynomial<T>::operator+(const mpfr_basic_polynomial& other) const {
+    mpfr_basic_polynomial tmp = *this;
     if (tmp.m_data.size() < other.m_data.size()) {
         tmp.set_max_degree(other.get_max_degree());
     }
@@ -76,13 +100,15 @@ mpfr_polynomial mpfr_polynomial::operator+(const mpfr_polynomial& other) const {
     return tmp;
 }
 
-mpfr_polynomial mpfr_polynomial::operator+(const mpfr_class& other) const {
-    mpfr_polynomial tmp = *this;
+template <class T>
+mpfr_basic_polynomial<T> mpfr_basic_polynomial<T>::operator+(const T& other) const {
+    mpfr_basic_polynomial tmp = *this;
     tmp.m_data[0] += other;
     return tmp;
 }
 
-mpfr_polynomial& mpfr_polynomial::operator+=(const mpfr_polynomial& other) {
+template <class T>
+mpfr_basic_polynomial<T>& mpfr_basic_polynomial<T>::operator+=(const mpfr_basic_polynomial& other) {
     if (this->m_data.size() < other.m_data.size()) {
         this->set_max_degree(other.get_max_degree());
     }
@@ -92,17 +118,20 @@ mpfr_polynomial& mpfr_polynomial::operator+=(const mpfr_polynomial& other) {
     return *this;
 }
 
-mpfr_polynomial& mpfr_polynomial::operator+=(const mpfr_class& other) {
+template <class T>
+mpfr_basic_polynomial<T>& mpfr_basic_polynomial<T>::operator+=(const T& other) {
     this->m_data[0] += other;
     return *this;
 }
 
-mpfr_polynomial mpfr_polynomial::operator+() const {
-    return mpfr_polynomial(*this);
+template <class T>
+mpfr_basic_polynomial<T> mpfr_basic_polynomial<T>::operator+() const {
+    return mpfr_basic_polynomial(*this);
 }
 
-mpfr_polynomial mpfr_polynomial::operator-(const mpfr_polynomial& other) const {
-    mpfr_polynomial tmp = *this;
+template <class T>
+mpfr_basic_polynomial<T> mpfr_basic_polynomial<T>::operator-(const mpfr_basic_polynomial& other) const {
+    mpfr_basic_polynomial tmp = *this;
     if (tmp.m_data.size() < other.m_data.size()) {
         tmp.set_max_degree(other.get_max_degree());
     }
@@ -112,13 +141,15 @@ mpfr_polynomial mpfr_polynomial::operator-(const mpfr_polynomial& other) const {
     return tmp;
 }
 
-mpfr_polynomial mpfr_polynomial::operator-(const mpfr_class& other) const {
-    mpfr_polynomial tmp = *this;
+template <class T>
+mpfr_basic_polynomial<T> mpfr_basic_polynomial<T>::operator-(const T& other) const {
+    mpfr_basic_polynomial tmp = *this;
     tmp.m_data[0] -= other;
     return tmp;
 }
 
-mpfr_polynomial& mpfr_polynomial::operator-=(const mpfr_polynomial& other) {
+template <class T>
+mpfr_basic_polynomial<T>& mpfr_basic_polynomial<T>::operator-=(const mpfr_basic_polynomial& other) {
     if (this->m_data.size() < other.m_data.size()) {
         this->set_max_degree(other.get_max_degree());
     }
@@ -128,23 +159,32 @@ mpfr_polynomial& mpfr_polynomial::operator-=(const mpfr_polynomial& other) {
     return *this;
 }
 
-mpfr_polynomial& mpfr_polynomial::operator-=(const mpfr_class& other) {
+template <class T>
+mpfr_basic_polynomial<T>& mpfr_basic_polynomial<T>::operator-=(const T& other) {
     this->m_data[0] -= other;
     return *this;
 }
 
-mpfr_polynomial mpfr_polynomial::operator-() const {
-    mpfr_polynomial tmp = *this;
+template <class T>
+mpfr_basic_polynomial<T> mpfr_basic_polynomial<T>::operator-() const& {
+    mpfr_basic_polynomial tmp = *this;
     for (size_t i = 0; i < tmp.m_data.size(); ++i) {
         tmp.m_data[i].set_neg();
     }
     return tmp;
 }
 
-mpfr_polynomial mpfr_polynomial::operator*(const mpfr_polynomial& other) const {
-    mpfr_class zero;
+template <class T>
+mpfr_basic_polynomial<T> mpfr_basic_polynomial<T>::operator-() && {
+    this->set_neg();
+    return std::move(*this);
+}
+
+template <class T>
+mpfr_basic_polynomial<T> mpfr_basic_polynomial<T>::operator*(const mpfr_basic_polynomial& other) const {
+    T zero;
     zero.set_zero(true);
-    mpfr_polynomial tmp(this->get_max_degree() + other.get_max_degree(), zero);
+    mpfr_basic_polynomial tmp(this->get_max_degree() + other.get_max_degree(), zero);
     for (size_t i = 0; i < this->get_max_degree() + 1; ++i) {
         for (size_t j = 0; j < other.get_max_degree() + 1; ++j) {
             tmp.m_data[i + j] += this->m_data[i] * other.m_data[j];
@@ -153,83 +193,84 @@ mpfr_polynomial mpfr_polynomial::operator*(const mpfr_polynomial& other) const {
     return tmp;
 }
 
-mpfr_polynomial mpfr_polynomial::operator*(const mpfr_class& other) const {
-    mpfr_polynomial tmp = *this;
+template <class T>
+mpfr_basic_polynomial<T> mpfr_basic_polynomial<T>::operator*(const T& other) const {
+    mpfr_basic_polynomial tmp = *this;
     for (size_t i = 0; i < tmp.m_data.size(); ++i) {
         tmp.m_data[i] *= other;
     }
     return tmp;
 }
 
-mpfr_polynomial& mpfr_polynomial::operator*=(const mpfr_polynomial& other) {
-    mpfr_class zero;
+template <class T>
+mpfr_basic_polynomial<T>& mpfr_basic_polynomial<T>::operator*=(const mpfr_basic_polynomial& other) {
+    T zero;
     zero.set_zero(true);
-    mpfr_polynomial tmp(this->get_max_degree() + other.get_max_degree(), zero);
+    mpfr_basic_polynomial tmp(this->get_max_degree() + other.get_max_degree(), zero);
     for (size_t i = 0; i < this->get_max_degree() + 1; ++i) {
         for (size_t j = 0; j < other.get_max_degree() + 1; ++j) {
             tmp.m_data[i + j] += this->m_data[i] * other.m_data[j];
         }
     }
-    this->operator=(tmp);
+    this->operator=(std::move(tmp));
     return *this;
 }
 
-mpfr_polynomial& mpfr_polynomial::operator*=(const mpfr_class& other) {
+template <class T>
+mpfr_basic_polynomial<T>& mpfr_basic_polynomial<T>::operator*=(const T& other) {
     for (size_t i = 0; i < this->m_data.size(); ++i) {
         this->m_data[i] *= other;
     }
     return *this;
 }
 
-mpfr_polynomial mpfr_polynomial::operator/(const mpfr_class& other) const {
-    mpfr_polynomial tmp = *this;
+template <class T>
+mpfr_basic_polynomial<T> mpfr_basic_polynomial<T>::operator/(const T& other) const {
+    mpfr_basic_polynomial tmp = *this;
     for (size_t i = 0; i < tmp.m_data.size(); ++i) {
         tmp.m_data[i] /= other;
     }
     return tmp;
 }
 
-mpfr_polynomial& mpfr_polynomial::operator/=(const mpfr_class& other) {
+template <class T>
+mpfr_basic_polynomial<T>& mpfr_basic_polynomial<T>::operator/=(const T& other) {
     for (size_t i = 0; i < this->m_data.size(); ++i) {
         this->m_data[i] /= other;
     }
     return *this;
 }
 
-mpfr_class& mpfr_polynomial::operator[](const size_t offset) {
+template <class T>
+T& mpfr_basic_polynomial<T>::operator[](const size_t offset) {
     return this->m_data[offset];
 }
 
-const mpfr_class& mpfr_polynomial::operator[](const size_t offset) const {
+template <class T>
+const T& mpfr_basic_polynomial<T>::operator[](const size_t offset) const {
     return this->m_data[offset];
 }
 
-std::ostream& operator<<(std::ostream& left, const mpfr_polynomial& right) {
-    for (size_t i = 0; i < right.m_data.size(); ++i) {
-        mpfr_class tmp_value = right.m_data[right.m_data.size() - i - 1];
-        left << tmp_value << "*x^" << right.m_data.size() - i - 1;
-    }
-    return left;
-}
-
 // horner -> synthetic division
-mpfr_class mpfr_polynomial::evaluate_at(const mpfr_class& point) const {
-    mpfr_class tmp = this->m_data[this->m_data.size() - 1];
+template <class T>
+T mpfr_basic_polynomial<T>::evaluate_at(const T& point) const {
+    T tmp = this->m_data[this->m_data.size() - 1];
     for (size_t i = 1; i < this->m_data.size(); ++i) {
         tmp = tmp * point + this->m_data[this->m_data.size() - i - 1];
     }
     return tmp;
 }
 
-mpfr_polynomial mpfr_polynomial::synthetic_division_without_remainder(const mpfr_class& point, const bool check_remainder) const {
+template <class T>
+mpfr_basic_polynomial<T> mpfr_basic_polynomial<T>::synthetic_division_without_remainder(const T& point, const bool check_remainder) const {
     if (check_remainder && this->evaluate_at(point) != 0) {
-        return mpfr_polynomial();
+        return mpfr_basic_polynomial();
     }
     size_t degree = this->get_degree();
     if (degree == 0) {
-        return mpfr_polynomial();
+        return mpfr_basic_polynomial();
     }
-    mpfr_polynomial tmp(degree - 1);
+    mpfr_basic_polynomial tmp(degree - 1);
     for (size_t i = 0; i < tmp.m_data.size(); ++i) {
         size_t offset = tmp.m_data.size() - i - 1;
         tmp.m_data[offset] = this->m_data[offset + 1];
@@ -240,21 +281,23 @@ mpfr_polynomial mpfr_polynomial::synthetic_division_without_remainder(const mpfr
     return tmp;
 }
 
-mpfr_polynomial mpfr_polynomial::derivative() const {
+template <class T>
+mpfr_basic_polynomial<T> mpfr_basic_polynomial<T>::derivative() const {
     size_t degree = this->get_degree();
     if (degree == 0) {
-        return mpfr_polynomial();
+        return mpfr_basic_polynomial();
     }
-    mpfr_polynomial tmp(degree - 1);
+    mpfr_basic_polynomial tmp(degree - 1);
     for (size_t i = 0; i < tmp.m_data.size(); ++i) {
         tmp.m_data[i] = (i + 1) * this->m_data[i + 1];
     }
     return tmp;
 }
 
-mpfr_polynomial mpfr_polynomial::antiderivative(const mpfr_class& constant) const {
+template <class T>
+mpfr_basic_polynomial<T> mpfr_basic_polynomial<T>::antiderivative(const T& constant) const {
     size_t degree = this->get_degree();
-    mpfr_polynomial tmp(degree + 1);
+    mpfr_basic_polynomial tmp(degree + 1);
     tmp.m_data[0] = constant;
     for (size_t i = 1; i < tmp.m_data.size(); ++i) {
         tmp.m_data[i] = this->m_data[i - 1] / i;
@@ -262,25 +305,29 @@ mpfr_polynomial mpfr_polynomial::antiderivative(const mpfr_class& constant) cons
     return tmp;
 }
 
-mpfr_class mpfr_polynomial::integral(const mpfr_class& left, const mpfr_class& right) const {
-    mpfr_polynomial antiderivative = this->antiderivative();
-    mpfr_class right_value = antiderivative.evaluate_at(right);
-    mpfr_class left_value = antiderivative.evaluate_at(left);
+template <class T>
+T mpfr_basic_polynomial<T>::integral(const T& left, const T& right) const {
+    mpfr_basic_polynomial antiderivative = this->antiderivative();
+    T right_value = antiderivative.evaluate_at(right);
+    T left_value = antiderivative.evaluate_at(left);
     return right_value - left_value;
 }
 
-void mpfr_polynomial::set_zero() {
+template <class T>
+void mpfr_basic_polynomial<T>::set_zero() {
     this->set_max_degree(0);
     this->m_data[0].set_zero(true);
 }
 
-void mpfr_polynomial::set_neg() {
+template <class T>
+void mpfr_basic_polynomial<T>::set_neg() {
     for (size_t i = 0; i < this->m_data.size(); ++i) {
         this->m_data[i].set_neg();
     }
 }
 
-size_t mpfr_polynomial::get_degree() const {
+template <class T>
+typename mpfr_basic_polynomial<T>::size_t mpfr_basic_polynomial<T>::get_degree() const {
     size_t degree = 0;
     for (size_t i = 0; i < this->m_data.size(); ++i) {
         if (this->m_data[i] != 0) {
@@ -290,15 +337,17 @@ size_t mpfr_polynomial::get_degree() const {
     return degree;
 }
 
-size_t mpfr_polynomial::get_max_degree() const {
+template <class T>
+typename mpfr_basic_polynomial<T>::size_t mpfr_basic_polynomial<T>::get_max_degree() const {
     return this->m_data.size() - 1;
 }
 
-void mpfr_polynomial::set_max_degree(const size_t degree) {
+template <class T>
+void mpfr_basic_polynomial<T>::set_max_degree(const size_t degree) {
     size_t new_size = degree + 1;
     if (this->m_data.size() < new_size) {
         size_t delta = new_size - this->m_data.size();
-        mpfr_class initial_value;
+        T initial_value;
         for (size_t i = 0; i < delta; ++i) {
             this->m_data.push_back(initial_value);
         }
@@ -306,3 +355,16 @@ void mpfr_polynomial::set_max_degree(const size_t degree) {
         this->m_data.erase(this->m_data.begin() + new_size, this->m_data.end());
     }
 }
+
+template class mpfr_basic_polynomial<mpfr_class>;
+template class mpfr_basic_polynomial<mpfr_fixed128>;
+template class mpfr_basic_polynomial<mpfr_fixed256>;
+template class mpfr_basic_polynomial<mpfr_fixed512>;
+template class mpfr_basic_polynomial<mpfr_fixed1024>;
+template class mpfr_basic_polynomial<dd_class>;
+template class mpfr_basic_polynomial<qd_class>;
+template class mpfr_basic_polynomial<double_class>;
+template class mpfr_basic_polynomial<ldouble_class>;
+#ifdef HAVE_FLOAT128
+template class mpfr_basic_polynomial<float128_class>;
+#endif
@@ -28,67 +28,110 @@
 #ifndef __MPFR_POLYNOMIAL_H__
 #define __MPFR_POLYNOMIAL_H__
 
+#include <iostream>
+#include <utility>
 #include <vector>
 
+#include "dd_class.h"
 #include "mpfr_class.h"
+#include "mpfr_fixed.h"
+#include "qd_class.h"
+#include "native_class.h"
 
-class mpfr_polynomial {
+template <class T>
+class mpfr_basic_polynomial {
 
 public:
 
-    typedef std::vector<mpfr_class>::size_type size_t;
+    typedef typename std::vector<T>::size_type size_t;
 
 private:
 
-    std::vector<mpfr_class> m_data;
+    std::vector<T> m_data;
 
 public:
 
-    mpfr_polynomial();
-    mpfr_polynomial(const mpfr_polynomial& other);
-    mpfr_polynomial(size_t max_degree);
-    mpfr_polynomial(size_t max_degree, const mpfr_class& initial_value);
-    ~mpfr_polynomial();
-
-    mpfr_polynomial& operator=(const mpfr_polynomial& other);
-    mpfr_polynomial& operator=(const mpfr_class& other);
-
-    mpfr_polynomial operator+(const mpfr_polynomial& other) const;
-    mpfr_polynomial operator+(const mpfr_class& other) const;
-
-    mpfr_polynomial& operator+=(const mpfr_polynomial& other);
-    mpfr_polynomial& operator+=(const mpfr_class& other);
-
-    mpfr_polynomial operator+() const;
-
-    mpfr_polynomial operator-(const mpfr_polynomial& other) const;
-    mpfr_polynomial operator-(const mpfr_class& other) const;
-
-    mpfr_polynomial& operator-=(const mpfr_polynomial& other);
-    mpfr_polynomial& operator-=(const mpfr_class& other);
-
-    mpfr_polynomial operator-() const;
-
-    mpfr_polynomial operator*(const mpfr_polynomial& other) const;
-    mpfr_polynomial operator*(const mpfr_class& other) const;
-
-    mpfr_polynomial& operator*=(const mpfr_polynomial& other);
-    mpfr_polynomial& operator*=(const mpfr_class& other);
-
-    mpfr_polynomial operator/(const mpfr_class& other) const;
-    mpfr_polynomial& operator/=(const mpfr_class& other);
-
-    mpfr_class& operator[](const size_t offset);
-    const mpfr_class& operator[](const size_t offset) const;
-
-    friend std::ostream& operator<<(std::ostream& left, const mpfr_polynomial& right);
-
-    mpfr_class evaluate_at(const mpfr_class& point) const;
-    mpfr_polynomial synthetic_division_without_remainder(const mpfr_class& point, const bool check_remainder = false) const;
-
-    mpfr_polynomial derivative() const;
-    mpfr_polynomial antiderivative(const mpfr_class& constant = 0) const;
-    mpfr_class integral(const mpfr_class& left, const mpfr_class& right) const;
+    mpfr_basic_polynomial();
+    mpfr_basic_polynomial(const mpfr_basic_polynomial& other);
+    mpfr_basic_polynomial(mpfr_basic_polynomial&& other) noexcept;
+    mpfr_basic_polynomial(size_t max_degree);
+    mpfr_basic_polynomial(size_t max_degree, const T& initial_value);
+    ~mpfr_basic_polynomial();
+
+    mpfr_basic_polynomial& operator=(const mpfr_basic_polynomial& other);
+    mpfr_basic_polynomial& operator=(mpfr_basic_polynomial&& other) noexcept;
+    mpfr_basic_polynomial& operator=(const T& other);
+
+    mpfr_basic_polynomial operator+(const mpfr_basic_polynomial& other) const;
+    mpfr_basic_polynomial operator+(const T& other) const;
+
+    friend mpfr_basic_polynomial operator+(mpfr_basic_polynomial&& left, const mpfr_basic_polynomial& right) {
+        left += right;
+        return std::move(left);
+    }
+    friend mpfr_basic_polynomial operator+(mpfr_basic_polynomial&& left, const T& right) {
+        left += right;
+        return std::move(left);
+    }
+
+    mpfr_basic_polynomial& operator+=(const mpfr_basic_polynomial& other);
+    mpfr_basic_polynomial& operator+=(const T& other);
+
+    mpfr_basic_polynomial operator+() const;
+
+    mpfr_basic_polynomial operator-(const mpfr_basic_polynomial& other) const;
+    mpfr_basic_polynomial operator-(const T& other) const;
+
+    friend mpfr_basic_polynomial operator-(mpfr_basic_polynomial&& left, const mpfr_basic_polynomial& right) {
+        left -= right;
+        return std::move(left);
+    }
+    friend mpfr_basic_polynomial operator-(mpfr_basic_polynomial&& left, const T& right) {
+        left -= right;
+        return std::move(left);
+    }
+
+    mpfr_basic_polynomial& operator-=(const mpfr_basic_polynomial& other);
+    mpfr_basic_polynomial& operator-=(const T& other);
+
+    mpfr_basic_polynomial operator-() const&;
+    mpfr_basic_polynomial operator-() &&;
+
+    mpfr_basic_polynomial operator*(const mpfr_basic_polynomial& other) const;
+    mpfr_basic_polynomial operator*(const T& other) const;
+
+    friend mpfr_basic_polynomial operator*(mpfr_basic_polynomial&& left, const T& right) {
+        left *= right;
+        return std::move(left);
+    }
+
+    mpfr_basic_polynomial& operator*=(const mpfr_basic_polynomial& other);
+    mpfr_basic_polynomial& operator*=(const T& other);
+
+    mpfr_basic_polynomial operator/(const T& other) const;
+    friend mpfr_basic_polynomial operator/(mpfr_basic_polynomial&& left, const T& right) {
+        left /= right;
+        return std::move(left);
+    }
+    mpfr_basic_polynomial& operator/=(const T& other);
+
+    T& operator[](const size_t offset);
+    const T& operator[](const size_t offset) const;
+
+    friend std::ostream& operator<<(std::ostream& left, const mpfr_basic_polynomial& right) {
+        for (size_t i = 0; i < right.m_data.size(); ++i) {
+            T tmp_value = right.m_data[right.m_data.size() - i - 1];
+            left << tmp_value << "*x^" << right.m_data.size() - i - 1;
+        }
+        return left;
+    }
+
+    T evaluate_at(const T& point) const;
+    mpfr_basic_polynomial synthetic_division_without_remainder(const T& point, const bool check_remainder = false) const;
+
+    mpfr_basic_polynomial derivative() const;
+    mpfr_basic_polynomial antiderivative(const T& constant = 0) const;
+    T integral(const T& left, const T& right) const;
 
     void set_zero();
     void set_neg();
@@ -97,6 +140,8 @@ public:
     size_t get_max_degree() const;
     void set_max_degree(const size_t degree);
 
-}; // class mpfr_polynomial
+}; // class mpfr_basic_polynomial
+
+typedef mpfr_basic_polynomial<mpfr_class> mpfr_polynomial;
 
 #endif // __MPFR_POLYNOMIAL_H__
@@ -0,0 +1,214 @@
+//
+//  mpfr_pool.cpp
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#include "mpfr_pool.h"
+
+#include <map>
+
+namespace {
+
+class mpfr_pool_back_store {
+
+private:
+
+    std::mutex m_mutex;
+    std::map<mpfr_prec_t, std::vector<__mpfr_struct>> m_slots;
+
+public:
+
+    ~mpfr_pool_back_store() {
+        this->clear();
+    }
+
+    size_t take(std::vector<__mpfr_struct>& slots, const mpfr_prec_t prec, const size_t count) {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        std::map<mpfr_prec_t, std::vector<__mpfr_struct>>::iterator it = this->m_slots.find(prec);
+        if (it == this->m_slots.end()) {
+            return 0;
+        }
+        size_t n = (count < it->second.size()) ? count : it->second.size();
+        slots.insert(slots.end(), it->second.end() - n, it->second.end());
+        it->second.resize(it->second.size() - n);
+        return n;
+    }
+
+    void give(std::vector<__mpfr_struct>& slots, const mpfr_prec_t prec, const size_t count) {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        std::vector<__mpfr_struct>& back = this->m_slots[prec];
+        for (size_t i = slots.size() - count; i < slots.size(); ++i) {
+            if (back.size() < mpfr_pool::back_capacity) {
+                back.push_back(slots[i]);
+            } else {
+                mpfr_clear(&slots[i]);
+            }
+        }
+        slots.resize(slots.size() - count);
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        for (std::map<mpfr_prec_t, std::vector<__mpfr_struct>>::iterator it = this->m_slots.begin(); it != this->m_slots.end(); ++it) {
+            for (size_t i = 0; i < it->second.size(); ++i) {
+                mpfr_clear(&it->second[i]);
+            }
+        }
+        this->m_slots.clear();
+    }
+
+};
+
+mpfr_pool_back_store& back_store() {
+    static mpfr_pool_back_store store;
+    return store;
+}
+
+} // namespace
+
+static thread_local mpfr_pool *tls_pool = NULL;
+static thread_local bool tls_pool_finished = false;
+
+namespace {
+
+struct mpfr_pool_cleanup {
+    ~mpfr_pool_cleanup() {
+        delete tls_pool;
+        tls_pool = NULL;
+        tls_pool_finished = true;
+    }
+};
+
+} // namespace
+
+// The back store is created first, so that it outlives every front cache.
+mpfr_pool::mpfr_pool() {
+    back_store();
+    this->m_last_bucket = 0;
+    this->reset_statistics();
+}
+
+// Slots of a finishing thread are handed over to the back store.
+mpfr_pool::~mpfr_pool() {
+    for (size_t i = 0; i < this->m_buckets.size(); ++i) {
+        back_store().give(this->m_buckets[i].slots, this->m_buckets[i].prec, this->m_buckets[i].slots.size());
+    }
+}
+
+void mpfr_pool::acquire(mpfr_ptr result, const mpfr_prec_t prec) {
+    bucket& current = this->find_bucket(prec);
+    if (current.slots.empty() && back_store().take(current.slots, prec, mpfr_pool::front_capacity / 2) == 0) {
+        ++this->m_statistics.n_misses;
+        mpfr_init2(result, prec);
+        return;
+    }
+    ++this->m_statistics.n_hits;
+    *result = current.slots.back();
+    current.slots.pop_back();
+    mpfr_set_nan(result);
+}
+
+void mpfr_pool::release(mpfr_ptr value) {
+    ++this->m_statistics.n_returns;
+    bucket& current = this->find_bucket(mpfr_get_prec(value));
+    current.slots.push_back(*value);
+    if (current.slots.size() > mpfr_pool::front_capacity) {
+        back_store().give(current.slots, current.prec, mpfr_pool::front_capacity / 2);
+    }
+}
+
+void mpfr_pool::flush() {
+    for (size_t i = 0; i < this->m_buckets.size(); ++i) {
+        for (size_t j = 0; j < this->m_buckets[i].slots.size(); ++j) {
+            mpfr_clear(&this->m_buckets[i].slots[j]);
+        }
+    }
+    this->m_buckets.clear();
+    this->m_last_bucket = 0;
+}
+
+const mpfr_pool_statistics& mpfr_pool::get_statistics() const {
+    return this->m_statistics;
+}
+
+void mpfr_pool::reset_statistics() {
+    this->m_statistics.n_hits = 0;
+    this->m_statistics.n_misses = 0;
+    this->m_statistics.n_returns = 0;
+}
+
+// A thread rarely works with more than a few precisions at once, so the
+// buckets are searched linearly, starting with the last one used.
+mpfr_pool::bucket& mpfr_pool::find_bucket(const mpfr_prec_t prec) {
+    if (this->m_last_bucket < this->m_buckets.size() && this->m_buckets[this->m_last_bucket].prec == prec) {
+        return this->m_buckets[this->m_last_bucket];
+    }
+    for (size_t i = 0; i < this->m_buckets.size(); ++i) {
+        if (this->m_buckets[i].prec == prec) {
+            this->m_last_bucket = i;
+            return this->m_buckets[i];
+        }
+    }
+    bucket tmp;
+    tmp.prec = prec;
+    this->m_buckets.push_back(tmp);
+    this->m_last_bucket = this->m_buckets.size() - 1;
+    return this->m_buckets.back();
+}
+
+mpfr_pool* mpfr_pool::local() {
+    if (tls_pool == NULL && !tls_pool_finished) {
+        static thread_local mpfr_pool_cleanup cleanup;
+        (void) cleanup;
+        tls_pool = new mpfr_pool();
+    }
+    return tls_pool;
+}
+
+void mpfr_pool::init(mpfr_ptr result, const mpfr_prec_t prec) {
+    mpfr_pool *pool = mpfr_pool::local();
+    if (pool == NULL) {
+        mpfr_init2(result, prec);
+        return;
+    }
+    pool->acquire(result, prec);
+}
+
+void mpfr_pool::clear(mpfr_ptr value) {
+    mpfr_pool *pool = mpfr_pool::local();
+    if (pool == NULL) {
+        mpfr_clear(value);
+        return;
+    }
+    pool->release(value);
+}
+
+void mpfr_pool::free_pool() {
+    mpfr_pool *pool = mpfr_pool::local();
+    if (pool != NULL) {
+        pool->flush();
+    }
+    back_store().clear();
+}
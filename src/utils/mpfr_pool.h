@@ -0,0 +1,93 @@
+//
+//  mpfr_pool.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __MPFR_POOL_H__
+#define __MPFR_POOL_H__
+
+#include <stddef.h>
+#include <mutex>
+#include <vector>
+#include <mpfr.h>
+
+// Free lists of initialized mpfr_t slots, one per precision. Every thread
+// keeps a bounded front cache and exchanges batches with a global back store,
+// so construction and destruction of mpfr_class rarely reach the allocator.
+
+typedef struct mpfr_pool_statistics {
+    size_t n_hits;
+    size_t n_misses;
+    size_t n_returns;
+} mpfr_pool_statistics;
+
+class mpfr_pool {
+
+private:
+
+    typedef struct bucket {
+        mpfr_prec_t prec;
+        std::vector<__mpfr_struct> slots;
+    } bucket;
+
+    std::vector<bucket> m_buckets;
+    size_t m_last_bucket;
+    mpfr_pool_statistics m_statistics;
+
+public:
+
+    mpfr_pool();
+    ~mpfr_pool();
+
+    mpfr_pool(const mpfr_pool& other) = delete;
+    mpfr_pool& operator=(const mpfr_pool& other) = delete;
+
+    void acquire(mpfr_ptr result, const mpfr_prec_t prec);
+    void release(mpfr_ptr value);
+    void flush();
+
+    const mpfr_pool_statistics& get_statistics() const;
+    void reset_statistics();
+
+private:
+
+    bucket& find_bucket(const mpfr_prec_t prec);
+
+public:
+
+    static const size_t front_capacity = 1024;
+    static const size_t back_capacity = 1 << 16;
+
+    static mpfr_pool* local();
+
+    static void init(mpfr_ptr result, const mpfr_prec_t prec);
+    static void clear(mpfr_ptr value);
+
+    // Releases the slots of the calling thread and of the back store.
+    static void free_pool();
+
+}; // class mpfr_pool
+
+#endif // __MPFR_POOL_H__
@@ -0,0 +1,54 @@
+//
+//  mpfr_scalar_traits.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __MPFR_SCALAR_TRAITS_H__
+#define __MPFR_SCALAR_TRAITS_H__
+
+#include <stdint.h>
+#include <mpfr.h>
+
+// Properties of the number types the containers and solvers are instantiated
+// on. Types with a precision fixed at compile time specialize this template;
+// is_mpfr marks types whose values can be handed to MPFR through get_raw().
+
+class mpfr_class;
+
+template <class T>
+struct mpfr_scalar_traits {
+    static const bool is_fixed_prec = false;
+    static const mpfr_prec_t fixed_prec = 0;
+    static const bool is_mpfr = false;
+};
+
+template <>
+struct mpfr_scalar_traits<mpfr_class> {
+    static const bool is_fixed_prec = false;
+    static const mpfr_prec_t fixed_prec = 0;
+    static const bool is_mpfr = true;
+};
+
+#endif // __MPFR_SCALAR_TRAITS_H__
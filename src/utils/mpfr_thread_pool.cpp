@@ -0,0 +1,182 @@
+//
+//  mpfr_thread_pool.cpp
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#include "mpfr_thread_pool.h"
+#include "mpfr_context.h"
+
+static thread_local mpfr_execution_policy tls_execution_policy = mpfr_execution_parallel;
+static thread_local bool tls_pool_worker = false;
+
+struct mpfr_thread_pool_range {
+
+    const std::function<void(size_t, size_t)>& kernel;
+    size_t size;
+    size_t n_chunks;
+
+    void operator()(const size_t i) const {
+        this->kernel((i * this->size) / this->n_chunks, ((i + 1) * this->size) / this->n_chunks);
+    }
+
+}; // struct mpfr_thread_pool_range
+
+mpfr_thread_pool::mpfr_thread_pool(const size_t n_workers) :
+    m_task(NULL),
+    m_n_tasks(0),
+    m_next_task(0),
+    m_n_pending(0),
+    m_generation(0),
+    m_stop(false),
+    m_prec(mpfr_class::get_default_prec()),
+    m_rnd(mpfr_class::get_default_rnd()),
+    m_mode(mpfr_class::get_precision_mode()) {
+    this->m_workers.reserve(n_workers);
+    for (size_t i = 0; i < n_workers; ++i) {
+        this->m_workers.push_back(std::thread(&mpfr_thread_pool::work, this));
+    }
+}
+
+mpfr_thread_pool::~mpfr_thread_pool() {
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_stop = true;
+    }
+    this->m_work_ready.notify_all();
+    for (size_t i = 0; i < this->m_workers.size(); ++i) {
+        this->m_workers[i].join();
+    }
+}
+
+// Runs task(0), ..., task(n_tasks - 1). Tasks are handed out one at a time,
+// so they should be of similar cost.
+void mpfr_thread_pool::run(const std::function<void(size_t)>& task, const size_t n_tasks) {
+    bool serial = (n_tasks < 2 || this->m_workers.empty() || tls_pool_worker ||
+                   tls_execution_policy == mpfr_execution_sequential);
+    if (serial || !this->m_run_mutex.try_lock()) {
+        for (size_t i = 0; i < n_tasks; ++i) {
+            task(i);
+        }
+        return;
+    }
+    std::lock_guard<std::mutex> run_lock(this->m_run_mutex, std::adopt_lock);
+    std::unique_lock<std::mutex> lock(this->m_mutex);
+    this->m_task = &task;
+    this->m_n_tasks = n_tasks;
+    this->m_next_task = 0;
+    this->m_n_pending = n_tasks;
+    this->m_prec = mpfr_class::get_default_prec();
+    this->m_rnd = mpfr_class::get_default_rnd();
+    this->m_mode = mpfr_class::get_precision_mode();
+    ++this->m_generation;
+    this->m_work_ready.notify_all();
+    tls_pool_worker = true;
+    this->run_tasks(lock);
+    tls_pool_worker = false;
+    while (this->m_n_pending > 0) {
+        this->m_work_done.wait(lock);
+    }
+    this->m_task = NULL;
+}
+
+// Splits [0, size) into n_chunks(size, cost, grain) contiguous ranges and
+// runs kernel(begin, end) on each of them. The split does not depend on the
+// number of threads.
+void mpfr_thread_pool::parallel_for(const std::function<void(size_t, size_t)>& kernel, const size_t size, const size_t cost, const size_t grain) {
+    size_t n_chunks = mpfr_thread_pool::n_chunks(size, cost, grain);
+    if (n_chunks < 2) {
+        kernel(0, size);
+        return;
+    }
+    mpfr_thread_pool_range range = {kernel, size, n_chunks};
+    this->run(range, n_chunks);
+}
+
+size_t mpfr_thread_pool::n_threads() const {
+    return this->m_workers.size() + 1;
+}
+
+void mpfr_thread_pool::work() {
+    tls_pool_worker = true;
+    size_t generation = 0;
+    std::unique_lock<std::mutex> lock(this->m_mutex);
+    for (;;) {
+        while (!this->m_stop && this->m_generation == generation) {
+            this->m_work_ready.wait(lock);
+        }
+        if (this->m_stop) {
+            return;
+        }
+        generation = this->m_generation;
+        mpfr_context context(this->m_prec, this->m_rnd);
+        mpfr_precision_mode_context mode_context(this->m_mode);
+        this->run_tasks(lock);
+    }
+}
+
+void mpfr_thread_pool::run_tasks(std::unique_lock<std::mutex>& lock) {
+    while (this->m_next_task < this->m_n_tasks) {
+        size_t i = this->m_next_task++;
+        lock.unlock();
+        (*this->m_task)(i);
+        lock.lock();
+        if (--this->m_n_pending == 0) {
+            this->m_work_done.notify_all();
+        }
+    }
+}
+
+// One worker per additional hardware thread, created on first use. The pool
+// is never destroyed, so its idle workers cannot race the destruction of
+// other statics at exit.
+mpfr_thread_pool& mpfr_thread_pool::global() {
+    static mpfr_thread_pool *pool = new mpfr_thread_pool(
+        (std::thread::hardware_concurrency() > 1) ? std::thread::hardware_concurrency() - 1 : 0);
+    return *pool;
+}
+
+// Number of ranges of at least grain units of work that [0, size) is split
+// into, if every element costs cost units.
+size_t mpfr_thread_pool::n_chunks(const size_t size, const size_t cost, const size_t grain) {
+    size_t n_chunks = (size * cost) / grain;
+    return (n_chunks < size) ? n_chunks : size;
+}
+
+mpfr_execution_policy mpfr_thread_pool::get_policy() {
+    return tls_execution_policy;
+}
+
+void mpfr_thread_pool::set_policy(const mpfr_execution_policy policy) {
+    tls_execution_policy = policy;
+}
+
+mpfr_execution_policy_context::mpfr_execution_policy_context(const mpfr_execution_policy policy) {
+    this->m_previous_policy = mpfr_thread_pool::get_policy();
+    mpfr_thread_pool::set_policy(policy);
+}
+
+mpfr_execution_policy_context::~mpfr_execution_policy_context() {
+    mpfr_thread_pool::set_policy(this->m_previous_policy);
+}
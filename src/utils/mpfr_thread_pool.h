@@ -0,0 +1,120 @@
+//
+//  mpfr_thread_pool.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __MPFR_THREAD_POOL_H__
+#define __MPFR_THREAD_POOL_H__
+
+#include <stddef.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <mpfr.h>
+
+#include "mpfr_class.h"
+
+typedef enum mpfr_execution_policy {
+    mpfr_execution_sequential = 0,
+    mpfr_execution_parallel = 1
+} mpfr_execution_policy;
+
+// Fixed set of worker threads that run the tasks of a parallel loop. The
+// calling thread takes part in the loop and returns once every task is done.
+// Tasks run with the default precision, rounding mode and precision mode of
+// the caller. A loop runs serially on the calling thread if the policy of
+// that thread is sequential or if it is issued from inside another loop.
+
+class mpfr_thread_pool {
+
+private:
+
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_run_mutex;
+    std::mutex m_mutex;
+    std::condition_variable m_work_ready;
+    std::condition_variable m_work_done;
+
+    const std::function<void(size_t)> *m_task;
+    size_t m_n_tasks;
+    size_t m_next_task;
+    size_t m_n_pending;
+    size_t m_generation;
+    bool m_stop;
+
+    mpfr_prec_t m_prec;
+    mpfr_rnd_t m_rnd;
+    mpfr_precision_mode m_mode;
+
+public:
+
+    explicit mpfr_thread_pool(const size_t n_workers);
+    ~mpfr_thread_pool();
+
+    mpfr_thread_pool(const mpfr_thread_pool& other) = delete;
+    mpfr_thread_pool& operator=(const mpfr_thread_pool& other) = delete;
+
+    void run(const std::function<void(size_t)>& task, const size_t n_tasks);
+    void parallel_for(const std::function<void(size_t, size_t)>& kernel, const size_t size, const size_t cost, const size_t grain);
+
+    size_t n_threads() const;
+
+private:
+
+    void work();
+    void run_tasks(std::unique_lock<std::mutex>& lock);
+
+public:
+
+    static mpfr_thread_pool& global();
+    static size_t n_chunks(const size_t size, const size_t cost, const size_t grain);
+
+    static mpfr_execution_policy get_policy();
+    static void set_policy(const mpfr_execution_policy policy);
+
+}; // class mpfr_thread_pool
+
+// Sets the execution policy of the calling thread for its lifetime.
+
+class mpfr_execution_policy_context {
+
+private:
+
+    mpfr_execution_policy m_previous_policy;
+
+public:
+
+    explicit mpfr_execution_policy_context(const mpfr_execution_policy policy);
+    ~mpfr_execution_policy_context();
+
+    mpfr_execution_policy_context(const mpfr_execution_policy_context& other) = delete;
+    mpfr_execution_policy_context& operator=(const mpfr_execution_policy_context& other) = delete;
+
+}; // class mpfr_execution_policy_context
+
+#endif // __MPFR_THREAD_POOL_H__
@@ -26,191 +26,424 @@
 //
 
 #include "mpfr_vector.h"
+#include "mpfr_thread_pool.h"
 
 #include <iostream>
+#include <utility>
 
-mpfr_vector::mpfr_vector() {
+// Precision changes of separately stored elements.
+template <class T>
+struct mpfr_vector_set_prec_kernel {
+
+    std::vector<T>& data;
+    mpfr_prec_t prec;
+
+    void operator()(const size_t begin, const size_t end) const {
+        for (size_t i = begin; i < end; ++i) {
+            this->data[i].set_prec(this->prec);
+        }
+    }
+
+}; // struct mpfr_vector_set_prec_kernel
+
+template <class T>
+struct mpfr_vector_round_prec_kernel {
+
+    std::vector<T>& data;
+    mpfr_prec_t prec;
+
+    void operator()(const size_t begin, const size_t end) const {
+        for (size_t i = begin; i < end; ++i) {
+            this->data[i].round_prec(this->prec);
+        }
+    }
+
+}; // struct mpfr_vector_round_prec_kernel
+
+// Contiguous storage hands the elements limbs out of one buffer owned by the
+// vector. Only mpfr_class supports it; the fixed-precision and native types
+// keep their digits inside the object anyway.
+template <class T>
+struct mpfr_vector_storage {
+
+    static const bool is_supported = false;
+
+    static void share(T& value, mp_limb_t *limbs, const mpfr_prec_t prec) {
+    }
+
+    static void unshare(T& value) {
+    }
+
+}; // struct mpfr_vector_storage
+
+template <>
+struct mpfr_vector_storage<mpfr_class> {
+
+    static const bool is_supported = true;
+
+    static void share(mpfr_class& value, mp_limb_t *limbs, const mpfr_prec_t prec) {
+        value.share_limbs(limbs, prec);
+    }
+
+    static void unshare(mpfr_class& value) {
+        value.unshare_limbs();
+    }
+
+}; // struct mpfr_vector_storage
+
+static size_t mpfr_vector_stride(const mpfr_prec_t prec) {
+    return (mpfr_custom_get_size(prec) + sizeof(mp_limb_t) - 1) / sizeof(mp_limb_t);
+}
+
+template <class T>
+mpfr_basic_vector<T>::mpfr_basic_vector() :
+    m_contiguous_prec(0) {
 }
 
-mpfr_vector::mpfr_vector(const mpfr_vector& other) {
+template <class T>
+mpfr_basic_vector<T>::mpfr_basic_vector(const mpfr_basic_vector& other) :
+    m_contiguous_prec(0) {
     this->m_data = other.m_data;
+    if (other.m_contiguous_prec != 0) {
+        this->share_all(other.m_contiguous_prec, this->m_data.capacity());
+    }
+}
+
+template <class T>
+mpfr_basic_vector<T>::mpfr_basic_vector(mpfr_basic_vector&& other) noexcept :
+    m_data(std::move(other.m_data)),
+    m_limbs(std::move(other.m_limbs)),
+    m_contiguous_prec(other.m_contiguous_prec) {
+    other.m_contiguous_prec = 0;
 }
 
-mpfr_vector::mpfr_vector(size_t size) {
-    mpfr_class initial_value;
+template <class T>
+mpfr_basic_vector<T>::mpfr_basic_vector(size_t size) :
+    m_contiguous_prec(0) {
+    T initial_value;
+    this->m_data.reserve(size);
     for (size_t i = 0; i < size; ++i) {
         this->m_data.push_back(initial_value);
     }
 }
 
-mpfr_vector::mpfr_vector(size_t size, const mpfr_class& initial_value) {
+template <class T>
+mpfr_basic_vector<T>::mpfr_basic_vector(size_t size, const T& initial_value) :
+    m_contiguous_prec(0) {
+    this->m_data.reserve(size);
     for (size_t i = 0; i < size; ++i) {
         this->m_data.push_back(initial_value);
     }
 }
 
-mpfr_vector::~mpfr_vector() {
+template <class T>
+mpfr_basic_vector<T>::mpfr_basic_vector(const mpfr_basic_vector_const_view<T>& other) :
+    m_contiguous_prec(0) {
+    this->m_data.reserve(other.size());
+    for (size_t i = 0; i < other.size(); ++i) {
+        this->m_data.push_back(other[i]);
+    }
+}
+
+template <class T>
+mpfr_basic_vector<T>::~mpfr_basic_vector() {
 }
 
-mpfr_vector& mpfr_vector::operator=(const mpfr_vector& other) {
+template <class T>
+mpfr_basic_vector<T>& mpfr_basic_vector<T>::operator=(const mpfr_basic_vector& other) {
     if (&other != this) {
-        this->m_data = other.m_data;
+        if (this->m_contiguous_prec == 0 && other.m_contiguous_prec == 0) {
+            this->m_data = other.m_data;
+        } else {
+            mpfr_basic_vector tmp(other);
+            this->operator=(std::move(tmp));
+        }
     }
     return *this;
 }
 
-mpfr_vector mpfr_vector::operator+(const mpfr_vector& other) const {
-    mpfr_vector tmp = *this;
-    if (tmp.m_data.size() == other.m_data.size()) {
-        for (size_t i = 0; i < other.m_data.size(); ++i) {
-            tmp.m_data[i] += other.m_data[i];
-        }
-    } else {
-        tmp.set_nan();
+template <class T>
+mpfr_basic_vector<T>& mpfr_basic_vector<T>::operator=(mpfr_basic_vector&& other) noexcept {
+    if (&other != this) {
+        this->m_data.swap(other.m_data);
+        this->m_limbs.swap(other.m_limbs);
+        std::swap(this->m_contiguous_prec, other.m_contiguous_prec);
     }
+    return *this;
+}
+
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_vector<T>::operator+(const mpfr_basic_vector& other) const {
+    mpfr_basic_vector tmp = *this;
+    tmp.view() += other;
     return tmp;
 }
 
-mpfr_vector& mpfr_vector::operator+=(const mpfr_vector& other) {
-    if (this->m_data.size() == other.m_data.size()) {
-        for (size_t i = 0; i < other.m_data.size(); ++i) {
-            this->m_data[i] += other.m_data[i];
-        }
-    } else {
-        this->set_nan();
-    }
+template <class T>
+mpfr_basic_vector<T>& mpfr_basic_vector<T>::operator+=(const mpfr_basic_vector& other) {
+    this->view() += other;
     return *this;
 }
 
-mpfr_vector mpfr_vector::operator+() const {
-    return mpfr_vector(*this);
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_vector<T>::operator+() const {
+    return mpfr_basic_vector(*this);
 }
 
-mpfr_vector mpfr_vector::operator-(const mpfr_vector& other) const {
-    mpfr_vector tmp = *this;
-    if (tmp.m_data.size() == other.m_data.size()) {
-        for (size_t i = 0; i < other.m_data.size(); ++i) {
-            tmp.m_data[i] -= other.m_data[i];
-        }
-    } else {
-        tmp.set_nan();
-    }
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_vector<T>::operator-(const mpfr_basic_vector& other) const {
+    mpfr_basic_vector tmp = *this;
+    tmp.view() -= other;
     return tmp;
 }
 
-mpfr_vector& mpfr_vector::operator-=(const mpfr_vector& other) {
-    if (this->m_data.size() == other.m_data.size()) {
-        for (size_t i = 0; i < other.m_data.size(); ++i) {
-            this->m_data[i] -= other.m_data[i];
-        }
-    } else {
-        this->set_nan();
-    }
+template <class T>
+mpfr_basic_vector<T>& mpfr_basic_vector<T>::operator-=(const mpfr_basic_vector& other) {
+    this->view() -= other;
     return *this;
 }
 
-mpfr_vector mpfr_vector::operator-() const {
-    mpfr_vector tmp = *this;
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_vector<T>::operator-() const& {
+    mpfr_basic_vector tmp = *this;
     for (size_t i = 0; i < tmp.m_data.size(); ++i) {
         tmp.m_data[i].set_neg();
     }
     return tmp;
 }
 
-mpfr_class mpfr_vector::operator*(const mpfr_vector& other) const {
-    mpfr_class tmp = 0;
-    if (this->m_data.size() == other.m_data.size()) {
-        for (size_t i = 0; i < this->m_data.size(); ++i) {
-            tmp += this->m_data[i] * other.m_data[i];
-        }
-    }
-    return tmp;
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_vector<T>::operator-() && {
+    this->set_neg();
+    return std::move(*this);
 }
 
-mpfr_vector mpfr_vector::operator*(const mpfr_class& other) const {
-    mpfr_vector tmp = *this;
-    for (size_t i = 0; i < tmp.m_data.size(); ++i) {
-        tmp.m_data[i] *= other;
-    }
+template <class T>
+T mpfr_basic_vector<T>::operator*(const mpfr_basic_vector& other) const {
+    return this->dot(other);
+}
+
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_vector<T>::operator*(const T& other) const {
+    mpfr_basic_vector tmp = *this;
+    tmp.view() *= other;
     return tmp;
 }
 
-mpfr_vector& mpfr_vector::operator*=(const mpfr_class& other) {
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        this->m_data[i] *= other;
-    }
+template <class T>
+mpfr_basic_vector<T>& mpfr_basic_vector<T>::operator*=(const T& other) {
+    this->view() *= other;
     return *this;
 }
 
-mpfr_vector mpfr_vector::operator/(const mpfr_class& other) const {
-    mpfr_vector tmp = *this;
-    for (size_t i = 0; i < tmp.m_data.size(); ++i) {
-        tmp.m_data[i] /= other;
-    }
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_vector<T>::operator/(const T& other) const {
+    mpfr_basic_vector tmp = *this;
+    tmp.view() /= other;
     return tmp;
 }
 
-mpfr_vector& mpfr_vector::operator/=(const mpfr_class& other) {
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        this->m_data[i] /= other;
-    }
+template <class T>
+mpfr_basic_vector<T>& mpfr_basic_vector<T>::operator/=(const T& other) {
+    this->view() /= other;
     return *this;
 }
 
-mpfr_class& mpfr_vector::operator[](const size_t offset) {
+template <class T>
+T& mpfr_basic_vector<T>::operator[](const size_t offset) {
     return this->m_data[offset];
 }
 
-const mpfr_class& mpfr_vector::operator[](const size_t offset) const {
+template <class T>
+const T& mpfr_basic_vector<T>::operator[](const size_t offset) const {
     return this->m_data[offset];
 }
 
-std::ostream& operator<<(std::ostream& left, const mpfr_vector& right) {
-    left << '{';
-    for (size_t i = 0; i < right.m_data.size(); ++i) {
-        if (i > 0) {
-            left << ',';
-        }
-        left << right.m_data[i];
+template <class T>
+mpfr_basic_vector_view<T> mpfr_basic_vector<T>::view() {
+    return mpfr_basic_vector_view<T>(*this);
+}
+
+template <class T>
+mpfr_basic_vector_const_view<T> mpfr_basic_vector<T>::view() const {
+    return mpfr_basic_vector_const_view<T>(*this);
+}
+
+template <class T>
+mpfr_basic_vector_view<T> mpfr_basic_vector<T>::slice(const size_t offset, const size_t size) {
+    return this->view().slice(offset, size);
+}
+
+template <class T>
+mpfr_basic_vector_const_view<T> mpfr_basic_vector<T>::slice(const size_t offset, const size_t size) const {
+    return this->view().slice(offset, size);
+}
+
+template <class T>
+T mpfr_basic_vector<T>::dot(const mpfr_basic_vector& other) const {
+    return this->view().dot(other);
+}
+
+template <class T>
+T mpfr_basic_vector<T>::sum() const {
+    return this->view().sum();
+}
+
+template <class T>
+T mpfr_basic_vector<T>::euclidean_norm() const {
+    return this->view().euclidean_norm();
+}
+
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_vector<T>::log_all() const {
+    mpfr_basic_vector tmp(this->size());
+    this->log_all(tmp);
+    return tmp;
+}
+
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_vector<T>::exp_all() const {
+    mpfr_basic_vector tmp(this->size());
+    this->exp_all(tmp);
+    return tmp;
+}
+
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_vector<T>::pow_all(const T& exponent) const {
+    mpfr_basic_vector tmp(this->size());
+    this->pow_all(exponent, tmp);
+    return tmp;
+}
+
+// The batched evaluations write into the entries of result in their own
+// precision, so result may be this vector. It is only reallocated if its
+// size does not match.
+template <class T>
+void mpfr_basic_vector<T>::log_all(mpfr_basic_vector& result) const {
+    if (result.size() != this->size()) {
+        result = mpfr_basic_vector(this->size());
     }
-    left << '}';
-    return left;
+    this->view().log_all(result);
 }
 
-mpfr_class mpfr_vector::euclidean_norm() const {
-    mpfr_class norm = 0;
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        norm += this->m_data[i] * this->m_data[i];
+template <class T>
+void mpfr_basic_vector<T>::exp_all(mpfr_basic_vector& result) const {
+    if (result.size() != this->size()) {
+        result = mpfr_basic_vector(this->size());
+    }
+    this->view().exp_all(result);
+}
+
+template <class T>
+void mpfr_basic_vector<T>::pow_all(const T& exponent, mpfr_basic_vector& result) const {
+    if (result.size() != this->size()) {
+        result = mpfr_basic_vector(this->size());
     }
-    return norm.sqrt_value();
+    this->view().pow_all(exponent, result);
 }
 
-void mpfr_vector::append(const mpfr_class& other) {
+template <class T>
+void mpfr_basic_vector<T>::append(const T& other) {
+    if (this->m_contiguous_prec != 0) {
+        T tmp(other);
+        this->append(std::move(tmp));
+        return;
+    }
     this->m_data.push_back(other);
 }
 
-void mpfr_vector::append(const mpfr_vector& other) {
+template <class T>
+void mpfr_basic_vector<T>::append(T&& other) {
+    this->reserve_contiguous(this->m_data.size() + 1);
+    this->m_data.push_back(std::move(other));
+    if (this->m_contiguous_prec != 0) {
+        size_t stride = mpfr_vector_stride(this->m_contiguous_prec);
+        mpfr_vector_storage<T>::share(this->m_data.back(), this->m_limbs.data() + (this->m_data.size() - 1) * stride, this->m_contiguous_prec);
+    }
+}
+
+template <class T>
+void mpfr_basic_vector<T>::append(const mpfr_basic_vector& other) {
+    if (&other == this) {
+        mpfr_basic_vector tmp(other);
+        this->append(std::move(tmp));
+        return;
+    }
+    this->reserve_contiguous(this->m_data.size() + other.m_data.size());
+    this->m_data.reserve(this->m_data.size() + other.m_data.size());
     for (size_t i = 0; i < other.m_data.size(); ++i) {
         this->m_data.push_back(other.m_data[i]);
     }
+    this->share_all(this->m_contiguous_prec, this->m_data.capacity());
 }
 
-void mpfr_vector::set_prec(mpfr_prec_t prec) {
-    for (size_t i = 0; i < this->m_data.size(); ++i) {
-        this->m_data[i].set_prec(prec);
+template <class T>
+void mpfr_basic_vector<T>::append(mpfr_basic_vector&& other) {
+    this->reserve_contiguous(this->m_data.size() + other.m_data.size());
+    this->m_data.reserve(this->m_data.size() + other.m_data.size());
+    for (size_t i = 0; i < other.m_data.size(); ++i) {
+        this->m_data.push_back(std::move(other.m_data[i]));
     }
+    other.m_data.clear();
+    this->share_all(this->m_contiguous_prec, this->m_data.capacity());
 }
 
-bool mpfr_vector::contains_nan() const {
+template <class T>
+void mpfr_basic_vector<T>::set_prec(mpfr_prec_t prec) {
+    if (this->m_contiguous_prec != 0) {
+        this->share_all(prec, this->m_data.capacity());
+        this->set_nan();
+        return;
+    }
+    mpfr_vector_set_prec_kernel<T> kernel = {this->m_data, prec};
+    mpfr_thread_pool::global().parallel_for(kernel, this->m_data.size(), prec, arithmetic_grain);
+}
+
+template <class T>
+void mpfr_basic_vector<T>::round_prec(mpfr_prec_t prec) {
+    if (this->m_contiguous_prec != 0) {
+        this->share_all(prec, this->m_data.capacity());
+        return;
+    }
+    mpfr_vector_round_prec_kernel<T> kernel = {this->m_data, prec};
+    mpfr_thread_pool::global().parallel_for(kernel, this->m_data.size(), prec, arithmetic_grain);
+}
+
+// All elements take their limbs from one buffer owned by the vector, at a
+// precision fixed for the whole vector. Values are rounded into it.
+template <class T>
+void mpfr_basic_vector<T>::set_contiguous_storage(const mpfr_prec_t prec) {
+    if (!mpfr_vector_storage<T>::is_supported) {
+        printf("mpfr_vector[%s:%d]: Contiguous storage is only available for mpfr_class.\n", __FILE__, __LINE__);
+        abort();
+    }
+    this->share_all(prec, this->m_data.capacity());
+}
+
+template <class T>
+void mpfr_basic_vector<T>::set_separate_storage() {
+    if (this->m_contiguous_prec == 0) {
+        return;
+    }
     for (size_t i = 0; i < this->m_data.size(); ++i) {
-        if (this->m_data[i].is_nan()) {
-            return true;
-        }
+        mpfr_vector_storage<T>::unshare(this->m_data[i]);
     }
-    return false;
+    std::vector<mp_limb_t>().swap(this->m_limbs);
+    this->m_contiguous_prec = 0;
+}
+
+template <class T>
+bool mpfr_basic_vector<T>::has_contiguous_storage() const {
+    return this->m_contiguous_prec != 0;
 }
 
-bool mpfr_vector::contains_inf() const {
+template <class T>
+bool mpfr_basic_vector<T>::contains_nan() const {
+    return this->view().contains_nan();
+}
+
+template <class T>
+bool mpfr_basic_vector<T>::contains_inf() const {
     for (size_t i = 0; i < this->m_data.size(); ++i) {
         if (this->m_data[i].is_inf()) {
             return true;
@@ -219,7 +452,8 @@ bool mpfr_vector::contains_inf() const {
     return false;
 }
 
-bool mpfr_vector::is_zero() const {
+template <class T>
+bool mpfr_basic_vector<T>::is_zero() const {
     for (size_t i = 0; i < this->m_data.size(); ++i) {
         if (!this->m_data[i].is_zero()) {
             return false;
@@ -228,40 +462,104 @@ bool mpfr_vector::is_zero() const {
     return true;
 }
 
-void mpfr_vector::set_nan() {
+template <class T>
+void mpfr_basic_vector<T>::set_nan() {
     for (size_t i = 0; i < this->m_data.size(); ++i) {
         this->m_data[i].set_nan();
     }
 }
 
-void mpfr_vector::set_inf(int sign) {
+template <class T>
+void mpfr_basic_vector<T>::set_inf(int sign) {
     for (size_t i = 0; i < this->m_data.size(); ++i) {
         this->m_data[i].set_inf(sign);
     }
 }
 
-void mpfr_vector::set_zero(int sign) {
+template <class T>
+void mpfr_basic_vector<T>::set_zero(int sign) {
     for (size_t i = 0; i < this->m_data.size(); ++i) {
         this->m_data[i].set_zero(sign);
     }
 }
 
-void mpfr_vector::set_neg() {
+template <class T>
+void mpfr_basic_vector<T>::set_neg() {
     for (size_t i = 0; i < this->m_data.size(); ++i) {
         this->m_data[i].set_neg();
     }
 }
 
-size_t mpfr_vector::size() const {
+template <class T>
+typename mpfr_basic_vector<T>::size_t mpfr_basic_vector<T>::size() const {
     return this->m_data.size();
 }
 
-mpfr_vector mpfr_vector::zero_vector(const size_t size) {
-    return mpfr_vector(size, 0);
+// Moves all elements into a new buffer with room for capacity elements. The
+// old buffer is released only after every value has been copied out of it.
+template <class T>
+void mpfr_basic_vector<T>::share_all(const mpfr_prec_t prec, const size_t capacity) {
+    if (prec == 0) {
+        return;
+    }
+    size_t stride = mpfr_vector_stride(prec);
+    std::vector<mp_limb_t> limbs(capacity * stride);
+    for (size_t i = 0; i < this->m_data.size(); ++i) {
+        mpfr_vector_storage<T>::share(this->m_data[i], limbs.data() + i * stride, prec);
+    }
+    this->m_limbs.swap(limbs);
+    this->m_contiguous_prec = prec;
 }
 
-mpfr_vector mpfr_vector::eye_vector(const size_t size, const size_t index) {
-    mpfr_vector tmp(size, 0);
+// Growing the element array moves the elements, which copies them out of the
+// buffer, so both grow together and the elements are shared again afterwards.
+template <class T>
+void mpfr_basic_vector<T>::reserve_contiguous(const size_t size) {
+    if (this->m_contiguous_prec == 0 || size <= this->m_data.capacity()) {
+        return;
+    }
+    size_t capacity = 2 * this->m_data.capacity();
+    if (capacity < size) {
+        capacity = size;
+    }
+    this->m_data.reserve(capacity);
+    this->share_all(this->m_contiguous_prec, this->m_data.capacity());
+}
+
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_vector<T>::zero_vector(const size_t size) {
+    return mpfr_basic_vector(size, 0);
+}
+
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_vector<T>::eye_vector(const size_t size, const size_t index) {
+    mpfr_basic_vector tmp(size, 0);
     tmp[index] = 1;
     return tmp;
 }
+
+template <class T>
+mpfr_basic_vector<T> mpfr_basic_vector<T>::contiguous_vector(const size_t size, const mpfr_prec_t prec) {
+    mpfr_basic_vector tmp(size, 0);
+    tmp.set_contiguous_storage(prec);
+    return tmp;
+}
+
+template <class T>
+bool mpfr_basic_vector<T>::supports_contiguous_storage() {
+    return mpfr_vector_storage<T>::is_supported;
+}
+
+template class mpfr_basic_vector<mpfr_class>;
+template class mpfr_basic_vector<mpfr_ball>;
+template class mpfr_basic_vector<mpfr_fixed128>;
+template class mpfr_basic_vector<mpfr_fixed256>;
+template class mpfr_basic_vector<mpfr_fixed512>;
+template class mpfr_basic_vector<mpfr_fixed1024>;
+template class mpfr_basic_vector<dd_class>;
+template class mpfr_basic_vector<qd_class>;
+template class mpfr_basic_vector<double_class>;
+template class mpfr_basic_vector<ldouble_class>;
+#ifdef HAVE_FLOAT128
+template class mpfr_basic_vector<float128_class>;
+#endif
@@ -28,57 +28,119 @@
 #ifndef __MPFR_VECTOR_H__
 #define __MPFR_VECTOR_H__
 
+#include <iostream>
+#include <utility>
 #include <vector>
 
+#include "dd_class.h"
+#include "mpfr_ball.h"
 #include "mpfr_class.h"
+#include "mpfr_fixed.h"
+#include "mpfr_vector_view.h"
+#include "qd_class.h"
+#include "native_class.h"
 
-class mpfr_vector {
+template <class T>
+class mpfr_basic_vector {
 
 public:
 
-    typedef std::vector<mpfr_class>::size_type size_t;
+    typedef typename std::vector<T>::size_type size_t;
 
 private:
 
-    std::vector<mpfr_class> m_data;
+    std::vector<T> m_data;
+    std::vector<mp_limb_t> m_limbs;
+    mpfr_prec_t m_contiguous_prec;
 
 public:
 
-    mpfr_vector();
-    mpfr_vector(const mpfr_vector& other);
-    mpfr_vector(size_t size);
-    mpfr_vector(size_t size, const mpfr_class& initial_value);
-    ~mpfr_vector();
-
-    mpfr_vector& operator=(const mpfr_vector& other);
-
-    mpfr_vector operator+(const mpfr_vector& other) const;
-    mpfr_vector& operator+=(const mpfr_vector& other);
-    mpfr_vector operator+() const;
-
-    mpfr_vector operator-(const mpfr_vector& other) const;
-    mpfr_vector& operator-=(const mpfr_vector& other);
-    mpfr_vector operator-() const;
-
-    mpfr_class operator*(const mpfr_vector& other) const;
-
-    mpfr_vector operator*(const mpfr_class& other) const;
-    mpfr_vector& operator*=(const mpfr_class& other);
-
-    mpfr_vector operator/(const mpfr_class& other) const;
-    mpfr_vector& operator/=(const mpfr_class& other);
-
-    mpfr_class& operator[](const size_t offset);
-    const mpfr_class& operator[](const size_t offset) const;
-
-    friend std::ostream& operator<<(std::ostream& left, const mpfr_vector& right);
-
-    mpfr_class euclidean_norm() const;
-
-    void append(const mpfr_class& other);
-    void append(const mpfr_vector& other);
+    mpfr_basic_vector();
+    mpfr_basic_vector(const mpfr_basic_vector& other);
+    mpfr_basic_vector(mpfr_basic_vector&& other) noexcept;
+    mpfr_basic_vector(size_t size);
+    mpfr_basic_vector(size_t size, const T& initial_value);
+    explicit mpfr_basic_vector(const mpfr_basic_vector_const_view<T>& other);
+    ~mpfr_basic_vector();
+
+    mpfr_basic_vector& operator=(const mpfr_basic_vector& other);
+    mpfr_basic_vector& operator=(mpfr_basic_vector&& other) noexcept;
+
+    mpfr_basic_vector operator+(const mpfr_basic_vector& other) const;
+    friend mpfr_basic_vector operator+(mpfr_basic_vector&& left, const mpfr_basic_vector& right) {
+        left += right;
+        return std::move(left);
+    }
+    mpfr_basic_vector& operator+=(const mpfr_basic_vector& other);
+    mpfr_basic_vector operator+() const;
+
+    mpfr_basic_vector operator-(const mpfr_basic_vector& other) const;
+    friend mpfr_basic_vector operator-(mpfr_basic_vector&& left, const mpfr_basic_vector& right) {
+        left -= right;
+        return std::move(left);
+    }
+    mpfr_basic_vector& operator-=(const mpfr_basic_vector& other);
+    mpfr_basic_vector operator-() const&;
+    mpfr_basic_vector operator-() &&;
+
+    T operator*(const mpfr_basic_vector& other) const;
+
+    mpfr_basic_vector operator*(const T& other) const;
+    friend mpfr_basic_vector operator*(mpfr_basic_vector&& left, const T& right) {
+        left *= right;
+        return std::move(left);
+    }
+    mpfr_basic_vector& operator*=(const T& other);
+
+    mpfr_basic_vector operator/(const T& other) const;
+    friend mpfr_basic_vector operator/(mpfr_basic_vector&& left, const T& right) {
+        left /= right;
+        return std::move(left);
+    }
+    mpfr_basic_vector& operator/=(const T& other);
+
+    T& operator[](const size_t offset);
+    const T& operator[](const size_t offset) const;
+
+    friend std::ostream& operator<<(std::ostream& left, const mpfr_basic_vector& right) {
+        left << '{';
+        for (size_t i = 0; i < right.m_data.size(); ++i) {
+            if (i > 0) {
+                left << ',';
+            }
+            left << right.m_data[i];
+        }
+        left << '}';
+        return left;
+    }
+
+    mpfr_basic_vector_view<T> view();
+    mpfr_basic_vector_const_view<T> view() const;
+    mpfr_basic_vector_view<T> slice(const size_t offset, const size_t size);
+    mpfr_basic_vector_const_view<T> slice(const size_t offset, const size_t size) const;
+
+    T dot(const mpfr_basic_vector& other) const;
+    T sum() const;
+    T euclidean_norm() const;
+
+    mpfr_basic_vector log_all() const;
+    mpfr_basic_vector exp_all() const;
+    mpfr_basic_vector pow_all(const T& exponent) const;
+    void log_all(mpfr_basic_vector& result) const;
+    void exp_all(mpfr_basic_vector& result) const;
+    void pow_all(const T& exponent, mpfr_basic_vector& result) const;
+
+    void append(const T& other);
+    void append(T&& other);
+    void append(const mpfr_basic_vector& other);
+    void append(mpfr_basic_vector&& other);
 
     void set_prec(mpfr_prec_t prec);
+    void round_prec(mpfr_prec_t prec);
+
+    void set_contiguous_storage(const mpfr_prec_t prec);
+    void set_separate_storage();
+    bool has_contiguous_storage() const;
 
     bool contains_nan() const;
     bool contains_inf() const;
@@ -91,11 +153,26 @@ public:
 
     size_t size() const;
 
+private:
+
+    void share_all(const mpfr_prec_t prec, const size_t capacity);
+    void reserve_contiguous(const size_t size);
+
 public:
 
-    static mpfr_vector zero_vector(const size_t size);
-    static mpfr_vector eye_vector(const size_t size, const size_t index);
+    static mpfr_basic_vector zero_vector(const size_t size);
+    static mpfr_basic_vector eye_vector(const size_t size, const size_t index);
+    static mpfr_basic_vector contiguous_vector(const size_t size, const mpfr_prec_t prec);
+    static bool supports_contiguous_storage();
+
+    // Minimum number of elements times precision in bits handed to one thread
+    // by the batched evaluations and by the element-wise arithmetic and
+    // reductions. Smaller vectors stay on the calling thread.
+    static const size_t parallel_grain = 1 << 15;
+    static const size_t arithmetic_grain = 1 << 18;
+
+}; // class mpfr_basic_vector
 
-}; // class mpfr_vector
+typedef mpfr_basic_vector<mpfr_class> mpfr_vector;
 
 #endif // __MPFR_VECTOR_H__
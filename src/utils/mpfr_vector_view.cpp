@@ -0,0 +1,611 @@
+//
+//  mpfr_vector_view.cpp
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#include "mpfr_vector_view.h"
+#include "mpfr_accumulator.h"
+#include "mpfr_thread_pool.h"
+#include "mpfr_vector.h"
+
+#include <atomic>
+#include <iostream>
+
+// Reductions over the elements. MPFR types use the correctly rounded mpfr_dot
+// and mpfr_sum, everything else accumulates in its own arithmetic.
+template <class T, bool IsMpfr = mpfr_scalar_traits<T>::is_mpfr>
+struct mpfr_vector_kernels {
+
+    static std::vector<mpfr_ptr> raw_pointers(const mpfr_basic_vector_const_view<T>& values) {
+        std::vector<mpfr_ptr> pointers(values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            pointers[i] = const_cast<mpfr_ptr>(values[i].get_raw());
+        }
+        return pointers;
+    }
+
+    static void dot(T& result, const mpfr_basic_vector_const_view<T>& left, const mpfr_basic_vector_const_view<T>& right) {
+        std::vector<mpfr_ptr> left_pointers = raw_pointers(left);
+        std::vector<mpfr_ptr> right_pointers = raw_pointers(right);
+        mpfr_dot(result.get_raw(), left_pointers.data(), right_pointers.data(), left_pointers.size(), mpfr_class::get_default_rnd());
+    }
+
+    static void sum(T& result, const mpfr_basic_vector_const_view<T>& values) {
+        std::vector<mpfr_ptr> pointers = raw_pointers(values);
+        mpfr_sum(result.get_raw(), pointers.data(), pointers.size(), mpfr_class::get_default_rnd());
+    }
+
+}; // struct mpfr_vector_kernels
+
+template <class T>
+struct mpfr_vector_kernels<T, false> {
+
+    static void dot(T& result, const mpfr_basic_vector_const_view<T>& left, const mpfr_basic_vector_const_view<T>& right) {
+        mpfr_accumulator_products<T>::addmul_n(result, left, right);
+    }
+
+    static void sum(T& result, const mpfr_basic_vector_const_view<T>& values) {
+        for (size_t i = 0; i < values.size(); ++i) {
+            result += values[i];
+        }
+    }
+
+}; // struct mpfr_vector_kernels
+
+// Element-wise evaluations used by the batched members. Each kernel handles
+// the elements in [begin, end) and writes into the existing entries of the
+// result, which keep their precision.
+template <class T>
+struct mpfr_vector_log_kernel {
+
+    const mpfr_basic_vector_view<T>& result;
+    const mpfr_basic_vector_const_view<T>& values;
+
+    void operator()(const size_t begin, const size_t end) const {
+        for (size_t i = begin; i < end; ++i) {
+            T::log_into(this->result[i], this->values[i]);
+        }
+    }
+
+}; // struct mpfr_vector_log_kernel
+
+template <class T>
+struct mpfr_vector_exp_kernel {
+
+    const mpfr_basic_vector_view<T>& result;
+    const mpfr_basic_vector_const_view<T>& values;
+
+    void operator()(const size_t begin, const size_t end) const {
+        for (size_t i = begin; i < end; ++i) {
+            T::exp_into(this->result[i], this->values[i]);
+        }
+    }
+
+}; // struct mpfr_vector_exp_kernel
+
+template <class T>
+struct mpfr_vector_pow_kernel {
+
+    const mpfr_basic_vector_view<T>& result;
+    const mpfr_basic_vector_const_view<T>& values;
+    const T& exponent;
+
+    void operator()(const size_t begin, const size_t end) const {
+        for (size_t i = begin; i < end; ++i) {
+            T::pow(this->result[i], this->values[i], this->exponent);
+        }
+    }
+
+}; // struct mpfr_vector_pow_kernel
+
+// Reductions over chunks of the elements. Every chunk is summed on its own,
+// and the partial sums are combined pairwise in a fixed tree, so the result
+// does not depend on the number of threads. MPFR types sum exactly and round
+// once, which gives the same result as mpfr_dot and mpfr_sum.
+template <class T>
+struct mpfr_vector_dot_task {
+
+    std::vector<mpfr_basic_accumulator<T>>& partial;
+    const mpfr_basic_vector_const_view<T>& left;
+    const mpfr_basic_vector_const_view<T>& right;
+
+    void operator()(const size_t i) const {
+        size_t begin = (i * this->left.size()) / this->partial.size();
+        size_t end = ((i + 1) * this->left.size()) / this->partial.size();
+        this->partial[i].addmul_n(this->left.slice(begin, end - begin), this->right.slice(begin, end - begin));
+    }
+
+}; // struct mpfr_vector_dot_task
+
+template <class T>
+struct mpfr_vector_sum_task {
+
+    std::vector<mpfr_basic_accumulator<T>>& partial;
+    const mpfr_basic_vector_const_view<T>& values;
+
+    void operator()(const size_t i) const {
+        size_t begin = (i * this->values.size()) / this->partial.size();
+        size_t end = ((i + 1) * this->values.size()) / this->partial.size();
+        for (size_t k = begin; k < end; ++k) {
+            this->partial[i].add(this->values[k]);
+        }
+    }
+
+}; // struct mpfr_vector_sum_task
+
+template <class T>
+void mpfr_vector_tree_reduce(T& result, std::vector<mpfr_basic_accumulator<T>>& partial) {
+    for (size_t step = 1; step < partial.size(); step *= 2) {
+        for (size_t i = 0; i + step < partial.size(); i += 2 * step) {
+            partial[i].merge(partial[i + step]);
+        }
+    }
+    partial[0].get(result);
+}
+
+template <class T>
+struct mpfr_vector_nan_kernel {
+
+    const mpfr_basic_vector_const_view<T>& values;
+    std::atomic<bool>& found;
+
+    void operator()(const size_t begin, const size_t end) const {
+        for (size_t i = begin; i < end && !this->found.load(std::memory_order_relaxed); ++i) {
+            if (this->values[i].is_nan()) {
+                this->found.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+
+}; // struct mpfr_vector_nan_kernel
+
+// Element-wise arithmetic of the mutable views.
+template <class T>
+struct mpfr_vector_add_kernel {
+
+    const mpfr_basic_vector_view<T>& result;
+    const mpfr_basic_vector_const_view<T>& other;
+
+    void operator()(const size_t begin, const size_t end) const {
+        for (size_t i = begin; i < end; ++i) {
+            this->result[i] += this->other[i];
+        }
+    }
+
+}; // struct mpfr_vector_add_kernel
+
+template <class T>
+struct mpfr_vector_sub_kernel {
+
+    const mpfr_basic_vector_view<T>& result;
+    const mpfr_basic_vector_const_view<T>& other;
+
+    void operator()(const size_t begin, const size_t end) const {
+        for (size_t i = begin; i < end; ++i) {
+            this->result[i] -= this->other[i];
+        }
+    }
+
+}; // struct mpfr_vector_sub_kernel
+
+template <class T>
+struct mpfr_vector_mul_kernel {
+
+    const mpfr_basic_vector_view<T>& result;
+    const T& other;
+
+    void operator()(const size_t begin, const size_t end) const {
+        for (size_t i = begin; i < end; ++i) {
+            this->result[i] *= this->other;
+        }
+    }
+
+}; // struct mpfr_vector_mul_kernel
+
+template <class T>
+struct mpfr_vector_div_kernel {
+
+    const mpfr_basic_vector_view<T>& result;
+    const T& other;
+
+    void operator()(const size_t begin, const size_t end) const {
+        for (size_t i = begin; i < end; ++i) {
+            this->result[i] /= this->other;
+        }
+    }
+
+}; // struct mpfr_vector_div_kernel
+
+template <class T>
+mpfr_basic_vector_const_view<T>::mpfr_basic_vector_const_view() :
+    m_data(NULL),
+    m_size(0),
+    m_stride(1) {
+}
+
+template <class T>
+mpfr_basic_vector_const_view<T>::mpfr_basic_vector_const_view(const T *data, const size_t size, const size_t stride) :
+    m_data(data),
+    m_size(size),
+    m_stride(stride) {
+}
+
+template <class T>
+mpfr_basic_vector_const_view<T>::mpfr_basic_vector_const_view(const mpfr_basic_vector<T>& other) :
+    m_data(other.size() > 0 ? &other[0] : NULL),
+    m_size(other.size()),
+    m_stride(1) {
+}
+
+template <class T>
+mpfr_basic_vector_const_view<T>::mpfr_basic_vector_const_view(const mpfr_basic_vector_view<T>& other) :
+    m_data(other.data()),
+    m_size(other.size()),
+    m_stride(other.stride()) {
+}
+
+template <class T>
+const T& mpfr_basic_vector_const_view<T>::operator[](const size_t offset) const {
+    return this->m_data[offset * this->m_stride];
+}
+
+template <class T>
+mpfr_basic_vector_const_view<T> mpfr_basic_vector_const_view<T>::slice(const size_t offset, const size_t size) const {
+    if (offset + size > this->m_size) {
+        printf("mpfr_basic_vector_const_view[%s:%d]: The slice exceeds the view.\n", __FILE__, __LINE__);
+        abort();
+    }
+    return mpfr_basic_vector_const_view(this->m_data + offset * this->m_stride, size, this->m_stride);
+}
+
+template <class T>
+T mpfr_basic_vector_const_view<T>::dot(const mpfr_basic_vector_const_view& other) const {
+    T tmp = 0;
+    if (this->m_size != other.m_size || this->m_size == 0) {
+        return tmp;
+    }
+    size_t n_chunks = mpfr_thread_pool::n_chunks(this->m_size, (*this)[0].get_prec(), mpfr_basic_vector<T>::arithmetic_grain);
+    if (n_chunks < 2) {
+        mpfr_vector_kernels<T>::dot(tmp, *this, other);
+        return tmp;
+    }
+    std::vector<mpfr_basic_accumulator<T>> partial(n_chunks);
+    mpfr_vector_dot_task<T> task = {partial, *this, other};
+    mpfr_thread_pool::global().run(task, n_chunks);
+    mpfr_vector_tree_reduce(tmp, partial);
+    return tmp;
+}
+
+template <class T>
+T mpfr_basic_vector_const_view<T>::sum() const {
+    T tmp = 0;
+    if (this->m_size == 0) {
+        return tmp;
+    }
+    size_t n_chunks = mpfr_thread_pool::n_chunks(this->m_size, (*this)[0].get_prec(), mpfr_basic_vector<T>::arithmetic_grain);
+    if (n_chunks < 2) {
+        mpfr_vector_kernels<T>::sum(tmp, *this);
+        return tmp;
+    }
+    std::vector<mpfr_basic_accumulator<T>> partial(n_chunks);
+    mpfr_vector_sum_task<T> task = {partial, *this};
+    mpfr_thread_pool::global().run(task, n_chunks);
+    mpfr_vector_tree_reduce(tmp, partial);
+    return tmp;
+}
+
+template <class T>
+T mpfr_basic_vector_const_view<T>::euclidean_norm() const {
+    T norm = this->dot(*this);
+    norm.to_sqrt();
+    return norm;
+}
+
+// The batched evaluations write into the entries of result in their own
+// precision, so result may view the same elements. A result of the wrong
+// size is set to NaN.
+template <class T>
+void mpfr_basic_vector_const_view<T>::log_all(const mpfr_basic_vector_view<T>& result) const {
+    if (result.size() != this->m_size) {
+        result.set_nan();
+        return;
+    }
+    if (this->m_size == 0) {
+        return;
+    }
+    mpfr_vector_log_kernel<T> kernel = {result, *this};
+    mpfr_thread_pool::global().parallel_for(kernel, this->m_size, result[0].get_prec(), mpfr_basic_vector<T>::parallel_grain);
+}
+
+template <class T>
+void mpfr_basic_vector_const_view<T>::exp_all(const mpfr_basic_vector_view<T>& result) const {
+    if (result.size() != this->m_size) {
+        result.set_nan();
+        return;
+    }
+    if (this->m_size == 0) {
+        return;
+    }
+    mpfr_vector_exp_kernel<T> kernel = {result, *this};
+    mpfr_thread_pool::global().parallel_for(kernel, this->m_size, result[0].get_prec(), mpfr_basic_vector<T>::parallel_grain);
+}
+
+template <class T>
+void mpfr_basic_vector_const_view<T>::pow_all(const T& exponent, const mpfr_basic_vector_view<T>& result) const {
+    if (result.size() != this->m_size) {
+        result.set_nan();
+        return;
+    }
+    if (this->m_size == 0) {
+        return;
+    }
+    mpfr_vector_pow_kernel<T> kernel = {result, *this, exponent};
+    mpfr_thread_pool::global().parallel_for(kernel, this->m_size, result[0].get_prec(), mpfr_basic_vector<T>::parallel_grain);
+}
+
+// The test costs the same at every precision, so only the size counts.
+template <class T>
+bool mpfr_basic_vector_const_view<T>::contains_nan() const {
+    std::atomic<bool> found(false);
+    mpfr_vector_nan_kernel<T> kernel = {*this, found};
+    mpfr_thread_pool::global().parallel_for(kernel, this->m_size, 1, mpfr_basic_vector<T>::arithmetic_grain);
+    return found.load();
+}
+
+template <class T>
+bool mpfr_basic_vector_const_view<T>::contains_inf() const {
+    for (size_t i = 0; i < this->m_size; ++i) {
+        if ((*this)[i].is_inf()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class T>
+bool mpfr_basic_vector_const_view<T>::is_zero() const {
+    for (size_t i = 0; i < this->m_size; ++i) {
+        if (!(*this)[i].is_zero()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class T>
+const T *mpfr_basic_vector_const_view<T>::data() const {
+    return this->m_data;
+}
+
+template <class T>
+typename mpfr_basic_vector_const_view<T>::size_t mpfr_basic_vector_const_view<T>::size() const {
+    return this->m_size;
+}
+
+template <class T>
+typename mpfr_basic_vector_const_view<T>::size_t mpfr_basic_vector_const_view<T>::stride() const {
+    return this->m_stride;
+}
+
+template <class T>
+mpfr_basic_vector_view<T>::mpfr_basic_vector_view() :
+    m_data(NULL),
+    m_size(0),
+    m_stride(1) {
+}
+
+template <class T>
+mpfr_basic_vector_view<T>::mpfr_basic_vector_view(T *data, const size_t size, const size_t stride) :
+    m_data(data),
+    m_size(size),
+    m_stride(stride) {
+}
+
+template <class T>
+mpfr_basic_vector_view<T>::mpfr_basic_vector_view(mpfr_basic_vector<T>& other) :
+    m_data(other.size() > 0 ? &other[0] : NULL),
+    m_size(other.size()),
+    m_stride(1) {
+}
+
+template <class T>
+T& mpfr_basic_vector_view<T>::operator[](const size_t offset) const {
+    return this->m_data[offset * this->m_stride];
+}
+
+template <class T>
+mpfr_basic_vector_view<T> mpfr_basic_vector_view<T>::slice(const size_t offset, const size_t size) const {
+    if (offset + size > this->m_size) {
+        printf("mpfr_basic_vector_view[%s:%d]: The slice exceeds the view.\n", __FILE__, __LINE__);
+        abort();
+    }
+    return mpfr_basic_vector_view(this->m_data + offset * this->m_stride, size, this->m_stride);
+}
+
+template <class T>
+T mpfr_basic_vector_view<T>::dot(const mpfr_basic_vector_const_view<T>& other) const {
+    return mpfr_basic_vector_const_view<T>(*this).dot(other);
+}
+
+template <class T>
+T mpfr_basic_vector_view<T>::sum() const {
+    return mpfr_basic_vector_const_view<T>(*this).sum();
+}
+
+template <class T>
+T mpfr_basic_vector_view<T>::euclidean_norm() const {
+    return mpfr_basic_vector_const_view<T>(*this).euclidean_norm();
+}
+
+template <class T>
+void mpfr_basic_vector_view<T>::log_all(const mpfr_basic_vector_view& result) const {
+    mpfr_basic_vector_const_view<T>(*this).log_all(result);
+}
+
+template <class T>
+void mpfr_basic_vector_view<T>::exp_all(const mpfr_basic_vector_view& result) const {
+    mpfr_basic_vector_const_view<T>(*this).exp_all(result);
+}
+
+template <class T>
+void mpfr_basic_vector_view<T>::pow_all(const T& exponent, const mpfr_basic_vector_view& result) const {
+    mpfr_basic_vector_const_view<T>(*this).pow_all(exponent, result);
+}
+
+template <class T>
+bool mpfr_basic_vector_view<T>::contains_nan() const {
+    return mpfr_basic_vector_const_view<T>(*this).contains_nan();
+}
+
+template <class T>
+bool mpfr_basic_vector_view<T>::contains_inf() const {
+    return mpfr_basic_vector_const_view<T>(*this).contains_inf();
+}
+
+template <class T>
+bool mpfr_basic_vector_view<T>::is_zero() const {
+    return mpfr_basic_vector_const_view<T>(*this).is_zero();
+}
+
+// Copies the values of other into the viewed elements, which keep their
+// precision.
+template <class T>
+void mpfr_basic_vector_view<T>::assign(const mpfr_basic_vector_const_view<T>& other) const {
+    if (this->m_size != other.size()) {
+        this->set_nan();
+        return;
+    }
+    for (size_t i = 0; i < this->m_size; ++i) {
+        (*this)[i] = other[i];
+    }
+}
+
+template <class T>
+const mpfr_basic_vector_view<T>& mpfr_basic_vector_view<T>::operator+=(const mpfr_basic_vector_const_view<T>& other) const {
+    if (this->m_size != other.size()) {
+        this->set_nan();
+        return *this;
+    }
+    if (this->m_size > 0) {
+        mpfr_vector_add_kernel<T> kernel = {*this, other};
+        mpfr_thread_pool::global().parallel_for(kernel, this->m_size, (*this)[0].get_prec(), mpfr_basic_vector<T>::arithmetic_grain);
+    }
+    return *this;
+}
+
+template <class T>
+const mpfr_basic_vector_view<T>& mpfr_basic_vector_view<T>::operator-=(const mpfr_basic_vector_const_view<T>& other) const {
+    if (this->m_size != other.size()) {
+        this->set_nan();
+        return *this;
+    }
+    if (this->m_size > 0) {
+        mpfr_vector_sub_kernel<T> kernel = {*this, other};
+        mpfr_thread_pool::global().parallel_for(kernel, this->m_size, (*this)[0].get_prec(), mpfr_basic_vector<T>::arithmetic_grain);
+    }
+    return *this;
+}
+
+template <class T>
+const mpfr_basic_vector_view<T>& mpfr_basic_vector_view<T>::operator*=(const T& other) const {
+    if (this->m_size > 0) {
+        mpfr_vector_mul_kernel<T> kernel = {*this, other};
+        mpfr_thread_pool::global().parallel_for(kernel, this->m_size, (*this)[0].get_prec(), mpfr_basic_vector<T>::arithmetic_grain);
+    }
+    return *this;
+}
+
+template <class T>
+const mpfr_basic_vector_view<T>& mpfr_basic_vector_view<T>::operator/=(const T& other) const {
+    if (this->m_size > 0) {
+        mpfr_vector_div_kernel<T> kernel = {*this, other};
+        mpfr_thread_pool::global().parallel_for(kernel, this->m_size, (*this)[0].get_prec(), mpfr_basic_vector<T>::arithmetic_grain);
+    }
+    return *this;
+}
+
+template <class T>
+void mpfr_basic_vector_view<T>::set_nan() const {
+    for (size_t i = 0; i < this->m_size; ++i) {
+        (*this)[i].set_nan();
+    }
+}
+
+template <class T>
+void mpfr_basic_vector_view<T>::set_zero(int sign) const {
+    for (size_t i = 0; i < this->m_size; ++i) {
+        (*this)[i].set_zero(sign);
+    }
+}
+
+template <class T>
+void mpfr_basic_vector_view<T>::set_neg() const {
+    for (size_t i = 0; i < this->m_size; ++i) {
+        (*this)[i].set_neg();
+    }
+}
+
+template <class T>
+T *mpfr_basic_vector_view<T>::data() const {
+    return this->m_data;
+}
+
+template <class T>
+typename mpfr_basic_vector_view<T>::size_t mpfr_basic_vector_view<T>::size() const {
+    return this->m_size;
+}
+
+template <class T>
+typename mpfr_basic_vector_view<T>::size_t mpfr_basic_vector_view<T>::stride() const {
+    return this->m_stride;
+}
+
+template class mpfr_basic_vector_const_view<mpfr_class>;
+template class mpfr_basic_vector_const_view<mpfr_ball>;
+template class mpfr_basic_vector_const_view<mpfr_fixed128>;
+template class mpfr_basic_vector_const_view<mpfr_fixed256>;
+template class mpfr_basic_vector_const_view<mpfr_fixed512>;
+template class mpfr_basic_vector_const_view<mpfr_fixed1024>;
+template class mpfr_basic_vector_const_view<dd_class>;
+template class mpfr_basic_vector_const_view<qd_class>;
+template class mpfr_basic_vector_const_view<double_class>;
+template class mpfr_basic_vector_const_view<ldouble_class>;
+#ifdef HAVE_FLOAT128
+template class mpfr_basic_vector_const_view<float128_class>;
+#endif
+
+template class mpfr_basic_vector_view<mpfr_class>;
+template class mpfr_basic_vector_view<mpfr_ball>;
+template class mpfr_basic_vector_view<mpfr_fixed128>;
+template class mpfr_basic_vector_view<mpfr_fixed256>;
+template class mpfr_basic_vector_view<mpfr_fixed512>;
+template class mpfr_basic_vector_view<mpfr_fixed1024>;
+template class mpfr_basic_vector_view<dd_class>;
+template class mpfr_basic_vector_view<qd_class>;
+template class mpfr_basic_vector_view<double_class>;
+template class mpfr_basic_vector_view<ldouble_class>;
+#ifdef HAVE_FLOAT128
+template class mpfr_basic_vector_view<float128_class>;
+#endif
@@ -0,0 +1,165 @@
+//
+//  mpfr_vector_view.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __MPFR_VECTOR_VIEW_H__
+#define __MPFR_VECTOR_VIEW_H__
+
+#include <iostream>
+#include <vector>
+
+#include "dd_class.h"
+#include "mpfr_ball.h"
+#include "mpfr_class.h"
+#include "mpfr_fixed.h"
+#include "qd_class.h"
+#include "native_class.h"
+
+template <class T>
+class mpfr_basic_vector;
+
+// Non-owning views of size elements that lie stride elements apart, for
+// example a slice of a vector or a row of a matrix. A view does not keep its
+// elements alive, so it must not outlive the container it was taken from or
+// any reallocation of it. Views are shallow: a const view only forbids
+// writing through it.
+
+template <class T>
+class mpfr_basic_vector_view;
+
+template <class T>
+class mpfr_basic_vector_const_view {
+
+public:
+
+    typedef typename std::vector<T>::size_type size_t;
+
+private:
+
+    const T *m_data;
+    size_t m_size;
+    size_t m_stride;
+
+public:
+
+    mpfr_basic_vector_const_view();
+    mpfr_basic_vector_const_view(const T *data, const size_t size, const size_t stride = 1);
+    mpfr_basic_vector_const_view(const mpfr_basic_vector<T>& other);
+    mpfr_basic_vector_const_view(const mpfr_basic_vector_view<T>& other);
+
+    const T& operator[](const size_t offset) const;
+
+    friend std::ostream& operator<<(std::ostream& left, const mpfr_basic_vector_const_view& right) {
+        left << '{';
+        for (size_t i = 0; i < right.m_size; ++i) {
+            if (i > 0) {
+                left << ',';
+            }
+            left << right[i];
+        }
+        left << '}';
+        return left;
+    }
+
+    mpfr_basic_vector_const_view slice(const size_t offset, const size_t size) const;
+
+    T dot(const mpfr_basic_vector_const_view& other) const;
+    T sum() const;
+    T euclidean_norm() const;
+
+    void log_all(const mpfr_basic_vector_view<T>& result) const;
+    void exp_all(const mpfr_basic_vector_view<T>& result) const;
+    void pow_all(const T& exponent, const mpfr_basic_vector_view<T>& result) const;
+
+    bool contains_nan() const;
+    bool contains_inf() const;
+    bool is_zero() const;
+
+    const T *data() const;
+    size_t size() const;
+    size_t stride() const;
+
+}; // class mpfr_basic_vector_const_view
+
+template <class T>
+class mpfr_basic_vector_view {
+
+public:
+
+    typedef typename std::vector<T>::size_type size_t;
+
+private:
+
+    T *m_data;
+    size_t m_size;
+    size_t m_stride;
+
+public:
+
+    mpfr_basic_vector_view();
+    mpfr_basic_vector_view(T *data, const size_t size, const size_t stride = 1);
+    mpfr_basic_vector_view(mpfr_basic_vector<T>& other);
+
+    T& operator[](const size_t offset) const;
+
+    friend std::ostream& operator<<(std::ostream& left, const mpfr_basic_vector_view& right) {
+        return left << mpfr_basic_vector_const_view<T>(right);
+    }
+
+    mpfr_basic_vector_view slice(const size_t offset, const size_t size) const;
+
+    T dot(const mpfr_basic_vector_const_view<T>& other) const;
+    T sum() const;
+    T euclidean_norm() const;
+
+    void log_all(const mpfr_basic_vector_view& result) const;
+    void exp_all(const mpfr_basic_vector_view& result) const;
+    void pow_all(const T& exponent, const mpfr_basic_vector_view& result) const;
+
+    bool contains_nan() const;
+    bool contains_inf() const;
+    bool is_zero() const;
+
+    void assign(const mpfr_basic_vector_const_view<T>& other) const;
+    const mpfr_basic_vector_view& operator+=(const mpfr_basic_vector_const_view<T>& other) const;
+    const mpfr_basic_vector_view& operator-=(const mpfr_basic_vector_const_view<T>& other) const;
+    const mpfr_basic_vector_view& operator*=(const T& other) const;
+    const mpfr_basic_vector_view& operator/=(const T& other) const;
+
+    void set_nan() const;
+    void set_zero(int sign) const;
+    void set_neg() const;
+
+    T *data() const;
+    size_t size() const;
+    size_t stride() const;
+
+}; // class mpfr_basic_vector_view
+
+typedef mpfr_basic_vector_view<mpfr_class> mpfr_vector_view;
+typedef mpfr_basic_vector_const_view<mpfr_class> mpfr_vector_const_view;
+
+#endif // __MPFR_VECTOR_VIEW_H__
@@ -0,0 +1,734 @@
+//
+//  native_class.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __NATIVE_CLASS_H__
+#define __NATIVE_CLASS_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <cmath>
+#include <limits>
+#include <mpfr.h>
+#include <iostream>
+#include <string>
+
+#ifdef HAVE_FLOAT128
+extern "C" {
+#include <quadmath.h>
+}
+#endif
+
+#include "mpfr_cache.h"
+#include "mpfr_class.h"
+#include "mpfr_scalar_traits.h"
+
+// Elementary functions and MPFR conversions of the hardware floating-point
+// types. Values are split into doubles when handed to MPFR, so no MPFR build
+// options are needed for __float128.
+
+template <class T>
+struct native_math {
+
+    static const mpfr_prec_t digits = std::numeric_limits<T>::digits;
+
+    static T abs(const T value) { return std::fabs(value); }
+    static T sqrt(const T value) { return std::sqrt(value); }
+    static T log(const T value) { return std::log(value); }
+    static T exp(const T value) { return std::exp(value); }
+    static T cos(const T value) { return std::cos(value); }
+    static T sin(const T value) { return std::sin(value); }
+    static T tan(const T value) { return std::tan(value); }
+    static T pow(const T value, const T exponent) { return std::pow(value, exponent); }
+    static T fma(const T left, const T right, const T addend) { return std::fma(left, right, addend); }
+    static T frexp(const T value, int *exponent) { return std::frexp(value, exponent); }
+    static T ldexp(const T value, const int exponent) { return std::ldexp(value, exponent); }
+    static bool is_nan(const T value) { return std::isnan(value); }
+    static bool is_inf(const T value) { return std::isinf(value); }
+    static bool is_signbit(const T value) { return std::signbit(value); }
+    static T nan() { return std::numeric_limits<T>::quiet_NaN(); }
+    static T inf() { return std::numeric_limits<T>::infinity(); }
+    static T epsilon() { return std::numeric_limits<T>::epsilon(); }
+
+    static void get_raw(mpfr_ptr result, const T value);
+    static T set_raw(mpfr_srcptr value);
+
+};
+
+template <>
+inline void native_math<double>::get_raw(mpfr_ptr result, const double value) {
+    mpfr_set_d(result, value, MPFR_RNDN);
+}
+
+template <>
+inline double native_math<double>::set_raw(mpfr_srcptr value) {
+    return mpfr_get_d(value, MPFR_RNDN);
+}
+
+template <>
+inline void native_math<long double>::get_raw(mpfr_ptr result, const long double value) {
+    mpfr_set_ld(result, value, MPFR_RNDN);
+}
+
+template <>
+inline long double native_math<long double>::set_raw(mpfr_srcptr value) {
+    return mpfr_get_ld(value, MPFR_RNDN);
+}
+
+#ifdef HAVE_FLOAT128
+
+template <>
+struct native_math<__float128> {
+
+    static const mpfr_prec_t digits = FLT128_MANT_DIG;
+
+    static __float128 abs(const __float128 value) { return fabsq(value); }
+    static __float128 sqrt(const __float128 value) { return sqrtq(value); }
+    static __float128 log(const __float128 value) { return logq(value); }
+    static __float128 exp(const __float128 value) { return expq(value); }
+    static __float128 cos(const __float128 value) { return cosq(value); }
+    static __float128 sin(const __float128 value) { return sinq(value); }
+    static __float128 tan(const __float128 value) { return tanq(value); }
+    static __float128 pow(const __float128 value, const __float128 exponent) { return powq(value, exponent); }
+    static __float128 fma(const __float128 left, const __float128 right, const __float128 addend) { return fmaq(left, right, addend); }
+    static __float128 frexp(const __float128 value, int *exponent) { return frexpq(value, exponent); }
+    static __float128 ldexp(const __float128 value, const int exponent) { return ldexpq(value, exponent); }
+    static bool is_nan(const __float128 value) { return isnanq(value); }
+    static bool is_inf(const __float128 value) { return isinfq(value); }
+    static bool is_signbit(const __float128 value) { return signbitq(value); }
+    static __float128 nan() { return nanq(""); }
+    static __float128 inf() { return (__float128)INFINITY; }
+    static __float128 epsilon() { return ldexpq(1, 1 - FLT128_MANT_DIG); }
+
+    // The 113-bit significand is carried exactly by three doubles.
+    static void get_raw(mpfr_ptr result, const __float128 value) {
+        double hi = (double)value;
+        if (!std::isfinite(hi) || hi == 0.0) {
+            mpfr_set_d(result, hi, MPFR_RNDN);
+            return;
+        }
+        __float128 remainder = value - hi;
+        double mid = (double)remainder;
+        double lo = (double)(remainder - mid);
+        MPFR_DECL_INIT(tmp_hi, DBL_MANT_DIG);
+        MPFR_DECL_INIT(tmp_mid, DBL_MANT_DIG);
+        MPFR_DECL_INIT(tmp_lo, DBL_MANT_DIG);
+        mpfr_set_d(tmp_hi, hi, MPFR_RNDN);
+        mpfr_set_d(tmp_mid, mid, MPFR_RNDN);
+        mpfr_set_d(tmp_lo, lo, MPFR_RNDN);
+        mpfr_ptr values[3] = {tmp_hi, tmp_mid, tmp_lo};
+        mpfr_sum(result, values, 3, MPFR_RNDN);
+    }
+
+    static __float128 set_raw(mpfr_srcptr value) {
+        if (!mpfr_regular_p(value)) {
+            return mpfr_get_d(value, MPFR_RNDN);
+        }
+        mpfr_t tmp;
+        mpfr_init2(tmp, mpfr_get_prec(value));
+        mpfr_set(tmp, value, MPFR_RNDN);
+        __float128 result = 0;
+        for (int i = 0; i < 3 && mpfr_regular_p(tmp); ++i) {
+            double part = mpfr_get_d(tmp, MPFR_RNDN);
+            result += part;
+            mpfr_sub_d(tmp, tmp, part, MPFR_RNDN);
+        }
+        mpfr_clear(tmp);
+        return result;
+    }
+
+};
+
+#endif // HAVE_FLOAT128
+
+// Hardware floating-point number behind the mpfr_class interface, so the
+// containers and solvers can run at native speed when the tolerance allows it.
+// The precision is that of T and the rounding mode is always to nearest.
+
+template <class T>
+class native_class {
+
+private:
+
+    T m_value;
+
+public:
+
+    native_class() {
+        this->m_value = native_math<T>::nan();
+    }
+
+    native_class(const native_class& other) {
+        this->m_value = other.m_value;
+    }
+
+    native_class(const int other) {
+        this->m_value = other;
+    }
+
+    native_class(const long int other) {
+        this->m_value = other;
+    }
+
+    native_class(const long long int other) {
+        this->m_value = other;
+    }
+
+    native_class(const unsigned int other) {
+        this->m_value = other;
+    }
+
+    native_class(const unsigned long int other) {
+        this->m_value = other;
+    }
+
+    native_class(const unsigned long long int other) {
+        this->m_value = other;
+    }
+
+    native_class(const float other) {
+        this->m_value = other;
+    }
+
+    native_class(const double other) {
+        this->m_value = other;
+    }
+
+    native_class(const long double other) {
+        this->m_value = other;
+    }
+
+#ifdef HAVE_FLOAT128
+    native_class(const __float128 other) {
+        this->m_value = other;
+    }
+#endif
+
+    native_class(const char *other) {
+        this->set_str(other, 10);
+    }
+
+    native_class(const std::string& other) {
+        this->set_str(other, 10);
+    }
+
+    explicit native_class(const mpfr_class& other) {
+        this->m_value = native_math<T>::set_raw(other.get_raw());
+    }
+
+    ~native_class() {
+    }
+
+    native_class& operator=(const native_class& other) {
+        this->m_value = other.m_value;
+        return *this;
+    }
+
+    friend native_class operator+(const native_class& left, const native_class& right) {
+        return native_class(left.m_value + right.m_value, 0);
+    }
+
+    native_class& operator+=(const native_class& other) {
+        this->m_value += other.m_value;
+        return *this;
+    }
+
+    native_class operator+() const {
+        return *this;
+    }
+
+    native_class& operator++() {
+        this->m_value += 1;
+        return *this;
+    }
+
+    native_class operator++(int) {
+        native_class tmp = *this;
+        this->m_value += 1;
+        return tmp;
+    }
+
+    friend native_class operator-(const native_class& left, const native_class& right) {
+        return native_class(left.m_value - right.m_value, 0);
+    }
+
+    native_class& operator-=(const native_class& other) {
+        this->m_value -= other.m_value;
+        return *this;
+    }
+
+    native_class operator-() const {
+        return native_class(-this->m_value, 0);
+    }
+
+    native_class& operator--() {
+        this->m_value -= 1;
+        return *this;
+    }
+
+    native_class operator--(int) {
+        native_class tmp = *this;
+        this->m_value -= 1;
+        return tmp;
+    }
+
+    friend native_class operator*(const native_class& left, const native_class& right) {
+        return native_class(left.m_value * right.m_value, 0);
+    }
+
+    native_class& operator*=(const native_class& other) {
+        this->m_value *= other.m_value;
+        return *this;
+    }
+
+    friend native_class operator/(const native_class& left, const native_class& right) {
+        return native_class(left.m_value / right.m_value, 0);
+    }
+
+    native_class& operator/=(const native_class& other) {
+        this->m_value /= other.m_value;
+        return *this;
+    }
+
+    friend native_class operator^(const native_class& left, const native_class& right) {
+        return left.pow_value(right);
+    }
+
+    friend native_class operator^(const native_class& left, const long int right) {
+        return left.pow_value(right);
+    }
+
+    native_class& operator^=(const native_class& other) {
+        this->to_pow(other);
+        return *this;
+    }
+
+    native_class& operator^=(const long int other) {
+        this->to_pow(other);
+        return *this;
+    }
+
+    friend bool operator==(const native_class& left, const native_class& right) {
+        return left.m_value == right.m_value;
+    }
+
+    friend bool operator!=(const native_class& left, const native_class& right) {
+        return left.m_value != right.m_value;
+    }
+
+    friend bool operator<(const native_class& left, const native_class& right) {
+        return left.m_value < right.m_value;
+    }
+
+    friend bool operator<=(const native_class& left, const native_class& right) {
+        return left.m_value <= right.m_value;
+    }
+
+    friend bool operator>(const native_class& left, const native_class& right) {
+        return left.m_value > right.m_value;
+    }
+
+    friend bool operator>=(const native_class& left, const native_class& right) {
+        return left.m_value >= right.m_value;
+    }
+
+    native_class pow_value(const native_class& exponent) const {
+        return native_class(native_math<T>::pow(this->m_value, exponent.m_value), 0);
+    }
+
+    // Integral exponents use binary powering.
+    native_class pow_value(const long int exponent) const {
+        unsigned long int n = (exponent < 0) ? -(unsigned long int)exponent : (unsigned long int)exponent;
+        T base = this->m_value;
+        T result = 1;
+        while (n != 0) {
+            if (n & 1) {
+                result *= base;
+            }
+            n >>= 1;
+            if (n != 0) {
+                base *= base;
+            }
+        }
+        return native_class((exponent < 0) ? 1 / result : result, 0);
+    }
+
+    void to_pow(const native_class& exponent) {
+        *this = this->pow_value(exponent);
+    }
+
+    void to_pow(const long int exponent) {
+        *this = this->pow_value(exponent);
+    }
+
+    native_class& fma(const native_class& left, const native_class& right, const native_class& addend) {
+        this->m_value = native_math<T>::fma(left.m_value, right.m_value, addend.m_value);
+        return *this;
+    }
+
+    native_class& fms(const native_class& left, const native_class& right, const native_class& subtrahend) {
+        this->m_value = native_math<T>::fma(left.m_value, right.m_value, -subtrahend.m_value);
+        return *this;
+    }
+
+    native_class& addmul(const native_class& left, const native_class& right) {
+        this->m_value = native_math<T>::fma(left.m_value, right.m_value, this->m_value);
+        return *this;
+    }
+
+    native_class& submul(const native_class& left, const native_class& right) {
+        this->m_value = native_math<T>::fma(-left.m_value, right.m_value, this->m_value);
+        return *this;
+    }
+
+    long int long_value() const {
+        return (long int)this->m_value;
+    }
+
+    double double_value() const {
+        return (double)this->m_value;
+    }
+
+    long double ldouble_value() const {
+        return (long double)this->m_value;
+    }
+
+    T native_value() const {
+        return this->m_value;
+    }
+
+    mpfr_class class_value() const {
+        mpfr_class tmp;
+        tmp.set_prec(native_class::precision);
+        native_math<T>::get_raw(tmp.get_raw(), this->m_value);
+        return tmp;
+    }
+
+    explicit operator double() const { return this->double_value(); }
+    explicit operator long double() const { return this->ldouble_value(); }
+
+    friend std::ostream& operator<<(std::ostream& left, const native_class& right) {
+        left << right.get_str();
+        return left;
+    }
+
+    friend std::istream& operator>>(std::istream& left, native_class& right) {
+        std::string tmp_string;
+        left >> tmp_string;
+        right.set_str(tmp_string, 10);
+        return left;
+    }
+
+    std::string get_str() const {
+        return this->class_value().get_str();
+    }
+
+    std::string get_str_with_format(std::string format) const {
+        return this->class_value().get_str_with_format(format);
+    }
+
+    void set_str(const std::string& other, const int base) {
+        mpfr_t tmp;
+        mpfr_init2(tmp, native_class::precision);
+        if (mpfr_set_str(tmp, other.c_str(), base, MPFR_RNDN) != 0) {
+            printf("native_class[%s:%d]: Invalid number string.\n", __FILE__, __LINE__);
+            abort();
+        }
+        this->m_value = native_math<T>::set_raw(tmp);
+        mpfr_clear(tmp);
+    }
+
+    native_class abs_value() const {
+        return native_class(native_math<T>::abs(this->m_value), 0);
+    }
+
+    void to_abs() {
+        this->m_value = native_math<T>::abs(this->m_value);
+    }
+
+    native_class sqrt_value() const {
+        return native_class(native_math<T>::sqrt(this->m_value), 0);
+    }
+
+    void to_sqrt() {
+        this->m_value = native_math<T>::sqrt(this->m_value);
+    }
+
+    native_class log_value() const {
+        return native_class(native_math<T>::log(this->m_value), 0);
+    }
+
+    void to_log() {
+        this->m_value = native_math<T>::log(this->m_value);
+    }
+
+    native_class exp_value() const {
+        return native_class(native_math<T>::exp(this->m_value), 0);
+    }
+
+    void to_exp() {
+        this->m_value = native_math<T>::exp(this->m_value);
+    }
+
+    native_class cos_value() const {
+        return native_class(native_math<T>::cos(this->m_value), 0);
+    }
+
+    void to_cos() {
+        this->m_value = native_math<T>::cos(this->m_value);
+    }
+
+    native_class sin_value() const {
+        return native_class(native_math<T>::sin(this->m_value), 0);
+    }
+
+    void to_sin() {
+        this->m_value = native_math<T>::sin(this->m_value);
+    }
+
+    native_class tan_value() const {
+        return native_class(native_math<T>::tan(this->m_value), 0);
+    }
+
+    void to_tan() {
+        this->m_value = native_math<T>::tan(this->m_value);
+    }
+
+    mpfr_prec_t get_prec() const {
+        return native_class::precision;
+    }
+
+    mpfr_exp_t get_exp() const {
+        int exponent;
+        native_math<T>::frexp(this->m_value, &exponent);
+        return exponent;
+    }
+
+    // The precision is fixed; set_prec only resets the value and round_prec
+    // rounds it to fewer bits.
+    void set_prec(mpfr_prec_t prec) {
+        this->set_nan();
+    }
+
+    void round_prec(mpfr_prec_t prec) {
+        if (prec >= native_class::precision || !this->is_regular()) {
+            return;
+        }
+        mpfr_class tmp = this->class_value();
+        mpfr_prec_round(tmp.get_raw(), prec, MPFR_RNDN);
+        this->m_value = native_math<T>::set_raw(tmp.get_raw());
+    }
+
+    bool is_nan() const {
+        return native_math<T>::is_nan(this->m_value);
+    }
+
+    bool is_inf() const {
+        return native_math<T>::is_inf(this->m_value);
+    }
+
+    bool is_number() const {
+        return !this->is_nan() && !this->is_inf();
+    }
+
+    bool is_zero() const {
+        return this->m_value == 0;
+    }
+
+    bool is_regular() const {
+        return this->is_number() && !this->is_zero();
+    }
+
+    void set_nan() {
+        this->m_value = native_math<T>::nan();
+    }
+
+    void set_inf(int sign) {
+        this->m_value = (sign < 0) ? -native_math<T>::inf() : native_math<T>::inf();
+    }
+
+    void set_zero(int sign) {
+        this->m_value = 0;
+        if (sign < 0) {
+            this->m_value = -this->m_value;
+        }
+    }
+
+    void set_neg() {
+        this->m_value = -this->m_value;
+    }
+
+    int get_sign() const {
+        return (this->m_value > 0) - (this->m_value < 0);
+    }
+
+    void set_sign(int sign) {
+        if ((sign < 0) != native_math<T>::is_signbit(this->m_value)) {
+            this->set_neg();
+        }
+    }
+
+private:
+
+    // Tagged to keep it apart from the converting constructors.
+    native_class(const T value, int) {
+        this->m_value = value;
+    }
+
+public:
+
+    static const mpfr_prec_t precision = native_math<T>::digits;
+
+    static native_class sqr(const native_class& value) {
+        return native_class(value.m_value * value.m_value, 0);
+    }
+
+    static native_class ldexp(const native_class& value, const int exponent) {
+        return native_class(native_math<T>::ldexp(value.m_value, exponent), 0);
+    }
+
+    static void set(native_class& result, const native_class& value) {
+        result.m_value = value.m_value;
+    }
+
+    static void add(native_class& result, const native_class& left, const native_class& right) {
+        result.m_value = left.m_value + right.m_value;
+    }
+
+    static void add(native_class& result, const native_class& left, const unsigned long int right) {
+        result.m_value = left.m_value + (T)right;
+    }
+
+    static void sub(native_class& result, const native_class& left, const native_class& right) {
+        result.m_value = left.m_value - right.m_value;
+    }
+
+    static void sub(native_class& result, const native_class& left, const unsigned long int right) {
+        result.m_value = left.m_value - (T)right;
+    }
+
+    static void sub(native_class& result, const unsigned long int left, const native_class& right) {
+        result.m_value = (T)left - right.m_value;
+    }
+
+    static void mul(native_class& result, const native_class& left, const native_class& right) {
+        result.m_value = left.m_value * right.m_value;
+    }
+
+    static void mul(native_class& result, const native_class& left, const unsigned long int right) {
+        result.m_value = left.m_value * (T)right;
+    }
+
+    static void div(native_class& result, const native_class& left, const native_class& right) {
+        result.m_value = left.m_value / right.m_value;
+    }
+
+    static void div(native_class& result, const native_class& left, const unsigned long int right) {
+        result.m_value = left.m_value / (T)right;
+    }
+
+    static void div(native_class& result, const unsigned long int left, const native_class& right) {
+        result.m_value = (T)left / right.m_value;
+    }
+
+    static void pow(native_class& result, const native_class& base, const native_class& exponent) {
+        result.m_value = native_math<T>::pow(base.m_value, exponent.m_value);
+    }
+
+    static void pow_ui(native_class& result, const native_class& base, const unsigned long int exponent) {
+        result = base.pow_value((long int)exponent);
+    }
+
+    static void abs_into(native_class& result, const native_class& value) {
+        result.m_value = native_math<T>::abs(value.m_value);
+    }
+
+    static void sqrt_into(native_class& result, const native_class& value) {
+        result.m_value = native_math<T>::sqrt(value.m_value);
+    }
+
+    static void log_into(native_class& result, const native_class& value) {
+        result.m_value = native_math<T>::log(value.m_value);
+    }
+
+    static void exp_into(native_class& result, const native_class& value) {
+        result.m_value = native_math<T>::exp(value.m_value);
+    }
+
+    static void cos_into(native_class& result, const native_class& value) {
+        result.m_value = native_math<T>::cos(value.m_value);
+    }
+
+    static void sin_into(native_class& result, const native_class& value) {
+        result.m_value = native_math<T>::sin(value.m_value);
+    }
+
+    static void tan_into(native_class& result, const native_class& value) {
+        result.m_value = native_math<T>::tan(value.m_value);
+    }
+
+    static native_class const_log2() {
+        mpfr_class tmp;
+        tmp.set_prec(native_class::precision);
+        mpfr_cache::global().constant(tmp.get_raw(), mpfr_cache::cache_log2, MPFR_RNDN);
+        return native_class(tmp);
+    }
+
+    static native_class const_pi() {
+        mpfr_class tmp;
+        tmp.set_prec(native_class::precision);
+        mpfr_cache::global().constant(tmp.get_raw(), mpfr_cache::cache_pi, MPFR_RNDN);
+        return native_class(tmp);
+    }
+
+    static native_class const_epsilon() {
+        return native_class(native_math<T>::epsilon(), 0);
+    }
+
+}; // class native_class
+
+template <class T>
+struct mpfr_scalar_traits<native_class<T> > {
+    static const bool is_fixed_prec = true;
+    static const mpfr_prec_t fixed_prec = native_class<T>::precision;
+    static const bool is_mpfr = false;
+};
+
+// native_class has no expression templates; expressions written for mpfr_class
+// are evaluated eagerly.
+template <class T>
+inline const native_class<T>& mpfr_expr(const native_class<T>& value) {
+    return value;
+}
+
+typedef native_class<double> double_class;
+typedef native_class<long double> ldouble_class;
+#ifdef HAVE_FLOAT128
+typedef native_class<__float128> float128_class;
+#endif
+
+#endif // __NATIVE_CLASS_H__
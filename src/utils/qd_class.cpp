@@ -0,0 +1,1146 @@
+//
+//  qd_class.cpp
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#include "qd_class.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <limits>
+#include <vector>
+
+static qd_class qd_constant(int (*constant_func)(mpfr_ptr, mpfr_rnd_t)) {
+    mpfr_class tmp;
+    tmp.set_prec(2 * qd_class::precision);
+    constant_func(tmp.get_raw(), MPFR_RNDN);
+    return qd_class(tmp);
+}
+
+static const int qd_n_inverse_factorials = 60;
+
+// 1/n! for the Taylor series, correctly rounded once from MPFR.
+static std::vector<qd_class> qd_build_inverse_factorials() {
+    std::vector<qd_class> values;
+    mpfr_class tmp;
+    tmp.set_prec(2 * qd_class::precision);
+    mpfr_set_ui(tmp.get_raw(), 1, MPFR_RNDN);
+    for (int n = 0; n < qd_n_inverse_factorials; ++n) {
+        if (n > 1) {
+            mpfr_div_ui(tmp.get_raw(), tmp.get_raw(), n, MPFR_RNDN);
+        }
+        values.push_back(qd_class(tmp));
+    }
+    return values;
+}
+
+static const qd_class* qd_inverse_factorials() {
+    static const std::vector<qd_class> table = qd_build_inverse_factorials();
+    return table.data();
+}
+
+// The exponent k with value = 2^k * m and m in [sqrt(1/2), sqrt(2)).
+static int qd_log_exponent(const double value) {
+    int k;
+    double fraction = std::frexp(value, &k);
+    if (fraction < M_SQRT1_2) {
+        --k;
+    }
+    return k;
+}
+
+static inline void qd_three_sum(double& a, double& b, double& c) {
+    double t1, t2, t3;
+    t1 = dd_two_sum(a, b, t2);
+    a = dd_two_sum(c, t1, t3);
+    b = dd_two_sum(t2, t3, c);
+}
+
+static inline void qd_three_sum2(double& a, double& b, double& c) {
+    double t1, t2, t3;
+    t1 = dd_two_sum(a, b, t2);
+    a = dd_two_sum(c, t1, t3);
+    b = t2 + t3;
+}
+
+static inline void qd_renorm(double& c0, double& c1, double& c2, double& c3) {
+    double s0, s1, s2 = 0.0, s3 = 0.0;
+    if (std::isinf(c0)) {
+        return;
+    }
+    s0 = dd_quick_two_sum(c2, c3, c3);
+    s0 = dd_quick_two_sum(c1, s0, c2);
+    c0 = dd_quick_two_sum(c0, s0, c1);
+    s0 = c0;
+    s1 = c1;
+    if (s1 != 0.0) {
+        s1 = dd_quick_two_sum(s1, c2, s2);
+        if (s2 != 0.0) {
+            s2 = dd_quick_two_sum(s2, c3, s3);
+        } else {
+            s1 = dd_quick_two_sum(s1, c3, s2);
+        }
+    } else {
+        s0 = dd_quick_two_sum(s0, c2, s1);
+        if (s1 != 0.0) {
+            s1 = dd_quick_two_sum(s1, c3, s2);
+        } else {
+            s0 = dd_quick_two_sum(s0, c3, s1);
+        }
+    }
+    c0 = s0;
+    c1 = s1;
+    c2 = s2;
+    c3 = s3;
+}
+
+static inline void qd_renorm(double& c0, double& c1, double& c2, double& c3, double& c4) {
+    double s0, s1, s2 = 0.0, s3 = 0.0;
+    if (std::isinf(c0)) {
+        return;
+    }
+    s0 = dd_quick_two_sum(c3, c4, c4);
+    s0 = dd_quick_two_sum(c2, s0, c3);
+    s0 = dd_quick_two_sum(c1, s0, c2);
+    c0 = dd_quick_two_sum(c0, s0, c1);
+    s0 = c0;
+    s1 = c1;
+    if (s1 != 0.0) {
+        s1 = dd_quick_two_sum(s1, c2, s2);
+        if (s2 != 0.0) {
+            s2 = dd_quick_two_sum(s2, c3, s3);
+            if (s3 != 0.0) {
+                s3 += c4;
+            } else {
+                s2 = dd_quick_two_sum(s2, c4, s3);
+            }
+        } else {
+            s1 = dd_quick_two_sum(s1, c3, s2);
+            if (s2 != 0.0) {
+                s2 = dd_quick_two_sum(s2, c4, s3);
+            } else {
+                s1 = dd_quick_two_sum(s1, c4, s2);
+            }
+        }
+    } else {
+        s0 = dd_quick_two_sum(s0, c2, s1);
+        if (s1 != 0.0) {
+            s1 = dd_quick_two_sum(s1, c3, s2);
+            if (s2 != 0.0) {
+                s2 = dd_quick_two_sum(s2, c4, s3);
+            } else {
+                s1 = dd_quick_two_sum(s1, c4, s2);
+            }
+        } else {
+            s0 = dd_quick_two_sum(s0, c3, s1);
+            if (s1 != 0.0) {
+                s1 = dd_quick_two_sum(s1, c4, s2);
+            } else {
+                s0 = dd_quick_two_sum(s0, c4, s1);
+            }
+        }
+    }
+    c0 = s0;
+    c1 = s1;
+    c2 = s2;
+    c3 = s3;
+}
+
+qd_class::qd_class() {
+    this->set_nan();
+}
+
+qd_class::qd_class(const int other) {
+    *this = qd_class((double)other, 0.0, 0.0, 0.0);
+}
+
+qd_class::qd_class(const long int other) {
+    double hi = (double)(other >> 32) * 4294967296.0;
+    double lo = (double)(other & 0xFFFFFFFFL);
+    this->m_data[0] = dd_two_sum(hi, lo, this->m_data[1]);
+    this->m_data[2] = 0.0;
+    this->m_data[3] = 0.0;
+}
+
+qd_class::qd_class(const long long int other) {
+    double hi = (double)(other >> 32) * 4294967296.0;
+    double lo = (double)(other & 0xFFFFFFFFLL);
+    this->m_data[0] = dd_two_sum(hi, lo, this->m_data[1]);
+    this->m_data[2] = 0.0;
+    this->m_data[3] = 0.0;
+}
+
+qd_class::qd_class(const unsigned int other) {
+    *this = qd_class((double)other, 0.0, 0.0, 0.0);
+}
+
+qd_class::qd_class(const unsigned long int other) {
+    double hi = (double)(other >> 32) * 4294967296.0;
+    double lo = (double)(other & 0xFFFFFFFFUL);
+    this->m_data[0] = dd_two_sum(hi, lo, this->m_data[1]);
+    this->m_data[2] = 0.0;
+    this->m_data[3] = 0.0;
+}
+
+qd_class::qd_class(const unsigned long long int other) {
+    double hi = (double)(other >> 32) * 4294967296.0;
+    double lo = (double)(other & 0xFFFFFFFFULL);
+    this->m_data[0] = dd_two_sum(hi, lo, this->m_data[1]);
+    this->m_data[2] = 0.0;
+    this->m_data[3] = 0.0;
+}
+
+qd_class::qd_class(const float other) {
+    *this = qd_class((double)other, 0.0, 0.0, 0.0);
+}
+
+qd_class::qd_class(const double other) {
+    *this = qd_class(other, 0.0, 0.0, 0.0);
+}
+
+qd_class::qd_class(const long double other) {
+    double hi = (double)other;
+    double lo = std::isfinite(hi) ? (double)(other - hi) : 0.0;
+    *this = qd_class(hi, lo, 0.0, 0.0);
+}
+
+qd_class::qd_class(const char *other) {
+    this->set_str(other, 10);
+}
+
+qd_class::qd_class(const std::string& other) {
+    this->set_str(other, 10);
+}
+
+qd_class::qd_class(const mpfr_class& other) {
+    this->set_raw(other.get_raw());
+}
+
+qd_class& qd_class::operator=(const double other) {
+    *this = qd_class(other, 0.0, 0.0, 0.0);
+    return *this;
+}
+
+// Adds the components pairwise and renormalizes (the sloppy addition of the
+// QD library): the error is bounded relative to the operands, not the sum.
+qd_class operator+(const qd_class& left, const qd_class& right) {
+    const double *a = left.m_data;
+    const double *b = right.m_data;
+    double t0, t1, t2, t3;
+    double s0 = dd_two_sum(a[0], b[0], t0);
+    if (!std::isfinite(s0)) {
+        return qd_class(s0, 0.0, 0.0, 0.0);
+    }
+    double s1 = dd_two_sum(a[1], b[1], t1);
+    double s2 = dd_two_sum(a[2], b[2], t2);
+    double s3 = dd_two_sum(a[3], b[3], t3);
+    s1 = dd_two_sum(s1, t0, t0);
+    qd_three_sum(s2, t0, t1);
+    qd_three_sum2(s3, t0, t2);
+    t0 = t0 + t1 + t3;
+    qd_renorm(s0, s1, s2, s3, t0);
+    return qd_class(s0, s1, s2, s3);
+}
+
+qd_class operator+(const qd_class& left, const double right) {
+    double e;
+    double c0 = dd_two_sum(left.m_data[0], right, e);
+    if (!std::isfinite(c0)) {
+        return qd_class(c0, 0.0, 0.0, 0.0);
+    }
+    double c1 = dd_two_sum(left.m_data[1], e, e);
+    double c2 = dd_two_sum(left.m_data[2], e, e);
+    double c3 = dd_two_sum(left.m_data[3], e, e);
+    qd_renorm(c0, c1, c2, c3, e);
+    return qd_class(c0, c1, c2, c3);
+}
+
+qd_class operator+(const double left, const qd_class& right) {
+    return right + left;
+}
+
+qd_class& qd_class::operator+=(const qd_class& other) {
+    *this = *this + other;
+    return *this;
+}
+
+qd_class& qd_class::operator+=(const double other) {
+    *this = *this + other;
+    return *this;
+}
+
+qd_class qd_class::operator+() const {
+    return *this;
+}
+
+qd_class& qd_class::operator++() {
+    *this = *this + 1.0;
+    return *this;
+}
+
+qd_class qd_class::operator++(int) {
+    qd_class tmp = *this;
+    *this = *this + 1.0;
+    return tmp;
+}
+
+qd_class operator-(const qd_class& left, const qd_class& right) {
+    return left + (-right);
+}
+
+qd_class operator-(const qd_class& left, const double right) {
+    return left + (-right);
+}
+
+qd_class operator-(const double left, const qd_class& right) {
+    return (-right) + left;
+}
+
+qd_class& qd_class::operator-=(const qd_class& other) {
+    *this = *this + (-other);
+    return *this;
+}
+
+qd_class& qd_class::operator-=(const double other) {
+    *this = *this + (-other);
+    return *this;
+}
+
+qd_class qd_class::operator-() const {
+    return qd_class(-this->m_data[0], -this->m_data[1], -this->m_data[2], -this->m_data[3]);
+}
+
+qd_class& qd_class::operator--() {
+    *this = *this - 1.0;
+    return *this;
+}
+
+qd_class qd_class::operator--(int) {
+    qd_class tmp = *this;
+    *this = *this - 1.0;
+    return tmp;
+}
+
+// The O(eps^4) partial products are dropped.
+qd_class operator*(const qd_class& left, const qd_class& right) {
+    const double *a = left.m_data;
+    const double *b = right.m_data;
+    double p0, p1, p2, p3, p4, p5;
+    double q0, q1, q2, q3, q4, q5;
+    double t0, t1;
+    double s0, s1, s2;
+    p0 = dd_two_prod(a[0], b[0], q0);
+    if (!std::isfinite(p0)) {
+        return qd_class(p0, 0.0, 0.0, 0.0);
+    }
+    p1 = dd_two_prod(a[0], b[1], q1);
+    p2 = dd_two_prod(a[1], b[0], q2);
+    p3 = dd_two_prod(a[0], b[2], q3);
+    p4 = dd_two_prod(a[1], b[1], q4);
+    p5 = dd_two_prod(a[2], b[0], q5);
+    qd_three_sum(p1, p2, q0);
+    qd_three_sum(p2, q1, q2);
+    qd_three_sum(p3, p4, p5);
+    s0 = dd_two_sum(p2, p3, t0);
+    s1 = dd_two_sum(q1, p4, t1);
+    s2 = q2 + p5;
+    s1 = dd_two_sum(s1, t0, t0);
+    s2 += (t0 + t1);
+    s1 += a[0] * b[3] + a[1] * b[2] + a[2] * b[1] + a[3] * b[0] + q0 + q3 + q4 + q5;
+    qd_renorm(p0, p1, s0, s1, s2);
+    return qd_class(p0, p1, s0, s1);
+}
+
+qd_class operator*(const qd_class& left, const double right) {
+    const double *a = left.m_data;
+    double p0, p1, p2, p3;
+    double q0, q1, q2;
+    double s0, s1, s2, s3, s4;
+    p0 = dd_two_prod(a[0], right, q0);
+    if (!std::isfinite(p0)) {
+        return qd_class(p0, 0.0, 0.0, 0.0);
+    }
+    p1 = dd_two_prod(a[1], right, q1);
+    p2 = dd_two_prod(a[2], right, q2);
+    p3 = a[3] * right;
+    s0 = p0;
+    s1 = dd_two_sum(q0, p1, s2);
+    qd_three_sum(s2, q1, p2);
+    qd_three_sum2(q1, q2, p3);
+    s3 = q1;
+    s4 = q2 + p2;
+    qd_renorm(s0, s1, s2, s3, s4);
+    return qd_class(s0, s1, s2, s3);
+}
+
+qd_class operator*(const double left, const qd_class& right) {
+    return right * left;
+}
+
+qd_class& qd_class::operator*=(const qd_class& other) {
+    *this = *this * other;
+    return *this;
+}
+
+qd_class& qd_class::operator*=(const double other) {
+    *this = *this * other;
+    return *this;
+}
+
+// Long division with five partial quotients.
+qd_class operator/(const qd_class& left, const qd_class& right) {
+    double q0, q1, q2, q3, q4;
+    q0 = left.m_data[0] / right.m_data[0];
+    if (!std::isfinite(q0)) {
+        return qd_class(q0, 0.0, 0.0, 0.0);
+    }
+    qd_class r = left - right * q0;
+    q1 = r.m_data[0] / right.m_data[0];
+    r -= right * q1;
+    q2 = r.m_data[0] / right.m_data[0];
+    r -= right * q2;
+    q3 = r.m_data[0] / right.m_data[0];
+    r -= right * q3;
+    q4 = r.m_data[0] / right.m_data[0];
+    qd_renorm(q0, q1, q2, q3, q4);
+    return qd_class(q0, q1, q2, q3);
+}
+
+qd_class operator/(const qd_class& left, const double right) {
+    double q[5];
+    q[0] = left.m_data[0] / right;
+    if (!std::isfinite(q[0])) {
+        return qd_class(q[0], 0.0, 0.0, 0.0);
+    }
+    qd_class r = left;
+    for (int i = 0; i < 4; ++i) {
+        double e;
+        double p = dd_two_prod(q[i], right, e);
+        r -= qd_class(p, e, 0.0, 0.0);
+        q[i + 1] = r.m_data[0] / right;
+    }
+    qd_renorm(q[0], q[1], q[2], q[3], q[4]);
+    return qd_class(q[0], q[1], q[2], q[3]);
+}
+
+qd_class operator/(const double left, const qd_class& right) {
+    return qd_class(left) / right;
+}
+
+qd_class& qd_class::operator/=(const qd_class& other) {
+    *this = *this / other;
+    return *this;
+}
+
+qd_class& qd_class::operator/=(const double other) {
+    *this = *this / other;
+    return *this;
+}
+
+qd_class operator^(const qd_class& left, const qd_class& right) {
+    return left.pow_value(right);
+}
+
+qd_class operator^(const qd_class& left, const int right) {
+    return left.pow_value((long int)right);
+}
+
+qd_class operator^(const qd_class& left, const long int right) {
+    return left.pow_value(right);
+}
+
+qd_class operator^(const qd_class& left, const unsigned int right) {
+    return left.pow_value((long int)right);
+}
+
+qd_class operator^(const qd_class& left, const unsigned long int right) {
+    return left.pow_value((long int)right);
+}
+
+qd_class operator^(const qd_class& left, const double right) {
+    return left.pow_value(qd_class(right));
+}
+
+qd_class& qd_class::operator^=(const qd_class& other) {
+    this->to_pow(other);
+    return *this;
+}
+
+qd_class& qd_class::operator^=(const long int other) {
+    this->to_pow(other);
+    return *this;
+}
+
+bool operator==(const qd_class& left, const qd_class& right) {
+    return (left.m_data[0] == right.m_data[0] && left.m_data[1] == right.m_data[1] &&
+            left.m_data[2] == right.m_data[2] && left.m_data[3] == right.m_data[3]);
+}
+
+bool operator==(const qd_class& left, const double right) {
+    return (left.m_data[0] == right && left.m_data[1] == 0.0 && left.m_data[2] == 0.0 && left.m_data[3] == 0.0);
+}
+
+bool operator==(const double left, const qd_class& right) {
+    return (right == left);
+}
+
+bool operator!=(const qd_class& left, const qd_class& right) {
+    return !(left == right);
+}
+
+bool operator!=(const qd_class& left, const double right) {
+    return !(left == right);
+}
+
+bool operator!=(const double left, const qd_class& right) {
+    return !(right == left);
+}
+
+bool operator<(const qd_class& left, const qd_class& right) {
+    for (int i = 0; i < 4; ++i) {
+        if (left.m_data[i] != right.m_data[i]) {
+            return left.m_data[i] < right.m_data[i];
+        }
+    }
+    return false;
+}
+
+bool operator<(const qd_class& left, const double right) {
+    return (left < qd_class(right));
+}
+
+bool operator<(const double left, const qd_class& right) {
+    return (qd_class(left) < right);
+}
+
+bool operator<=(const qd_class& left, const qd_class& right) {
+    return (left < right || left == right);
+}
+
+bool operator<=(const qd_class& left, const double right) {
+    return (left <= qd_class(right));
+}
+
+bool operator<=(const double left, const qd_class& right) {
+    return (qd_class(left) <= right);
+}
+
+bool operator>(const qd_class& left, const qd_class& right) {
+    return (right < left);
+}
+
+bool operator>(const qd_class& left, const double right) {
+    return (qd_class(right) < left);
+}
+
+bool operator>(const double left, const qd_class& right) {
+    return (right < qd_class(left));
+}
+
+bool operator>=(const qd_class& left, const qd_class& right) {
+    return (right <= left);
+}
+
+bool operator>=(const qd_class& left, const double right) {
+    return (qd_class(right) <= left);
+}
+
+bool operator>=(const double left, const qd_class& right) {
+    return (right <= qd_class(left));
+}
+
+// Integral exponents use binary powering, everything else exp(y*log(x)),
+// split into 2^n * exp(f*log(2) + y*log(m)) as for dd_class.
+qd_class qd_class::pow_value(const qd_class& exponent) const {
+    if (exponent.m_data[1] == 0.0 && std::fabs(exponent.m_data[0]) < 2147483648.0 &&
+        exponent.m_data[0] == std::floor(exponent.m_data[0])) {
+        return this->pow_value((long int)exponent.m_data[0]);
+    }
+    if (!(this->m_data[0] > 0.0) || !std::isfinite(this->m_data[0])) {
+        return (exponent * this->log_value()).exp_value();
+    }
+    int k = qd_log_exponent(this->m_data[0]);
+    qd_class t = qd_class(exponent.m_data[0]) * (double)k;
+    double n = std::floor(t.m_data[0] + 0.5);
+    if (!(std::fabs(n) < 2100.0)) {
+        return (exponent * this->log_value()).exp_value();
+    }
+    qd_class tail(exponent.m_data[1], exponent.m_data[2], exponent.m_data[3], 0.0);
+    qd_class f = (t - n) + tail * (double)k;
+    qd_class m = qd_class::ldexp(*this, -k);
+    qd_class y = f * qd_class::const_log2() + exponent * m.log_reduced();
+    return qd_class::ldexp(y.exp_value(), (int)n);
+}
+
+qd_class qd_class::pow_value(const long int exponent) const {
+    if (exponent == 0) {
+        return qd_class(1.0);
+    }
+    unsigned long int n = (exponent < 0) ? -(unsigned long int)exponent : (unsigned long int)exponent;
+    qd_class base = *this;
+    qd_class result(1.0);
+    while (true) {
+        if (n & 1) {
+            result *= base;
+        }
+        n >>= 1;
+        if (n == 0) {
+            break;
+        }
+        base = qd_class::sqr(base);
+    }
+    if (exponent < 0) {
+        return 1.0 / result;
+    }
+    return result;
+}
+
+void qd_class::to_pow(const qd_class& exponent) {
+    *this = this->pow_value(exponent);
+}
+
+void qd_class::to_pow(const long int exponent) {
+    *this = this->pow_value(exponent);
+}
+
+qd_class& qd_class::fma(const qd_class& left, const qd_class& right, const qd_class& addend) {
+    *this = left * right + addend;
+    return *this;
+}
+
+qd_class& qd_class::fms(const qd_class& left, const qd_class& right, const qd_class& subtrahend) {
+    *this = left * right - subtrahend;
+    return *this;
+}
+
+qd_class& qd_class::addmul(const qd_class& left, const qd_class& right) {
+    *this = *this + left * right;
+    return *this;
+}
+
+qd_class& qd_class::submul(const qd_class& left, const qd_class& right) {
+    *this = *this - left * right;
+    return *this;
+}
+
+long int qd_class::long_value() const {
+    return this->class_value().long_value();
+}
+
+double qd_class::double_value() const {
+    return this->m_data[0] + (this->m_data[1] + (this->m_data[2] + this->m_data[3]));
+}
+
+long double qd_class::ldouble_value() const {
+    return (long double)this->m_data[0] + (long double)this->m_data[1] + (long double)this->m_data[2];
+}
+
+mpfr_class qd_class::class_value() const {
+    mpfr_class tmp;
+    tmp.set_prec(qd_class::precision);
+    MPFR_DECL_INIT(c0, DBL_MANT_DIG);
+    MPFR_DECL_INIT(c1, DBL_MANT_DIG);
+    MPFR_DECL_INIT(c2, DBL_MANT_DIG);
+    MPFR_DECL_INIT(c3, DBL_MANT_DIG);
+    mpfr_set_d(c0, this->m_data[0], MPFR_RNDN);
+    mpfr_set_d(c1, this->m_data[1], MPFR_RNDN);
+    mpfr_set_d(c2, this->m_data[2], MPFR_RNDN);
+    mpfr_set_d(c3, this->m_data[3], MPFR_RNDN);
+    mpfr_ptr values[4] = {c0, c1, c2, c3};
+    mpfr_sum(tmp.get_raw(), values, 4, MPFR_RNDN);
+    return tmp;
+}
+
+std::ostream& operator<<(std::ostream& left, const qd_class& right) {
+    left << right.get_str();
+    return left;
+}
+
+std::istream& operator>>(std::istream& left, qd_class& right) {
+    std::string tmp_string;
+    left >> tmp_string;
+    right.set_str(tmp_string, 10);
+    return left;
+}
+
+std::string qd_class::get_str() const {
+    return this->class_value().get_str();
+}
+
+std::string qd_class::get_str_with_format(std::string format) const {
+    return this->class_value().get_str_with_format(format);
+}
+
+void qd_class::set_str(const std::string& other, const int base) {
+    mpfr_t tmp;
+    mpfr_init2(tmp, 2 * qd_class::precision);
+    if (mpfr_set_str(tmp, other.c_str(), base, MPFR_RNDN) != 0) {
+        printf("qd_class[%s:%d]: Invalid number string.\n", __FILE__, __LINE__);
+        abort();
+    }
+    this->set_raw(tmp);
+    mpfr_clear(tmp);
+}
+
+qd_class qd_class::abs_value() const {
+    if (this->m_data[0] < 0.0) {
+        return -*this;
+    }
+    return *this;
+}
+
+void qd_class::to_abs() {
+    *this = this->abs_value();
+}
+
+// Newton iteration on 1/sqrt(a), each step doubling the number of bits.
+qd_class qd_class::sqrt_value() const {
+    if (this->m_data[0] == 0.0 || !std::isfinite(this->m_data[0])) {
+        return (this->m_data[0] < 0.0 && !this->is_zero()) ? qd_class(NAN, 0.0, 0.0, 0.0) : *this;
+    }
+    if (this->m_data[0] < 0.0) {
+        return qd_class(NAN, 0.0, 0.0, 0.0);
+    }
+    qd_class r(1.0 / std::sqrt(this->m_data[0]));
+    qd_class h = qd_class::ldexp(*this, -1);
+    for (int i = 0; i < 3; ++i) {
+        r += (0.5 - h * qd_class::sqr(r)) * r;
+    }
+    return r * *this;
+}
+
+void qd_class::to_sqrt() {
+    *this = this->sqrt_value();
+}
+
+// log(a) = k*log(2) + log(m) with a = 2^k * m and m in [sqrt(1/2), sqrt(2)).
+qd_class qd_class::log_value() const {
+    if (this->is_nan() || this->m_data[0] < 0.0) {
+        return qd_class(NAN, 0.0, 0.0, 0.0);
+    }
+    if (this->m_data[0] == 0.0) {
+        return qd_class(-INFINITY, 0.0, 0.0, 0.0);
+    }
+    if (std::isinf(this->m_data[0])) {
+        return *this;
+    }
+    if (*this == 1.0) {
+        return qd_class(0.0);
+    }
+    int k = qd_log_exponent(this->m_data[0]);
+    qd_class m = qd_class::ldexp(*this, -k);
+    return m.log_reduced() + qd_class::const_log2() * (double)k;
+}
+
+void qd_class::to_log() {
+    *this = this->log_value();
+}
+
+// One Newton step on exp(x) = m from the dd_class logarithm, written as
+// x + ((m - 1) - expm1(x)) / (1 + expm1(x)) as for dd_class. The start
+// accounts for the two components dropped by dd_class to first order, so
+// that it is relatively accurate for m close to one.
+qd_class qd_class::log_reduced() const {
+    qd_class d = *this - 1.0;
+    dd_class start = dd_class(this->m_data[0], this->m_data[1]).log_value();
+    qd_class x(start.get_hi(), start.get_lo(), 0.0, 0.0);
+    x += (this->m_data[2] + this->m_data[3]) / this->m_data[0];
+    qd_class s = x.expm1_reduced();
+    x += (d - s) / (s + 1.0);
+    return x;
+}
+
+// exp(a) = 2^m * exp(r) with |r| <= log(2)/2.
+qd_class qd_class::exp_value() const {
+    if (this->is_nan()) {
+        return *this;
+    }
+    if (this->m_data[0] > 709.79) {
+        return qd_class(INFINITY, 0.0, 0.0, 0.0);
+    }
+    if (this->m_data[0] < -745.14) {
+        return qd_class(0.0);
+    }
+    if (this->m_data[0] == 0.0) {
+        return qd_class(1.0);
+    }
+    const qd_class log2 = qd_class::const_log2();
+    double m = std::floor(this->m_data[0] / log2.m_data[0] + 0.5);
+    qd_class s = (*this - log2 * m).expm1_reduced();
+    s += 1.0;
+    return qd_class::ldexp(s, (int)m);
+}
+
+void qd_class::to_exp() {
+    *this = this->exp_value();
+}
+
+// exp(a) - 1 = exp(r)^65536 - 1 with r = a/65536 for |a| <= log(2)/2; the
+// Taylor series gives exp(r) - 1, which is squared sixteen times as
+// s -> 2*s + s^2.
+qd_class qd_class::expm1_reduced() const {
+    const double threshold = std::ldexp(qd_class::const_epsilon().m_data[0], -16);
+    qd_class r = qd_class::ldexp(*this, -16);
+    const qd_class *inverse_factorial = qd_inverse_factorials();
+    qd_class s = r;
+    qd_class p = r;
+    for (int n = 2; n < qd_n_inverse_factorials; ++n) {
+        p *= r;
+        qd_class t = p * inverse_factorial[n];
+        s += t;
+        if (std::fabs(t.m_data[0]) <= threshold) {
+            break;
+        }
+    }
+    for (int i = 0; i < 16; ++i) {
+        s = qd_class::ldexp(s, 1) + qd_class::sqr(s);
+    }
+    return s;
+}
+
+qd_class qd_class::cos_value() const {
+    qd_class sin_result, cos_result;
+    this->sin_cos(sin_result, cos_result);
+    return cos_result;
+}
+
+void qd_class::to_cos() {
+    *this = this->cos_value();
+}
+
+qd_class qd_class::sin_value() const {
+    qd_class sin_result, cos_result;
+    this->sin_cos(sin_result, cos_result);
+    return sin_result;
+}
+
+void qd_class::to_sin() {
+    *this = this->sin_value();
+}
+
+qd_class qd_class::tan_value() const {
+    qd_class sin_result, cos_result;
+    this->sin_cos(sin_result, cos_result);
+    return sin_result / cos_result;
+}
+
+void qd_class::to_tan() {
+    *this = this->tan_value();
+}
+
+double qd_class::get_component(const int index) const {
+    return this->m_data[index];
+}
+
+mpfr_prec_t qd_class::get_prec() const {
+    return qd_class::precision;
+}
+
+mpfr_exp_t qd_class::get_exp() const {
+    int exponent;
+    double mantissa = std::frexp(this->m_data[0], &exponent);
+    if (std::fabs(mantissa) == 0.5) {
+        for (int i = 1; i < 4; ++i) {
+            if (this->m_data[i] != 0.0) {
+                if (this->m_data[0] * this->m_data[i] < 0.0) {
+                    --exponent;
+                }
+                break;
+            }
+        }
+    }
+    return exponent;
+}
+
+// The precision is fixed; set_prec only resets the value and round_prec
+// rounds it to fewer bits.
+void qd_class::set_prec(mpfr_prec_t prec) {
+    this->set_nan();
+}
+
+void qd_class::round_prec(mpfr_prec_t prec) {
+    if (prec >= qd_class::precision || !this->is_regular()) {
+        return;
+    }
+    mpfr_class tmp = this->class_value();
+    mpfr_prec_round(tmp.get_raw(), prec, MPFR_RNDN);
+    this->set_raw(tmp.get_raw());
+}
+
+bool qd_class::is_nan() const {
+    return std::isnan(this->m_data[0]);
+}
+
+bool qd_class::is_inf() const {
+    return std::isinf(this->m_data[0]);
+}
+
+bool qd_class::is_number() const {
+    return std::isfinite(this->m_data[0]);
+}
+
+bool qd_class::is_zero() const {
+    return this->m_data[0] == 0.0;
+}
+
+bool qd_class::is_regular() const {
+    return std::isfinite(this->m_data[0]) && this->m_data[0] != 0.0;
+}
+
+void qd_class::set_nan() {
+    for (int i = 0; i < 4; ++i) {
+        this->m_data[i] = std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+void qd_class::set_inf(int sign) {
+    *this = qd_class((sign < 0) ? -INFINITY : INFINITY, 0.0, 0.0, 0.0);
+}
+
+void qd_class::set_zero(int sign) {
+    *this = qd_class((sign < 0) ? -0.0 : 0.0, 0.0, 0.0, 0.0);
+}
+
+void qd_class::set_neg() {
+    for (int i = 0; i < 4; ++i) {
+        this->m_data[i] = -this->m_data[i];
+    }
+}
+
+int qd_class::get_sign() const {
+    return (this->m_data[0] > 0.0) - (this->m_data[0] < 0.0);
+}
+
+void qd_class::set_sign(int sign) {
+    if ((sign < 0) != (std::signbit(this->m_data[0]) != 0)) {
+        this->set_neg();
+    }
+}
+
+void qd_class::set_raw(mpfr_srcptr other) {
+    if (mpfr_nan_p(other)) {
+        this->set_nan();
+        return;
+    }
+    if (mpfr_inf_p(other)) {
+        this->set_inf(mpfr_sgn(other));
+        return;
+    }
+    if (mpfr_zero_p(other)) {
+        this->set_zero(mpfr_signbit(other) ? -1 : 1);
+        return;
+    }
+    mpfr_t tmp;
+    mpfr_init2(tmp, mpfr_get_prec(other));
+    mpfr_set(tmp, other, MPFR_RNDN);
+    double c[4];
+    for (int i = 0; i < 4; ++i) {
+        c[i] = mpfr_get_d(tmp, MPFR_RNDN);
+        if (!std::isfinite(c[i])) {
+            for (++i; i < 4; ++i) {
+                c[i] = 0.0;
+            }
+            break;
+        }
+        mpfr_sub_d(tmp, tmp, c[i], MPFR_RNDN);
+    }
+    mpfr_clear(tmp);
+    qd_renorm(c[0], c[1], c[2], c[3]);
+    *this = qd_class(c[0], c[1], c[2], c[3]);
+}
+
+// Reduction by multiples of pi/2 and Taylor series for sin and cos of the
+// remainder |r| <= pi/4.
+void qd_class::sin_cos(qd_class& sin_result, qd_class& cos_result) const {
+    if (this->m_data[0] == 0.0) {
+        sin_result = *this;
+        cos_result = qd_class(1.0);
+        return;
+    }
+    if (!std::isfinite(this->m_data[0])) {
+        sin_result.set_nan();
+        cos_result.set_nan();
+        return;
+    }
+    const qd_class half_pi = qd_class::ldexp(qd_class::const_pi(), -1);
+    const double epsilon = qd_class::const_epsilon().m_data[0];
+    double k = std::floor(this->m_data[0] / half_pi.m_data[0] + 0.5);
+    qd_class r = *this - half_pi * k;
+    qd_class r2 = qd_class::sqr(r);
+    const qd_class *inverse_factorial = qd_inverse_factorials();
+    qd_class sin_r = r;
+    qd_class p = r;
+    for (int n = 3; n < qd_n_inverse_factorials; n += 2) {
+        p *= r2;
+        qd_class t = p * inverse_factorial[n];
+        if (n % 4 == 3) {
+            sin_r -= t;
+        } else {
+            sin_r += t;
+        }
+        if (std::fabs(t.m_data[0]) <= epsilon * std::fabs(r.m_data[0])) {
+            break;
+        }
+    }
+    qd_class cos_r(1.0);
+    p = qd_class(1.0);
+    for (int n = 2; n < qd_n_inverse_factorials; n += 2) {
+        p *= r2;
+        qd_class t = p * inverse_factorial[n];
+        if (n % 4 == 2) {
+            cos_r -= t;
+        } else {
+            cos_r += t;
+        }
+        if (std::fabs(t.m_data[0]) <= epsilon) {
+            break;
+        }
+    }
+    long int quadrant = (long int)std::fmod(k, 4.0);
+    if (quadrant < 0) {
+        quadrant += 4;
+    }
+    switch (quadrant) {
+        case 0: {
+            sin_result = sin_r;
+            cos_result = cos_r;
+        } break;
+        case 1: {
+            sin_result = cos_r;
+            cos_result = -sin_r;
+        } break;
+        case 2: {
+            sin_result = -sin_r;
+            cos_result = -cos_r;
+        } break;
+        default: {
+            sin_result = -cos_r;
+            cos_result = sin_r;
+        }
+    }
+}
+
+qd_class qd_class::sqr(const qd_class& value) {
+    return value * value;
+}
+
+qd_class qd_class::ldexp(const qd_class& value, const int exponent) {
+    return qd_class(std::ldexp(value.m_data[0], exponent), std::ldexp(value.m_data[1], exponent),
+                    std::ldexp(value.m_data[2], exponent), std::ldexp(value.m_data[3], exponent));
+}
+
+void qd_class::set(qd_class& result, const qd_class& value) {
+    result = value;
+}
+
+void qd_class::add(qd_class& result, const qd_class& left, const qd_class& right) {
+    result = left + right;
+}
+
+void qd_class::add(qd_class& result, const qd_class& left, const unsigned long int right) {
+    result = left + (double)right;
+}
+
+void qd_class::sub(qd_class& result, const qd_class& left, const qd_class& right) {
+    result = left - right;
+}
+
+void qd_class::sub(qd_class& result, const qd_class& left, const unsigned long int right) {
+    result = left - (double)right;
+}
+
+void qd_class::sub(qd_class& result, const unsigned long int left, const qd_class& right) {
+    result = (double)left - right;
+}
+
+void qd_class::mul(qd_class& result, const qd_class& left, const qd_class& right) {
+    result = left * right;
+}
+
+void qd_class::mul(qd_class& result, const qd_class& left, const unsigned long int right) {
+    result = left * (double)right;
+}
+
+void qd_class::div(qd_class& result, const qd_class& left, const qd_class& right) {
+    result = left / right;
+}
+
+void qd_class::div(qd_class& result, const qd_class& left, const unsigned long int right) {
+    result = left / (double)right;
+}
+
+void qd_class::div(qd_class& result, const unsigned long int left, const qd_class& right) {
+    result = (double)left / right;
+}
+
+void qd_class::pow(qd_class& result, const qd_class& base, const qd_class& exponent) {
+    result = base.pow_value(exponent);
+}
+
+void qd_class::pow_ui(qd_class& result, const qd_class& base, const unsigned long int exponent) {
+    result = base.pow_value((long int)exponent);
+}
+
+void qd_class::abs_into(qd_class& result, const qd_class& value) {
+    result = value.abs_value();
+}
+
+void qd_class::sqrt_into(qd_class& result, const qd_class& value) {
+    result = value.sqrt_value();
+}
+
+void qd_class::log_into(qd_class& result, const qd_class& value) {
+    result = value.log_value();
+}
+
+void qd_class::exp_into(qd_class& result, const qd_class& value) {
+    result = value.exp_value();
+}
+
+void qd_class::cos_into(qd_class& result, const qd_class& value) {
+    result = value.cos_value();
+}
+
+void qd_class::sin_into(qd_class& result, const qd_class& value) {
+    result = value.sin_value();
+}
+
+void qd_class::tan_into(qd_class& result, const qd_class& value) {
+    result = value.tan_value();
+}
+
+qd_class qd_class::const_log2() {
+    static const qd_class value = qd_constant(mpfr_const_log2);
+    return value;
+}
+
+qd_class qd_class::const_pi() {
+    static const qd_class value = qd_constant(mpfr_const_pi);
+    return value;
+}
+
+qd_class qd_class::const_epsilon() {
+    return qd_class(std::ldexp(1.0, -209), 0.0, 0.0, 0.0);
+}
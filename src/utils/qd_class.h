@@ -0,0 +1,278 @@
+//
+//  qd_class.h
+//  Generalized Gaussian Quadrature
+//
+//  MIT License
+//
+//  Copyright (c) 2017 Paul Warkentin
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#ifndef __QD_CLASS_H__
+#define __QD_CLASS_H__
+
+#include <stdint.h>
+#include <cmath>
+#include <mpfr.h>
+#include <iostream>
+#include <string>
+
+#include "dd_class.h"
+#include "mpfr_class.h"
+#include "mpfr_scalar_traits.h"
+
+// Quad-double number: an unevaluated sum of four non-overlapping doubles in
+// decreasing magnitude, giving 212 bits of precision. The algorithms follow
+// the QD library (Hida, Li and Bailey); the interface is the one of qd_class.
+
+class qd_class {
+
+private:
+
+    double m_data[4];
+
+public:
+
+    qd_class();
+
+    qd_class(const qd_class& other) {
+        for (int i = 0; i < 4; ++i) {
+            this->m_data[i] = other.m_data[i];
+        }
+    }
+
+    qd_class(const double c0, const double c1, const double c2, const double c3) {
+        this->m_data[0] = c0;
+        this->m_data[1] = c1;
+        this->m_data[2] = c2;
+        this->m_data[3] = c3;
+    }
+
+    qd_class(const int other);
+    qd_class(const long int other);
+    qd_class(const long long int other);
+    qd_class(const unsigned int other);
+    qd_class(const unsigned long int other);
+    qd_class(const unsigned long long int other);
+    qd_class(const float other);
+    qd_class(const double other);
+    qd_class(const long double other);
+    qd_class(const char *other);
+    qd_class(const std::string& other);
+    explicit qd_class(const mpfr_class& other);
+
+    ~qd_class() {
+    }
+
+    qd_class& operator=(const qd_class& other) {
+        for (int i = 0; i < 4; ++i) {
+            this->m_data[i] = other.m_data[i];
+        }
+        return *this;
+    }
+
+    qd_class& operator=(const double other);
+
+    friend qd_class operator+(const qd_class& left, const qd_class& right);
+    friend qd_class operator+(const qd_class& left, const double right);
+    friend qd_class operator+(const double left, const qd_class& right);
+    qd_class& operator+=(const qd_class& other);
+    qd_class& operator+=(const double other);
+    qd_class operator+() const;
+    qd_class& operator++();
+    qd_class operator++(int);
+
+    friend qd_class operator-(const qd_class& left, const qd_class& right);
+    friend qd_class operator-(const qd_class& left, const double right);
+    friend qd_class operator-(const double left, const qd_class& right);
+    qd_class& operator-=(const qd_class& other);
+    qd_class& operator-=(const double other);
+    qd_class operator-() const;
+    qd_class& operator--();
+    qd_class operator--(int);
+
+    friend qd_class operator*(const qd_class& left, const qd_class& right);
+    friend qd_class operator*(const qd_class& left, const double right);
+    friend qd_class operator*(const double left, const qd_class& right);
+    qd_class& operator*=(const qd_class& other);
+    qd_class& operator*=(const double other);
+
+    friend qd_class operator/(const qd_class& left, const qd_class& right);
+    friend qd_class operator/(const qd_class& left, const double right);
+    friend qd_class operator/(const double left, const qd_class& right);
+    qd_class& operator/=(const qd_class& other);
+    qd_class& operator/=(const double other);
+
+    friend qd_class operator^(const qd_class& left, const qd_class& right);
+    friend qd_class operator^(const qd_class& left, const int right);
+    friend qd_class operator^(const qd_class& left, const long int right);
+    friend qd_class operator^(const qd_class& left, const unsigned int right);
+    friend qd_class operator^(const qd_class& left, const unsigned long int right);
+    friend qd_class operator^(const qd_class& left, const double right);
+    qd_class& operator^=(const qd_class& other);
+    qd_class& operator^=(const long int other);
+
+    friend bool operator==(const qd_class& left, const qd_class& right);
+    friend bool operator==(const qd_class& left, const double right);
+    friend bool operator==(const double left, const qd_class& right);
+
+    friend bool operator!=(const qd_class& left, const qd_class& right);
+    friend bool operator!=(const qd_class& left, const double right);
+    friend bool operator!=(const double left, const qd_class& right);
+
+    friend bool operator<(const qd_class& left, const qd_class& right);
+    friend bool operator<(const qd_class& left, const double right);
+    friend bool operator<(const double left, const qd_class& right);
+
+    friend bool operator<=(const qd_class& left, const qd_class& right);
+    friend bool operator<=(const qd_class& left, const double right);
+    friend bool operator<=(const double left, const qd_class& right);
+
+    friend bool operator>(const qd_class& left, const qd_class& right);
+    friend bool operator>(const qd_class& left, const double right);
+    friend bool operator>(const double left, const qd_class& right);
+
+    friend bool operator>=(const qd_class& left, const qd_class& right);
+    friend bool operator>=(const qd_class& left, const double right);
+    friend bool operator>=(const double left, const qd_class& right);
+
+    qd_class pow_value(const qd_class& exponent) const;
+    qd_class pow_value(const long int exponent) const;
+    void to_pow(const qd_class& exponent);
+    void to_pow(const long int exponent);
+
+    qd_class& fma(const qd_class& left, const qd_class& right, const qd_class& addend);
+    qd_class& fms(const qd_class& left, const qd_class& right, const qd_class& subtrahend);
+    qd_class& addmul(const qd_class& left, const qd_class& right);
+    qd_class& submul(const qd_class& left, const qd_class& right);
+
+    long int long_value() const;
+    double double_value() const;
+    long double ldouble_value() const;
+    mpfr_class class_value() const;
+
+    explicit operator double() const { return this->double_value(); }
+    explicit operator long double() const { return this->ldouble_value(); }
+
+    friend std::ostream& operator<<(std::ostream& left, const qd_class& right);
+    friend std::istream& operator>>(std::istream& left, qd_class& right);
+
+    std::string get_str() const;
+    std::string get_str_with_format(std::string format) const;
+    void set_str(const std::string& other, const int base);
+
+    qd_class abs_value() const;
+    void to_abs();
+
+    qd_class sqrt_value() const;
+    void to_sqrt();
+
+    qd_class log_value() const;
+    void to_log();
+
+    qd_class exp_value() const;
+    void to_exp();
+
+    qd_class cos_value() const;
+    void to_cos();
+
+    qd_class sin_value() const;
+    void to_sin();
+
+    qd_class tan_value() const;
+    void to_tan();
+
+    double get_component(const int index) const;
+
+    mpfr_prec_t get_prec() const;
+    mpfr_exp_t get_exp() const;
+    void set_prec(mpfr_prec_t prec);
+    void round_prec(mpfr_prec_t prec);
+
+    bool is_nan() const;
+    bool is_inf() const;
+    bool is_number() const;
+    bool is_zero() const;
+    bool is_regular() const;
+
+    void set_nan();
+    void set_inf(int sign);
+    void set_zero(int sign);
+    void set_neg();
+
+    int get_sign() const;
+    void set_sign(int sign);
+
+private:
+
+    void set_raw(mpfr_srcptr other);
+    void sin_cos(qd_class& sin_result, qd_class& cos_result) const;
+    qd_class log_reduced() const;
+    qd_class expm1_reduced() const;
+
+public:
+
+    static const mpfr_prec_t precision = 212;
+
+    static qd_class sqr(const qd_class& value);
+    static qd_class ldexp(const qd_class& value, const int exponent);
+
+    static void set(qd_class& result, const qd_class& value);
+    static void add(qd_class& result, const qd_class& left, const qd_class& right);
+    static void add(qd_class& result, const qd_class& left, const unsigned long int right);
+    static void sub(qd_class& result, const qd_class& left, const qd_class& right);
+    static void sub(qd_class& result, const qd_class& left, const unsigned long int right);
+    static void sub(qd_class& result, const unsigned long int left, const qd_class& right);
+    static void mul(qd_class& result, const qd_class& left, const qd_class& right);
+    static void mul(qd_class& result, const qd_class& left, const unsigned long int right);
+    static void div(qd_class& result, const qd_class& left, const qd_class& right);
+    static void div(qd_class& result, const qd_class& left, const unsigned long int right);
+    static void div(qd_class& result, const unsigned long int left, const qd_class& right);
+    static void pow(qd_class& result, const qd_class& base, const qd_class& exponent);
+    static void pow_ui(qd_class& result, const qd_class& base, const unsigned long int exponent);
+
+    static void abs_into(qd_class& result, const qd_class& value);
+    static void sqrt_into(qd_class& result, const qd_class& value);
+    static void log_into(qd_class& result, const qd_class& value);
+    static void exp_into(qd_class& result, const qd_class& value);
+    static void cos_into(qd_class& result, const qd_class& value);
+    static void sin_into(qd_class& result, const qd_class& value);
+    static void tan_into(qd_class& result, const qd_class& value);
+
+    static qd_class const_log2();
+    static qd_class const_pi();
+    static qd_class const_epsilon();
+
+}; // class qd_class
+
+template <>
+struct mpfr_scalar_traits<qd_class> {
+    static const bool is_fixed_prec = true;
+    static const mpfr_prec_t fixed_prec = qd_class::precision;
+    static const bool is_mpfr = false;
+};
+
+// qd_class has no expression templates; expressions written for mpfr_class
+// are evaluated eagerly.
+inline const qd_class& mpfr_expr(const qd_class& value) {
+    return value;
+}
+
+#endif // __QD_CLASS_H__